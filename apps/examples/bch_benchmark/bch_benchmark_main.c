@@ -0,0 +1,266 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/bch_benchmark/bch_benchmark_main.c
+ *
+ * Reports the throughput and the sector cache hit rate of the BCH
+ * character driver for a few access patterns of small transfers.  The BCH
+ * driver sits on a RAM MTD device, so that the time measured is mostly
+ * spent in the BCH and FTL layers.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/ioctl.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/mtd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE
+#define CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE 65536
+#endif
+
+#ifndef CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE
+#define CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE 64
+#endif
+
+#ifndef CONFIG_EXAMPLES_BCH_BENCHMARK_MINOR
+#define CONFIG_EXAMPLES_BCH_BENCHMARK_MINOR 7
+#endif
+
+#define BCH_BENCHMARK_PINGPONG 1000
+
+/* Access patterns */
+
+#define BCH_BENCHMARK_SEQWRITE    0	/* Write the device from start to end */
+#define BCH_BENCHMARK_SEQREAD     1	/* Read the device from start to end */
+#define BCH_BENCHMARK_ALTERNATE   2	/* Read the first and last sector in turn */
+#define BCH_BENCHMARK_INTERLEAVED 3	/* Read the first sector before each read
+									 * of the second half of the device */
+
+#define BCH_BENCHMARK_STR(x)  #x
+#define BCH_BENCHMARK_XSTR(x) BCH_BENCHMARK_STR(x)
+#define BCH_BENCHMARK_BLKDEV  "/dev/mtdblock" BCH_BENCHMARK_XSTR(CONFIG_EXAMPLES_BCH_BENCHMARK_MINOR)
+#define BCH_BENCHMARK_CHRDEV  "/dev/mtd" BCH_BENCHMARK_XSTR(CONFIG_EXAMPLES_BCH_BENCHMARK_MINOR)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t g_simflash[CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE];
+static uint8_t g_buffer[CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE];
+static bool g_initialized;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static unsigned long bch_benchmark_usec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	int64_t usec;
+
+	usec = (int64_t)(end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+	return usec > 0 ? (unsigned long)usec : 0;
+}
+
+/* Create the RAM MTD device, the FTL block device on top of it and the BCH
+ * character device on top of that.
+ */
+
+static int bch_benchmark_setup(void)
+{
+	FAR struct mtd_dev_s *mtd;
+	int ret;
+
+	mtd = rammtd_initialize(g_simflash, CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE);
+	if (!mtd) {
+		printf("ERROR: rammtd_initialize failed\n");
+		return ERROR;
+	}
+
+	ret = ftl_initialize(CONFIG_EXAMPLES_BCH_BENCHMARK_MINOR, mtd);
+	if (ret < 0) {
+		printf("ERROR: ftl_initialize %s failed: %d\n", BCH_BENCHMARK_BLKDEV, ret);
+		return ERROR;
+	}
+
+	ret = bchdev_register(BCH_BENCHMARK_BLKDEV, BCH_BENCHMARK_CHRDEV, false);
+	if (ret < 0) {
+		printf("ERROR: bchdev_register %s failed: %d\n", BCH_BENCHMARK_CHRDEV, ret);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/* Run one access pattern on a new open of the character device.  The
+ * time includes close(), which writes back what is left in the cache.
+ */
+
+static int bch_benchmark_run(FAR const char *name, int pattern)
+{
+	struct bchstats_s before;
+	struct bchstats_s after;
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec;
+	unsigned long naccesses;
+	unsigned long hits;
+	uint64_t nbytes = 0;
+	off_t last = CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE - CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE;
+	off_t pos = 0;
+	off_t next = 0;
+	ssize_t ret = 0;
+	int fd;
+	int i;
+
+	fd = open(BCH_BENCHMARK_CHRDEV, O_RDWR);
+	if (fd < 0) {
+		printf("ERROR: Failed to open %s\n", BCH_BENCHMARK_CHRDEV);
+		return ERROR;
+	}
+
+	if (ioctl(fd, DIOC_GETSTATS, (unsigned long)&before) < 0) {
+		printf("ERROR: DIOC_GETSTATS failed\n");
+		close(fd);
+		return ERROR;
+	}
+
+	if (pattern == BCH_BENCHMARK_INTERLEAVED) {
+		next = CONFIG_EXAMPLES_BCH_BENCHMARK_SIZE / 2;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; pattern == BCH_BENCHMARK_ALTERNATE ? i < BCH_BENCHMARK_PINGPONG : next <= last; i++) {
+		/* Select the position of this transfer and the next sequential one */
+
+		pos = next;
+		if (pattern == BCH_BENCHMARK_ALTERNATE) {
+			pos = (i & 1) ? last : 0;
+		} else if (pattern == BCH_BENCHMARK_INTERLEAVED && (i & 1) == 0) {
+			pos = 0;
+		} else {
+			next += CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE;
+		}
+
+		if (lseek(fd, pos, SEEK_SET) != pos) {
+			ret = ERROR;
+			break;
+		}
+
+		if (pattern == BCH_BENCHMARK_SEQWRITE) {
+			memset(g_buffer, i, CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE);
+			ret = write(fd, g_buffer, CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE);
+		} else {
+			ret = read(fd, g_buffer, CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE);
+		}
+
+		if (ret != CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE) {
+			break;
+		}
+
+		nbytes += ret;
+	}
+
+	(void)ioctl(fd, DIOC_GETSTATS, (unsigned long)&after);
+	close(fd);
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	if (ret != CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE) {
+		printf("ERROR: %s failed at offset %lu\n", name, (unsigned long)pos);
+		return ERROR;
+	}
+
+	usec = bch_benchmark_usec(&start, &end);
+	hits = after.hits - before.hits;
+	naccesses = hits + after.misses - before.misses;
+
+	printf("%-10s: %lu bytes in %lu us", name, (unsigned long)nbytes, usec);
+	if (usec > 0) {
+		printf(", %lu KB/s", (unsigned long)(nbytes * 1000000 / 1024 / usec));
+	}
+
+	printf("\n");
+	printf("            hits %lu misses %lu", hits, naccesses - hits);
+	if (naccesses > 0) {
+		printf(" (%lu%%)", hits * 100 / naccesses);
+	}
+
+	printf(", read ahead %lu, driver reads %lu writes %lu\n", (unsigned long)(after.readahead - before.readahead), (unsigned long)(after.devreads - before.devreads), (unsigned long)(after.devwrites - before.devwrites));
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int bch_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int ret = OK;
+
+	if (!g_initialized) {
+		if (bch_benchmark_setup() < 0) {
+			return ERROR;
+		}
+
+		g_initialized = true;
+	}
+
+	printf("BCH benchmark of %s, %d byte transfers\n", BCH_BENCHMARK_CHRDEV, CONFIG_EXAMPLES_BCH_BENCHMARK_IOSIZE);
+
+	/* Write first so that the reads do not see erased sectors only */
+
+	if (bch_benchmark_run("seqwrite", BCH_BENCHMARK_SEQWRITE) < 0) {
+		ret = ERROR;
+	}
+
+	if (bch_benchmark_run("seqread", BCH_BENCHMARK_SEQREAD) < 0) {
+		ret = ERROR;
+	}
+
+	if (bch_benchmark_run("pingpong", BCH_BENCHMARK_ALTERNATE) < 0) {
+		ret = ERROR;
+	}
+
+	if (bch_benchmark_run("interleave", BCH_BENCHMARK_INTERLEAVED) < 0) {
+		ret = ERROR;
+	}
+
+	return ret;
+}
@@ -0,0 +1,192 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/inode_benchmark/inode_benchmark_main.c
+ *
+ * Registers a directory of dummy character drivers and reports the time
+ * taken by stat() and by open() and close() of some of them, that is,
+ * mostly the time taken to look up a path in the pseudo-filesystem.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+#include <tinyara/fs/fs.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODE_BENCHMARK_DIR     "/dev/ibench"
+#define INODE_BENCHMARK_PATHLEN 32
+
+#ifndef CONFIG_EXAMPLES_INODE_BENCHMARK_NNODES
+#define CONFIG_EXAMPLES_INODE_BENCHMARK_NNODES 32
+#endif
+
+#ifndef CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS
+#define CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS 10000
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int inode_benchmark_open(FAR struct file *filep);
+static int inode_benchmark_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_inode_benchmark_fops = {
+	inode_benchmark_open,		/* open */
+	inode_benchmark_close,		/* close */
+	0,							/* read */
+	0,							/* write */
+	0,							/* seek */
+	0							/* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+	, 0							/* poll */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int inode_benchmark_open(FAR struct file *filep)
+{
+	return OK;
+}
+
+static int inode_benchmark_close(FAR struct file *filep)
+{
+	return OK;
+}
+
+static void inode_benchmark_path(FAR char *path, int index)
+{
+	snprintf(path, INODE_BENCHMARK_PATHLEN, INODE_BENCHMARK_DIR "/n%03d", index);
+}
+
+static unsigned long inode_benchmark_nsec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	int64_t nsec;
+
+	nsec = (int64_t)(end->tv_sec - start->tv_sec) * 1000000000 + (end->tv_nsec - start->tv_nsec);
+	return nsec > 0 ? (unsigned long)(nsec / CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS) : 0;
+}
+
+static void inode_benchmark_run(FAR const char *path)
+{
+	struct timespec start;
+	struct timespec end;
+	struct stat st;
+	unsigned long statns;
+	unsigned long openns;
+	int nfail = 0;
+	int fd;
+	int i;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS; i++) {
+		if (stat(path, &st) != OK) {
+			nfail++;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	statns = inode_benchmark_nsec(&start, &end);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS; i++) {
+		fd = open(path, O_RDONLY);
+		if (fd >= 0) {
+			close(fd);
+		} else {
+			nfail++;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	openns = inode_benchmark_nsec(&start, &end);
+
+	printf("%-20s stat %7lu ns, open/close %7lu ns%s\n", path, statns, openns, nfail ? " (not found)" : "");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int inode_benchmark_main(int argc, char *argv[])
+#endif
+{
+	char path[INODE_BENCHMARK_PATHLEN];
+	int nnodes;
+	int ret;
+	int i;
+
+	for (nnodes = 0; nnodes < CONFIG_EXAMPLES_INODE_BENCHMARK_NNODES; nnodes++) {
+		inode_benchmark_path(path, nnodes);
+		ret = register_driver(path, &g_inode_benchmark_fops, 0666, NULL);
+		if (ret < 0) {
+			printf("register_driver %s failed: %d\n", path, ret);
+			goto errout;
+		}
+	}
+
+	printf("Path lookup, %d drivers in %s, %d calls per measurement\n", nnodes, INODE_BENCHMARK_DIR, CONFIG_EXAMPLES_INODE_BENCHMARK_NLOOPS);
+
+	inode_benchmark_path(path, 0);
+	inode_benchmark_run(path);
+	inode_benchmark_path(path, nnodes / 2);
+	inode_benchmark_run(path);
+	inode_benchmark_path(path, nnodes - 1);
+	inode_benchmark_run(path);
+	inode_benchmark_run("/dev/null");
+	inode_benchmark_run(INODE_BENCHMARK_DIR "/none");
+
+	ret = OK;
+
+errout:
+	for (i = 0; i < nnodes; i++) {
+		inode_benchmark_path(path, i);
+		(void)unregister_driver(path);
+	}
+
+	/* Remove the directory node that was created for the drivers as well */
+
+	(void)unregister_driver(INODE_BENCHMARK_DIR);
+	return ret;
+}
@@ -188,6 +188,77 @@ void hnd_get_time(coap_context_t *ctx, struct coap_resource_t *resource, coap_ad
 	}
 }
 
+/* Large resource served block-wise from a cached representation, so that
+ * the text is rendered once for all its blocks instead of once per block. */
+#define LARGE_LINES 512
+
+static coap_block_cache_t large_cache;
+
+static int render_large(void *arg, unsigned char **data, size_t *len)
+{
+	unsigned char *buf;
+	coap_tick_t t;
+	size_t size = LARGE_LINES * 32;
+	size_t pos = 0;
+	int i;
+
+	buf = coap_malloc(size);
+	if (!buf) {
+		return 0;
+	}
+
+	coap_ticks(&t);
+	for (i = 0; i < LARGE_LINES && pos < size; i++) {
+		pos += snprintf((char *)buf + pos, size - pos, "%04d %10u abcdefghijklmn\n", i, (unsigned int)t);
+	}
+
+	*data = buf;
+	*len = pos;
+	return 1;
+}
+
+void hnd_get_large(coap_context_t *ctx, struct coap_resource_t *resource, coap_address_t *peer, coap_pdu_t *request, str *token, coap_pdu_t *response)
+{
+	coap_block_t block;
+	unsigned char buf[3];
+	coap_transport_t transport = COAP_UDP;
+
+	if (ctx->protocol == COAP_PROTO_TCP || ctx->protocol == COAP_PROTO_TLS) {
+		transport = coap_get_tcp_header_type_from_initbyte(((unsigned char *)request->transport_hdr)[0] >> 4);
+	}
+
+	if (!coap_block_cache_update(&large_cache)) {
+		response->transport_hdr->udp.code = COAP_RESPONSE_CODE(500);
+		return;
+	}
+
+	if (coap_block_cache_etag_match(&large_cache, request, transport)) {
+		response->transport_hdr->udp.code = COAP_RESPONSE_CODE(203);
+		coap_add_option(response, COAP_OPTION_ETAG, sizeof(coap_key_t), large_cache.etag);
+		return;
+	}
+
+	if (!coap_get_block2(request, COAP_OPTION_BLOCK2, &block, transport)) {
+		block.num = 0;
+		block.szx = COAP_MAX_BLOCK_SZX;
+	} else if (block.szx > 6) {
+		response->transport_hdr->udp.code = COAP_RESPONSE_CODE(400);
+		return;
+	} else if (block.szx > COAP_MAX_BLOCK_SZX) {
+		block.num <<= block.szx - COAP_MAX_BLOCK_SZX;
+		block.szx = COAP_MAX_BLOCK_SZX;
+	}
+
+	response->transport_hdr->udp.code = COAP_RESPONSE_CODE(205);
+	coap_add_option(response, COAP_OPTION_ETAG, sizeof(coap_key_t), large_cache.etag);
+	coap_add_option(response, COAP_OPTION_CONTENT_FORMAT, coap_encode_var_bytes(buf, COAP_MEDIATYPE_TEXT_PLAIN), buf);
+
+	if (coap_write_block_opt(&block, COAP_OPTION_BLOCK2, response, large_cache.length) < 0
+		|| !coap_add_block_stream(response, large_cache.length, coap_block_cache_read, &large_cache, block.num, block.szx)) {
+		response->transport_hdr->udp.code = COAP_RESPONSE_CODE(402);
+	}
+}
+
 void hnd_put_time(coap_context_t *ctx, struct coap_resource_t *resource, coap_address_t *peer, coap_pdu_t *request, str *token, coap_pdu_t *response)
 {
 	coap_tick_t t;
@@ -360,6 +431,14 @@ void init_resources(coap_context_t *ctx)
 	coap_add_resource(ctx, r);
 	time_resource = r;
 
+	coap_block_cache_init(&large_cache, render_large, NULL);
+	r = coap_resource_init((unsigned char *)"large", 5, 0);
+	coap_register_handler(r, COAP_REQUEST_GET, hnd_get_large);
+
+	coap_add_attr(r, (unsigned char *)"ct", 2, (unsigned char *)"0", 1, 0);
+	coap_add_attr(r, (unsigned char *)"title", 5, (unsigned char *)"\"Large Data\"", 12, 0);
+	coap_add_resource(ctx, r);
+
 #ifndef WITHOUT_ASYNC
 	r = coap_resource_init((unsigned char *)"async", 5, 0);
 	coap_register_handler(r, COAP_REQUEST_GET, hnd_get_async);
@@ -665,6 +744,7 @@ exit:
 #endif
 
 	coap_free_context(ctx);
+	coap_block_cache_invalidate(&large_cache);
 	if (addr_str) {
 		coap_free(addr_str);
 	}
@@ -0,0 +1,393 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mq_benchmark/mq_benchmark_main.c
+ *
+ * A sender task passes messages through a message queue to the receiver
+ * (the calling task) and the receiver reports the message rate, for
+ * several message sizes, sender priorities and ways of passing the
+ * messages.  Then an echo task measures the round trip latency.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <mqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MQ_BENCHMARK_DATA      "mqb_data"
+#define MQ_BENCHMARK_ECHO      "mqb_echo"
+#define MQ_BENCHMARK_MAXMSGS   8
+#define MQ_BENCHMARK_NVEC      8
+#define MQ_BENCHMARK_MAXSIZE   256
+#define MQ_BENCHMARK_STACKSIZE 2048
+
+#ifndef CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS
+#define CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS 10000
+#endif
+
+/* The ways of passing the messages */
+
+#define MQ_BENCHMARK_COPY      0	/* mq_send() and mq_receive() */
+#define MQ_BENCHMARK_BATCH     1	/* mq_send() and mq_receivev() */
+#define MQ_BENCHMARK_ZCOPY     2	/* The zero-copy interfaces */
+
+#ifdef CONFIG_MQ_ZEROCOPY
+#define MQ_BENCHMARK_NMODES    3
+#else
+#define MQ_BENCHMARK_NMODES    2
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_modenames[] = { "copy", "batch", "zcopy" };
+
+static const size_t g_sizes[] = { 16, 64, MQ_BENCHMARK_MAXSIZE };
+
+/* The priority of the sender relative to the receiver */
+
+static const int g_prios[] = { -10, 0, 10 };
+static const char *g_prionames[] = { "lower", "same", "higher" };
+
+static char g_sndbuf[MQ_BENCHMARK_MAXSIZE];
+static char g_echobuf[MQ_BENCHMARK_MAXSIZE];
+static char g_rcvbuf[MQ_BENCHMARK_NVEC][MQ_BENCHMARK_MAXSIZE];
+static struct mq_msgvec g_msgvec[MQ_BENCHMARK_NVEC];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static long mq_benchmark_usec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	long usec;
+
+	usec = (end->tv_sec - start->tv_sec) * 1000000L + (end->tv_nsec - start->tv_nsec) / 1000;
+	return usec > 0 ? usec : 1;
+}
+
+static int mq_benchmark_priority(int delta)
+{
+	struct sched_param param;
+	int prio;
+
+	sched_getparam(0, &param);
+	prio = param.sched_priority + delta;
+
+	if (prio > SCHED_PRIORITY_MAX) {
+		prio = SCHED_PRIORITY_MAX;
+	} else if (prio < SCHED_PRIORITY_MIN) {
+		prio = SCHED_PRIORITY_MIN;
+	}
+
+	return prio;
+}
+
+/* Sender task: argv[1] is the way of passing messages, argv[2] the size */
+
+static int mq_benchmark_sender(int argc, char *argv[])
+{
+	size_t size = (size_t)atoi(argv[2]);
+#ifdef CONFIG_MQ_ZEROCOPY
+	int mode = atoi(argv[1]);
+	FAR char *msg;
+#endif
+	mqd_t mqdes;
+	int ret;
+	int i;
+
+	mqdes = mq_open(MQ_BENCHMARK_DATA, O_WRONLY);
+	if (mqdes == (mqd_t)ERROR) {
+		printf("sender: mq_open failed: %d\n", errno);
+		return ERROR;
+	}
+
+	for (i = 0; i < CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS; i++) {
+		/* Only the sequence number changes from one message to the next */
+
+#ifdef CONFIG_MQ_ZEROCOPY
+		if (mode == MQ_BENCHMARK_ZCOPY) {
+			msg = mq_msgreserve(mqdes);
+			if (msg == NULL) {
+				printf("sender: mq_msgreserve failed: %d\n", errno);
+				break;
+			}
+
+			memcpy(msg, &i, sizeof(i));
+			ret = mq_msgcommit(mqdes, msg, size, 0);
+		} else
+#endif
+		{
+			memcpy(g_sndbuf, &i, sizeof(i));
+			ret = mq_send(mqdes, g_sndbuf, size, 0);
+		}
+
+		if (ret < 0) {
+			printf("sender: send failed: %d\n", errno);
+			break;
+		}
+	}
+
+	mq_close(mqdes);
+	return OK;
+}
+
+static int mq_benchmark_run(int mode, size_t size, int prioidx)
+{
+	char modestr[4];
+	char sizestr[12];
+	FAR char *argv[3];
+	struct mq_attr attr;
+	struct timespec start;
+	struct timespec end;
+	int received = 0;
+	ssize_t nrecv;
+	mqd_t mqdes;
+	long usec;
+	pid_t pid;
+#ifdef CONFIG_MQ_ZEROCOPY
+	FAR void *msg;
+#endif
+
+	attr.mq_maxmsg = MQ_BENCHMARK_MAXMSGS;
+	attr.mq_msgsize = size;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open(MQ_BENCHMARK_DATA, O_RDONLY | O_CREAT, 0666, &attr);
+	if (mqdes == (mqd_t)ERROR) {
+		printf("receiver: mq_open failed: %d\n", errno);
+		return ERROR;
+	}
+
+	snprintf(modestr, sizeof(modestr), "%d", mode);
+	snprintf(sizestr, sizeof(sizestr), "%u", (unsigned int)size);
+	argv[0] = modestr;
+	argv[1] = sizestr;
+	argv[2] = NULL;
+
+	pid = task_create("mq_sender", mq_benchmark_priority(g_prios[prioidx]), MQ_BENCHMARK_STACKSIZE, mq_benchmark_sender, argv);
+	if (pid < 0) {
+		printf("task_create failed: %d\n", errno);
+		mq_close(mqdes);
+		mq_unlink(MQ_BENCHMARK_DATA);
+		return ERROR;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	while (received < CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS) {
+		if (mode == MQ_BENCHMARK_BATCH) {
+			nrecv = mq_receivev(mqdes, g_msgvec, MQ_BENCHMARK_NVEC);
+		}
+#ifdef CONFIG_MQ_ZEROCOPY
+		else if (mode == MQ_BENCHMARK_ZCOPY) {
+			nrecv = mq_msgreceive(mqdes, &msg, NULL);
+			if (nrecv >= 0) {
+				mq_msgrelease(mqdes, msg);
+				nrecv = 1;
+			}
+		}
+#endif
+		else {
+			nrecv = mq_receive(mqdes, g_rcvbuf[0], size, NULL);
+			if (nrecv >= 0) {
+				nrecv = 1;
+			}
+		}
+
+		if (nrecv < 0) {
+			printf("receiver: receive failed: %d\n", errno);
+			break;
+		}
+
+		received += nrecv;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	mq_close(mqdes);
+	mq_unlink(MQ_BENCHMARK_DATA);
+
+	usec = mq_benchmark_usec(&start, &end);
+	printf("%-5s %3u bytes, sender %-6s: %7d msgs in %8ld us, %7lu msgs/s\n", g_modenames[mode], (unsigned int)size, g_prionames[prioidx], received, usec, (unsigned long)((uint64_t)received * 1000000 / usec));
+
+	return received == CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS ? OK : ERROR;
+}
+
+/* Echo task: argv[1] is the message size */
+
+static int mq_benchmark_echo(int argc, char *argv[])
+{
+	size_t size = (size_t)atoi(argv[1]);
+	mqd_t reqdes;
+	mqd_t rspdes;
+	ssize_t nrecv;
+	int i;
+
+	reqdes = mq_open(MQ_BENCHMARK_DATA, O_RDONLY);
+	rspdes = mq_open(MQ_BENCHMARK_ECHO, O_WRONLY);
+	if (reqdes == (mqd_t)ERROR || rspdes == (mqd_t)ERROR) {
+		printf("echo: mq_open failed: %d\n", errno);
+		return ERROR;
+	}
+
+	for (i = 0; i < CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS; i++) {
+		nrecv = mq_receive(reqdes, g_echobuf, size, NULL);
+		if (nrecv < 0 || mq_send(rspdes, g_echobuf, nrecv, 0) < 0) {
+			printf("echo: failed: %d\n", errno);
+			break;
+		}
+	}
+
+	mq_close(reqdes);
+	mq_close(rspdes);
+	return OK;
+}
+
+static int mq_benchmark_latency(size_t size)
+{
+	char sizestr[12];
+	FAR char *argv[2];
+	struct mq_attr attr;
+	struct timespec start;
+	struct timespec end;
+	mqd_t reqdes;
+	mqd_t rspdes;
+	long usec;
+	pid_t pid;
+	int i;
+
+	attr.mq_maxmsg = 1;
+	attr.mq_msgsize = size;
+	attr.mq_flags = 0;
+
+	reqdes = mq_open(MQ_BENCHMARK_DATA, O_WRONLY | O_CREAT, 0666, &attr);
+	rspdes = mq_open(MQ_BENCHMARK_ECHO, O_RDONLY | O_CREAT, 0666, &attr);
+	if (reqdes == (mqd_t)ERROR || rspdes == (mqd_t)ERROR) {
+		printf("mq_open failed: %d\n", errno);
+		i = 0;
+		goto errout;
+	}
+
+	snprintf(sizestr, sizeof(sizestr), "%u", (unsigned int)size);
+	argv[0] = sizestr;
+	argv[1] = NULL;
+
+	pid = task_create("mq_echo", mq_benchmark_priority(0), MQ_BENCHMARK_STACKSIZE, mq_benchmark_echo, argv);
+	if (pid < 0) {
+		printf("task_create failed: %d\n", errno);
+		i = 0;
+		goto errout;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	for (i = 0; i < CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS; i++) {
+		memcpy(g_sndbuf, &i, sizeof(i));
+		if (mq_send(reqdes, g_sndbuf, size, 0) < 0 || mq_receive(rspdes, g_rcvbuf[0], size, NULL) < 0) {
+			printf("round trip failed: %d\n", errno);
+			break;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	usec = mq_benchmark_usec(&start, &end);
+	printf("round trip %3u bytes: %7lu ns\n", (unsigned int)size, (unsigned long)((uint64_t)usec * 1000 / CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS));
+
+errout:
+	if (reqdes != (mqd_t)ERROR) {
+		mq_close(reqdes);
+	}
+
+	if (rspdes != (mqd_t)ERROR) {
+		mq_close(rspdes);
+	}
+
+	mq_unlink(MQ_BENCHMARK_DATA);
+	mq_unlink(MQ_BENCHMARK_ECHO);
+	return i == CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS ? OK : ERROR;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * mq_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mq_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int ret = OK;
+	int mode;
+	int prio;
+	int i;
+
+	for (i = 0; i < MQ_BENCHMARK_NVEC; i++) {
+		g_msgvec[i].msg = g_rcvbuf[i];
+		g_msgvec[i].bufsize = MQ_BENCHMARK_MAXSIZE;
+	}
+
+	memset(g_sndbuf, 0x5a, sizeof(g_sndbuf));
+
+	printf("Message queue throughput, %d messages per measurement\n", CONFIG_EXAMPLES_MQ_BENCHMARK_NMSGS);
+
+	for (i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]) && ret == OK; i++) {
+		if (g_sizes[i] > CONFIG_MQ_MAXMSGSIZE) {
+			break;
+		}
+
+		for (mode = 0; mode < MQ_BENCHMARK_NMODES && ret == OK; mode++) {
+			for (prio = 0; prio < sizeof(g_prios) / sizeof(g_prios[0]) && ret == OK; prio++) {
+				ret = mq_benchmark_run(mode, g_sizes[i], prio);
+			}
+		}
+	}
+
+	for (i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]) && ret == OK; i++) {
+		if (g_sizes[i] > CONFIG_MQ_MAXMSGSIZE) {
+			break;
+		}
+
+		ret = mq_benchmark_latency(g_sizes[i]);
+	}
+
+	return ret;
+}
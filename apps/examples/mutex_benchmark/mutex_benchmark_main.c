@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mutex_benchmark/mutex_benchmark_main.c
+ *
+ * Reports the cost of an uncontended pthread_mutex_lock()/unlock() pair
+ * (and of sem_wait()/sem_post() for comparison), and the rate of critical
+ * sections executed by several threads sharing one mutex.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sched.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MUTEX_BENCHMARK_MAXTHREADS 4
+#define MUTEX_BENCHMARK_STACKSIZE  2048
+
+#ifndef CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS
+#define CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS 100000
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static pthread_mutex_t g_mutex;
+static pthread_mutex_t g_start;
+static volatile unsigned long g_counter;
+
+/* Parameters of the running measurement */
+
+static int g_nloops;
+static bool g_yield;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static unsigned long mutex_benchmark_usec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	int64_t usec;
+
+	usec = (int64_t)(end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+	return usec > 0 ? (unsigned long)usec : 1;
+}
+
+static void mutex_benchmark_uncontended(void)
+{
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec;
+	sem_t sem;
+	int i;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS; i++) {
+		pthread_mutex_lock(&g_mutex);
+		g_counter++;
+		pthread_mutex_unlock(&g_mutex);
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	usec = mutex_benchmark_usec(&start, &end);
+	printf("uncontended mutex    : %7lu ns per lock/unlock\n", (unsigned long)((uint64_t)usec * 1000 / CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS));
+
+	sem_init(&sem, 0, 1);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS; i++) {
+		sem_wait(&sem);
+		g_counter++;
+		sem_post(&sem);
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	usec = mutex_benchmark_usec(&start, &end);
+	printf("uncontended semaphore: %7lu ns per wait/post\n", (unsigned long)((uint64_t)usec * 1000 / CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS));
+
+	sem_destroy(&sem);
+}
+
+static FAR void *mutex_benchmark_thread(FAR void *arg)
+{
+	int i;
+
+	/* Wait until all of the threads were created */
+
+	pthread_mutex_lock(&g_start);
+	pthread_mutex_unlock(&g_start);
+
+	for (i = 0; i < g_nloops; i++) {
+		pthread_mutex_lock(&g_mutex);
+		g_counter++;
+		if (g_yield) {
+			/* Let the next thread find the mutex locked */
+
+			sched_yield();
+		}
+
+		pthread_mutex_unlock(&g_mutex);
+	}
+
+	return NULL;
+}
+
+static int mutex_benchmark_contended(int nthreads, bool yield)
+{
+	pthread_t threads[MUTEX_BENCHMARK_MAXTHREADS];
+	struct sched_param param;
+	struct timespec start;
+	struct timespec end;
+	pthread_attr_t attr;
+	unsigned long usec;
+	unsigned long total;
+	int ret = OK;
+	int i;
+
+	g_nloops = CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS / nthreads;
+	g_yield = yield;
+	g_counter = 0;
+	total = (unsigned long)g_nloops * nthreads;
+
+	/* Hold the threads at the start until all of them were created, so
+	 * that they start together and the clock starts when they do.
+	 */
+
+	pthread_mutex_lock(&g_start);
+
+	sched_getparam(0, &param);
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, MUTEX_BENCHMARK_STACKSIZE);
+	pthread_attr_setschedparam(&attr, &param);
+
+	for (i = 0; i < nthreads; i++) {
+		ret = pthread_create(&threads[i], &attr, mutex_benchmark_thread, NULL);
+		if (ret != OK) {
+			printf("pthread_create failed: %d\n", ret);
+			break;
+		}
+	}
+
+	if (i < nthreads) {
+		/* Let the threads that were created finish, then give up */
+
+		nthreads = i;
+		ret = ERROR;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	pthread_mutex_unlock(&g_start);
+
+	for (i = 0; i < nthreads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	pthread_attr_destroy(&attr);
+
+	if (ret != OK) {
+		return ERROR;
+	}
+
+	if (g_counter != total) {
+		printf("%d threads: counted %lu of %lu critical sections\n", nthreads, g_counter, total);
+		return ERROR;
+	}
+
+	usec = mutex_benchmark_usec(&start, &end);
+	printf("%d threads, %-4s     : %7lu critical sections/s\n", nthreads, yield ? "high" : "low", (unsigned long)((uint64_t)total * 1000000 / usec));
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mutex_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int nthreads;
+	int ret = OK;
+
+	pthread_mutex_init(&g_mutex, NULL);
+	pthread_mutex_init(&g_start, NULL);
+
+	printf("Mutex benchmark, %d lock/unlock pairs per measurement\n", CONFIG_EXAMPLES_MUTEX_BENCHMARK_NLOOPS);
+
+	mutex_benchmark_uncontended();
+
+	for (nthreads = 2; nthreads <= MUTEX_BENCHMARK_MAXTHREADS && ret == OK; nthreads *= 2) {
+		ret = mutex_benchmark_contended(nthreads, false);
+		if (ret == OK) {
+			ret = mutex_benchmark_contended(nthreads, true);
+		}
+	}
+
+	pthread_mutex_destroy(&g_start);
+	pthread_mutex_destroy(&g_mutex);
+	return ret;
+}
@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/pipe_benchmark/pipe_benchmark_main.c
+ *
+ * A writer task sends a fixed amount of data through a FIFO to the reader
+ * (the calling task) and the reader reports the throughput, for several
+ * transfer sizes and with both file descriptor and stdio access.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PIPE_BENCHMARK_FIFO      "/dev/pipe_benchmark"
+#define PIPE_BENCHMARK_MAXSIZE   4096
+#define PIPE_BENCHMARK_STACKSIZE 2048
+
+#ifndef CONFIG_EXAMPLES_PIPE_BENCHMARK_TOTAL
+#define CONFIG_EXAMPLES_PIPE_BENCHMARK_TOTAL 262144
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const size_t g_sizes[] = { 1, 16, 64, 256, 1024, PIPE_BENCHMARK_MAXSIZE };
+
+static uint8_t g_wrbuf[PIPE_BENCHMARK_MAXSIZE];
+static uint8_t g_rdbuf[PIPE_BENCHMARK_MAXSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Writer task: argv[1] is the transfer size, argv[2] is "1" for stdio */
+
+static int pipe_benchmark_writer(int argc, char *argv[])
+{
+	size_t size = (size_t)atoi(argv[1]);
+	bool use_stdio = atoi(argv[2]) != 0;
+	size_t remaining = CONFIG_EXAMPLES_PIPE_BENCHMARK_TOTAL;
+	FILE *stream = NULL;
+	ssize_t nwritten;
+	size_t n;
+	int fd;
+
+	fd = open(PIPE_BENCHMARK_FIFO, O_WRONLY);
+	if (fd < 0) {
+		printf("writer: open failed: %d\n", errno);
+		return ERROR;
+	}
+
+	if (use_stdio) {
+		stream = fdopen(fd, "w");
+		if (stream == NULL) {
+			printf("writer: fdopen failed: %d\n", errno);
+			close(fd);
+			return ERROR;
+		}
+	}
+
+	while (remaining > 0) {
+		n = remaining < size ? remaining : size;
+
+		if (use_stdio) {
+			nwritten = fwrite(g_wrbuf, 1, n, stream) == n ? (ssize_t)n : -1;
+		} else {
+			nwritten = write(fd, g_wrbuf, n);
+		}
+
+		if (nwritten <= 0) {
+			printf("writer: write failed: %d\n", errno);
+			break;
+		}
+
+		remaining -= nwritten;
+	}
+
+	if (use_stdio) {
+		fclose(stream);
+	} else {
+		close(fd);
+	}
+
+	return OK;
+}
+
+static int pipe_benchmark_run(size_t size, bool use_stdio)
+{
+	char sizestr[12];
+	char stdiostr[2];
+	FAR char *argv[3];
+	struct timespec start;
+	struct timespec end;
+	FILE *stream = NULL;
+	size_t total = 0;
+	ssize_t nread;
+	long usec;
+	pid_t pid;
+	int fd;
+
+	snprintf(sizestr, sizeof(sizestr), "%u", (unsigned int)size);
+	stdiostr[0] = use_stdio ? '1' : '0';
+	stdiostr[1] = '\0';
+	argv[0] = sizestr;
+	argv[1] = stdiostr;
+	argv[2] = NULL;
+
+	pid = task_create("pipe_writer", SCHED_PRIORITY_DEFAULT, PIPE_BENCHMARK_STACKSIZE, pipe_benchmark_writer, argv);
+	if (pid < 0) {
+		printf("task_create failed: %d\n", errno);
+		return ERROR;
+	}
+
+	fd = open(PIPE_BENCHMARK_FIFO, O_RDONLY);
+	if (fd < 0) {
+		printf("reader: open failed: %d\n", errno);
+		return ERROR;
+	}
+
+	if (use_stdio) {
+		stream = fdopen(fd, "r");
+		if (stream == NULL) {
+			printf("reader: fdopen failed: %d\n", errno);
+			close(fd);
+			return ERROR;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	/* Read until the writer closes its end of the FIFO */
+
+	for (;;) {
+		if (use_stdio) {
+			nread = fread(g_rdbuf, 1, size, stream);
+		} else {
+			nread = read(fd, g_rdbuf, size);
+		}
+
+		if (nread <= 0) {
+			break;
+		}
+
+		total += nread;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	if (use_stdio) {
+		fclose(stream);
+	} else {
+		close(fd);
+	}
+
+	usec = (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000;
+	if (usec <= 0) {
+		usec = 1;
+	}
+
+	printf("%-6s %5u bytes: %7u bytes in %7ld us, %7lu KB/s\n", use_stdio ? "stdio" : "fd", (unsigned int)size, (unsigned int)total, usec, (unsigned long)((uint64_t)total * 1000000 / usec / 1024));
+
+	return total == CONFIG_EXAMPLES_PIPE_BENCHMARK_TOTAL ? OK : ERROR;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * pipe_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int pipe_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int ret = OK;
+	int mode;
+	int i;
+
+	if (mkfifo(PIPE_BENCHMARK_FIFO, 0666) < 0 && errno != EEXIST) {
+		printf("mkfifo failed: %d\n", errno);
+		return ERROR;
+	}
+
+	memset(g_wrbuf, 0x5a, sizeof(g_wrbuf));
+
+	printf("FIFO throughput, %u bytes per measurement\n", (unsigned int)CONFIG_EXAMPLES_PIPE_BENCHMARK_TOTAL);
+
+	for (mode = 0; mode < 2 && ret == OK; mode++) {
+		for (i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]); i++) {
+			ret = pipe_benchmark_run(g_sizes[i], mode != 0);
+			if (ret != OK) {
+				break;
+			}
+		}
+	}
+
+	unlink(PIPE_BENCHMARK_FIFO);
+	return ret;
+}
@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/romfs_benchmark/romfs_benchmark_main.c
+ *
+ * Reports the latency of open() for every file of a directory tree, which
+ * for ROMFS is dominated by the path lookup, and the throughput of reading
+ * the files.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ROMFS_BENCHMARK_BUFSIZE 512
+
+#ifndef CONFIG_EXAMPLES_ROMFS_BENCHMARK_PATH
+#define CONFIG_EXAMPLES_ROMFS_BENCHMARK_PATH "/rom"
+#endif
+
+#ifndef CONFIG_EXAMPLES_ROMFS_BENCHMARK_NLOOPS
+#define CONFIG_EXAMPLES_ROMFS_BENCHMARK_NLOOPS 10
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_path[PATH_MAX];
+static uint8_t g_buffer[ROMFS_BENCHMARK_BUFSIZE];
+
+/* Results */
+
+static unsigned long g_nfiles;
+static unsigned long g_nerrors;
+static uint64_t g_opentime;
+static unsigned long g_openmax;
+static uint64_t g_readtime;
+static uint64_t g_readbytes;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static unsigned long romfs_benchmark_usec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	int64_t usec;
+
+	usec = (int64_t)(end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+	return usec > 0 ? (unsigned long)usec : 0;
+}
+
+static void romfs_benchmark_file(FAR const char *path)
+{
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec;
+	ssize_t nread;
+	int fd;
+	int i;
+
+	for (i = 0; i < CONFIG_EXAMPLES_ROMFS_BENCHMARK_NLOOPS; i++) {
+		clock_gettime(CLOCK_REALTIME, &start);
+		fd = open(path, O_RDONLY);
+		clock_gettime(CLOCK_REALTIME, &end);
+		if (fd < 0) {
+			printf("Failed to open %s\n", path);
+			g_nerrors++;
+			return;
+		}
+
+		close(fd);
+
+		usec = romfs_benchmark_usec(&start, &end);
+		g_opentime += usec;
+		if (usec > g_openmax) {
+			g_openmax = usec;
+		}
+	}
+
+	g_nfiles++;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		g_nerrors++;
+		return;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	while ((nread = read(fd, g_buffer, ROMFS_BENCHMARK_BUFSIZE)) > 0) {
+		g_readbytes += nread;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	close(fd);
+
+	if (nread < 0) {
+		printf("Failed to read %s\n", path);
+		g_nerrors++;
+	}
+
+	g_readtime += romfs_benchmark_usec(&start, &end);
+}
+
+/* Walk the directory in g_path, which is extended in place for the
+ * entries of the directory.
+ */
+
+static void romfs_benchmark_walk(void)
+{
+	FAR struct dirent *entryp;
+	FAR DIR *dirp;
+	size_t pathlen = strlen(g_path);
+
+	dirp = opendir(g_path);
+	if (!dirp) {
+		printf("Failed to open directory %s\n", g_path);
+		g_nerrors++;
+		return;
+	}
+
+	while ((entryp = readdir(dirp)) != NULL) {
+		if (strcmp(entryp->d_name, ".") == 0 || strcmp(entryp->d_name, "..") == 0) {
+			continue;
+		}
+
+		if (pathlen + strlen(entryp->d_name) + 2 > PATH_MAX) {
+			printf("Path too long: %s/%s\n", g_path, entryp->d_name);
+			g_nerrors++;
+			continue;
+		}
+
+		g_path[pathlen] = '/';
+		strcpy(&g_path[pathlen + 1], entryp->d_name);
+
+		if (DIRENT_ISDIRECTORY(entryp->d_type)) {
+			romfs_benchmark_walk();
+		} else if (DIRENT_ISFILE(entryp->d_type)) {
+			romfs_benchmark_file(g_path);
+		}
+
+		g_path[pathlen] = '\0';
+	}
+
+	closedir(dirp);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int romfs_benchmark_main(int argc, char *argv[])
+#endif
+{
+	FAR const char *dir = CONFIG_EXAMPLES_ROMFS_BENCHMARK_PATH;
+	unsigned long nopens;
+
+	if (argc > 1) {
+		dir = argv[1];
+	}
+
+	if (strlen(dir) >= PATH_MAX) {
+		printf("Path too long: %s\n", dir);
+		return ERROR;
+	}
+
+	strcpy(g_path, dir);
+	g_nfiles = 0;
+	g_nerrors = 0;
+	g_opentime = 0;
+	g_openmax = 0;
+	g_readtime = 0;
+	g_readbytes = 0;
+
+	romfs_benchmark_walk();
+
+	printf("ROMFS benchmark of %s, %d opens per file\n", dir, CONFIG_EXAMPLES_ROMFS_BENCHMARK_NLOOPS);
+	if (g_nfiles == 0) {
+		printf("No files found\n");
+		return ERROR;
+	}
+
+	nopens = g_nfiles * CONFIG_EXAMPLES_ROMFS_BENCHMARK_NLOOPS;
+	printf("files      : %lu\n", g_nfiles);
+	printf("open       : %lu us average, %lu us worst\n", (unsigned long)(g_opentime / nopens), g_openmax);
+	printf("read       : %lu bytes in %lu us", (unsigned long)g_readbytes, (unsigned long)g_readtime);
+	if (g_readtime > 0) {
+		printf(", %lu KB/s", (unsigned long)(g_readbytes * 1000000 / 1024 / g_readtime));
+	}
+
+	printf("\n");
+
+	if (g_nerrors > 0) {
+		printf("errors     : %lu\n", g_nerrors);
+		return ERROR;
+	}
+
+	return OK;
+}
@@ -45,6 +45,7 @@
 #define LOOP_COUNT 5
 #define PROC_UPTIME_PATH PROCFS_TEST_MOUNTPOINT"/uptime"
 #define PROC_VERSION_PATH PROCFS_TEST_MOUNTPOINT"/version"
+#define PROC_SCHED_PATH PROCFS_TEST_MOUNTPOINT"/sched"
 #define PROC_INVALID_PATH PROCFS_TEST_MOUNTPOINT"/nofile"
 #define INVALID_PATH PROCFS_TEST_MOUNTPOINT"/fs/invalid"
 #if defined(CONFIG_SIDK_S5JT200_AUTOMOUNT_USERFS)
@@ -187,6 +188,72 @@ static int procfs_version_ops(char *dirpath)
 		return OK;
 }
 
+#if defined(CONFIG_SCHED_TASKSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SCHED)
+static int procfs_sched_read(const char *path, unsigned long *nswitches)
+{
+	int fd;
+	ssize_t nread;
+	char buf[PROC_BUFFER_LEN];
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		printf("Failed to open %s\n", path);
+		return ERROR;
+	}
+
+	nread = read(fd, buf, PROC_BUFFER_LEN - 1);
+	close(fd);
+	if (nread <= 0) {
+		printf("Failed to read %s\n", path);
+		return ERROR;
+	}
+
+	buf[nread] = '\0';
+	if (sscanf(buf, "Switches: %lu", nswitches) != 1) {
+		printf("Unexpected contents of %s: %s\n", path, buf);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+static int procfs_sched_ops(void)
+{
+	int ret;
+	unsigned long total;
+	unsigned long before;
+	unsigned long after;
+	char path[PROC_FILEPATH_LEN];
+
+	ret = procfs_sched_read(PROC_SCHED_PATH, &total);
+	if (ret != OK) {
+		return ERROR;
+	}
+
+	/* Sleeping blocks this task, so it must be switched in again */
+
+	snprintf(path, PROC_FILEPATH_LEN, "%s/%d/sched", PROCFS_TEST_MOUNTPOINT, getpid());
+	ret = procfs_sched_read(path, &before);
+	if (ret != OK) {
+		return ERROR;
+	}
+
+	usleep(1000);
+
+	ret = procfs_sched_read(path, &after);
+	if (ret != OK) {
+		return ERROR;
+	}
+
+	if (after <= before) {
+		printf("%s: switches %lu -> %lu\n", path, before, after);
+		return ERROR;
+	}
+
+	return OK;
+}
+#endif
+
 static int procfs_rewind_tc(const char *dirpath)
 {
 	int count;
@@ -325,6 +392,10 @@ void tc_fs_procfs_main(void)
 
 	ret = procfs_version_ops(PROC_UPTIME_PATH);
 	TC_ASSERT_EQ("procfs_version_ops", ret, OK);
+#if defined(CONFIG_SCHED_TASKSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SCHED)
+	ret = procfs_sched_ops();
+	TC_ASSERT_EQ("procfs_sched_ops", ret, OK);
+#endif
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_SMARTFS
 	tc_fs_smartfs_procfs_main();
 #endif
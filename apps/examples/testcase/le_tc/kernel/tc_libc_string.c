@@ -39,6 +39,9 @@
 #define BUFF_SIZE 5
 #define BUFF_SIZE_10 10
 #define BUFF_SIZE_12 12
+#define ALIGN_RANGE 8
+#define ALIGN_MAXLEN 40
+#define ALIGN_BUFF_SIZE (ALIGN_RANGE + ALIGN_MAXLEN + 8)
 
 /****************************************************************************
  * Public Functions
@@ -919,6 +922,71 @@ static void tc_libc_string_strtold(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+* @fn                   :tc_libc_string_word_access
+* @brief                :Checks the word-at-a-time string functions with every alignment of their buffers.
+* @Scenario             :Call memcpy, memset, memcmp, strlen and strchr for each source and destination\
+*                        offset within a word and each length up to ALIGN_MAXLEN, and check the bytes\
+*                        around the buffers are not touched.
+* API's covered         :memcpy, memset, memcmp, strlen, strchr
+* Preconditions         :none
+* Postconditions        :none
+* @return               :void
+*/
+static void tc_libc_string_word_access(void)
+{
+	static unsigned char src[ALIGN_BUFF_SIZE];
+	static unsigned char dest[ALIGN_BUFF_SIZE];
+	int soff;
+	int doff;
+	int len;
+	int i;
+
+	for (i = 0; i < ALIGN_BUFF_SIZE; i++) {
+		src[i] = (unsigned char)(i * 7 + 1);
+	}
+
+	for (soff = 0; soff < ALIGN_RANGE; soff++) {
+		for (doff = 0; doff < ALIGN_RANGE; doff++) {
+			for (len = 0; len <= ALIGN_MAXLEN; len++) {
+				memset(dest, 0xee, sizeof(dest));
+				TC_ASSERT_EQ("memcpy", memcpy(dest + doff, src + soff, len), dest + doff);
+				for (i = 0; i < ALIGN_BUFF_SIZE; i++) {
+					TC_ASSERT_EQ("memcpy", dest[i], (i >= doff && i < doff + len) ? src[soff + i - doff] : 0xee);
+				}
+
+				TC_ASSERT_EQ("memcmp", memcmp(dest + doff, src + soff, len), 0);
+				if (len > 0) {
+					dest[doff + len - 1]++;
+					TC_ASSERT_EQ("memcmp", memcmp(dest + doff, src + soff, len), dest[doff + len - 1] ? 1 : -1);
+				}
+			}
+		}
+	}
+
+	for (doff = 0; doff < ALIGN_RANGE; doff++) {
+		for (len = 0; len <= ALIGN_MAXLEN; len++) {
+			memset(dest, 0xee, sizeof(dest));
+			TC_ASSERT_EQ("memset", memset(dest + doff, 0x15a, len), dest + doff);
+			for (i = 0; i < ALIGN_BUFF_SIZE; i++) {
+				TC_ASSERT_EQ("memset", dest[i], (i >= doff && i < doff + len) ? 0x5a : 0xee);
+			}
+
+			memset(dest, 'a', sizeof(dest));
+			dest[doff + len] = '\0';
+			TC_ASSERT_EQ("strlen", strlen((char *)dest + doff), len);
+			TC_ASSERT_EQ("strchr", strchr((char *)dest + doff, 'b'), NULL);
+			TC_ASSERT_EQ("strchr", strchr((char *)dest + doff, '\0'), (char *)dest + doff + len);
+			if (len > 0) {
+				dest[doff + len - 1] = 0xb0;
+				TC_ASSERT_EQ("strchr", strchr((char *)dest + doff, 0xb0), (char *)dest + doff + len - 1);
+			}
+		}
+	}
+
+	TC_SUCCESS_RESULT();
+}
+
 /****************************************************************************
  * Name: libc_string
  ****************************************************************************/
@@ -959,6 +1027,7 @@ int libc_string_main(void)
 	tc_libc_string_strlcpy();
 	tc_libc_string_strtof();
 	tc_libc_string_strtold();
+	tc_libc_string_word_access();
 
 	return 0;
 }
@@ -758,6 +758,136 @@ static void tc_mqueue_mq_unlink(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+* @fn                   :tc_mqueue_mq_receivev
+* @brief                :receive several queued messages in one call
+* @scenario             :send messages of different priorities, then receive them with mq_receivev
+* API's covered         :mq_send, mq_receivev
+* Preconditions         :none
+* Postconditions        :none
+* @return               :void
+*/
+static void tc_mqueue_mq_receivev(void)
+{
+	char msg_buffer[3][TEST_MSGLEN];
+	struct mq_msgvec msgvec[3];
+	struct mq_attr attr;
+	mqd_t mqdes;
+	ssize_t nrecv;
+	int idx;
+
+	attr.mq_maxmsg = 3;
+	attr.mq_msgsize = TEST_MSGLEN;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open("mqrecvv", O_RDWR | O_CREAT | O_NONBLOCK, 0666, &attr);
+	TC_ASSERT_NEQ("mq_open", mqdes, (mqd_t)ERROR);
+
+	for (idx = 0; idx < 3; idx++) {
+		msgvec[idx].msg = msg_buffer[idx];
+		msgvec[idx].bufsize = TEST_MSGLEN;
+	}
+
+	/* An empty non-blocking queue fails like mq_receive() */
+
+	nrecv = mq_receivev(mqdes, msgvec, 3);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", nrecv, ERROR, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", errno, EAGAIN, goto cleanup);
+
+	nrecv = mq_receivev(mqdes, msgvec, 0);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", nrecv, ERROR, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", errno, EINVAL, goto cleanup);
+
+	/* Two messages are received in priority order, the third buffer is unused */
+
+	TC_ASSERT_EQ_CLEANUP("mq_send", mq_send(mqdes, "low", 4, 1), OK, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_send", mq_send(mqdes, TEST_MESSAGE, TEST_MSGLEN, 5), OK, goto cleanup);
+
+	nrecv = mq_receivev(mqdes, msgvec, 3);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", nrecv, 2, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", msgvec[0].msglen, TEST_MSGLEN, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", msgvec[0].prio, 5, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", strcmp(msg_buffer[0], TEST_MESSAGE), 0, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", msgvec[1].msglen, 4, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", msgvec[1].prio, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", strcmp(msg_buffer[1], "low"), 0, goto cleanup);
+
+	/* A buffer smaller than the message size is rejected */
+
+	msgvec[2].bufsize = TEST_MSGLEN - 1;
+	TC_ASSERT_EQ_CLEANUP("mq_send", mq_send(mqdes, "low", 4, 1), OK, goto cleanup);
+	nrecv = mq_receivev(mqdes, msgvec, 3);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", nrecv, ERROR, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_receivev", errno, EMSGSIZE, goto cleanup);
+
+	TC_ASSERT_EQ_CLEANUP("mq_close", mq_close(mqdes), OK, goto cleanup_unlink);
+	TC_ASSERT_EQ("mq_unlink", mq_unlink("mqrecvv"), OK);
+
+	TC_SUCCESS_RESULT();
+	return;
+
+cleanup:
+	mq_close(mqdes);
+cleanup_unlink:
+	mq_unlink("mqrecvv");
+}
+
+#ifdef CONFIG_MQ_ZEROCOPY
+/**
+* @fn                   :tc_mqueue_mq_msgreserve_msgreceive
+* @brief                :pass messages without copying them
+* @scenario             :write a message into a reserved buffer, commit it, then borrow and release it
+* API's covered         :mq_msgreserve, mq_msgcommit, mq_msgreceive, mq_msgrelease
+* Preconditions         :none
+* Postconditions        :none
+* @return               :void
+*/
+static void tc_mqueue_mq_msgreserve_msgreceive(void)
+{
+	struct mq_attr attr;
+	FAR char *msg;
+	FAR void *rcvmsg;
+	mqd_t mqdes;
+	ssize_t nbytes;
+	int prio;
+
+	attr.mq_maxmsg = 2;
+	attr.mq_msgsize = TEST_MSGLEN;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open("mqzcopy", O_RDWR | O_CREAT | O_NONBLOCK, 0666, &attr);
+	TC_ASSERT_NEQ("mq_open", mqdes, (mqd_t)ERROR);
+
+	msg = mq_msgreserve(mqdes);
+	TC_ASSERT_NEQ_CLEANUP("mq_msgreserve", msg, NULL, goto cleanup);
+
+	memcpy(msg, TEST_MESSAGE, TEST_MSGLEN);
+	TC_ASSERT_EQ_CLEANUP("mq_msgcommit", mq_msgcommit(mqdes, msg, TEST_MSGLEN, 3), OK, goto cleanup);
+
+	nbytes = mq_msgreceive(mqdes, &rcvmsg, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", nbytes, TEST_MSGLEN, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", rcvmsg, msg, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", prio, 3, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", strcmp(rcvmsg, TEST_MESSAGE), 0, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_msgrelease", mq_msgrelease(mqdes, rcvmsg), OK, goto cleanup);
+
+	nbytes = mq_msgreceive(mqdes, &rcvmsg, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", nbytes, ERROR, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("mq_msgreceive", errno, EAGAIN, goto cleanup);
+
+	TC_ASSERT_EQ_CLEANUP("mq_close", mq_close(mqdes), OK, goto cleanup_unlink);
+	TC_ASSERT_EQ("mq_unlink", mq_unlink("mqzcopy"), OK);
+
+	TC_SUCCESS_RESULT();
+	return;
+
+cleanup:
+	mq_close(mqdes);
+cleanup_unlink:
+	mq_unlink("mqzcopy");
+}
+#endif
+
 /**
 * @fn                   :tc_mqueue_mq_timedsend_timedreceive_failurechecks
 * @description          :Function for tc_mqueue_mq_timedsend_timedreceive corner case checks
@@ -865,6 +995,10 @@ int mqueue_main(void)
 	tc_mqueue_mq_timedsend_timedreceive();
 	tc_mqueue_mq_timedsend_timedreceive_failurechecks();
 	tc_mqueue_mq_unlink();
+	tc_mqueue_mq_receivev();
+#ifdef CONFIG_MQ_ZEROCOPY
+	tc_mqueue_mq_msgreserve_msgreceive();
+#endif
 
 	return 0;
 }
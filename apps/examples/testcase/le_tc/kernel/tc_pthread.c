@@ -1050,6 +1050,89 @@ static void tc_pthread_pthread_mutex_lock_unlock_trylock(void)
 	TC_SUCCESS_RESULT();
 }
 
+#ifdef CONFIG_PRIORITY_INHERITANCE
+/**
+* @fn                   :thread_mutex_waiter
+* @brief                :Waits for g_mutex and releases it again
+*/
+static void *thread_mutex_waiter(void *param)
+{
+	pthread_mutex_lock(&g_mutex);
+	pthread_mutex_unlock(&g_mutex);
+	return NULL;
+}
+
+/**
+* @fn                   :tc_pthread_pthread_mutex_priority_inheritance
+* @brief                :The holder of a mutex inherits the priority of a thread waiting for it
+* @Scenario             :The caller locks a free mutex, so that the lock takes the uncontended
+*                        path. Then a thread of higher priority waits for the mutex. The caller
+*                        must run at the priority of that thread until it unlocks the mutex,
+*                        and at its own priority again afterwards.
+* API's covered         :pthread_mutex_lock, pthread_mutex_unlock
+* Preconditions         :pthread_mutex_init
+* Postconditions        :pthread_mutex_destroy
+* @return               :void
+*/
+static void tc_pthread_pthread_mutex_priority_inheritance(void)
+{
+	struct sched_param param;
+	pthread_attr_t attr;
+	pthread_t waiter;
+	int base_prio;
+	int ret_chk;
+
+	ret_chk = sched_getparam(0, &param);
+	TC_ASSERT_EQ("sched_getparam", ret_chk, OK);
+	base_prio = param.sched_priority;
+	TC_ASSERT_LT("sched_getparam", base_prio, SCHED_PRIORITY_MAX);
+
+	ret_chk = pthread_mutex_init(&g_mutex, NULL);
+	TC_ASSERT_EQ("pthread_mutex_init", ret_chk, OK);
+
+	ret_chk = pthread_mutex_lock(&g_mutex);
+	TC_ASSERT_EQ_CLEANUP("pthread_mutex_lock", ret_chk, OK, pthread_mutex_destroy(&g_mutex));
+
+	/* The waiter runs as soon as it is created and blocks on the mutex */
+
+	pthread_attr_init(&attr);
+	param.sched_priority = base_prio + VAL_ONE;
+	pthread_attr_setschedparam(&attr, &param);
+	ret_chk = pthread_create(&waiter, &attr, thread_mutex_waiter, NULL);
+	TC_ASSERT_EQ_CLEANUP("pthread_create", ret_chk, OK, goto cleanup_mutex);
+
+	ret_chk = sched_getparam(0, &param);
+	TC_ASSERT_EQ_CLEANUP("sched_getparam", ret_chk, OK, goto cleanup_thread);
+	TC_ASSERT_EQ_CLEANUP("sched_getparam", param.sched_priority, base_prio + VAL_ONE, goto cleanup_thread);
+
+	ret_chk = pthread_mutex_unlock(&g_mutex);
+	TC_ASSERT_EQ_CLEANUP("pthread_mutex_unlock", ret_chk, OK, goto cleanup_join);
+
+	ret_chk = sched_getparam(0, &param);
+	TC_ASSERT_EQ_CLEANUP("sched_getparam", ret_chk, OK, goto cleanup_join);
+	TC_ASSERT_EQ_CLEANUP("sched_getparam", param.sched_priority, base_prio, goto cleanup_join);
+
+	pthread_join(waiter, NULL);
+	pthread_attr_destroy(&attr);
+	pthread_mutex_destroy(&g_mutex);
+	TC_SUCCESS_RESULT();
+	return;
+
+cleanup_thread:
+	pthread_mutex_unlock(&g_mutex);
+cleanup_join:
+	pthread_join(waiter, NULL);
+	pthread_attr_destroy(&attr);
+	pthread_mutex_destroy(&g_mutex);
+	return;
+
+cleanup_mutex:
+	pthread_attr_destroy(&attr);
+	pthread_mutex_unlock(&g_mutex);
+	pthread_mutex_destroy(&g_mutex);
+}
+#endif
+
 /**
 * @fn                   :tc_pthread_pthread_mutex_init
 * @brief                :this tc test pthread_mutex_init
@@ -1517,6 +1600,9 @@ int pthread_main(void)
 	tc_pthread_pthread_mutex_init();
 	tc_pthread_pthread_mutex_destroy();
 	tc_pthread_pthread_mutex_lock_unlock_trylock();
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	tc_pthread_pthread_mutex_priority_inheritance();
+#endif
 	tc_pthread_pthread_once();
 	tc_pthread_pthread_yield();
 	tc_pthread_pthread_cond_signal_wait();
@@ -22,6 +22,8 @@
 
 #include <tinyara/config.h>
 #include <stdio.h>
+#include <time.h>
+#include <semaphore.h>
 #include <netdb.h>
 #include <network/mqtt/mqtt_api.h>
 #include "tc_common.h"
@@ -37,6 +39,8 @@
 #define ITC_MQTT_LOGD
 #endif
 #define ITC_MQTT_LOOP_SIZE 10
+#define ITC_MQTT_INFLIGHT_COUNT 2000
+#define ITC_MQTT_INFLIGHT_TIMEOUT 60
 
 #define ITC_MQTT_WAIT_SIGNAL \
 	do {\
@@ -51,6 +55,8 @@
 static mqtt_client_t *g_mqtt_client_handle;
 static sem_t g_mqtt_itc_signal;
 static char g_mqtt_msg[] = ITC_MQTT_MESSAGE;
+static sem_t g_mqtt_inflight_signal;
+static volatile int g_mqtt_inflight_acked;
 
 /****************************************************************************************
  *Private Functions
@@ -104,6 +110,13 @@ static void on_publish(void *client, int msg_id)
 	ITC_MQTT_SEND_SIGNAL;
 }
 
+static void on_publish_inflight(void *client, int msg_id)
+{
+	if (++g_mqtt_inflight_acked == ITC_MQTT_INFLIGHT_COUNT) {
+		sem_post(&g_mqtt_inflight_signal);
+	}
+}
+
 static void on_message(void *client, mqtt_msg_t *msg)
 {
 	mqtt_client_t *id = (mqtt_client_t *)client;
@@ -156,6 +169,19 @@ static mqtt_client_config_t g_mqtt_client_config = {
 	on_unsubscribe
 };
 
+static mqtt_client_config_t g_mqtt_inflight_config = {
+	ITC_SUB_PUB_ID,
+	"", "", 1, 3, 0, 0,
+	on_connect,
+	on_disconnect,
+	on_publish_inflight,
+	on_message,
+	on_subscribe,
+	on_unsubscribe,
+	NULL,
+	-1
+};
+
 /*
  * @testcase             itc_mqtt_init_deinit_client_p
  * @brief                To check  initialize mqtt and de-initialize mqtt
@@ -813,6 +839,66 @@ void itc_mqtt_publish_p_zero_len_msg(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+ * @testcase         itc_mqtt_publish_p_inflight_stress
+ * @brief            publishing thousands of QoS 1 and 2 messages without waiting
+ * @scenario         open the in-flight window, publish ITC_MQTT_INFLIGHT_COUNT messages
+ *                   back to back and wait until every one has been acknowledged
+ * @apicovered       mqtt_init_client, mqtt_connect, mqtt_publish, mqtt_disconnect,
+ *                   mqtt_deinit_client
+ * @precondition     mqtt_init_client, mqtt_connect
+ * @postcondition    mqtt_disconnect, mqtt_deinit_client
+*/
+
+void itc_mqtt_publish_p_inflight_stress(void)
+{
+	struct timeval start;
+	struct timeval end;
+	struct timespec abstime;
+	int res;
+	int i;
+
+	res = sem_init(&g_mqtt_inflight_signal, 0, 0);
+	TC_ASSERT_EQ("sem_init", res, OK);
+	g_mqtt_inflight_acked = 0;
+
+	g_mqtt_client_handle = mqtt_init_client(&g_mqtt_inflight_config);
+	TC_ASSERT_NEQ_CLEANUP("mqtt_init_client", g_mqtt_client_handle, NULL, sem_destroy(&g_mqtt_inflight_signal));
+	res = mqtt_connect(g_mqtt_client_handle, CONFIG_ITC_MQTT_BROKER_ADDR, CONFIG_ITC_MQTT_BROKER_PORT, 0);
+	TC_ASSERT_EQ_CLEANUP("mqtt_connect", res, 0,
+		mqtt_deinit_client(g_mqtt_client_handle); sem_destroy(&g_mqtt_inflight_signal));
+	ITC_MQTT_WAIT_SIGNAL;
+
+	gettimeofday(&start, NULL);
+	for (i = 0; i < ITC_MQTT_INFLIGHT_COUNT; i++) {
+		res = mqtt_publish(g_mqtt_client_handle, ITC_MQTT_TOPIC, g_mqtt_msg, sizeof(g_mqtt_msg), (i % 2) + 1, 0);
+		if (res != 0) {
+			break;
+		}
+	}
+	TC_ASSERT_EQ_CLEANUP("mqtt_publish", res, 0,
+		mqtt_disconnect(g_mqtt_client_handle); mqtt_deinit_client(g_mqtt_client_handle); sem_destroy(&g_mqtt_inflight_signal));
+
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_sec += ITC_MQTT_INFLIGHT_TIMEOUT;
+	res = sem_timedwait(&g_mqtt_inflight_signal, &abstime);
+	gettimeofday(&end, NULL);
+	TC_ASSERT_EQ_CLEANUP("on_publish", g_mqtt_inflight_acked, ITC_MQTT_INFLIGHT_COUNT,
+		mqtt_disconnect(g_mqtt_client_handle); mqtt_deinit_client(g_mqtt_client_handle); sem_destroy(&g_mqtt_inflight_signal));
+
+	res = mqtt_disconnect(g_mqtt_client_handle);
+	TC_ASSERT_EQ_CLEANUP("mqtt_disconnect", res, 0,
+		mqtt_deinit_client(g_mqtt_client_handle); sem_destroy(&g_mqtt_inflight_signal));
+	ITC_MQTT_WAIT_SIGNAL;
+
+	res = mqtt_deinit_client(g_mqtt_client_handle);
+	sem_destroy(&g_mqtt_inflight_signal);
+	TC_ASSERT_EQ("mqtt_deinit_client", res, 0);
+	printf("\n[%d QoS 1/2 messages acknowledged in %.2f ms]\n",
+			ITC_MQTT_INFLIGHT_COUNT, diff_time(&start, &end) / 1000);
+	TC_SUCCESS_RESULT();
+}
+
 /*******************************************************************************************/
 
 
@@ -844,6 +930,7 @@ int itc_mqtt_main(int argc, char *argv[])
 		itc_mqtt_api_success_ratio_p();
 		itc_mqtt_subscribe_p_performance();
 		itc_mqtt_publish_p_zero_len_msg();
+		itc_mqtt_publish_p_inflight_stress();
 		itc_mqtt_deinit_n_redeinit_client();
 		itc_mqtt_connect_n_reconnect();
 		itc_mqtt_disconnect_n_redisconnect();
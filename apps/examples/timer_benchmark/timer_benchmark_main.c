@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/timer_benchmark/timer_benchmark_main.c
+ *
+ * Measures the time taken to arm and cancel a watchdog timer and a piece of
+ * delayed work while other timers are pending.  Both operations run with
+ * interrupts disabled, so their cost adds directly to interrupt latency.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <tinyara/clock.h>
+#include <tinyara/wdog.h>
+#include <tinyara/wqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS
+#define CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS 256
+#endif
+
+#ifndef CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS
+#define CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS 10000
+#endif
+
+/* The pending timers expire long after the test is over; their delays are
+ * spread over about one second on top of that so that they do not all
+ * share one expiration time.
+ */
+
+#define TIMER_BENCHMARK_DELAY  SEC2TICK(600)
+#define TIMER_BENCHMARK_SPREAD (SEC2TICK(1) + 1)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wdog_s g_wdogs[CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS];
+static struct wdog_s g_probe_wdog;
+
+static struct work_s g_works[CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS];
+static struct work_s g_probe_work;
+
+static const int g_npending[] = { 0, 8, 64, CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void timer_benchmark_wdentry(int argc, uint32_t arg1)
+{
+}
+
+static void timer_benchmark_worker(FAR void *arg)
+{
+}
+
+static int timer_benchmark_delay(int i)
+{
+	return (i * 37) % TIMER_BENCHMARK_SPREAD + 1;
+}
+
+static unsigned long timer_benchmark_nsec(FAR const struct timespec *start, FAR const struct timespec *end)
+{
+	unsigned long long nsec;
+
+	nsec = (unsigned long long)(end->tv_sec - start->tv_sec) * 1000000000ULL + end->tv_nsec - start->tv_nsec;
+	return (unsigned long)(nsec / CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS);
+}
+
+static unsigned long timer_benchmark_wdog(int npending)
+{
+	struct timespec start;
+	struct timespec end;
+	int i;
+
+	for (i = 0; i < npending; i++) {
+		wd_start(&g_wdogs[i], TIMER_BENCHMARK_DELAY + timer_benchmark_delay(i), (wdentry_t)timer_benchmark_wdentry, 1, (uint32_t)i);
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS; i++) {
+		wd_start(&g_probe_wdog, timer_benchmark_delay(i), (wdentry_t)timer_benchmark_wdentry, 1, 0);
+		wd_cancel(&g_probe_wdog);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	for (i = 0; i < npending; i++) {
+		wd_cancel(&g_wdogs[i]);
+	}
+
+	return timer_benchmark_nsec(&start, &end);
+}
+
+static unsigned long timer_benchmark_work(int npending)
+{
+	struct timespec start;
+	struct timespec end;
+	int i;
+
+	for (i = 0; i < npending; i++) {
+		work_queue(HPWORK, &g_works[i], timer_benchmark_worker, NULL, TIMER_BENCHMARK_DELAY + timer_benchmark_delay(i));
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS; i++) {
+		work_queue(HPWORK, &g_probe_work, timer_benchmark_worker, NULL, timer_benchmark_delay(i));
+		work_cancel(HPWORK, &g_probe_work);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	for (i = 0; i < npending; i++) {
+		work_cancel(HPWORK, &g_works[i]);
+	}
+
+	return timer_benchmark_nsec(&start, &end);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * timer_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int timer_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int i;
+
+	for (i = 0; i < CONFIG_EXAMPLES_TIMER_BENCHMARK_NTIMERS; i++) {
+		wd_static(&g_wdogs[i]);
+	}
+
+	wd_static(&g_probe_wdog);
+
+	printf("Arm + cancel, average of %d operations\n", CONFIG_EXAMPLES_TIMER_BENCHMARK_ITERATIONS);
+	printf("pending   wd_start/wd_cancel   work_queue/work_cancel\n");
+
+	for (i = 0; i < sizeof(g_npending) / sizeof(g_npending[0]); i++) {
+		printf("%7d   %15lu ns   %19lu ns\n", g_npending[i], timer_benchmark_wdog(g_npending[i]), timer_benchmark_work(g_npending[i]));
+	}
+
+	return OK;
+}
@@ -138,7 +138,7 @@ void count_time(int seconds)
 	"arc4, des3, des, camellia, blowfish,\n"				\
 	"aes_cbc, aes_gcm, aes_ccm, aes_cmac, des3_cmac,\n"		\
 	"havege, ctr_drbg, hmac_drbg\n"							\
-	"rsa, dhm, ecdsa, ecdh.\n"
+	"rsa, dhm, ecdsa, ecdh, handshake.\n"
 
 #if defined(MBEDTLS_ERROR_C)
 #define PRINT_ERROR													\
@@ -272,7 +272,7 @@ typedef struct {
 		 aes_cbc, aes_gcm, aes_ccm, aes_cmac, des3_cmac,
 		 camellia, blowfish,
 		 havege, ctr_drbg, hmac_drbg,
-		 rsa, dhm, ecdsa, ecdh;
+		 rsa, dhm, ecdsa, ecdh, handshake;
 } todo_list;
 
 pthread_addr_t tls_benchmark_cb(void *args)
@@ -342,6 +342,8 @@ pthread_addr_t tls_benchmark_cb(void *args)
 				todo.ecdsa = 1;
 			} else if (strcmp(argv[i], "ecdh") == 0) {
 				todo.ecdh = 1;
+			} else if (strcmp(argv[i], "handshake") == 0) {
+				todo.handshake = 1;
 			} else {
 				mbedtls_printf("Unrecognized option: %s\n", argv[i]);
 				mbedtls_printf("Available options: " OPTIONS);
@@ -819,6 +821,50 @@ pthread_addr_t tls_benchmark_cb(void *args)
 	}
 #endif
 
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_SHA256_C) && \
+	defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+	/*
+	 * Public key operations of a full ECDHE-ECDSA handshake on secp256r1, as
+	 * seen by a client: verify the server certificate and ServerKeyExchange
+	 * signatures, generate the ECDHE key pair and compute the shared secret.
+	 * Fresh contexts are used on each round, as in a new connection.
+	 */
+	if (todo.handshake) {
+		mbedtls_ecdsa_context ecdsa;
+		mbedtls_ecdsa_context peer;
+		mbedtls_ecdh_context ecdh;
+		size_t sig_len;
+		size_t olen;
+
+		memset(buf, 0x2A, sizeof(buf));
+		mbedtls_ecdsa_init(&ecdsa);
+
+		if (mbedtls_ecdsa_genkey(&ecdsa, MBEDTLS_ECP_DP_SECP256R1, myrand, NULL) != 0 ||
+			mbedtls_ecdsa_write_signature(&ecdsa, MBEDTLS_MD_SHA256, buf, 32,
+										  tmp, &sig_len, myrand, NULL) != 0) {
+			mbedtls_exit(1);
+		}
+
+		TIME_PUBLIC("ECDHE-ECDSA-secp256r1", "handshake",
+					mbedtls_ecdsa_init(&peer);
+					ret |= mbedtls_ecp_group_load(&peer.grp, MBEDTLS_ECP_DP_SECP256R1);
+					ret |= mbedtls_ecp_copy(&peer.Q, &ecdsa.Q);
+					ret |= mbedtls_ecdsa_read_signature(&peer, buf, 32, tmp, sig_len);
+					ret |= mbedtls_ecdsa_read_signature(&peer, buf, 32, tmp, sig_len);
+					mbedtls_ecdsa_free(&peer);
+					mbedtls_ecdh_init(&ecdh);
+					ret |= mbedtls_ecp_group_load(&ecdh.grp, MBEDTLS_ECP_DP_SECP256R1);
+					ret |= mbedtls_ecdh_make_public(&ecdh, &olen, buf + 64, sizeof(buf) - 64,
+							myrand, NULL);
+					ret |= mbedtls_ecp_copy(&ecdh.Qp, &ecdsa.Q);
+					ret |= mbedtls_ecdh_calc_secret(&ecdh, &olen, buf + 64, sizeof(buf) - 64,
+							myrand, NULL);
+					mbedtls_ecdh_free(&ecdh));
+
+		mbedtls_ecdsa_free(&ecdsa);
+	}
+#endif
+
 	mbedtls_printf("Benchmark test finished \n");
 	mbedtls_printf("\n");
 
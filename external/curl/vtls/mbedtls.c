@@ -49,6 +49,7 @@
 #include <mbedtls/entropy.h>
 #include <mbedtls/ctr_drbg.h>
 #include <mbedtls/sha256.h>
+#include <mbedtls/ssl_session_store.h>
 
 #include "urldata.h"
 #include "sendf.h"
@@ -256,6 +257,7 @@ mbed_connect_step1(struct connectdata *conn,
     conn->host.name;
   const long int port = SSL_IS_PROXY() ? conn->port : conn->remote_port;
   int ret = -1;
+  bool session_reused = FALSE;
   char errorbuf[128];
   errorbuf[0] = 0;
 
@@ -466,6 +468,7 @@ mbed_connect_step1(struct connectdata *conn,
         return CURLE_SSL_CONNECT_ERROR;
       }
       infof(data, "mbedTLS re-using session\n");
+      session_reused = TRUE;
     }
     Curl_ssl_sessionid_unlock(conn);
   }
@@ -486,6 +489,17 @@ mbed_connect_step1(struct connectdata *conn,
     return CURLE_SSL_CONNECT_ERROR;
   }
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+  /* Not in this handle's cache: try the session another client of the
+     system negotiated with this server. Keyed by SNI, so after
+     mbedtls_ssl_set_hostname(). */
+  if(SSL_SET_OPTION(primary.sessionid) && !session_reused &&
+     mbedtls_ssl_session_store_load(&BACKEND->ssl, hostname, (int)port) == 0)
+    infof(data, "mbedTLS re-using stored session\n");
+#else
+  (void)session_reused;
+#endif
+
 #ifdef HAS_ALPN
   if(conn->bits.tls_enable_alpn) {
     const char **p = &BACKEND->protocols[0];
@@ -545,6 +559,11 @@ mbed_connect_step2(struct connectdata *conn,
   const char * const pinnedpubkey = SSL_IS_PROXY() ?
         data->set.str[STRING_SSL_PINNEDPUBLICKEY_PROXY] :
         data->set.str[STRING_SSL_PINNEDPUBLICKEY_ORIG];
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+  const char * const hostname = SSL_IS_PROXY() ? conn->http_proxy.host.name :
+    conn->host.name;
+  const long int port = SSL_IS_PROXY() ? conn->port : conn->remote_port;
+#endif
 
 #ifdef HAS_ALPN
   const char *next_protocol;
@@ -572,6 +591,9 @@ mbed_connect_step2(struct connectdata *conn,
 #endif /* MBEDTLS_ERROR_C */
     failf(data, "ssl_handshake returned - mbedTLS: (-0x%04X) %s",
           -ret, errorbuf);
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+    mbedtls_ssl_session_store_remove(&BACKEND->ssl, hostname, (int)port);
+#endif
     return CURLE_SSL_CONNECT_ERROR;
   }
 
@@ -738,6 +760,16 @@ mbed_connect_step3(struct connectdata *conn,
       failf(data, "failed to store ssl session");
       return retcode;
     }
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+    {
+      const char * const hostname = SSL_IS_PROXY() ?
+        conn->http_proxy.host.name : conn->host.name;
+      const long int port = SSL_IS_PROXY() ? conn->port : conn->remote_port;
+
+      mbedtls_ssl_session_store_save(&BACKEND->ssl, hostname, (int)port);
+    }
+#endif
   }
 
   connssl->connecting_state = ssl_connect_done;
@@ -61,6 +61,8 @@ extern "C"
  * Included Files
  ****************************************************************************/
 
+#include <tinyara/config.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -84,6 +86,15 @@ extern "C"
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_IsArena 1024 /* item and its valuestring live in a cJSON_Arena */
+
+/* Per-document allocation arena, see cJSON_CreateArena() */
+typedef struct cJSON_Arena cJSON_Arena;
+
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+/* Lazily built hash index over the children of a large object */
+struct cJSON_Index;
+#endif
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -106,6 +117,11 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    /* Private: hash index over child, managed by cJSON. Never touch it directly. */
+    struct cJSON_Index *index;
+#endif
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -178,6 +194,16 @@ CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error. If not, then cJSON_GetErrorPtr() does the job. */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Arena allocation: every item and string of a document parsed with cJSON_ParseInArena comes out of
+ * a few large blocks owned by the arena. cJSON_Delete on such items is a no-op for arena memory, and the
+ * whole tree is released at once by cJSON_ResetArena (keeps the largest block for reuse) or cJSON_DeleteArena.
+ * Items must not be used after their arena was reset or deleted. block_size = 0 selects the default. */
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size);
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(cJSON_Arena *arena, const char *value);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArenaWithOpts(cJSON_Arena *arena, const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -194,7 +220,10 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *c);
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
 /* Retrieve item number "item" from array "array". Returns NULL if unsuccessful. */
 CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
-/* Get item "string" from object. Case insensitive. */
+/* Get item "string" from object. Case insensitive.
+ * With CONFIG_NETUTILS_JSON_OBJECT_INDEX, objects with at least CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD
+ * children are looked up through a hash index built on first use and dropped when the object is modified
+ * through the cJSON API. Do not relink the children of an indexed object by hand. */
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
@@ -41,7 +41,18 @@
 extern "C" {
 #endif
 
-void uv__work_submit(uv_loop_t *loop, struct uv__work *w, void (*work)(struct uv__work *w), void (*done)(struct uv__work *w, int status));
+/*
+ * Lanes of the threadpool. Slow I/O requests may only occupy part of the
+ * workers, so CPU bound work and DNS lookups are not stuck behind file
+ * system requests on slow flash.
+ */
+enum uv__work_kind {
+	UV__WORK_CPU,				/* uv_queue_work(), uv_getaddrinfo() */
+	UV__WORK_SLOW_IO,			/* uv_fs_*() */
+	UV__WORK_KINDS
+};
+
+void uv__work_submit(uv_loop_t *loop, struct uv__work *w, enum uv__work_kind kind, void (*work)(struct uv__work *w), void (*done)(struct uv__work *w, int status));
 
 void uv__work_done(uv_async_t *handle);
 
@@ -59,6 +70,21 @@ int uv_queue_work(uv_loop_t *loop, uv_work_t *req, uv_work_cb work_cb, uv_after_
 
 int uv_cancel(uv_req_t *req);
 
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+/*
+ * Queue latency statistics of a threadpool lane.
+ */
+typedef struct {
+	uint64_t started;			/* requests picked up by a worker */
+	uint64_t stolen;			/* ... from the queue of another worker */
+	uint32_t pending;			/* requests waiting in the queues */
+	uint64_t wait_total;		/* sum of the queueing delays (ns) */
+	uint64_t wait_max;			/* longest queueing delay (ns) */
+} uv_threadpool_stats_t;
+
+int uv_threadpool_get_stats(enum uv__work_kind kind, uv_threadpool_stats_t *stats);
+#endif
+
 /*
  * for embed systems that need cleanup before exit
  */
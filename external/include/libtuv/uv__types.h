@@ -142,6 +142,11 @@ struct uv__work {
 	void (*done)(struct uv__work *w, int status);
 	struct uv_loop_s *loop;
 	void *wq[2];
+	unsigned char kind;			/* enum uv__work_kind */
+	unsigned char owner;		/* threadpool worker whose queue holds it */
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+	uint64_t queued_time;		/* when uv__work_submit() queued it */
+#endif
 };
 
 //-----------------------------------------------------------------------------
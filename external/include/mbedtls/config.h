@@ -629,6 +629,24 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_ECP_P256_OPTIM
+ *
+ * Use dedicated fixed-size field arithmetic for secp256r1, with a comb table
+ * for the generator in ROM and a cache of comb tables for the public keys
+ * seen in ECDSA verification (see MBEDTLS_ECP_P256_CACHE_SIZE).
+ * Speeds up ECDHE-ECDSA handshakes on P-256 by avoiding the generic bignum
+ * code and its heap allocations. Other curves are not affected.
+ *
+ * Requires: MBEDTLS_ECP_C, MBEDTLS_ECP_DP_SECP256R1_ENABLED
+ *
+ * Module:  library/ecp_p256.c
+ * Caller:  library/ecp.c
+ */
+#if defined(CONFIG_TLS_ECP_P256_OPTIM)
+#define MBEDTLS_ECP_P256_OPTIM
+#endif
+
 /**
  * \def MBEDTLS_ECDSA_DETERMINISTIC
  *
@@ -1293,6 +1311,41 @@
  */
 #define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 
+/**
+ * \def MBEDTLS_SSL_RECORD_SIZE_LIMIT
+ *
+ * Enable support for the RFC 8449 record_size_limit extension in SSL.
+ *
+ * Unlike max_fragment_length, each side announces the largest record it is
+ * willing to receive, so a small input limit does not cap the output.
+ *
+ * Requires: MBEDTLS_SSL_PROTO_TLS1 or MBEDTLS_SSL_PROTO_TLS1_1 or
+ *           MBEDTLS_SSL_PROTO_TLS1_2
+ *
+ * Enabled by CONFIG_TLS_RECORD_SIZE_LIMIT.
+ */
+#if defined(CONFIG_TLS_RECORD_SIZE_LIMIT)
+#define MBEDTLS_SSL_RECORD_SIZE_LIMIT
+#endif
+
+/**
+ * \def MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+ *
+ * Size the record buffers of each SSL context dynamically instead of
+ * allocating two buffers of MBEDTLS_SSL_BUFFER_LEN in mbedtls_ssl_setup().
+ *
+ * The input buffer starts at MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN and grows
+ * when a larger record arrives. Once the handshake is over both buffers are
+ * shrunk to the negotiated maximum fragment length / record size limit, and
+ * mbedtls_ssl_release_buffers() frees them while the connection is idle.
+ * Datagram transport keeps fixed size buffers.
+ *
+ * Enabled by CONFIG_TLS_VARIABLE_BUFFER_LENGTH.
+ */
+#if defined(CONFIG_TLS_VARIABLE_BUFFER_LENGTH)
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+#endif
+
 /**
  * \def MBEDTLS_SSL_PROTO_SSL3
  *
@@ -2545,6 +2598,21 @@
  */
 #define MBEDTLS_SSL_CACHE_C
 
+/**
+ * \def MBEDTLS_SSL_SESSION_STORE_C
+ *
+ * Enable the client-side session store, shared by all TLS clients to resume
+ * sessions with the servers they connect to.
+ *
+ * Module:  library/ssl_session_store.c
+ * Caller:
+ *
+ * Requires: MBEDTLS_SSL_CLI_C
+ */
+#if defined(CONFIG_TLS_SESSION_STORE)
+#define MBEDTLS_SSL_SESSION_STORE_C
+#endif
+
 /**
  * \def MBEDTLS_SSL_COOKIE_C
  *
@@ -2819,6 +2887,9 @@
 //#define MBEDTLS_ECP_MAX_BITS             521 /**< Maximum bit size of groups */
 #define MBEDTLS_ECP_WINDOW_SIZE            7 /**< Maximum window size used */
 #define MBEDTLS_ECP_FIXED_POINT_OPTIM      1 /**< Enable fixed-point speed-up */
+#if defined(CONFIG_TLS_ECP_P256_CACHE_SIZE)
+#define MBEDTLS_ECP_P256_CACHE_SIZE        CONFIG_TLS_ECP_P256_CACHE_SIZE /**< Cached P-256 comb tables */
+#endif
 
 /* Entropy options */
 //#define MBEDTLS_ENTROPY_MAX_SOURCES                20 /**< Maximum number of sources supported */
@@ -2862,8 +2933,27 @@
 //#define MBEDTLS_SSL_CACHE_DEFAULT_TIMEOUT       86400 /**< 1 day  */
 #define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES      2 /**< Maximum entries in cache */
 
+/* SSL session store options */
+#if defined(CONFIG_TLS_SESSION_STORE_ENTRIES)
+#define MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES     CONFIG_TLS_SESSION_STORE_ENTRIES /**< Maximum stored client sessions */
+#endif
+#if defined(CONFIG_TLS_SESSION_STORE_TIMEOUT)
+#define MBEDTLS_SSL_SESSION_STORE_TIMEOUT         CONFIG_TLS_SESSION_STORE_TIMEOUT /**< Lifetime of stored sessions */
+#endif
+#if defined(CONFIG_TLS_SESSION_STORE_PERSIST)
+#define MBEDTLS_SSL_SESSION_STORE_FILE            CONFIG_TLS_SESSION_STORE_PATH /**< File keeping stored sessions across reboots */
+#endif
+//#define MBEDTLS_SSL_SESSION_STORE_MAX_TICKET_LEN  512 /**< Longer tickets are not stored */
+
 /* SSL options */
 //#define MBEDTLS_SSL_MAX_CONTENT_LEN             16384 /**< Maxium fragment length in bytes, determines the size of each of the two internal I/O buffers */
+#if defined(CONFIG_TLS_IN_CONTENT_LEN)
+#define MBEDTLS_SSL_IN_CONTENT_LEN              CONFIG_TLS_IN_CONTENT_LEN /**< Largest record plaintext accepted from the peer */
+#endif
+#if defined(CONFIG_TLS_OUT_CONTENT_LEN)
+#define MBEDTLS_SSL_OUT_CONTENT_LEN             CONFIG_TLS_OUT_CONTENT_LEN /**< Largest record plaintext sent to the peer */
+#endif
+//#define MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN       1024 /**< Initial input buffer payload with MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
 //#define MBEDTLS_SSL_DEFAULT_TICKET_LIFETIME     86400 /**< Lifetime of session tickets (if enabled) */
 //#define MBEDTLS_PSK_MAX_LEN               32 /**< Max size of TLS pre-shared keys, in bytes (default 256 bits) */
 //#define MBEDTLS_SSL_COOKIE_TIMEOUT        60 /**< Default expiration delay of DTLS cookies, in seconds if HAVE_TIME, or in number of cookies issued */
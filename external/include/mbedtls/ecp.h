@@ -255,6 +255,15 @@ mbedtls_ecp_keypair;
 #define MBEDTLS_ECP_FIXED_POINT_OPTIM  1   /**< Enable fixed-point speed-up */
 #endif /* MBEDTLS_ECP_FIXED_POINT_OPTIM */
 
+#if !defined(MBEDTLS_ECP_P256_CACHE_SIZE)
+/*
+ * Number of secp256r1 public keys whose comb tables are kept by
+ * MBEDTLS_ECP_P256_OPTIM for mbedtls_ecp_muladd() (ECDSA verification).
+ * Each entry takes 576 bytes of static memory. 0 disables the cache.
+ */
+#define MBEDTLS_ECP_P256_CACHE_SIZE    2   /**< Cached P-256 comb tables */
+#endif /* MBEDTLS_ECP_P256_CACHE_SIZE */
+
 /* \} name SECTION: Module settings */
 
 /*
@@ -690,6 +699,15 @@ int mbedtls_ecp_gen_key( mbedtls_ecp_group_id grp_id, mbedtls_ecp_keypair *key,
  */
 int mbedtls_ecp_check_pub_priv( const mbedtls_ecp_keypair *pub, const mbedtls_ecp_keypair *prv );
 
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+/**
+ * \brief           Drop the secp256r1 comb tables cached for public keys
+ *                  used with mbedtls_ecp_muladd(), e.g. after the trusted
+ *                  certificates have changed.
+ */
+void mbedtls_ecp_p256_cache_flush( void );
+#endif
+
 #if defined(MBEDTLS_SELF_TEST)
 
 /**
@@ -306,5 +306,46 @@ int mbedtls_internal_ecp_normalize_mxz( const mbedtls_ecp_group *grp,
 
 #endif /* MBEDTLS_ECP_INTERNAL_ALT */
 
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+
+/**
+ * \brief           Multiplication R = m * P on secp256r1, using the
+ *                  dedicated fixed-size field arithmetic of ecp_p256.c.
+ *
+ * \note            Same contract as the comb method of mbedtls_ecp_mul():
+ *                  the caller has checked m and P, and grp is secp256r1.
+ *
+ * \param grp       secp256r1 group
+ * \param R         Destination point
+ * \param m         Integer by which to multiply
+ * \param P         Point to multiply
+ * \param f_rng     RNG function (see notes of mbedtls_ecp_mul())
+ * \param p_rng     RNG parameter
+ * \param cache     Non-zero to keep the comb table of P (unless P is the
+ *                  generator) in the cache for later multiplications.
+ *                  Only useful for long-lived public keys.
+ *
+ * \return          0 if successful,
+ *                  or a MBEDTLS_ERR_ECP_XXX or MBEDTLS_MPI_XXX error code
+ */
+int mbedtls_ecp_p256_mul( const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                          int (*f_rng)(void *, unsigned char *, size_t),
+                          void *p_rng, int cache );
+
+#if defined(MBEDTLS_SELF_TEST)
+/**
+ * \brief           Check the precomputed generator table of ecp_p256.c
+ *
+ * \param grp       secp256r1 group
+ *
+ * \return          0 if successful, 1 if the table is wrong,
+ *                  or a MBEDTLS_ERR_ECP_XXX or MBEDTLS_MPI_XXX error code
+ */
+int mbedtls_ecp_p256_self_test( const mbedtls_ecp_group *grp );
+#endif
+
+#endif /* MBEDTLS_ECP_P256_OPTIM */
+
 #endif /* ecp_internal.h */
 
@@ -240,6 +240,32 @@
 #define MBEDTLS_SSL_MAX_CONTENT_LEN         16384   /**< Size of the input / output buffer */
 #endif
 
+/*
+ * Maximum record plaintext accepted from the peer and sent to the peer.
+ * Both default to MBEDTLS_SSL_MAX_CONTENT_LEN and may only be lowered.
+ *
+ * Lowering MBEDTLS_SSL_OUT_CONTENT_LEN is always safe as long as our own
+ * handshake messages (mostly the Certificate message) fit. Lowering
+ * MBEDTLS_SSL_IN_CONTENT_LEN below 16384 requires the peer to honour the
+ * max_fragment_length or record_size_limit extension.
+ */
+#if !defined(MBEDTLS_SSL_IN_CONTENT_LEN)
+#define MBEDTLS_SSL_IN_CONTENT_LEN          MBEDTLS_SSL_MAX_CONTENT_LEN
+#endif
+
+#if !defined(MBEDTLS_SSL_OUT_CONTENT_LEN)
+#define MBEDTLS_SSL_OUT_CONTENT_LEN         MBEDTLS_SSL_MAX_CONTENT_LEN
+#endif
+
+/*
+ * Record plaintext the input buffer is sized for when it is (re)allocated
+ * with MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH. The buffer grows on demand up to
+ * the negotiated input limit when a larger record arrives.
+ */
+#if !defined(MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN)
+#define MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN  1024
+#endif
+
 /* \} name SECTION: Module settings */
 
 /*
@@ -359,6 +385,8 @@
 #define MBEDTLS_TLS_EXT_ENCRYPT_THEN_MAC            22 /* 0x16 */
 #define MBEDTLS_TLS_EXT_EXTENDED_MASTER_SECRET  0x0017 /* 23 */
 
+#define MBEDTLS_TLS_EXT_RECORD_SIZE_LIMIT           28 /* RFC 8449 */
+
 #define MBEDTLS_TLS_EXT_SESSION_TICKET              35
 
 #define MBEDTLS_TLS_EXT_ECJPAKE_KKPP               256 /* experimental */
@@ -595,6 +623,13 @@ struct mbedtls_ssl_session
     unsigned char mfl_code;     /*!< MaxFragmentLength negotiated by peer */
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    uint16_t peer_record_size_limit;    /*!< limit announced by the peer,
+                                             0 if none                    */
+    uint16_t own_record_size_limit;     /*!< our limit, 0 unless the peer
+                                             agreed to the extension      */
+#endif /* MBEDTLS_SSL_RECORD_SIZE_LIMIT */
+
 #if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
     int trunc_hmac;             /*!< flag for truncated hmac activation   */
 #endif /* MBEDTLS_SSL_TRUNCATED_HMAC */
@@ -752,6 +787,11 @@ struct mbedtls_ssl_config
     unsigned char min_major_ver;    /*!< min. major version used            */
     unsigned char min_minor_ver;    /*!< min. minor version used            */
 
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    uint16_t record_size_limit;     /*!< record size limit to announce,
+                                         0 for MBEDTLS_SSL_IN_CONTENT_LEN   */
+#endif
+
     /*
      * Flags (bitfields)
      */
@@ -858,6 +898,12 @@ struct mbedtls_ssl_context
      * Record layer (incoming data)
      */
     unsigned char *in_buf;      /*!< input buffer                     */
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    size_t in_buf_len;          /*!< current size of in_buf, 0 while
+                                     the buffer is released           */
+    size_t in_msg_offset;       /*!< in_msg - in_buf while released   */
+    unsigned char in_ctr_saved[8];  /*!< in_ctr while released        */
+#endif
     unsigned char *in_ctr;      /*!< 64-bit incoming message counter
                                      TLS: maintained by us
                                      DTLS: read from peer             */
@@ -891,6 +937,12 @@ struct mbedtls_ssl_context
      * Record layer (outgoing data)
      */
     unsigned char *out_buf;     /*!< output buffer                    */
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    size_t out_buf_len;         /*!< current size of out_buf, 0 while
+                                     the buffer is released           */
+    size_t out_msg_offset;      /*!< out_msg - out_buf while released */
+    unsigned char out_ctr_saved[8]; /*!< out_ctr while released       */
+#endif
     unsigned char *out_ctr;     /*!< 64-bit outgoing message counter  */
     unsigned char *out_hdr;     /*!< start of record header           */
     unsigned char *out_len;     /*!< two-bytes message length field   */
@@ -2193,6 +2245,26 @@ void mbedtls_ssl_conf_cert_req_ca_list( mbedtls_ssl_config *conf,
 int mbedtls_ssl_conf_max_frag_len( mbedtls_ssl_config *conf, unsigned char mfl_code );
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+/**
+ * \brief          Set the record size limit announced to the peer with the
+ *                 RFC 8449 record_size_limit extension
+ *                 (Default: MBEDTLS_SSL_IN_CONTENT_LEN)
+ *
+ * \note           Unlike max_fragment_length, the limit only restricts what
+ *                 the peer sends to us. What we send is restricted by the
+ *                 limit the peer announces. If the peer offers both
+ *                 extensions, record_size_limit takes precedence.
+ *
+ * \param conf     SSL configuration
+ * \param limit    Largest record plaintext we accept, between 64 and
+ *                 MBEDTLS_SSL_IN_CONTENT_LEN
+ *
+ * \return         0 if successful or MBEDTLS_ERR_SSL_BAD_INPUT_DATA
+ */
+int mbedtls_ssl_conf_record_size_limit( mbedtls_ssl_config *conf, uint16_t limit );
+#endif /* MBEDTLS_SSL_RECORD_SIZE_LIMIT */
+
 #if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
 /**
  * \brief          Activate negotiation of truncated HMAC
@@ -2426,6 +2498,28 @@ int mbedtls_ssl_get_record_expansion( const mbedtls_ssl_context *ssl );
 size_t mbedtls_ssl_get_max_frag_len( const mbedtls_ssl_context *ssl );
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+/**
+ * \brief          Return the largest record plaintext we may send, taking
+ *                 MBEDTLS_SSL_OUT_CONTENT_LEN, max_fragment_length and the
+ *                 peer's record_size_limit into account.
+ *
+ * \param ssl      SSL context
+ *
+ * \return         Current maximum outgoing record payload, in bytes.
+ */
+size_t mbedtls_ssl_get_output_max_frag_len( const mbedtls_ssl_context *ssl );
+
+/**
+ * \brief          Return the largest record plaintext the peer may send us,
+ *                 taking MBEDTLS_SSL_IN_CONTENT_LEN, max_fragment_length and
+ *                 our own record_size_limit into account.
+ *
+ * \param ssl      SSL context
+ *
+ * \return         Current maximum incoming record payload, in bytes.
+ */
+size_t mbedtls_ssl_get_input_max_frag_len( const mbedtls_ssl_context *ssl );
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 /**
  * \brief          Return the peer certificate from the current connection
@@ -2654,6 +2748,26 @@ int mbedtls_ssl_send_alert_message( mbedtls_ssl_context *ssl,
  */
 int mbedtls_ssl_close_notify( mbedtls_ssl_context *ssl );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/**
+ * \brief          Release the record buffers of an idle connection
+ *
+ *                 The buffers are allocated again, at their initial size,
+ *                 by the next call that needs them (read, write, handshake,
+ *                 renegotiation or close notification).
+ *
+ * \param ssl      SSL context
+ *
+ * \return         0 if successful or if the buffers were already released,
+ *                 MBEDTLS_ERR_SSL_BAD_INPUT_DATA if the handshake is not
+ *                 over or unread / unsent data is still buffered.
+ *
+ * \note           Only stream transport releases its buffers; for DTLS
+ *                 this function does nothing and returns 0.
+ */
+int mbedtls_ssl_release_buffers( mbedtls_ssl_context *ssl );
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
 /**
  * \brief          Free referenced items in an SSL context and clear memory
  *
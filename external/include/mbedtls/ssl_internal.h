@@ -160,13 +160,24 @@
 #define MBEDTLS_SSL_PADDING_ADD              0
 #endif
 
-#define MBEDTLS_SSL_PAYLOAD_LEN ( MBEDTLS_SSL_MAX_CONTENT_LEN    \
-                        + MBEDTLS_SSL_COMPRESSION_ADD            \
+#define MBEDTLS_SSL_PAYLOAD_OVERHEAD ( MBEDTLS_SSL_COMPRESSION_ADD    \
                         + MBEDTLS_MAX_IV_LENGTH                  \
                         + MBEDTLS_SSL_MAC_ADD                    \
                         + MBEDTLS_SSL_PADDING_ADD                \
                         )
 
+#define MBEDTLS_SSL_PAYLOAD_LEN ( MBEDTLS_SSL_MAX_CONTENT_LEN    \
+                        + MBEDTLS_SSL_PAYLOAD_OVERHEAD           \
+                        )
+
+#define MBEDTLS_SSL_IN_PAYLOAD_LEN ( MBEDTLS_SSL_IN_CONTENT_LEN  \
+                        + MBEDTLS_SSL_PAYLOAD_OVERHEAD           \
+                        )
+
+#define MBEDTLS_SSL_OUT_PAYLOAD_LEN ( MBEDTLS_SSL_OUT_CONTENT_LEN \
+                        + MBEDTLS_SSL_PAYLOAD_OVERHEAD           \
+                        )
+
 /*
  * Check that we obey the standard's message size bounds
  */
@@ -175,6 +186,14 @@
 #error Bad configuration - record content too large.
 #endif
 
+#if MBEDTLS_SSL_IN_CONTENT_LEN > MBEDTLS_SSL_MAX_CONTENT_LEN
+#error Bad configuration - incoming record content too large.
+#endif
+
+#if MBEDTLS_SSL_OUT_CONTENT_LEN > MBEDTLS_SSL_MAX_CONTENT_LEN
+#error Bad configuration - outgoing record content too large.
+#endif
+
 #if MBEDTLS_SSL_PAYLOAD_LEN > 16384 + 2048
 #error Bad configuration - protected record payload too large.
 #endif
@@ -187,6 +206,12 @@
 #define MBEDTLS_SSL_BUFFER_LEN  \
     ( ( MBEDTLS_SSL_HEADER_LEN ) + ( MBEDTLS_SSL_PAYLOAD_LEN ) )
 
+#define MBEDTLS_SSL_IN_BUFFER_LEN  \
+    ( ( MBEDTLS_SSL_HEADER_LEN ) + ( MBEDTLS_SSL_IN_PAYLOAD_LEN ) )
+
+#define MBEDTLS_SSL_OUT_BUFFER_LEN  \
+    ( ( MBEDTLS_SSL_HEADER_LEN ) + ( MBEDTLS_SSL_OUT_PAYLOAD_LEN ) )
+
 /*
  * TLS extension flags (for extensions with outgoing ServerHello content
  * that need it (e.g. for RENEGOTIATION_INFO the server already knows because
@@ -321,6 +346,9 @@ struct mbedtls_ssl_handshake_params
 #if defined(MBEDTLS_SSL_SESSION_TICKETS)
     int new_session_ticket;             /*!< use NewSessionTicket?    */
 #endif /* MBEDTLS_SSL_SESSION_TICKETS */
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    uint16_t peer_record_size_limit;    /*!< Srv: limit from ClientHello */
+#endif
 #if defined(MBEDTLS_SSL_EXTENDED_MASTER_SECRET)
     int extended_ms;                    /*!< use Extended Master Secret? */
 #endif
@@ -613,6 +641,30 @@ void mbedtls_ssl_write_version( int major, int minor, int transport,
 void mbedtls_ssl_read_version( int *major, int *minor, int transport,
                        const unsigned char ver[2] );
 
+/*
+ * Current size of the record buffers. With MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+ * they change over the lifetime of the connection, see ssl_tls.c.
+ */
+static inline size_t mbedtls_ssl_in_buf_len( const mbedtls_ssl_context *ssl )
+{
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    return( ssl->in_buf_len );
+#else
+    ((void) ssl);
+    return( MBEDTLS_SSL_IN_BUFFER_LEN );
+#endif
+}
+
+static inline size_t mbedtls_ssl_out_buf_len( const mbedtls_ssl_context *ssl )
+{
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    return( ssl->out_buf_len );
+#else
+    ((void) ssl);
+    return( MBEDTLS_SSL_OUT_BUFFER_LEN );
+#endif
+}
+
 static inline size_t mbedtls_ssl_hdr_len( const mbedtls_ssl_context *ssl )
 {
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ * Copyright 2019 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/**
+ * \file ssl_session_store.h
+ *
+ * \brief Client-side TLS session store shared by all TLS clients
+ *
+ * The server side of session resumption is handled by ssl_cache.h and
+ * ssl_ticket.h. This module is the client side: it remembers the session
+ * (session ID and/or RFC 5077 ticket) negotiated with each server, keyed by
+ * host, port and SNI, so that the next connection to the same server, from
+ * any client in the system, can use an abbreviated handshake.
+ *
+ * Typical use around mbedtls_ssl_handshake():
+ *
+ *     mbedtls_ssl_setup( &ssl, &conf );
+ *     mbedtls_ssl_set_hostname( &ssl, host );
+ *     mbedtls_ssl_session_store_load( &ssl, host, port );
+ *     ret = mbedtls_ssl_handshake( &ssl );
+ *     if( ret == 0 )
+ *         mbedtls_ssl_session_store_save( &ssl, host, port );
+ *     else
+ *         mbedtls_ssl_session_store_remove( &ssl, host, port );
+ */
+#ifndef MBEDTLS_SSL_SESSION_STORE_H
+#define MBEDTLS_SSL_SESSION_STORE_H
+
+#include "ssl.h"
+
+/**
+ * \name SECTION: Module settings
+ *
+ * The configuration options you can set for this module are in this section.
+ * Either change them in config.h or define them on the compiler command line.
+ * \{
+ */
+
+#if !defined(MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES)
+#define MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES       4   /*!< Maximum number of stored sessions */
+#endif
+
+#if !defined(MBEDTLS_SSL_SESSION_STORE_TIMEOUT)
+#define MBEDTLS_SSL_SESSION_STORE_TIMEOUT       86400   /*!< Lifetime of a session (seconds) */
+#endif
+
+#if !defined(MBEDTLS_SSL_SESSION_STORE_MAX_TICKET_LEN)
+#define MBEDTLS_SSL_SESSION_STORE_MAX_TICKET_LEN  512   /*!< Longer tickets are not stored */
+#endif
+
+/*
+ * MBEDTLS_SSL_SESSION_STORE_FILE: if defined, the store is written to this
+ * file whenever it changes and read back on first use, so that sessions
+ * survive a reboot. The file holds master secrets: it must live on storage
+ * that is not readable from outside the device.
+ */
+
+/* \} name SECTION: Module settings */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief          Resume the session stored for a server, if any
+ *
+ *                 Call it after mbedtls_ssl_setup() and
+ *                 mbedtls_ssl_set_hostname(), before the handshake.
+ *                 With MBEDTLS_SSL_VERIFY_REQUIRED, only sessions whose
+ *                 server certificate was successfully verified are used.
+ *
+ * \param ssl      SSL context (client)
+ * \param host     host name or address used to connect
+ * \param port     server port
+ *
+ * \return         0 if a session was loaded, 1 if none was found,
+ *                 or a negative error code.
+ */
+int mbedtls_ssl_session_store_load( mbedtls_ssl_context *ssl,
+                                    const char *host, int port );
+
+/**
+ * \brief          Remember the session of a completed handshake
+ *
+ *                 Sessions the server cannot resume (no session ID and no
+ *                 ticket) are not stored. When the store is full, the least
+ *                 recently used entry is replaced.
+ *
+ * \param ssl      SSL context (client), after a successful handshake
+ * \param host     host name or address used to connect
+ * \param port     server port
+ *
+ * \return         0 if successful, or a negative error code.
+ */
+int mbedtls_ssl_session_store_save( const mbedtls_ssl_context *ssl,
+                                    const char *host, int port );
+
+/**
+ * \brief          Forget the session stored for a server, e.g. after a
+ *                 handshake failure
+ *
+ * \param ssl      SSL context (client)
+ * \param host     host name or address used to connect
+ * \param port     server port
+ */
+void mbedtls_ssl_session_store_remove( const mbedtls_ssl_context *ssl,
+                                       const char *host, int port );
+
+/**
+ * \brief          Forget all stored sessions, including the persistent copy
+ */
+void mbedtls_ssl_session_store_flush( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ssl_session_store.h */
@@ -120,6 +120,12 @@ extern mbedtls_threading_mutex_t mbedtls_threading_readdir_mutex;
 #if defined(MBEDTLS_HAVE_TIME_DATE)
 extern mbedtls_threading_mutex_t mbedtls_threading_gmtime_mutex;
 #endif
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+extern mbedtls_threading_mutex_t mbedtls_threading_ecp_p256_mutex;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+extern mbedtls_threading_mutex_t mbedtls_threading_ssl_session_store_mutex;
+#endif
 #endif /* MBEDTLS_THREADING_C */
 
 #ifdef __cplusplus
@@ -29,6 +29,9 @@
 #include <protocols/libcoap/option.h>
 #include <protocols/libcoap/encode.h>
 #include <protocols/libcoap/pdu.h>
+#include <protocols/libcoap/hashkey.h>
+#include <protocols/libcoap/coap_time.h>
+#include <sys/types.h>
 
 /**
  * @defgroup block Block Transfer
@@ -163,6 +166,106 @@ int coap_write_block_opt(coap_block_t *block, unsigned short type, coap_pdu_t *p
  * @return @c 1 on success, @c 0 otherwise.
  */
 int coap_add_block(coap_pdu_t *pdu, unsigned int len, const unsigned char *data, unsigned int block_num, unsigned char block_szx);
+
+/**
+ * Reads part of a resource representation for coap_add_block_stream().
+ * Copies up to @p len bytes starting at @p offset into @p buf.
+ *
+ * @param arg    The argument given to coap_add_block_stream().
+ * @param offset The offset in the representation of the first byte to copy.
+ * @param buf    The destination, inside the payload of the response.
+ * @param len    The number of bytes wanted.
+ * @return The number of bytes copied, less than @p len only at the end of
+ *         the representation, or a negative value on error.
+ */
+typedef ssize_t (*coap_block_read_t)(void *arg, size_t offset, unsigned char *buf, size_t len);
+
+/**
+ * Adds the @p block_num block of size 1 << (@p block_szx + 4) of a
+ * representation of @p len bytes to @p pdu, like coap_add_block(), but
+ * reads only that block from @p read directly into the payload of @p pdu.
+ * The representation never has to be available as a whole. If @p read
+ * returns no data, no payload (and no payload marker) is added.
+ *
+ * @param pdu    The message to add the block
+ * @param len    The total length of the representation.
+ * @param read   The function reading the representation
+ * @param arg    The argument passed to @p read
+ * @param block_num The actual block number
+ * @param block_szx Encoded size of block @p block_number
+ * @return @c 1 on success, @c 0 otherwise.
+ */
+int coap_add_block_stream(coap_pdu_t *pdu, size_t len, coap_block_read_t read, void *arg, unsigned int block_num, unsigned char block_szx);
+
+#ifndef COAP_BLOCK_CACHE_LIFETIME
+#define COAP_BLOCK_CACHE_LIFETIME 5	/**< seconds a cached representation is reused, 0 until invalidated */
+#endif
+
+/**
+ * Renders the complete representation of a resource for a
+ * coap_block_cache_t. The buffer must be allocated with coap_malloc(), the
+ * cache releases it.
+ *
+ * @param arg    The argument given to coap_block_cache_init().
+ * @param data   Set to the rendered representation.
+ * @param len    Set to the length of @p data.
+ * @return @c 1 on success, @c 0 on error.
+ */
+typedef int (*coap_block_render_t)(void *arg, unsigned char **data, size_t *len);
+
+/**
+ * Rendered representation of a resource served block-wise. A handler that
+ * can only produce its representation as a whole renders it once with
+ * coap_block_cache_update(), and the following Block2 requests are served
+ * from the cache with coap_block_cache_read() until it expires (see
+ * COAP_BLOCK_CACHE_LIFETIME) or is invalidated. The ETag is derived from
+ * the content, so clients can tell when the representation changed
+ * between two blocks.
+ */
+typedef struct coap_block_cache_t {
+	coap_block_render_t render;	/**< renders the representation */
+	void *arg;					/**< argument of @c render */
+	unsigned char *data;		/**< the representation, NULL if not rendered */
+	size_t length;				/**< length of @c data */
+	coap_key_t etag;			/**< hash of @c data, to be sent as ETag option */
+	coap_tick_t rendered;		/**< time @c data was rendered */
+} coap_block_cache_t;
+
+/**
+ * Initializes @p cache for a resource whose representation is produced by
+ * @p render.
+ */
+void coap_block_cache_init(coap_block_cache_t *cache, coap_block_render_t render, void *arg);
+
+/**
+ * Renders the representation if the cache is empty, expired or has been
+ * invalidated. After a successful call, @c data, @c length and @c etag of
+ * @p cache describe the current representation.
+ *
+ * @return @c 1 on success, @c 0 if the representation could not be rendered.
+ */
+int coap_block_cache_update(coap_block_cache_t *cache);
+
+/**
+ * Drops the cached representation, e.g. when the resource changed. The
+ * next coap_block_cache_update() renders it again.
+ */
+void coap_block_cache_invalidate(coap_block_cache_t *cache);
+
+/**
+ * Checks whether @p request carries an ETag option matching the cached
+ * representation, in which case a 2.03 Valid response without payload can
+ * be sent.
+ *
+ * @return @c 1 if an ETag option of @p request matches, @c 0 otherwise.
+ */
+int coap_block_cache_etag_match(coap_block_cache_t *cache, coap_pdu_t *request, coap_transport_t transport);
+
+/**
+ * coap_block_read_t for a coap_block_cache_t passed as @p arg, to be used
+ * with coap_add_block_stream().
+ */
+ssize_t coap_block_cache_read(void *arg, size_t offset, unsigned char *buf, size_t len);
 /**@}*/
 
 #endif							/* _COAP_BLOCK_H_ */
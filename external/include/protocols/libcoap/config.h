@@ -37,6 +37,16 @@
 #undef NDEBUG
 #endif
 
+/* Number of PDUs of COAP_MAX_PDU_SIZE kept in a static pool, 0 to always use the heap */
+#ifdef CONFIG_NETUTILS_LIBCOAP_PDU_POOL_SIZE
+#define COAP_PDU_POOL_SIZE CONFIG_NETUTILS_LIBCOAP_PDU_POOL_SIZE
+#endif
+
+/* Lifetime in seconds of a cached block-wise representation, 0 until invalidated */
+#ifdef CONFIG_NETUTILS_LIBCOAP_BLOCK_CACHE_LIFETIME
+#define COAP_BLOCK_CACHE_LIFETIME CONFIG_NETUTILS_LIBCOAP_BLOCK_CACHE_LIFETIME
+#endif
+
 #ifdef CONFIG_NET_SECURITY_TLS
 #define WITH_MBEDTLS
 #else
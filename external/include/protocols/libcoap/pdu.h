@@ -49,6 +49,10 @@
 #endif
 #endif							/* COAP_MAX_PDU_SIZE */
 
+#ifndef COAP_PDU_POOL_SIZE
+#define COAP_PDU_POOL_SIZE             4	/* number of statically allocated PDUs of COAP_MAX_PDU_SIZE */
+#endif							/* COAP_PDU_POOL_SIZE */
+
 #define COAP_DEFAULT_VERSION           1	/* version of CoAP supported */
 #define COAP_DEFAULT_SCHEME        "coap"	/* the default scheme for CoAP URIs */
 
@@ -610,6 +610,9 @@ typedef struct _lwm2m_watcher_
         int64_t asInteger;
         double  asFloat;
     } lastValue;
+    struct _lwm2m_observed_ * observed; // observed URI this watcher belongs to
+    time_t nextTime;                    // next pmin/pmax deadline, valid when heapIndex != 0
+    size_t heapIndex;                   // 1-based position in the context deadline heap, 0 if not scheduled
 } lwm2m_watcher_t;
 
 typedef struct _lwm2m_observed_
@@ -618,6 +621,8 @@ typedef struct _lwm2m_observed_
 
     lwm2m_uri_t uri;
     lwm2m_watcher_t * watcherList;
+    bool dirty;                         // linked in the context dirty list
+    struct _lwm2m_observed_ * nextDirty;
 } lwm2m_observed_t;
 
 #ifdef LWM2M_CLIENT_MODE
@@ -659,6 +664,10 @@ typedef struct
     lwm2m_server_t *     serverList;
     lwm2m_object_t *     objectList;
     lwm2m_observed_t *   observedList;
+    lwm2m_observed_t *   observedDirtyList;  // observed URIs to evaluate on next step
+    lwm2m_watcher_t **   watcherHeap;        // active watchers ordered by nextTime
+    size_t               watcherHeapCount;
+    size_t               watcherHeapSize;
 #endif
 #ifdef LWM2M_SERVER_MODE
     lwm2m_client_t *        clientList;
@@ -91,7 +91,18 @@
 
 #define HTTP_CONF_MAX_CLIENT                    16
 #define HTTP_CONF_CLIENT_STACKSIZE              8192
+#if defined(CONFIG_NET_SECURITY_TLS) && defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/* Free heap needed for a TLS client: the handshake and the two record
+ * buffers at their configured sizes (80000 with the default of 16 KB each)
+ */
+#define HTTP_CONF_TLS_HANDSHAKE_MEMORY          46208
+#define HTTP_CONF_TLS_RECORD_OVERHEAD           512
+#define HTTP_CONF_MIN_TLS_MEMORY                (HTTP_CONF_TLS_HANDSHAKE_MEMORY + \
+						 MBEDTLS_SSL_IN_CONTENT_LEN + MBEDTLS_SSL_OUT_CONTENT_LEN + \
+						 2 * HTTP_CONF_TLS_RECORD_OVERHEAD)
+#else
 #define HTTP_CONF_MIN_TLS_MEMORY                80000
+#endif
 #define HTTP_CONF_SOCKET_TIMEOUT_MSEC           50000
 #define HTTP_CONF_SERVER_MQ_MAX_MSG             10
 #define HTTP_CONF_SERVER_MQ_PRIO                50
@@ -226,6 +226,16 @@ void wslay_frame_context_free(wslay_frame_context_ptr ctx);
  */
 ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb);
 
+/*
+ * Same as wslay_frame_send(), but a masked payload is masked in place
+ * instead of being copied through a bounce buffer, so iocb->data must
+ * point to writable memory whose content is lost once it is sent. Large
+ * payloads are then handed to send_callback in a single call. As with
+ * wslay_frame_send(), keep passing the same buffer, advanced by the
+ * number of bytes sent, until the frame is complete.
+ */
+ssize_t wslay_frame_send_inplace(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb);
+
 /*
  * Receives WebSocket frame and stores it in iocb.  This function
  * returns the number of payload bytes received.  This does not
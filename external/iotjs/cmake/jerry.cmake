@@ -92,6 +92,7 @@ endif()
 
 add_cmake_arg(DEPS_LIB_JERRY_ARGS ENABLE_LTO)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_MEM_STATS)
+add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_GC_INCREMENTAL)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_ERROR_MESSAGES)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_DEBUGGER)
 add_cmake_arg(DEPS_LIB_JERRY_ARGS FEATURE_DEBUGGER_PORT)
@@ -26,6 +26,7 @@
 #include "ecma-gc.h"
 #include "ecma-helpers.h"
 #include "ecma-init-finalize.h"
+#include "ecma-inline-cache.h"
 #include "ecma-lex-env.h"
 #include "ecma-literal-storage.h"
 #include "ecma-objects.h"
@@ -2049,10 +2050,16 @@ jerry_set_prototype (const jerry_value_t obj_val, /**< object value */
   }
   else
   {
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+    ecma_gc_write_barrier (ecma_get_object_from_value (proto_obj_val));
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
     ECMA_SET_POINTER (ecma_get_object_from_value (obj_val)->prototype_or_outer_reference_cp,
                       ecma_get_object_from_value (proto_obj_val));
   }
 
+  ecma_inline_cache_invalidate ();
+
   return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
 } /* jerry_set_prototype */
 
@@ -73,6 +73,20 @@
  */
 // #define CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
 
+/**
+ * Disable inline caches of property accesses with a literal property name
+ */
+// #define CONFIG_ECMA_INLINE_CACHE_DISABLE
+
+/**
+ * Number of property access sites remembered by the inline caches (must be a power of 2).
+ *
+ * Each entry uses 44 bytes with 16 bit compressed pointers.
+ */
+#ifndef CONFIG_ECMA_INLINE_CACHE_SIZE
+# define CONFIG_ECMA_INLINE_CACHE_SIZE (32)
+#endif /* !CONFIG_ECMA_INLINE_CACHE_SIZE */
+
 /**
  * Share of newly allocated since last GC objects among all currently allocated objects,
  * after achieving which, GC is started upon low severity try-give-memory-back requests.
@@ -82,6 +96,33 @@
  */
 #define CONFIG_ECMA_GC_NEW_OBJECTS_SHARE_TO_START_GC (16)
 
+/**
+ * Number of entries of the GC mark stack.
+ *
+ * Objects that do not fit on the stack are found later by rescanning the object list,
+ * so a small stack only makes marking of deep object graphs slower.
+ */
+#ifndef CONFIG_ECMA_GC_MARK_STACK_SIZE
+# define CONFIG_ECMA_GC_MARK_STACK_SIZE (64)
+#endif /* !CONFIG_ECMA_GC_MARK_STACK_SIZE */
+
+/**
+ * Enable incremental garbage collection
+ *
+ * Instead of stopping the world until the whole heap is marked and swept, a
+ * collection started upon a low severity try-give-memory-back request is
+ * performed in bounded slices interleaved with object allocations. High severity
+ * requests still complete the collection at once.
+ */
+// #define CONFIG_ECMA_GC_INCREMENTAL
+
+/**
+ * Number of objects marked or swept by a slice of an incremental garbage collection.
+ */
+#ifndef CONFIG_ECMA_GC_INCREMENTAL_BUDGET
+# define CONFIG_ECMA_GC_INCREMENTAL_BUDGET (64)
+#endif /* !CONFIG_ECMA_GC_INCREMENTAL_BUDGET */
+
 /**
  * Link Global Environment to an empty declarative lexical environment
  * instead of lexical environment bound to Global Object.
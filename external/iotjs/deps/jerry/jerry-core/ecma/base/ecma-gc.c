@@ -60,6 +60,12 @@
 
 static void ecma_gc_mark (ecma_object_t *object_p);
 static void ecma_gc_sweep (ecma_object_t *object_p);
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+static void ecma_gc_run_slice (void);
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
+JERRY_STATIC_ASSERT (CONFIG_ECMA_GC_MARK_STACK_SIZE > 0 && CONFIG_ECMA_GC_MARK_STACK_SIZE <= UINT16_MAX,
+                     gc_mark_stack_size_must_fit_into_its_top_index);
 
 /**
  * Get next object in list of objects with same generation.
@@ -116,12 +122,56 @@ ecma_gc_set_object_visited (ecma_object_t *object_p, /**< object */
   }
 } /* ecma_gc_set_object_visited */
 
+/**
+ * Push a visited object onto the mark stack.
+ *
+ * If the stack is full, the object is found later by rescanning the list of objects.
+ */
+static void
+ecma_gc_push_gray_object (ecma_object_t *object_p) /**< object */
+{
+  JERRY_ASSERT (ecma_gc_is_object_visited (object_p));
+
+  uint16_t top = JERRY_CONTEXT (ecma_gc_mark_stack_top);
+
+  if (likely (top < CONFIG_ECMA_GC_MARK_STACK_SIZE))
+  {
+    ECMA_SET_NON_NULL_POINTER (JERRY_CONTEXT (ecma_gc_mark_stack)[top], object_p);
+    JERRY_CONTEXT (ecma_gc_mark_stack_top) = (uint16_t) (top + 1);
+  }
+  else
+  {
+    JERRY_CONTEXT (ecma_gc_flags) |= ECMA_GC_FLAG_MARK_STACK_OVERFLOW;
+  }
+} /* ecma_gc_push_gray_object */
+
+/**
+ * Mark an object as visited, and schedule the marking of the objects referenced by it.
+ */
+static inline void __attr_always_inline___
+ecma_gc_set_object_gray (ecma_object_t *object_p) /**< object */
+{
+  if (!ecma_gc_is_object_visited (object_p))
+  {
+    ecma_gc_set_object_visited (object_p, true);
+    ecma_gc_push_gray_object (object_p);
+  }
+} /* ecma_gc_set_object_gray */
+
 /**
  * Initialize GC information for the object
  */
 inline void
 ecma_init_gc_info (ecma_object_t *object_p) /**< object */
 {
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  /* The object is not initialized yet, so the slice must run before it is linked in. */
+  if (JERRY_CONTEXT (ecma_gc_state) != ECMA_GC_STATE_IDLE)
+  {
+    ecma_gc_run_slice ();
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   JERRY_CONTEXT (ecma_gc_objects_number)++;
   JERRY_CONTEXT (ecma_gc_new_objects)++;
 
@@ -130,19 +180,57 @@ ecma_init_gc_info (ecma_object_t *object_p) /**< object */
   JERRY_ASSERT (object_p->type_flags_refs < ECMA_OBJECT_REF_ONE);
   object_p->type_flags_refs = (uint16_t) (object_p->type_flags_refs | ECMA_OBJECT_REF_ONE);
 
-  ecma_gc_set_object_next (object_p, JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY]);
-  JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = object_p;
+  ecma_gc_set_object_next (object_p, JERRY_CONTEXT (ecma_gc_objects_p));
+  JERRY_CONTEXT (ecma_gc_objects_p) = object_p;
 
-  /* Should be set to false at the beginning of garbage collection */
-  ecma_gc_set_object_visited (object_p, false);
+  if (likely (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_IDLE))
+  {
+    /* Should be set to false at the beginning of garbage collection */
+    ecma_gc_set_object_visited (object_p, false);
+    return;
+  }
+
+  /* Objects created during a garbage collection survive it. While marking, the
+   * object is gray: its references are stored by the caller without barrier. */
+  ecma_gc_set_object_visited (object_p, true);
+
+  if (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_MARK)
+  {
+    ecma_gc_push_gray_object (object_p);
+  }
 } /* ecma_init_gc_info */
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+
+/**
+ * Write barrier of incremental garbage collection
+ *
+ * Must be called when a reference to the object is stored into another object.
+ * While marking is in progress, the object becomes gray, so a reference moved
+ * into an already marked object is never missed.
+ */
+inline void __attr_always_inline___
+ecma_gc_write_barrier (ecma_object_t *object_p) /**< referenced object */
+{
+  if (unlikely (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_MARK))
+  {
+    ecma_gc_set_object_gray (object_p);
+  }
+} /* ecma_gc_write_barrier */
+
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
 /**
  * Increase reference counter of an object
  */
 void
 ecma_ref_object (ecma_object_t *object_p) /**< object */
 {
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  /* Objects taken by the engine during marking are live. */
+  ecma_gc_write_barrier (object_p);
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   if (likely (object_p->type_flags_refs < ECMA_OBJECT_MAX_REF))
   {
     object_p->type_flags_refs = (uint16_t) (object_p->type_flags_refs + ECMA_OBJECT_REF_ONE);
@@ -160,6 +248,13 @@ void
 ecma_deref_object (ecma_object_t *object_p) /**< object */
 {
   JERRY_ASSERT (object_p->type_flags_refs >= ECMA_OBJECT_REF_ONE);
+
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  /* The object may be a root which is not scanned yet, and it might have
+   * been stored into an already marked object without taking a reference. */
+  ecma_gc_write_barrier (object_p);
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   object_p->type_flags_refs = (uint16_t) (object_p->type_flags_refs - ECMA_OBJECT_REF_ONE);
 } /* ecma_deref_object */
 
@@ -188,7 +283,7 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
       {
         ecma_object_t *value_obj_p = ecma_get_object_from_value (value);
 
-        ecma_gc_set_object_visited (value_obj_p, true);
+        ecma_gc_set_object_gray (value_obj_p);
       }
       break;
     }
@@ -200,12 +295,12 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
 
       if (getter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (getter_obj_p, true);
+        ecma_gc_set_object_gray (getter_obj_p);
       }
 
       if (setter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (setter_obj_p, true);
+        ecma_gc_set_object_gray (setter_obj_p);
       }
       break;
     }
@@ -224,9 +319,9 @@ ecma_gc_mark_property (ecma_property_pair_t *property_pair_p, /**< property pair
 } /* ecma_gc_mark_property */
 
 /**
- * Mark objects as visited starting from specified object as root
+ * Mark the objects referenced by a visited object
  */
-void
+static void
 ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
 {
   JERRY_ASSERT (object_p != NULL);
@@ -239,13 +334,13 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *lex_env_p = ecma_get_lex_env_outer_reference (object_p);
     if (lex_env_p != NULL)
     {
-      ecma_gc_set_object_visited (lex_env_p, true);
+      ecma_gc_set_object_gray (lex_env_p);
     }
 
     if (ecma_get_lex_env_type (object_p) != ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
     {
       ecma_object_t *binding_object_p = ecma_get_lex_env_binding_object (object_p);
-      ecma_gc_set_object_visited (binding_object_p, true);
+      ecma_gc_set_object_gray (binding_object_p);
 
       traverse_properties = false;
     }
@@ -255,7 +350,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *proto_p = ecma_get_object_prototype (object_p);
     if (proto_p != NULL)
     {
-      ecma_gc_set_object_visited (proto_p, true);
+      ecma_gc_set_object_gray (proto_p);
     }
 
     switch (ecma_get_object_type (object_p))
@@ -272,7 +367,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
 
           if (ecma_is_value_object (result))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (result), true);
+            ecma_gc_set_object_gray (ecma_get_object_from_value (result));
           }
 
           /* Mark all reactions. */
@@ -281,14 +376,14 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
 
           while (ecma_collection_iterator_next (&iter))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (*iter.current_value_p), true);
+            ecma_gc_set_object_gray (ecma_get_object_from_value (*iter.current_value_p));
           }
 
           ecma_collection_iterator_init (&iter, ((ecma_promise_object_t *) ext_object_p)->reject_reactions);
 
           while (ecma_collection_iterator_next (&iter))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (*iter.current_value_p), true);
+            ecma_gc_set_object_gray (ecma_get_object_from_value (*iter.current_value_p));
           }
         }
 
@@ -306,14 +401,14 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
             ecma_object_t *lex_env_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                                         ext_object_p->u.pseudo_array.u2.lex_env_cp);
 
-            ecma_gc_set_object_visited (lex_env_p, true);
+            ecma_gc_set_object_gray (lex_env_p);
             break;
           }
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
           case ECMA_PSEUDO_ARRAY_TYPEDARRAY:
           case ECMA_PSEUDO_ARRAY_TYPEDARRAY_WITH_INFO:
           {
-            ecma_gc_set_object_visited (ecma_typedarray_get_arraybuffer (object_p), true);
+            ecma_gc_set_object_gray (ecma_typedarray_get_arraybuffer (object_p));
             break;
           }
 #endif /* !CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN */
@@ -334,7 +429,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         target_func_obj_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                              ext_function_p->u.bound_function.target_function);
 
-        ecma_gc_set_object_visited (target_func_obj_p, true);
+        ecma_gc_set_object_gray (target_func_obj_p);
 
         ecma_value_t args_len_or_this = ext_function_p->u.bound_function.args_len_or_this;
 
@@ -342,7 +437,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         {
           if (ecma_is_value_object (args_len_or_this))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (args_len_or_this), true);
+            ecma_gc_set_object_gray (ecma_get_object_from_value (args_len_or_this));
           }
           break;
         }
@@ -356,7 +451,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
         {
           if (ecma_is_value_object (args_p[i]))
           {
-            ecma_gc_set_object_visited (ecma_get_object_from_value (args_p[i]), true);
+            ecma_gc_set_object_gray (ecma_get_object_from_value (args_p[i]));
           }
         }
         break;
@@ -370,7 +465,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
           ecma_object_t *scope_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                                     ext_func_p->u.function.scope_cp);
 
-          ecma_gc_set_object_visited (scope_p, true);
+          ecma_gc_set_object_gray (scope_p);
         }
         break;
       }
@@ -438,10 +533,44 @@ ecma_gc_free_native_pointer (ecma_property_t *property_p, /**< property */
   }
 } /* ecma_gc_free_native_pointer */
 
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+
+/**
+ * Remove the receivers which are going to be freed from the inline caches.
+ *
+ * Must be called before sweeping, because the address of a freed object may be
+ * reused by a new object. The owners of the cached properties are reachable from
+ * the receivers, so their properties are not freed while the receiver is alive.
+ */
+static void
+ecma_gc_sweep_inline_caches (void)
+{
+  ecma_inline_cache_entry_t *entry_p = JERRY_CONTEXT (ecma_inline_cache);
+  ecma_inline_cache_entry_t *entry_end_p = entry_p + CONFIG_ECMA_INLINE_CACHE_SIZE;
+
+  while (entry_p < entry_end_p)
+  {
+    for (uint32_t i = 0; i < ECMA_INLINE_CACHE_WAYS; i++)
+    {
+      jmem_cpointer_t object_cp = entry_p->ways[i].object_cp;
+
+      if (object_cp != ECMA_NULL_POINTER
+          && !ecma_gc_is_object_visited (ECMA_GET_NON_NULL_POINTER (ecma_object_t, object_cp)))
+      {
+        entry_p->ways[i].object_cp = ECMA_NULL_POINTER;
+      }
+    }
+
+    entry_p++;
+  }
+} /* ecma_gc_sweep_inline_caches */
+
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+
 /**
  * Free specified object.
  */
-void
+static void
 ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
 {
   JERRY_ASSERT (object_p != NULL
@@ -698,119 +827,277 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
 } /* ecma_gc_sweep */
 
 /**
- * Run garbage collection
+ * Unlink an object found unvisited by the sweep phase from the list of objects.
  */
-void
-ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
+static void
+ecma_gc_unlink_object (ecma_object_t *object_p) /**< object */
 {
-  JERRY_CONTEXT (ecma_gc_new_objects) = 0;
-
-  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] == NULL);
+  ecma_object_t *prev_p = JERRY_CONTEXT (ecma_gc_cursor_prev_p);
+  ecma_object_t *next_p = ecma_gc_get_object_next (object_p);
 
-  /* if some object is referenced from stack or globals (i.e. it is root), mark it */
-  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
-       obj_iter_p != NULL;
-       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  if (prev_p == NULL)
   {
-    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+    if (JERRY_CONTEXT (ecma_gc_objects_p) == object_p)
+    {
+      JERRY_CONTEXT (ecma_gc_objects_p) = next_p;
+      return;
+    }
 
-    if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE)
+    /* Objects created since the sweep phase started precede the object. */
+    prev_p = JERRY_CONTEXT (ecma_gc_objects_p);
+
+    while (ecma_gc_get_object_next (prev_p) != object_p)
     {
-      ecma_gc_set_object_visited (obj_iter_p, true);
+      prev_p = ecma_gc_get_object_next (prev_p);
     }
+
+    JERRY_CONTEXT (ecma_gc_cursor_prev_p) = prev_p;
   }
 
-  bool marked_anything_during_current_iteration = false;
+  JERRY_ASSERT (ecma_gc_get_object_next (prev_p) == object_p);
+
+  ecma_gc_set_object_next (prev_p, next_p);
+} /* ecma_gc_unlink_object */
+
+/**
+ * Start a garbage collection
+ */
+static void
+ecma_gc_start (jmem_free_unused_memory_severity_t severity) /**< gc severity */
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_IDLE);
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_mark_stack_top) == 0);
+
+  JERRY_CONTEXT (ecma_gc_new_objects) = 0;
+
+  JERRY_CONTEXT (ecma_gc_state) = ECMA_GC_STATE_MARK;
+  JERRY_CONTEXT (ecma_gc_cursor_p) = JERRY_CONTEXT (ecma_gc_objects_p);
 
-  do
+  if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
   {
-    marked_anything_during_current_iteration = false;
+    JERRY_CONTEXT (ecma_gc_flags) |= ECMA_GC_FLAG_HIGH_SEVERITY;
+  }
+} /* ecma_gc_start */
+
+/**
+ * Finish the current garbage collection
+ */
+static void
+ecma_gc_finish (void)
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_SWEEP);
 
-    ecma_object_t *obj_prev_p = NULL;
-    ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+  JERRY_CONTEXT (ecma_gc_state) = ECMA_GC_STATE_IDLE;
+  JERRY_CONTEXT (ecma_gc_flags) &= ECMA_GC_FLAG_RUNNING;
+  JERRY_CONTEXT (ecma_gc_cursor_prev_p) = NULL;
 
-    while (obj_iter_p != NULL)
+  /* Unmarking all objects */
+  JERRY_CONTEXT (ecma_gc_visited_flip_flag) = !JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+
+#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
+  /* Free RegExp bytecodes stored in cache */
+  re_cache_gc_run ();
+#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+} /* ecma_gc_finish */
+
+/**
+ * Advance the current garbage collection
+ *
+ * Each object popped from the mark stack, examined by the root scan or examined
+ * by the sweep phase consumes one unit of the budget.
+ */
+static void
+ecma_gc_step (size_t budget) /**< maximum number of objects to process */
+{
+  while (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_MARK)
+  {
+    if (budget == 0)
     {
-      ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+      return;
+    }
 
-      if (ecma_gc_is_object_visited (obj_iter_p))
-      {
-        /* Moving the object to list of marked objects */
-        ecma_gc_set_object_next (obj_iter_p, JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK]);
-        JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] = obj_iter_p;
+    budget--;
 
-        if (likely (obj_prev_p != NULL))
-        {
-          JERRY_ASSERT (ecma_gc_get_object_next (obj_prev_p) == obj_iter_p);
+    if (JERRY_CONTEXT (ecma_gc_mark_stack_top) > 0)
+    {
+      uint16_t top = (uint16_t) (JERRY_CONTEXT (ecma_gc_mark_stack_top) - 1);
+      JERRY_CONTEXT (ecma_gc_mark_stack_top) = top;
 
-          ecma_gc_set_object_next (obj_prev_p, obj_next_p);
-        }
-        else
+      ecma_gc_mark (ECMA_GET_NON_NULL_POINTER (ecma_object_t, JERRY_CONTEXT (ecma_gc_mark_stack)[top]));
+      continue;
+    }
+
+    ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_cursor_p);
+
+    if (obj_iter_p != NULL)
+    {
+      JERRY_CONTEXT (ecma_gc_cursor_p) = ecma_gc_get_object_next (obj_iter_p);
+
+      if (ecma_gc_is_object_visited (obj_iter_p))
+      {
+        if (JERRY_CONTEXT (ecma_gc_flags) & ECMA_GC_FLAG_RESCAN)
         {
-          JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = obj_next_p;
+          ecma_gc_mark (obj_iter_p);
         }
-
-        ecma_gc_mark (obj_iter_p);
-        marked_anything_during_current_iteration = true;
       }
-      else
+      else if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE)
       {
-        obj_prev_p = obj_iter_p;
+        /* if some object is referenced from stack or globals (i.e. it is root), mark it */
+        ecma_gc_set_object_visited (obj_iter_p, true);
+        ecma_gc_mark (obj_iter_p);
       }
+      continue;
+    }
 
-      obj_iter_p = obj_next_p;
+    if (JERRY_CONTEXT (ecma_gc_flags) & ECMA_GC_FLAG_MARK_STACK_OVERFLOW)
+    {
+      /* Some gray objects are only known by their visited flag. */
+      JERRY_CONTEXT (ecma_gc_flags) &= (uint8_t) ~ECMA_GC_FLAG_MARK_STACK_OVERFLOW;
+      JERRY_CONTEXT (ecma_gc_flags) |= ECMA_GC_FLAG_RESCAN;
+      JERRY_CONTEXT (ecma_gc_cursor_p) = JERRY_CONTEXT (ecma_gc_objects_p);
+      continue;
     }
+
+    /* Sweeping objects that are currently unmarked */
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+    ecma_gc_sweep_inline_caches ();
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+    JERRY_CONTEXT (ecma_gc_state) = ECMA_GC_STATE_SWEEP;
+    JERRY_CONTEXT (ecma_gc_cursor_p) = JERRY_CONTEXT (ecma_gc_objects_p);
+    JERRY_CONTEXT (ecma_gc_cursor_prev_p) = NULL;
   }
-  while (marked_anything_during_current_iteration);
 
-  /* Sweeping objects that are currently unmarked */
-  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_SWEEP);
 
-  while (obj_iter_p != NULL)
+  while (budget > 0)
   {
-    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+    ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_cursor_p);
 
-    JERRY_ASSERT (!ecma_gc_is_object_visited (obj_iter_p));
+    if (obj_iter_p == NULL)
+    {
+      ecma_gc_finish ();
+      return;
+    }
 
-    ecma_gc_sweep (obj_iter_p);
-    obj_iter_p = obj_next_p;
-  }
+    budget--;
+    JERRY_CONTEXT (ecma_gc_cursor_p) = ecma_gc_get_object_next (obj_iter_p);
 
-  if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
-  {
-    /* Remove the property hashmap of BLACK objects */
-    obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+    if (!ecma_gc_is_object_visited (obj_iter_p))
+    {
+      ecma_gc_unlink_object (obj_iter_p);
+      ecma_gc_sweep (obj_iter_p);
+      continue;
+    }
+
+    JERRY_CONTEXT (ecma_gc_cursor_prev_p) = obj_iter_p;
 
-    while (obj_iter_p != NULL)
+    if ((JERRY_CONTEXT (ecma_gc_flags) & ECMA_GC_FLAG_HIGH_SEVERITY)
+        && (!ecma_is_lexical_environment (obj_iter_p)
+            || ecma_get_lex_env_type (obj_iter_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE))
     {
-      JERRY_ASSERT (ecma_gc_is_object_visited (obj_iter_p));
+      /* Remove the property hashmap of surviving objects */
+      ecma_property_header_t *prop_iter_p = ecma_get_property_list (obj_iter_p);
 
-      if (!ecma_is_lexical_environment (obj_iter_p)
-          || ecma_get_lex_env_type (obj_iter_p) == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
+      if (prop_iter_p != NULL && prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
       {
-        ecma_property_header_t *prop_iter_p = ecma_get_property_list (obj_iter_p);
-
-        if (prop_iter_p != NULL && prop_iter_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
-        {
-          ecma_property_hashmap_free (obj_iter_p);
-        }
+        ecma_property_hashmap_free (obj_iter_p);
       }
-
-      obj_iter_p = ecma_gc_get_object_next (obj_iter_p);
     }
   }
+} /* ecma_gc_step */
 
-  /* Unmarking all objects */
-  ecma_object_t *black_objects = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
-  JERRY_CONTEXT (ecma_gc_objects_lists)[ECMA_GC_COLOR_WHITE_GRAY] = black_objects;
-  JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] = NULL;
+#ifdef JMEM_STATS
 
-  JERRY_CONTEXT (ecma_gc_visited_flip_flag) = !JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+/**
+ * Get the current time for measuring garbage collector pauses.
+ *
+ * @return time in milliseconds
+ */
+static inline double __attr_always_inline___
+ecma_gc_pause_start (void)
+{
+  return jerry_port_get_current_time ();
+} /* ecma_gc_pause_start */
 
-#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
-  /* Free RegExp bytecodes stored in cache */
-  re_cache_gc_run ();
-#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+/**
+ * Register a garbage collector pause.
+ */
+static void
+ecma_gc_pause_end (double start_time) /**< value returned by ecma_gc_pause_start */
+{
+  double pause_time = jerry_port_get_current_time () - start_time;
+
+  jmem_stats_gc_pause ((pause_time > 0) ? (size_t) (pause_time * 1000.0) : 0);
+} /* ecma_gc_pause_end */
+
+#endif /* JMEM_STATS */
+
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+
+/**
+ * Run a slice of the current incremental garbage collection
+ */
+static void
+ecma_gc_run_slice (void)
+{
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_state) != ECMA_GC_STATE_IDLE);
+
+  if (JERRY_CONTEXT (ecma_gc_flags) & ECMA_GC_FLAG_RUNNING)
+  {
+    /* An object is created by a native free callback. */
+    return;
+  }
+
+#ifdef JMEM_STATS
+  double start_time = ecma_gc_pause_start ();
+#endif /* JMEM_STATS */
+
+  JERRY_CONTEXT (ecma_gc_flags) |= ECMA_GC_FLAG_RUNNING;
+  ecma_gc_step (CONFIG_ECMA_GC_INCREMENTAL_BUDGET);
+  JERRY_CONTEXT (ecma_gc_flags) &= (uint8_t) ~ECMA_GC_FLAG_RUNNING;
+
+#ifdef JMEM_STATS
+  ecma_gc_pause_end (start_time);
+#endif /* JMEM_STATS */
+} /* ecma_gc_run_slice */
+
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
+/**
+ * Run garbage collection
+ *
+ * An incremental garbage collection in progress is completed first, since
+ * the objects it has already marked are kept alive by it.
+ */
+void
+ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
+{
+  if (JERRY_CONTEXT (ecma_gc_flags) & ECMA_GC_FLAG_RUNNING)
+  {
+    /* Memory is requested by a native free callback. */
+    return;
+  }
+
+#ifdef JMEM_STATS
+  double start_time = ecma_gc_pause_start ();
+#endif /* JMEM_STATS */
+
+  JERRY_CONTEXT (ecma_gc_flags) |= ECMA_GC_FLAG_RUNNING;
+
+  if (JERRY_CONTEXT (ecma_gc_state) != ECMA_GC_STATE_IDLE)
+  {
+    ecma_gc_step (SIZE_MAX);
+  }
+
+  ecma_gc_start (severity);
+  ecma_gc_step (SIZE_MAX);
+
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_state) == ECMA_GC_STATE_IDLE);
+  JERRY_CONTEXT (ecma_gc_flags) &= (uint8_t) ~ECMA_GC_FLAG_RUNNING;
+
+#ifdef JMEM_STATS
+  ecma_gc_pause_end (start_time);
+#endif /* JMEM_STATS */
 } /* ecma_gc_run */
 
 /**
@@ -844,10 +1131,22 @@ ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< sever
      */
     size_t new_objects_share = CONFIG_ECMA_GC_NEW_OBJECTS_SHARE_TO_START_GC;
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+    if (JERRY_CONTEXT (ecma_gc_state) != ECMA_GC_STATE_IDLE)
+    {
+      ecma_gc_run_slice ();
+    }
+    else if (JERRY_CONTEXT (ecma_gc_new_objects) * new_objects_share > JERRY_CONTEXT (ecma_gc_objects_number))
+    {
+      ecma_gc_start (severity);
+      ecma_gc_run_slice ();
+    }
+#else /* !CONFIG_ECMA_GC_INCREMENTAL */
     if (JERRY_CONTEXT (ecma_gc_new_objects) * new_objects_share > JERRY_CONTEXT (ecma_gc_objects_number))
     {
       ecma_gc_run (severity);
     }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
   }
   else
   {
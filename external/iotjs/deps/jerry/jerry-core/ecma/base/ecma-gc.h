@@ -29,6 +29,9 @@
 void ecma_init_gc_info (ecma_object_t *object_p);
 void ecma_ref_object (ecma_object_t *object_p);
 void ecma_deref_object (ecma_object_t *object_p);
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+void ecma_gc_write_barrier (ecma_object_t *object_p);
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
 void ecma_gc_run (jmem_free_unused_memory_severity_t severity);
 void ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity);
 
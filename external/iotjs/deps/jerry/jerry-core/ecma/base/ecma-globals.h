@@ -1144,19 +1144,32 @@ typedef struct
 } ecma_compiled_code_t;
 
 /**
- * An object's GC color
+ * Phases of a garbage collection
  *
  * Tri-color marking:
- *   WHITE_GRAY, unvisited -> WHITE: not referenced by a live object or the reference not found yet
- *   WHITE_GRAY, visited   -> GRAY: referenced by some live object
- *   BLACK                 -> BLACK: all referenced objects are gray or black
+ *   unvisited                        -> WHITE: not referenced by a live object or the reference not found yet
+ *   visited, on the mark stack       -> GRAY: referenced by some live object
+ *   visited, not on the mark stack   -> BLACK: all referenced objects are gray or black
+ *
+ * Gray objects which did not fit on the mark stack are found by rescanning the list of objects.
+ */
+typedef enum
+{
+  ECMA_GC_STATE_IDLE, /**< no garbage collection is in progress */
+  ECMA_GC_STATE_MARK, /**< live objects are being marked */
+  ECMA_GC_STATE_SWEEP, /**< unvisited objects are being freed */
+} ecma_gc_state_t;
+
+/**
+ * Garbage collector flags
  */
 typedef enum
 {
-  ECMA_GC_COLOR_WHITE_GRAY, /**< white or gray */
-  ECMA_GC_COLOR_BLACK, /**< black */
-  ECMA_GC_COLOR__COUNT /**< number of colors */
-} ecma_gc_color_t;
+  ECMA_GC_FLAG_MARK_STACK_OVERFLOW = (1u << 0), /**< a gray object did not fit on the mark stack */
+  ECMA_GC_FLAG_RESCAN = (1u << 1), /**< the object list is rescanned for gray objects */
+  ECMA_GC_FLAG_HIGH_SEVERITY = (1u << 2), /**< property hashmaps of surviving objects are freed */
+  ECMA_GC_FLAG_RUNNING = (1u << 3), /**< the garbage collector is running */
+} ecma_gc_flags_t;
 
 #ifndef CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
 
@@ -1217,6 +1230,60 @@ typedef struct
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+
+/**
+ * Number of receivers remembered by an inline cache entry
+ */
+#define ECMA_INLINE_CACHE_WAYS 2
+
+/**
+ * Maximum number of prototypes skipped to reach the object which owns a cached property
+ */
+#define ECMA_INLINE_CACHE_MAX_DEPTH 4
+
+/**
+ * Number of consecutive misses after which a site is treated as megamorphic
+ * and stops filling its entry
+ */
+#define ECMA_INLINE_CACHE_MISS_LIMIT 8
+
+/**
+ * Receiver remembered by an inline cache entry
+ */
+typedef struct
+{
+  /** Pointer to the cached named data property */
+  ecma_property_t *prop_p;
+
+  /** Compressed pointer to the receiver object (ECMA_NULL_POINTER marks the way empty) */
+  jmem_cpointer_t object_cp;
+
+  /** Number of objects on the prototype chain before the owner of the property */
+  uint8_t depth;
+
+  /** Bit i is set if the first slot of property_list_cp[i] was free when the way was filled */
+  uint8_t free_slot_mask;
+
+  /** First property pair of each skipped object, a property added to them changes it
+   *  or fills its free first slot */
+  jmem_cpointer_t property_list_cp[ECMA_INLINE_CACHE_MAX_DEPTH];
+} ecma_inline_cache_way_t;
+
+/**
+ * Inline cache entry of a property access site
+ */
+typedef struct
+{
+  const uint8_t *site_p; /**< byte code of the property access */
+  ecma_value_t name; /**< literal property name */
+  uint16_t epoch; /**< value of the inline cache epoch when the ways were filled */
+  uint8_t misses; /**< number of consecutive misses */
+  ecma_inline_cache_way_t ways[ECMA_INLINE_CACHE_WAYS]; /**< receivers, most recent first */
+} ecma_inline_cache_entry_t;
+
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+
 #ifndef CONFIG_DISABLE_ES2015_TYPEDARRAY_BUILTIN
 
 /**
@@ -17,6 +17,7 @@
 #include "ecma-gc.h"
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
+#include "ecma-inline-cache.h"
 #include "ecma-lcache.h"
 #include "ecma-property-hashmap.h"
 #include "jrt-bit-fields.h"
@@ -786,6 +787,8 @@ ecma_delete_property (ecma_object_t *object_p, /**< object */
   ecma_property_header_t *prev_prop_p = NULL;
   ecma_property_hashmap_delete_status hashmap_status = ECMA_PROPERTY_HASHMAP_DELETE_NO_HASHMAP;
 
+  ecma_inline_cache_invalidate ();
+
   if (cur_prop_p != NULL && cur_prop_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
   {
     prev_prop_p = cur_prop_p;
@@ -919,6 +922,8 @@ ecma_delete_array_properties (ecma_object_t *object_p, /**< object */
   }
 
   /* Second all properties between new_length and old_length are deleted. */
+  ecma_inline_cache_invalidate ();
+
   current_prop_p = ecma_get_property_list (object_p);
   ecma_property_header_t *prev_prop_p = NULL;
   ecma_property_hashmap_delete_status hashmap_status = ECMA_PROPERTY_HASHMAP_DELETE_NO_HASHMAP;
@@ -1055,6 +1060,13 @@ ecma_named_data_property_assign_value (ecma_object_t *obj_p, /**< object */
 {
   ecma_assert_object_contains_the_property (obj_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDDATA);
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  if (ecma_is_value_object (value))
+  {
+    ecma_gc_write_barrier (ecma_get_object_from_value (value));
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   ecma_value_assign_value (&prop_value_p->value, value);
 } /* ecma_named_data_property_assign_value */
 
@@ -1104,6 +1116,13 @@ ecma_set_named_accessor_property_getter (ecma_object_t *object_p, /**< the prope
 {
   ecma_assert_object_contains_the_property (object_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDACCESSOR);
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  if (getter_p != NULL)
+  {
+    ecma_gc_write_barrier (getter_p);
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
 #ifdef JERRY_CPOINTER_32_BIT
   ecma_getter_setter_pointers_t *getter_setter_pair_p;
   getter_setter_pair_p = ECMA_GET_POINTER (ecma_getter_setter_pointers_t,
@@ -1124,6 +1143,13 @@ ecma_set_named_accessor_property_setter (ecma_object_t *object_p, /**< the prope
 {
   ecma_assert_object_contains_the_property (object_p, prop_value_p, ECMA_PROPERTY_TYPE_NAMEDACCESSOR);
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  if (setter_p != NULL)
+  {
+    ecma_gc_write_barrier (setter_p);
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
 #ifdef JERRY_CPOINTER_32_BIT
   ecma_getter_setter_pointers_t *getter_setter_pair_p;
   getter_setter_pair_p = ECMA_GET_POINTER (ecma_getter_setter_pointers_t,
@@ -0,0 +1,351 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-globals.h"
+#include "ecma-helpers.h"
+#include "ecma-inline-cache.h"
+#include "jcontext.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmainlinecache Inline caches of property accesses
+ * @{
+ *
+ * Each property access site of the byte code which uses a literal property name
+ * remembers the last receivers it was executed with and the named data property
+ * found for them, either on the receiver itself or on one of its prototypes.
+ * Unlike the LCache, which is keyed by object and name and is shared by every
+ * site, the entries are selected by the site, so polymorphic sites do not evict
+ * each other's properties.
+ *
+ * A cached property stays valid until:
+ *  - a property is deleted or a prototype of an object is changed: these
+ *    change the global epoch, which invalidates all entries,
+ *  - a property is added to an object which is skipped on the prototype chain:
+ *    detected by comparing the first property pair of the skipped objects,
+ *    because new properties are always added to the front of the list or into
+ *    the free first slot of the first pair,
+ *  - the receiver is freed: the garbage collector removes it from the entries
+ *    before sweeping. The other objects on the chain are kept alive by it.
+ */
+
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+
+JERRY_STATIC_ASSERT ((CONFIG_ECMA_INLINE_CACHE_SIZE & (CONFIG_ECMA_INLINE_CACHE_SIZE - 1)) == 0,
+                     ecma_inline_cache_size_must_be_power_of_2);
+
+/**
+ * Mask for the entry index
+ */
+#define ECMA_INLINE_CACHE_MASK (CONFIG_ECMA_INLINE_CACHE_SIZE - 1)
+
+/**
+ * Get the entry of a property access site
+ *
+ * @return pointer to the entry
+ */
+static inline ecma_inline_cache_entry_t * __attr_always_inline___
+ecma_inline_cache_get_entry (const uint8_t *site_p) /**< byte code of the property access */
+{
+  uintptr_t site = (uintptr_t) site_p;
+
+  return JERRY_CONTEXT (ecma_inline_cache) + ((site ^ (site >> 7)) & ECMA_INLINE_CACHE_MASK);
+} /* ecma_inline_cache_get_entry */
+
+/**
+ * Get the first property pair of an object, skipping the property hashmap
+ *
+ * @return compressed pointer to the first property pair
+ */
+static inline jmem_cpointer_t __attr_always_inline___
+ecma_inline_cache_get_property_list (ecma_object_t *object_p) /**< object */
+{
+  jmem_cpointer_t property_list_cp = object_p->property_list_or_bound_object_cp;
+
+  if (property_list_cp != ECMA_NULL_POINTER)
+  {
+    ecma_property_header_t *header_p = ECMA_GET_NON_NULL_POINTER (ecma_property_header_t, property_list_cp);
+
+    if (header_p->types[0] == ECMA_PROPERTY_TYPE_HASHMAP)
+    {
+      property_list_cp = header_p->next_property_cp;
+    }
+  }
+
+  return property_list_cp;
+} /* ecma_inline_cache_get_property_list */
+
+/**
+ * Checks whether the first slot of a property list is free.
+ *
+ * Note:
+ *      a new property is stored in this slot without changing the property list
+ *
+ * @return true - if the first slot is free
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+ecma_inline_cache_has_free_slot (jmem_cpointer_t property_list_cp) /**< first property pair */
+{
+  return (property_list_cp != ECMA_NULL_POINTER
+          && (ECMA_GET_NON_NULL_POINTER (ecma_property_header_t, property_list_cp)->types[0]
+              == ECMA_PROPERTY_TYPE_DELETED));
+} /* ecma_inline_cache_has_free_slot */
+
+/**
+ * Checks whether the property lookup may continue on the prototype of an object
+ * when the property is not found in its property list.
+ *
+ * @return true - if the object has no virtual or lazily instantiated properties with this name
+ *         false - otherwise
+ */
+static bool
+ecma_inline_cache_can_skip_object (ecma_object_t *object_p, /**< object */
+                                   ecma_string_t *name_p) /**< property name */
+{
+  if (ecma_get_object_is_builtin (object_p))
+  {
+    return false;
+  }
+
+  switch (ecma_get_object_type (object_p))
+  {
+    case ECMA_OBJECT_TYPE_GENERAL:
+    {
+      return true;
+    }
+    case ECMA_OBJECT_TYPE_CLASS:
+    {
+      ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+
+      return ext_object_p->u.class_prop.class_id != LIT_MAGIC_STRING_STRING_UL;
+    }
+    case ECMA_OBJECT_TYPE_ARRAY:
+    {
+      return !ecma_string_is_length (name_p);
+    }
+    default:
+    {
+      return false;
+    }
+  }
+} /* ecma_inline_cache_can_skip_object */
+
+/**
+ * Search the property on the prototype chain and remember it in the entry.
+ *
+ * @return pointer to the named data property - if it is found and can be cached
+ *         NULL - otherwise
+ */
+static ecma_property_t *
+ecma_inline_cache_fill (ecma_inline_cache_entry_t *entry_p, /**< entry of the access site */
+                        const uint8_t *site_p, /**< byte code of the property access */
+                        ecma_object_t *object_p, /**< receiver */
+                        ecma_value_t name) /**< literal property name */
+{
+  ecma_string_t *name_p = ecma_get_string_from_value (name);
+  ecma_inline_cache_way_t new_way;
+  ecma_object_t *current_p = object_p;
+  ecma_property_t *property_p;
+  uint16_t epoch = JERRY_CONTEXT (ecma_inline_cache_epoch);
+
+  memset (&new_way, 0, sizeof (new_way));
+
+  while (true)
+  {
+    if (ecma_get_object_type (current_p) == ECMA_OBJECT_TYPE_PSEUDO_ARRAY)
+    {
+      /* Arguments and typed array elements are not read from the property list. */
+      return NULL;
+    }
+
+    property_p = ecma_find_named_property (current_p, name_p);
+
+    if (property_p != NULL)
+    {
+      break;
+    }
+
+    if (new_way.depth == ECMA_INLINE_CACHE_MAX_DEPTH
+        || !ecma_inline_cache_can_skip_object (current_p, name_p))
+    {
+      return NULL;
+    }
+
+    jmem_cpointer_t property_list_cp = ecma_inline_cache_get_property_list (current_p);
+
+    if (ecma_inline_cache_has_free_slot (property_list_cp))
+    {
+      new_way.free_slot_mask = (uint8_t) (new_way.free_slot_mask | (1u << new_way.depth));
+    }
+
+    new_way.property_list_cp[new_way.depth++] = property_list_cp;
+
+    current_p = ecma_get_object_prototype (current_p);
+
+    if (current_p == NULL)
+    {
+      return NULL;
+    }
+  }
+
+  if (ECMA_PROPERTY_GET_TYPE (*property_p) != ECMA_PROPERTY_TYPE_NAMEDDATA)
+  {
+    return NULL;
+  }
+
+  if (JERRY_CONTEXT (ecma_inline_cache_epoch) != epoch)
+  {
+    /* The lookup has triggered a garbage collection: the skipped objects
+     * are still valid, but the entry may have been invalidated. */
+    return property_p;
+  }
+
+  if (entry_p->site_p != site_p
+      || entry_p->name != name
+      || entry_p->epoch != epoch)
+  {
+    memset (entry_p->ways, 0, sizeof (entry_p->ways));
+    entry_p->site_p = site_p;
+    entry_p->name = name;
+    entry_p->epoch = epoch;
+    entry_p->misses = 0;
+  }
+
+  uint32_t way_index;
+  for (way_index = 0; way_index < ECMA_INLINE_CACHE_WAYS - 1; way_index++)
+  {
+    if (entry_p->ways[way_index].object_cp == ECMA_NULL_POINTER)
+    {
+      break;
+    }
+  }
+
+  /* Shift the ways before the free (or the least recently filled) one towards the end. */
+  for (uint32_t i = way_index; i > 0; i--)
+  {
+    entry_p->ways[i] = entry_p->ways[i - 1];
+  }
+
+  new_way.prop_p = property_p;
+  ECMA_SET_NON_NULL_POINTER (new_way.object_cp, object_p);
+  entry_p->ways[0] = new_way;
+
+  return property_p;
+} /* ecma_inline_cache_fill */
+
+/**
+ * Find a named data property through the inline cache of a property access site
+ *
+ * Note:
+ *      the name must be a literal string of the byte code which contains the site
+ *
+ * @return pointer to the named data property - if it is found and can be cached
+ *         NULL - otherwise, the property must be searched in the normal way
+ */
+ecma_property_t *
+ecma_inline_cache_lookup (const uint8_t *site_p, /**< byte code of the property access */
+                          ecma_object_t *object_p, /**< receiver */
+                          ecma_value_t name) /**< literal property name */
+{
+  JERRY_ASSERT (object_p != NULL && !ecma_is_lexical_environment (object_p));
+  JERRY_ASSERT (ecma_is_value_string (name));
+
+  ecma_inline_cache_entry_t *entry_p = ecma_inline_cache_get_entry (site_p);
+
+  if (entry_p->site_p == site_p
+      && entry_p->name == name
+      && entry_p->epoch == JERRY_CONTEXT (ecma_inline_cache_epoch))
+  {
+    jmem_cpointer_t object_cp;
+    ECMA_SET_NON_NULL_POINTER (object_cp, object_p);
+
+    for (uint32_t i = 0; i < ECMA_INLINE_CACHE_WAYS; i++)
+    {
+      ecma_inline_cache_way_t *way_p = entry_p->ways + i;
+
+      if (way_p->object_cp != object_cp)
+      {
+        continue;
+      }
+
+      /* The prototype chain cannot change without changing the epoch. */
+      ecma_object_t *current_p = object_p;
+      uint32_t depth;
+
+      for (depth = 0; depth < way_p->depth; depth++)
+      {
+        jmem_cpointer_t property_list_cp = ecma_inline_cache_get_property_list (current_p);
+
+        if (property_list_cp != way_p->property_list_cp[depth]
+            || ((way_p->free_slot_mask & (1u << depth))
+                && !ecma_inline_cache_has_free_slot (property_list_cp)))
+        {
+          break;
+        }
+
+        current_p = ecma_get_object_prototype (current_p);
+        JERRY_ASSERT (current_p != NULL);
+      }
+
+      if (depth == way_p->depth
+          && ECMA_PROPERTY_GET_TYPE (*way_p->prop_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
+      {
+        entry_p->misses = 0;
+        return way_p->prop_p;
+      }
+
+      /* The way is refilled below. */
+      way_p->object_cp = ECMA_NULL_POINTER;
+      break;
+    }
+
+    if (entry_p->misses >= ECMA_INLINE_CACHE_MISS_LIMIT)
+    {
+      /* Megamorphic site (e.g. iterating over many objects): the
+       * LCache and the property hashmap are cheaper than refilling. */
+      return NULL;
+    }
+
+    entry_p->misses++;
+  }
+
+  return ecma_inline_cache_fill (entry_p, site_p, object_p, name);
+} /* ecma_inline_cache_lookup */
+
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+
+/**
+ * Invalidate all inline caches
+ *
+ * Called when a property is deleted or a prototype is changed.
+ */
+void
+ecma_inline_cache_invalidate (void)
+{
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+  if (++JERRY_CONTEXT (ecma_inline_cache_epoch) == 0)
+  {
+    /* Entries filled before the counter wrapped around would become valid again. */
+    memset (JERRY_CONTEXT (ecma_inline_cache), 0, sizeof (JERRY_CONTEXT (ecma_inline_cache)));
+  }
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+} /* ecma_inline_cache_invalidate */
+
+/**
+ * @}
+ * @}
+ */
@@ -0,0 +1,36 @@
+/* Copyright JS Foundation and other contributors, http://js.foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECMA_INLINE_CACHE_H
+#define ECMA_INLINE_CACHE_H
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmainlinecache Inline caches of property accesses
+ * @{
+ */
+
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+ecma_property_t *ecma_inline_cache_lookup (const uint8_t *site_p, ecma_object_t *object_p, ecma_value_t name);
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+void ecma_inline_cache_invalidate (void);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !ECMA_INLINE_CACHE_H */
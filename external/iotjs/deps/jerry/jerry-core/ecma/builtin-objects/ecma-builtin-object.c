@@ -22,6 +22,7 @@
 #include "ecma-gc.h"
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
+#include "ecma-inline-cache.h"
 #include "ecma-objects.h"
 #include "ecma-objects-general.h"
 #include "ecma-try-catch-macro.h"
@@ -189,7 +190,15 @@ ecma_set_prototype_of (ecma_value_t o_value, /**< O */
   }
 
   /* 9. */
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  if (v_p != NULL)
+  {
+    ecma_gc_write_barrier (v_p);
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   ECMA_SET_POINTER (o_p->prototype_or_outer_reference_cp, v_p);
+  ecma_inline_cache_invalidate ();
 
   /* 10. */
   return true;
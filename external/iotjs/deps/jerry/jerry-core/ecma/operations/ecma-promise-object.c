@@ -75,6 +75,13 @@ ecma_promise_set_result (ecma_object_t *obj_p, /**< points to promise object */
 
   JERRY_ASSERT (ext_object_p->u.class_prop.u.value == ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED));
 
+#ifdef CONFIG_ECMA_GC_INCREMENTAL
+  if (ecma_is_value_object (result))
+  {
+    ecma_gc_write_barrier (ecma_get_object_from_value (result));
+  }
+#endif /* CONFIG_ECMA_GC_INCREMENTAL */
+
   ext_object_p->u.class_prop.u.value = result;
 } /* ecma_promise_set_result */
 
@@ -62,8 +62,9 @@ typedef struct
 #ifndef CONFIG_DISABLE_REGEXP_BUILTIN
   const re_compiled_code_t *re_cache[RE_CACHE_SIZE]; /**< regex cache */
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
-  ecma_object_t *ecma_gc_objects_lists[ECMA_GC_COLOR__COUNT]; /**< List of marked (visited during
-                                                               *   current GC session) and umarked objects */
+  ecma_object_t *ecma_gc_objects_p; /**< list of all objects */
+  ecma_object_t *ecma_gc_cursor_p; /**< next object of the list processed by the current GC phase */
+  ecma_object_t *ecma_gc_cursor_prev_p; /**< last object kept by the sweep phase (NULL if none) */
   jmem_heap_free_t *jmem_heap_list_skip_p; /**< This is used to speed up deallocation. */
   jmem_pools_chunk_t *jmem_free_8_byte_chunk_p; /**< list of free eight byte pool chunks */
 #ifdef JERRY_CPOINTER_32_BIT
@@ -84,7 +85,14 @@ typedef struct
                            *   causes call of "try give memory back" callbacks */
   uint32_t lit_magic_string_ex_count; /**< external magic strings count */
   uint32_t jerry_init_flags; /**< run-time configuration flags */
+  jmem_cpointer_t ecma_gc_mark_stack[CONFIG_ECMA_GC_MARK_STACK_SIZE]; /**< gray objects */
+  uint16_t ecma_gc_mark_stack_top; /**< number of objects on the mark stack */
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+  uint16_t ecma_inline_cache_epoch; /**< changed whenever a cached property may become invalid */
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
   uint8_t ecma_gc_visited_flip_flag; /**< current state of an object's visited flag */
+  uint8_t ecma_gc_state; /**< current phase of garbage collection (ecma_gc_state_t) */
+  uint8_t ecma_gc_flags; /**< garbage collector flags (ecma_gc_flags_t) */
   uint8_t is_direct_eval_form_call; /**< direct call from eval */
   uint8_t jerry_api_available; /**< API availability flag */
 
@@ -94,6 +102,10 @@ typedef struct
   bool ecma_prop_hashmap_alloc_last_is_hs_gc; /**< true, if and only if the last gc action was a high severity gc */
 #endif /* !CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE */
 
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+  ecma_inline_cache_entry_t ecma_inline_cache[CONFIG_ECMA_INLINE_CACHE_SIZE]; /**< inline caches of property accesses */
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+
 #ifndef CONFIG_DISABLE_REGEXP_BUILTIN
   uint8_t re_cache_idx; /**< evicted item index when regex cache is full (round-robin) */
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
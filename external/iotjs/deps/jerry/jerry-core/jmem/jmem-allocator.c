@@ -159,6 +159,35 @@ void
 jmem_stats_print (void)
 {
   jmem_heap_stats_print ();
+
+  jmem_heap_stats_t *heap_stats = &JERRY_CONTEXT (jmem_heap_stats);
+
+  JERRY_DEBUG_MSG ("GC stats:\n"
+                   "  GC pauses = %zu\n"
+                   "  Total GC pause = %zu us\n"
+                   "  Max GC pause = %zu us\n",
+                   heap_stats->gc_pause_count,
+                   heap_stats->gc_pause_total_us,
+                   heap_stats->gc_pause_max_us);
+
+  for (uint32_t i = 0; i < JMEM_STATS_GC_PAUSE_BUCKETS; i++)
+  {
+    if (heap_stats->gc_pause_histogram[i] == 0)
+    {
+      continue;
+    }
+
+    if (i < JMEM_STATS_GC_PAUSE_BUCKETS - 1)
+    {
+      JERRY_DEBUG_MSG ("  GC pauses < %zu us = %zu\n", (size_t) 1 << i, heap_stats->gc_pause_histogram[i]);
+    }
+    else
+    {
+      JERRY_DEBUG_MSG ("  GC pauses >= %zu us = %zu\n", (size_t) 1 << (i - 1), heap_stats->gc_pause_histogram[i]);
+    }
+  }
+
+  JERRY_DEBUG_MSG ("\n");
 } /* jmem_stats_print */
 
 /**
@@ -277,4 +306,30 @@ jmem_stats_free_property_bytes (size_t property_size)
   heap_stats->property_bytes -= property_size;
 } /* jmem_stats_free_property_bytes */
 
+/**
+ * Register a garbage collector pause.
+ */
+void
+jmem_stats_gc_pause (size_t pause_us) /**< duration of the pause in microseconds */
+{
+  jmem_heap_stats_t *heap_stats = &JERRY_CONTEXT (jmem_heap_stats);
+
+  heap_stats->gc_pause_count++;
+  heap_stats->gc_pause_total_us += pause_us;
+
+  if (pause_us > heap_stats->gc_pause_max_us)
+  {
+    heap_stats->gc_pause_max_us = pause_us;
+  }
+
+  uint32_t bucket = 0;
+
+  while (bucket < JMEM_STATS_GC_PAUSE_BUCKETS - 1 && (pause_us >> bucket) != 0)
+  {
+    bucket++;
+  }
+
+  heap_stats->gc_pause_histogram[bucket]++;
+} /* jmem_stats_gc_pause */
+
 #endif /* JMEM_STATS */
@@ -116,6 +116,11 @@ void *jmem_heap_alloc_block_null_on_error (const size_t size);
 void jmem_heap_free_block (void *ptr, const size_t size);
 
 #ifdef JMEM_STATS
+/**
+ * Number of buckets of the garbage collector pause histogram
+ */
+#define JMEM_STATS_GC_PAUSE_BUCKETS 16
+
 /**
  * Heap memory usage statistics
  */
@@ -149,6 +154,13 @@ typedef struct
   size_t free_count; /**< number of memory frees */
   size_t alloc_iter_count; /**< Number of iterations required for allocations */
   size_t free_iter_count; /**< Number of iterations required for inserting free blocks */
+
+  size_t gc_pause_count; /**< number of garbage collector pauses */
+  size_t gc_pause_total_us; /**< total time spent in garbage collector pauses (microseconds) */
+  size_t gc_pause_max_us; /**< longest garbage collector pause (microseconds) */
+  size_t gc_pause_histogram[JMEM_STATS_GC_PAUSE_BUCKETS]; /**< number of pauses shorter than
+                                                            *   1 << index microseconds (the last
+                                                            *   bucket counts the longer ones too) */
 } jmem_heap_stats_t;
 
 void jmem_stats_print (void);
@@ -160,6 +172,7 @@ void jmem_stats_allocate_object_bytes (size_t object_size);
 void jmem_stats_free_object_bytes (size_t string_size);
 void jmem_stats_allocate_property_bytes (size_t property_size);
 void jmem_stats_free_property_bytes (size_t property_size);
+void jmem_stats_gc_pause (size_t pause_us);
 
 void jmem_heap_get_stats (jmem_heap_stats_t *);
 #endif /* JMEM_STATS */
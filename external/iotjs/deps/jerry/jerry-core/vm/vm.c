@@ -24,6 +24,7 @@
 #include "ecma-function-object.h"
 #include "ecma-gc.h"
 #include "ecma-helpers.h"
+#include "ecma-inline-cache.h"
 #include "ecma-lcache.h"
 #include "ecma-lex-env.h"
 #include "ecma-objects.h"
@@ -122,6 +123,35 @@ vm_op_get_value (ecma_value_t object, /**< base object */
   return get_value_result;
 } /* vm_op_get_value */
 
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+
+/**
+ * Get the value of object[property] where property is a literal string of the byte code.
+ *
+ * @return ecma value
+ */
+static inline ecma_value_t __attr_always_inline___
+vm_op_get_literal_value (ecma_value_t object, /**< base object */
+                         ecma_value_t property, /**< literal property name */
+                         const uint8_t *site_p) /**< byte code of the property access */
+{
+  if (ecma_is_value_object (object))
+  {
+    ecma_property_t *property_p = ecma_inline_cache_lookup (site_p,
+                                                            ecma_get_object_from_value (object),
+                                                            property);
+
+    if (property_p != NULL)
+    {
+      return ecma_fast_copy_value (ECMA_PROPERTY_VALUE_PTR (property_p)->value);
+    }
+  }
+
+  return vm_op_get_value (object, property);
+} /* vm_op_get_literal_value */
+
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+
 /**
  * Set the value of object[property].
  *
@@ -1177,8 +1207,41 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
         case VM_OC_PROP_POST_INCR:
         case VM_OC_PROP_POST_DECR:
         {
-          result = vm_op_get_value (left_value,
-                                    right_value);
+#ifndef CONFIG_ECMA_INLINE_CACHE_DISABLE
+          bool is_literal_name = false;
+
+          if (operands >= VM_OC_GET_LITERAL && ecma_is_value_string (right_value))
+          {
+            /* The property name is the last literal argument. Only constant
+             * literals (not registers or identifiers) can be cached, because
+             * they live as long as the byte code. */
+            uint8_t *literal_p = byte_code_start_p + 1;
+            uint16_t literal_index = *literal_p++;
+
+            if (operands == VM_OC_GET_LITERAL_LITERAL)
+            {
+              literal_p += (literal_index >= encoding_limit) ? 1 : 0;
+              literal_index = *literal_p++;
+            }
+
+            if (literal_index >= encoding_limit)
+            {
+              literal_index = (uint16_t) (((literal_index << 8) | *literal_p) - encoding_delta);
+            }
+
+            is_literal_name = (literal_index >= ident_end);
+          }
+
+          if (is_literal_name)
+          {
+            result = vm_op_get_literal_value (left_value, right_value, byte_code_start_p);
+          }
+          else
+#endif /* !CONFIG_ECMA_INLINE_CACHE_DISABLE */
+          {
+            result = vm_op_get_value (left_value,
+                                      right_value);
+          }
 
           if (ECMA_IS_VALUE_ERROR (result))
           {
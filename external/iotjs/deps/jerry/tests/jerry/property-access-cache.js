@@ -0,0 +1,155 @@
+// Copyright JS Foundation and other contributors, http://js.foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+function getX (obj) {
+  return obj.x;
+}
+
+function getLength (obj) {
+  return obj.length;
+}
+
+/* Own property, then shadowed prototype property. */
+var proto = { x: 1 };
+var obj = Object.create (proto);
+assert (getX (obj) === 1);
+assert (getX (obj) === 1);
+obj.x = 2;
+assert (getX (obj) === 2);
+delete obj.x;
+assert (getX (obj) === 1);
+proto.x = 3;
+assert (getX (obj) === 3);
+
+/* Property added to an object in the middle of the prototype chain. */
+var base = { x: "base" };
+var middle = Object.create (base);
+var derived = Object.create (middle);
+var leaf = Object.create (derived);
+assert (getX (leaf) === "base");
+assert (getX (leaf) === "base");
+middle.x = "middle";
+assert (getX (leaf) === "middle");
+derived.x = "derived";
+assert (getX (leaf) === "derived");
+delete derived.x;
+delete middle.x;
+assert (getX (leaf) === "base");
+
+/* Free slot of a deleted property reused by the shadowing property. */
+var reuse = Object.create (proto);
+reuse.a = 1;
+reuse.b = 2;
+delete reuse.b;
+assert (getX (reuse) === 3);
+assert (getX (reuse) === 3);
+reuse.x = "reused";
+assert (getX (reuse) === "reused");
+
+/* Objects with a property hashmap in the chain. */
+var big = Object.create (proto);
+for (var i = 0; i < 64; i++) {
+  big["p" + i] = i;
+}
+var small = Object.create (big);
+assert (getX (small) === 3);
+assert (getX (small) === 3);
+big.x = "big";
+assert (getX (small) === "big");
+small.x = "small";
+assert (getX (small) === "small");
+
+/* Prototype changes. */
+var other = { x: "other" };
+if (Object.setPrototypeOf) {
+  var changing = Object.create (proto);
+  assert (getX (changing) === 3);
+  assert (getX (changing) === 3);
+  Object.setPrototypeOf (changing, other);
+  assert (getX (changing) === "other");
+  Object.setPrototypeOf (changing, null);
+  assert (getX (changing) === undefined);
+}
+
+/* Data property redefined as an accessor. */
+var accessor = { x: 5 };
+assert (getX (accessor) === 5);
+assert (getX (accessor) === 5);
+Object.defineProperty (accessor, "x", { get: function () { return 6; } });
+assert (getX (accessor) === 6);
+Object.defineProperty (accessor, "x", { value: 7 });
+assert (getX (accessor) === 7);
+
+/* Polymorphic site. */
+var receivers = [ { x: 0 }, Object.create ({ x: 1 }), { y: 0, x: 2 }, [], function () {} ];
+receivers[3].x = 3;
+receivers[4].x = 4;
+for (var round = 0; round < 4; round++) {
+  for (var j = 0; j < receivers.length; j++) {
+    assert (getX (receivers[j]) === j);
+  }
+}
+
+/* Virtual properties are not taken from the prototype. */
+var arr = [1, 2, 3];
+var str = new String ("abcd");
+var fn = function (a, b) {};
+var plain = Object.create ({ length: "proto" });
+for (var k = 0; k < 3; k++) {
+  assert (getLength (arr) === 3);
+  assert (getLength (str) === 4);
+  assert (getLength (fn) === 2);
+  assert (getLength (plain) === "proto");
+}
+arr.push (4);
+assert (getLength (arr) === 4);
+
+/* Arguments objects map their elements to the parameters. */
+function mapped (a) {
+  var result = [];
+  for (var n = 0; n < 3; n++) {
+    result.push (arguments[0]);
+    a = n + 10;
+  }
+  return result;
+}
+assert (mapped (1).join () === "1,10,11");
+
+/* Lazily instantiated properties of functions and built-in objects. */
+function Ctor () {}
+var instance = new Ctor ();
+function getPrototype (obj) {
+  return obj.prototype;
+}
+assert (getPrototype (instance) === undefined);
+assert (getPrototype (Ctor) === Ctor.prototype);
+assert (getPrototype (Ctor) === Ctor.prototype);
+
+function getFloor (obj) {
+  return obj.floor;
+}
+var math = Object.create (Math);
+assert (getFloor (math) === Math.floor);
+assert (getFloor (math) === Math.floor);
+math.floor = 1;
+assert (getFloor (math) === 1);
+
+/* Properties of freed objects. */
+for (var m = 0; m < 100; m++) {
+  var temp = Object.create (m % 2 ? proto : other);
+  if (m % 3) {
+    temp.x = m;
+  }
+  assert (getX (temp) === (m % 3 ? m : (m % 2 ? 3 : "other")));
+}
@@ -68,6 +68,8 @@ def get_arguments():
                         help='enable error messages (%(choices)s; default: %(default)s)')
     parser.add_argument('--external-context', metavar='X', choices=['ON', 'OFF'], default='OFF', type=str.upper,
                         help='enable external context (%(choices)s; default: %(default)s)')
+    parser.add_argument('--gc-incremental', metavar='X', choices=['ON', 'OFF'], default='OFF', type=str.upper,
+                        help='enable incremental garbage collection (%(choices)s; default: %(default)s)')
     parser.add_argument('-j', '--jobs', metavar='N', action='store', type=int, default=multiprocessing.cpu_count() + 1,
                         help='Allowed N build jobs at once (default: %(default)s)')
     parser.add_argument('--jerry-cmdline', metavar='X', choices=['ON', 'OFF'], default='ON', type=str.upper,
@@ -163,6 +165,7 @@ def generate_build_options(arguments):
     build_options.append('-DFEATURE_PROFILE=%s' % arguments.profile)
     build_options.append('-DFEATURE_DEBUGGER=%s' % arguments.jerry_debugger)
     build_options.append('-DFEATURE_EXTERNAL_CONTEXT=%s' % arguments.external_context)
+    build_options.append('-DFEATURE_GC_INCREMENTAL=%s' % arguments.gc_incremental)
     build_options.append('-DFEATURE_SNAPSHOT_EXEC=%s' % arguments.snapshot_exec)
     build_options.append('-DFEATURE_SNAPSHOT_SAVE=%s' % arguments.snapshot_save)
     build_options.append('-DFEATURE_SYSTEM_ALLOCATOR=%s' % arguments.system_allocator)
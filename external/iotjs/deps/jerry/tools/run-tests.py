@@ -67,7 +67,9 @@ JERRY_TESTS_OPTIONS = [
     Options('jerry_tests-es2015-subset-debug',
             ['--debug', '--profile=es2015-subset']),
     Options('jerry_tests-debug-external-context',
-            ['--debug', '--jerry-libc=off', '--external-context=on'])
+            ['--debug', '--jerry-libc=off', '--external-context=on']),
+    Options('jerry_tests-es2015-subset-debug-gc_incremental',
+            ['--debug', '--profile=es2015-subset', '--gc-incremental=on'])
 ]
 
 # Test options for jerry-test-suite
@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 
 /**
@@ -91,6 +92,38 @@ static bool iotjs_jerry_initialize(iotjs_environment_t* env) {
 }
 
 
+// Time when iotjs_entry() was called.
+static struct timespec iotjs_entry_time;
+
+
+/**
+ * Print how long the startup took and how much of the JerryScript heap it
+ * left allocated. Startup ends when the main module has been evaluated and
+ * the event loop is about to start.
+ */
+static void iotjs_print_startup_stats() {
+  struct timespec now;
+  jerry_heap_stats_t stats;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  int64_t elapsed = (now.tv_sec - iotjs_entry_time.tv_sec) * 1000000 +
+                    (now.tv_nsec - iotjs_entry_time.tv_nsec) / 1000;
+
+  printf("Startup stats:\n");
+  printf("  Startup time = %u us\n", (unsigned)elapsed);
+
+  // Count only the live data.
+  jerry_gc();
+
+  if (jerry_get_memory_stats(&stats)) {
+    printf("  Heap allocated after startup = %u bytes\n",
+           (unsigned)stats.allocated_bytes);
+  }
+
+  printf("\n");
+}
+
+
 static void iotjs_jerry_release(iotjs_environment_t* env) {
   jerry_cleanup();
 }
@@ -137,6 +170,10 @@ static int iotjs_start(iotjs_environment_t* env) {
   // Load and call iotjs.js.
   iotjs_run(env);
 
+  if (iotjs_environment_config(env)->memstat) {
+    iotjs_print_startup_stats();
+  }
+
   int exit_code = 0;
   if (!iotjs_environment_is_exiting(env)) {
     // Run event loop.
@@ -183,6 +220,8 @@ static void iotjs_uv_walk_to_close_callback(uv_handle_t* handle, void* arg) {
 
 
 int iotjs_entry(int argc, char** argv) {
+  clock_gettime(CLOCK_MONOTONIC, &iotjs_entry_time);
+
   // Initialize debug print.
   init_debug_settings();
 
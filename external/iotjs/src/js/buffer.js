@@ -217,6 +217,7 @@ Buffer.prototype.write = function(string, offset, length) {
 // [3] buff.slice(start, end)
 // * start - default to 0
 // * end - default to buff.length
+// The returned buffer shares the memory of this buffer.
 Buffer.prototype.slice = function(start, end) {
   start = start === undefined ? 0 : ~~start;
   end = end === undefined ? this.length : ~~end;
@@ -52,8 +52,32 @@ Native.prototype.compile = function() {
   fn(this.exports, Native.require, this);
 }
 
-global.console = Native.require('console');
-global.Buffer = Native.require('buffer');
+// Modules behind these globals are compiled on first use, so a script which
+// never touches them does not pay for them at startup.
+function defineLazyGlobal(name, id) {
+  var define = function(value) {
+    Object.defineProperty(global, name, {
+      value: value,
+      writable: true,
+      enumerable: true,
+      configurable: true
+    });
+  };
+
+  Object.defineProperty(global, name, {
+    get: function() {
+      var exports = Native.require(id);
+      define(exports);
+      return exports;
+    },
+    set: define,
+    enumerable: true,
+    configurable: true
+  });
+}
+
+defineLazyGlobal('console', 'console');
+defineLazyGlobal('Buffer', 'buffer');
 
 (function() {
   var timers = undefined;
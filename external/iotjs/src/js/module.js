@@ -15,7 +15,8 @@
 
 
 var Native = require('native');
-var fs = Native.require('fs');
+// Only stat() is needed here: the 'fs' module is not loaded for it.
+var fsBuiltin = process.binding(process.binding.fs);
 
 function iotjs_module_t(id, parent) {
   this.id = id;
@@ -160,7 +161,7 @@ iotjs_module_t.normalizePath = function(path) {
 
 iotjs_module_t.tryPath = function(path) {
   try {
-    var stats = fs.statSync(path);
+    var stats = fsBuiltin.stat(path);
     if (stats && !stats.isDirectory()) {
       return path;
     }
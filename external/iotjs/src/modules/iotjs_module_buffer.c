@@ -24,6 +24,58 @@
 IOTJS_DEFINE_NATIVE_HANDLE_INFO_THIS_MODULE(bufferwrap);
 
 
+struct iotjs_bufferstore_t {
+  char* data;
+  size_t refcount;
+  iotjs_bufferwrap_release_cb release;
+  void* hint;
+};
+
+
+// Allocates the store and the memory of a buffer at once.
+static iotjs_bufferstore_t* iotjs_bufferstore_create(size_t length) {
+  iotjs_bufferstore_t* store = (iotjs_bufferstore_t*)iotjs_buffer_allocate(
+      sizeof(iotjs_bufferstore_t) + length);
+  store->data = (char*)(store + 1);
+  store->refcount = 1;
+  store->release = NULL;
+  store->hint = NULL;
+  return store;
+}
+
+
+static iotjs_bufferstore_t* iotjs_bufferstore_create_external(
+    char* data, iotjs_bufferwrap_release_cb release, void* hint) {
+  iotjs_bufferstore_t* store = IOTJS_ALLOC(iotjs_bufferstore_t);
+  store->data = data;
+  store->refcount = 1;
+  store->release = release;
+  store->hint = hint;
+  return store;
+}
+
+
+static void iotjs_bufferstore_unref(iotjs_bufferstore_t* store) {
+  IOTJS_ASSERT(store->refcount > 0);
+  if (--store->refcount > 0) {
+    return;
+  }
+  if (store->release != NULL) {
+    store->release(store->data, store->hint);
+  }
+  IOTJS_RELEASE(store);
+}
+
+
+// Memory adopted by the next created buffer instead of allocating a new one.
+// Set while iotjs_bufferwrap_create_view() and
+// iotjs_bufferwrap_create_external() call the Buffer constructor.
+static struct {
+  iotjs_bufferstore_t* store;
+  char* buffer;
+} pending_memory;
+
+
 iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
                                             size_t length) {
   iotjs_bufferwrap_t* bufferwrap = IOTJS_ALLOC(iotjs_bufferwrap_t);
@@ -31,11 +83,17 @@ iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
 
   iotjs_jobjectwrap_initialize(&_this->jobjectwrap, jbuiltin,
                                &this_module_native_info);
-  if (length > 0) {
+  if (pending_memory.store != NULL) {
+    _this->store = pending_memory.store;
+    _this->length = length;
+    _this->buffer = pending_memory.buffer;
+    pending_memory.store = NULL;
+  } else if (length > 0) {
+    _this->store = iotjs_bufferstore_create(length);
     _this->length = length;
-    _this->buffer = iotjs_buffer_allocate(length);
-    IOTJS_ASSERT(_this->buffer != NULL);
+    _this->buffer = _this->store->data;
   } else {
+    _this->store = NULL;
     _this->length = 0;
     _this->buffer = NULL;
   }
@@ -50,8 +108,8 @@ iotjs_bufferwrap_t* iotjs_bufferwrap_create(const iotjs_jval_t* jbuiltin,
 
 static void iotjs_bufferwrap_destroy(iotjs_bufferwrap_t* bufferwrap) {
   IOTJS_VALIDATED_STRUCT_DESTRUCTOR(iotjs_bufferwrap_t, bufferwrap);
-  if (_this->buffer != NULL) {
-    iotjs_buffer_release(_this->buffer);
+  if (_this->store != NULL) {
+    iotjs_bufferstore_unref(_this->store);
   }
   iotjs_jobjectwrap_destroy(&_this->jobjectwrap);
   IOTJS_RELEASE(bufferwrap);
@@ -194,13 +252,15 @@ size_t iotjs_bufferwrap_copy_internal(iotjs_bufferwrap_t* bufferwrap,
                                       const char* src, size_t src_from,
                                       size_t src_to, size_t dst_from) {
   IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
-  size_t copied = 0;
-  size_t dst_length = _this->length;
-  for (size_t i = src_from, j = dst_from; i < src_to && j < dst_length;
-       ++i, ++j) {
-    *(_this->buffer + j) = *(src + i);
-    ++copied;
+  if (src_to <= src_from || dst_from >= _this->length) {
+    return 0;
   }
+  size_t copied = src_to - src_from;
+  if (copied > _this->length - dst_from) {
+    copied = _this->length - dst_from;
+  }
+  // Source and destination may be slices of the same memory.
+  memmove(_this->buffer + dst_from, src + src_from, copied);
   return copied;
 }
 
@@ -212,7 +272,8 @@ size_t iotjs_bufferwrap_copy(iotjs_bufferwrap_t* bufferwrap, const char* src,
 }
 
 
-iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len) {
+static iotjs_jval_t iotjs_bufferwrap_call_constructor(size_t len,
+                                                      bool* throws) {
   iotjs_jval_t* jglobal = iotjs_jval_get_global_object();
 
   iotjs_jval_t jbuffer =
@@ -223,8 +284,7 @@ iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len) {
   iotjs_jargs_append_number(&jargs, len);
 
   iotjs_jval_t jres =
-      iotjs_jhelper_call_ok(&jbuffer, iotjs_jval_get_undefined(), &jargs);
-  IOTJS_ASSERT(iotjs_jval_is_object(&jres));
+      iotjs_jhelper_call(&jbuffer, iotjs_jval_get_undefined(), &jargs, throws);
 
   iotjs_jargs_destroy(&jargs);
   iotjs_jval_destroy(&jbuffer);
@@ -233,6 +293,89 @@ iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len) {
 }
 
 
+iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len) {
+  bool throws;
+  iotjs_jval_t jres = iotjs_bufferwrap_call_constructor(len, &throws);
+  IOTJS_ASSERT(!throws);
+  IOTJS_ASSERT(iotjs_jval_is_object(&jres));
+
+  return jres;
+}
+
+
+// The Buffer constructor adopts the pending memory. If it fails before doing
+// so, the reference on `store` is dropped here and the exception returned.
+static iotjs_jval_t iotjs_bufferwrap_create_buffer_with(
+    iotjs_bufferstore_t* store, char* buffer, size_t len) {
+  IOTJS_ASSERT(pending_memory.store == NULL);
+  pending_memory.store = store;
+  pending_memory.buffer = buffer;
+
+  bool throws;
+  iotjs_jval_t jres = iotjs_bufferwrap_call_constructor(len, &throws);
+
+  if (pending_memory.store != NULL) {
+    pending_memory.store = NULL;
+    pending_memory.buffer = NULL;
+    iotjs_bufferstore_unref(store);
+  }
+
+  return jres;
+}
+
+
+iotjs_jval_t iotjs_bufferwrap_create_view(iotjs_bufferwrap_t* bufferwrap,
+                                          size_t offset, size_t len) {
+  IOTJS_VALIDATED_STRUCT_METHOD(iotjs_bufferwrap_t, bufferwrap);
+  IOTJS_ASSERT(offset <= _this->length && len <= _this->length - offset);
+
+  if (len == 0) {
+    return iotjs_bufferwrap_create_buffer(0);
+  }
+
+  _this->store->refcount++;
+  return iotjs_bufferwrap_create_buffer_with(_this->store,
+                                             _this->buffer + offset, len);
+}
+
+
+iotjs_jval_t iotjs_bufferwrap_create_external(
+    char* data, size_t len, iotjs_bufferwrap_release_cb release, void* hint) {
+  IOTJS_ASSERT(data != NULL && release != NULL);
+
+  iotjs_bufferstore_t* store =
+      iotjs_bufferstore_create_external(data, release, hint);
+  return iotjs_bufferwrap_create_buffer_with(store, data, len);
+}
+
+
+static void iotjs_bufferwrap_release_allocated(char* data, void* hint) {
+  IOTJS_UNUSED(hint);
+  iotjs_buffer_release(data);
+}
+
+
+iotjs_jval_t iotjs_bufferwrap_create_buffer_from(char* data, size_t len) {
+  if (len == 0) {
+    if (data != NULL) {
+      iotjs_buffer_release(data);
+    }
+    return iotjs_bufferwrap_create_buffer(0);
+  }
+
+  // Read buffers are allocated with the maximum read size: give the unused
+  // tail back to the heap since the buffer may be retained for a long time.
+  char* shrunk = iotjs_buffer_reallocate(data, len);
+  if (shrunk != NULL) {
+    data = shrunk;
+  }
+
+  return iotjs_bufferwrap_create_external(data, len,
+                                          iotjs_bufferwrap_release_allocated,
+                                          NULL);
+}
+
+
 JHANDLER_FUNCTION(Buffer) {
   DJHANDLER_CHECK_THIS(object);
   DJHANDLER_CHECK_ARGS(2, object, number);
@@ -419,12 +562,9 @@ JHANDLER_FUNCTION(Slice) {
 
   size_t length = (size_t)(end_idx - start_idx);
 
-  iotjs_jval_t jnew_buffer = iotjs_bufferwrap_create_buffer(length);
-  iotjs_bufferwrap_t* new_buffer_wrap =
-      iotjs_bufferwrap_from_jbuffer(&jnew_buffer);
-  iotjs_bufferwrap_copy_internal(new_buffer_wrap,
-                                 iotjs_bufferwrap_buffer(buffer_wrap),
-                                 start_idx, end_idx, 0);
+  // The new buffer shares the memory of this buffer.
+  iotjs_jval_t jnew_buffer =
+      iotjs_bufferwrap_create_view(buffer_wrap, start_idx, length);
 
   iotjs_jhandler_return_jval(jhandler, &jnew_buffer);
   iotjs_jval_destroy(&jnew_buffer);
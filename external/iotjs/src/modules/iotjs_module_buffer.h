@@ -20,8 +20,16 @@
 #include "iotjs_objectwrap.h"
 
 
+// Called when no buffer refers to the memory of an external buffer anymore.
+typedef void (*iotjs_bufferwrap_release_cb)(char* data, void* hint);
+
+// Reference counted memory shared by a buffer and its slices.
+typedef struct iotjs_bufferstore_t iotjs_bufferstore_t;
+
+
 typedef struct {
   iotjs_jobjectwrap_t jobjectwrap;
+  iotjs_bufferstore_t* store;
   char* buffer;
   size_t length;
 } IOTJS_VALIDATED_STRUCT(iotjs_bufferwrap_t);
@@ -49,5 +57,18 @@ size_t iotjs_bufferwrap_copy(iotjs_bufferwrap_t* bufferwrap, const char* src,
 // Create buffer object.
 iotjs_jval_t iotjs_bufferwrap_create_buffer(size_t len);
 
+// Create buffer object sharing `len` bytes from `offset` of another buffer.
+iotjs_jval_t iotjs_bufferwrap_create_view(iotjs_bufferwrap_t* bufferwrap,
+                                          size_t offset, size_t len);
+
+// Create buffer object over memory owned by the caller, e.g. a driver.
+// `release` is called once the buffer and all of its slices are collected.
+iotjs_jval_t iotjs_bufferwrap_create_external(
+    char* data, size_t len, iotjs_bufferwrap_release_cb release, void* hint);
+
+// Create buffer object taking the ownership of `data`, which must be
+// allocated by iotjs_buffer_allocate(). The memory is shrunk to `len` bytes.
+iotjs_jval_t iotjs_bufferwrap_create_buffer_from(char* data, size_t len);
+
 
 #endif /* IOTJS_MODULE_BUFFER_H */
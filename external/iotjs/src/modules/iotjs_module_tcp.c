@@ -501,16 +501,14 @@ void OnRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
       iotjs_make_callback(&jonread, iotjs_jval_get_undefined(), &jargs);
     }
   } else {
-    iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer((size_t)nread);
-    iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
-
-    iotjs_bufferwrap_copy(buffer_wrap, buf->base, (size_t)nread);
+    // The buffer takes over the read memory instead of copying it.
+    iotjs_jval_t jbuffer =
+        iotjs_bufferwrap_create_buffer_from(buf->base, (size_t)nread);
 
     iotjs_jargs_append_jval(&jargs, &jbuffer);
     iotjs_make_callback(&jonread, iotjs_jval_get_undefined(), &jargs);
 
     iotjs_jval_destroy(&jbuffer);
-    iotjs_buffer_release(buf->base);
   }
 
   iotjs_jargs_destroy(&jargs);
@@ -208,10 +208,9 @@ static void OnRecv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
     return;
   }
 
-  iotjs_jval_t jbuffer = iotjs_bufferwrap_create_buffer((size_t)nread);
-  iotjs_bufferwrap_t* buffer_wrap = iotjs_bufferwrap_from_jbuffer(&jbuffer);
-
-  iotjs_bufferwrap_copy(buffer_wrap, buf->base, (size_t)nread);
+  // The buffer takes over the received memory instead of copying it.
+  iotjs_jval_t jbuffer =
+      iotjs_bufferwrap_create_buffer_from(buf->base, (size_t)nread);
 
   iotjs_jargs_append_jval(&jargs, &jbuffer);
 
@@ -224,7 +223,6 @@ static void OnRecv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
   iotjs_jval_destroy(&rinfo);
   iotjs_jval_destroy(&jbuffer);
   iotjs_jval_destroy(&jonmessage);
-  iotjs_buffer_release(buf->base);
   iotjs_jargs_destroy(&jargs);
 }
 
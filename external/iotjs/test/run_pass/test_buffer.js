@@ -177,3 +177,28 @@ assert.equal(new Buffer(1).readUInt16LE({}, true), 0);
 
 var buff17 = new Buffer("a");
 assert.throws(function() { buff17.fill(8071).toString(); }, TypeError);
+
+// Slices share the memory of the original buffer.
+var buff18 = new Buffer('0123456789');
+var buff19 = buff18.slice(2, 8);
+var buff20 = buff19.slice(1, -1);
+assert.equal(buff20.toString(), '3456');
+buff20.writeUInt8(0x41, 0);
+assert.equal(buff18.toString(), '012A456789');
+assert.equal(buff19.toString(), '2A4567');
+buff18.write('xy', 4);
+assert.equal(buff20.toString(), 'Axy6');
+assert.equal(buff18.slice(5, 5).length, 0);
+
+// Copying between overlapping slices of the same memory.
+buff18.copy(buff18.slice(2), 0, 0, 6);
+assert.equal(buff18.toString(), '01012Axy89');
+
+// A slice keeps the memory alive after the original buffer is gone.
+var buff21 = (function() {
+  return new Buffer('collected').slice(3, 7);
+})();
+for (var i = 0; i < 100; ++i) {
+  new Buffer(256);
+}
+assert.equal(buff21.toString(), 'lect');
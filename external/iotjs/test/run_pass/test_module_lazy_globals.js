@@ -0,0 +1,44 @@
+/* Copyright 2017-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// 'console' and 'Buffer' are loaded on first use.
+var desc = Object.getOwnPropertyDescriptor(global, 'Buffer');
+var lazy = desc.get !== undefined;
+
+var assert = require('assert');
+
+assert.equal(Buffer, require('buffer'));
+assert.equal(console, require('console'));
+assert.equal(new Buffer('abc').toString(), 'abc');
+
+if (lazy) {
+  // The first access replaces the accessor with the module.
+  desc = Object.getOwnPropertyDescriptor(global, 'Buffer');
+  assert.equal(desc.value, require('buffer'));
+}
+assert.equal(desc.enumerable, true);
+assert.equal(desc.configurable, true);
+
+assert.notEqual(Object.keys(global).indexOf('console'), -1);
+
+// The globals can be overwritten before and after they are loaded.
+var myConsole = { log: function() {} };
+console = myConsole;
+assert.equal(global.console, myConsole);
+
+var myBuffer = function() {};
+global.Buffer = myBuffer;
+assert.equal(Buffer, myBuffer);
+assert.equal(typeof require('buffer').byteLength, 'function');
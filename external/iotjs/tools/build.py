@@ -182,6 +182,9 @@ def init_options():
     parser.add_argument('--jerry-memstat',
         action='store_true', default=False,
         help='Enable JerryScript heap statistics')
+    parser.add_argument('--jerry-gc-incremental',
+        action='store_true', default=False,
+        help='Enable incremental garbage collection of JerryScript')
 
     parser.add_argument('--jerry-profile',
         choices=['es5.1', 'es2015-subset'], default='es5.1',
@@ -368,6 +371,9 @@ def build_iotjs(options):
         '-DBUILD_LIB_ONLY=%s' % get_on_off(options.buildlib), # --build-lib
         # --jerry-memstat
         '-DFEATURE_MEM_STATS=%s' % get_on_off(options.jerry_memstat),
+        # --jerry-gc-incremental
+        '-DFEATURE_GC_INCREMENTAL=%s' %
+            get_on_off(options.jerry_gc_incremental),
         # --iotjs-include-module
         "-DIOTJS_INCLUDE_MODULE='%s'" % ','.join(options.iotjs_include_module),
         # --iotjs-exclude-module
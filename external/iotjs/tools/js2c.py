@@ -111,6 +111,11 @@ FOOTER1 = '''
 HEADER2 = '''#include <stdio.h>
 #include <stdint.h>
 #include "iotjs_js.h"
+
+/* Snapshots are executed in place, without copying their byte code into
+ * the JerryScript heap, and JerryScript reads their headers and literal
+ * tables as 32 bit words. */
+#define IOTJS_JS_MODULE_ALIGN __attribute__((aligned(4)))
 '''
 
 EMPTY_LINE = '\n'
@@ -128,7 +133,7 @@ MODULE_VARIABLES_C = '''
 #define SIZE_{NAME_UPPER} {SIZE}
 const size_t {NAME}_l = SIZE_{NAME_UPPER};
 const char {NAME}_n[] = "{NAME}";
-const uint8_t {NAME}_s[] = {{
+const uint8_t {NAME}_s[] IOTJS_JS_MODULE_ALIGN = {{
 {CODE}
 }};
 '''
@@ -37,30 +37,45 @@ def get_arguments():
     return script_args
 
 def run_iotjs(cmd):
-    pattern = re.compile(r'Peak allocated = (\d+) bytes')
+    patterns = [re.compile(r'Peak allocated = (\d+) bytes'),
+                re.compile(r'Max GC pause = (\d+) us'),
+                re.compile(r'Heap allocated after startup = (\d+) bytes'),
+                re.compile(r'Startup time = (\d+) us')]
 
     try:
         output = subprocess.check_output(cmd, stderr=subprocess.STDOUT)
     except subprocess.CalledProcessError as err:
-        return ""
+        return [""] * len(patterns)
 
-    match = pattern.search(str(output))
+    results = []
+    for pattern in patterns:
+        match = pattern.search(str(output))
+        results.append(match.group(1) if match else "")
 
-    if match:
-        return match.group(1)
-    else:
-        return ""
+    return results
 
 
-if __name__ == "__main__":
-    script_args = get_arguments()
-    print("**JS heap peak (bytes)**\n")
+def print_table(title, results):
+    print("**%s**\n" % title)
     print("| {0:^40} | {1:^10} | {2:^10} |".format("Test file", "base", "new"))
     print("| {0} | {1} | {2} |".format("-"*40, "-"*10, "-"*10))
 
+    for test_file, base_out, new_out in results:
+        if base_out or new_out:
+            print("| {0:40} | {1:^10} | {2:^10} |"
+                .format(test_file, base_out, new_out))
+    print("")
+
+
+if __name__ == "__main__":
+    script_args = get_arguments()
+    heap_results = []
+    pause_results = []
+    startup_heap_results = []
+    startup_time_results = []
+
     for test_file in os.listdir(path.RUN_PASS_DIR):
         if test_file.endswith(".js"):
-            line = "| " + test_file + " | "
             cmd = [script_args.base, '--memstat',
                 os.path.join(path.RUN_PASS_DIR, test_file)
             ]
@@ -71,6 +86,12 @@ if __name__ == "__main__":
             ]
             new_out = run_iotjs(cmd)
 
-            if base_out or new_out:
-                print("| {0:40} | {1:^10} | {2:^10} |"
-                    .format(test_file, base_out, new_out))
+            heap_results.append((test_file, base_out[0], new_out[0]))
+            pause_results.append((test_file, base_out[1], new_out[1]))
+            startup_heap_results.append((test_file, base_out[2], new_out[2]))
+            startup_time_results.append((test_file, base_out[3], new_out[3]))
+
+    print_table("JS heap peak (bytes)", heap_results)
+    print_table("Longest GC pause (us)", pause_results)
+    print_table("JS heap after startup (bytes)", startup_heap_results)
+    print_table("Startup time (us)", startup_time_results)
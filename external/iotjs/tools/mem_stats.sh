@@ -37,7 +37,8 @@ then
   echo "different builds and a suite of JavaScript programs. Each benchmark"
   echo "script is executed by both builds: the \"memstats\" build reports"
   echo "statistics retrieved from JerryScript, while the \"normal\" build"
-  echo "reports RSS results."
+  echo "reports RSS results. The longest garbage collector pause measured by"
+  echo "the \"memstats\" build is reported as well."
   exit 1
 fi
 
@@ -46,12 +47,12 @@ if [ "$1" == "-d" ]
 then
   TABLE="no"
   PRINT_TEST_NAME_AWK_SCRIPT='{printf "%s;", $1}'
-  PRINT_TOTAL_AWK_SCRIPT='{printf "%d;%d\n", $1, $2 * 1024}'
+  PRINT_TOTAL_AWK_SCRIPT='{printf "%d;%d;%d\n", $1, $2 * 1024, $3}'
 
   shift
 else
   PRINT_TEST_NAME_AWK_SCRIPT='{printf "%30s", $1}'
-  PRINT_TOTAL_AWK_SCRIPT='{printf "%25d%25d\n", $1, $2 * 1024}'
+  PRINT_TOTAL_AWK_SCRIPT='{printf "%25d%25d%25d\n", $1, $2 * 1024, $3}'
   TABLE="yes"
 fi
 
@@ -99,8 +100,8 @@ done
 # Running
 if [ "$TABLE" == "yes" ]
 then
-  awk 'BEGIN {printf "%30s%25s%25s\n", "Test name", "Peak Heap (jerry)", \
-    "Maximum RSS"}'
+  awk 'BEGIN {printf "%30s%25s%25s%25s\n", "Test name", "Peak Heap (jerry)", \
+    "Maximum RSS", "Max GC pause (us)"}'
   echo
 fi
 
@@ -114,11 +115,14 @@ do
   cd `dirname $bench_canon`
 
   echo "$bench_name" | awk "$PRINT_TEST_NAME_AWK_SCRIPT"
-  MEM_STATS=$("$IOTJS_MEM_STATS" --memstat $bench_canon | \
+  MEM_STATS_OUTPUT=$("$IOTJS_MEM_STATS" --memstat $bench_canon)
+  MEM_STATS=$(echo "$MEM_STATS_OUTPUT" | \
     grep -e "Peak allocated =" | grep -o "[0-9]*")
+  GC_PAUSE=$(echo "$MEM_STATS_OUTPUT" | \
+    grep -e "Max GC pause =" | grep -o "[0-9]*")
   RSS=$($STARTDIR/deps/jerry/tools/rss-measure.sh "$IOTJS" $bench_canon | \
     tail -n 1 | grep -o "[0-9]*")
-  echo $MEM_STATS $RSS | xargs | awk "$PRINT_TOTAL_AWK_SCRIPT"
+  echo $MEM_STATS $RSS ${GC_PAUSE:-0} | xargs | awk "$PRINT_TOTAL_AWK_SCRIPT"
 
   cd $STARTDIR
 done
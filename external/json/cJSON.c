@@ -115,9 +115,156 @@ typedef struct internal_hooks
     void *(*allocate)(size_t size);
     void (*deallocate)(void *pointer);
     void *(*reallocate)(void *pointer, size_t size);
+    cJSON_Arena *arena; /* if set, allocations are served from this arena */
 } internal_hooks;
 
-static internal_hooks global_hooks = { malloc, free, realloc };
+static internal_hooks global_hooks = { malloc, free, realloc, NULL };
+
+/* Arena allocator. Blocks are chained newest first, each new block being twice
+ * the size of the previous one so that a document needs only a few of them. */
+#ifndef CONFIG_NETUTILS_JSON_ARENA_BLOCKSIZE
+#define CONFIG_NETUTILS_JSON_ARENA_BLOCKSIZE 2048
+#endif
+
+#define ARENA_ALIGN 8
+#define arena_align(size) (((size) + (ARENA_ALIGN - 1)) & ~((size_t)ARENA_ALIGN - 1))
+
+typedef struct arena_block
+{
+    struct arena_block *next;
+    size_t size; /* usable bytes after the header */
+} arena_block;
+
+#define ARENA_BLOCK_HEADER arena_align(sizeof(arena_block))
+
+struct cJSON_Arena
+{
+    arena_block *blocks; /* current block first */
+    size_t used;         /* bytes used in the current block */
+    size_t next_size;    /* usable size of the next block to allocate */
+};
+
+static arena_block *arena_add_block(cJSON_Arena * const arena, size_t size)
+{
+    arena_block *block = NULL;
+
+    if (size < arena->next_size)
+    {
+        size = arena->next_size;
+    }
+
+    block = (arena_block*)global_hooks.allocate(ARENA_BLOCK_HEADER + size);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    block->size = size;
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->used = 0;
+    arena->next_size = size * 2;
+
+    return block;
+}
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    void *pointer = NULL;
+
+    size = arena_align(size);
+    if ((arena->blocks == NULL) || (size > (arena->blocks->size - arena->used)))
+    {
+        if (arena_add_block(arena, size) == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    pointer = (unsigned char*)arena->blocks + ARENA_BLOCK_HEADER + arena->used;
+    arena->used += size;
+
+    return pointer;
+}
+
+static void *hooks_allocate(const internal_hooks * const hooks, size_t size)
+{
+    if (hooks->arena != NULL)
+    {
+        return arena_allocate(hooks->arena, size);
+    }
+
+    return hooks->allocate(size);
+}
+
+static void hooks_deallocate(const internal_hooks * const hooks, void *pointer)
+{
+    /* arena memory is only released together with the arena */
+    if (hooks->arena == NULL)
+    {
+        hooks->deallocate(pointer);
+    }
+}
+
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size)
+{
+    cJSON_Arena *arena = (cJSON_Arena*)global_hooks.allocate(sizeof(cJSON_Arena));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    arena->blocks = NULL;
+    arena->used = 0;
+    arena->next_size = arena_align((block_size != 0) ? block_size : CONFIG_NETUTILS_JSON_ARENA_BLOCKSIZE);
+
+    /* allocate the first block up front, parsing then only grows the arena for big documents */
+    if (arena_add_block(arena, arena->next_size) == NULL)
+    {
+        global_hooks.deallocate(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    arena_block *block = NULL;
+
+    if ((arena == NULL) || (arena->blocks == NULL))
+    {
+        return;
+    }
+
+    /* the current block is the largest one, keep it for the next document */
+    block = arena->blocks->next;
+    while (block != NULL)
+    {
+        arena_block *next = block->next;
+        global_hooks.deallocate(block);
+        block = next;
+    }
+
+    arena->blocks->next = NULL;
+    arena->used = 0;
+    arena->next_size = arena->blocks->size * 2;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    cJSON_ResetArena(arena);
+    if (arena->blocks != NULL)
+    {
+        global_hooks.deallocate(arena->blocks);
+    }
+    global_hooks.deallocate(arena);
+}
 
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
@@ -130,7 +277,7 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
     }
 
     length = strlen((const char*)string) + sizeof("");
-    if (!(copy = (unsigned char*)hooks->allocate(length)))
+    if (!(copy = (unsigned char*)hooks_allocate(hooks, length)))
     {
         return NULL;
     }
@@ -173,15 +320,259 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
 /* Internal constructor. */
 static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
+    cJSON* node = (cJSON*)hooks_allocate(hooks, sizeof(cJSON));
     if (node)
     {
         memset(node, '\0', sizeof(cJSON));
+        if (hooks->arena != NULL)
+        {
+            node->type = cJSON_IsArena;
+        }
     }
 
     return node;
 }
 
+/* Flags that survive the parser assigning the value type of an item */
+#define parse_flags(item) ((item)->type & (cJSON_IsArena | cJSON_StringIsConst))
+
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+#ifndef CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD
+#define CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+/* Chained hash over the names of an object's children. Each chain keeps the
+ * list order, so a lookup returns the same (first) match as the linear search.
+ * The hash folds case, which serves both the case sensitive and insensitive getters. */
+struct cJSON_Index
+{
+    cJSON_Arena *arena; /* owner of the tables, NULL for the global heap */
+    size_t capacity;    /* number of buckets and slots, 0 while not built */
+    size_t count;       /* number of slots in use */
+    int *heads;         /* first slot of each bucket, -1 if empty */
+    int *next;          /* next slot in the same bucket, -1 at the end */
+    cJSON **items;
+};
+
+static size_t index_hash(const unsigned char *string)
+{
+    unsigned long hash = 2166136261UL;
+
+    while (*string != '\0')
+    {
+        hash = (hash ^ (unsigned long)tolower(*string)) * 16777619UL;
+        string++;
+    }
+
+    return (size_t)hash;
+}
+
+static struct cJSON_Index *create_index(cJSON_Arena * const arena)
+{
+    struct cJSON_Index *index = NULL;
+
+    if (arena != NULL)
+    {
+        index = (struct cJSON_Index*)arena_allocate(arena, sizeof(struct cJSON_Index));
+    }
+    else
+    {
+        index = (struct cJSON_Index*)global_hooks.allocate(sizeof(struct cJSON_Index));
+    }
+    if (index != NULL)
+    {
+        memset(index, '\0', sizeof(struct cJSON_Index));
+        index->arena = arena;
+    }
+
+    return index;
+}
+
+/* Forget the index content after the children of object were changed. Arena
+ * indexes keep their header and give the tables back with the arena. */
+static void invalidate_index(cJSON * const object)
+{
+    struct cJSON_Index *index = object->index;
+
+    if (index == NULL)
+    {
+        return;
+    }
+
+    if (index->arena != NULL)
+    {
+        index->capacity = 0;
+        index->count = 0;
+        return;
+    }
+
+    if (index->items != NULL)
+    {
+        global_hooks.deallocate(index->items); /* start of the tables */
+    }
+    global_hooks.deallocate(index);
+    object->index = NULL;
+}
+
+static void drop_index(cJSON * const item)
+{
+    invalidate_index(item);
+    item->index = NULL;
+}
+
+static void index_link(struct cJSON_Index * const index, int slot)
+{
+    const cJSON *item = index->items[slot];
+    int *link = &index->heads[index_hash((const unsigned char*)item->string) & (index->capacity - 1)];
+
+    /* append to the chain to keep list order */
+    while (*link >= 0)
+    {
+        link = &index->next[*link];
+    }
+    index->next[slot] = -1;
+    *link = slot;
+}
+
+static cJSON_bool build_index(cJSON * const object)
+{
+    struct cJSON_Index *index = object->index;
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t capacity = 1;
+    size_t size = 0;
+    size_t i = 0;
+    unsigned char *table = NULL;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+    while (capacity < count)
+    {
+        capacity <<= 1;
+    }
+
+    if (index == NULL)
+    {
+        index = object->index = create_index(NULL);
+        if (index == NULL)
+        {
+            return false;
+        }
+    }
+
+    size = capacity * (2 * sizeof(int) + sizeof(cJSON*));
+    if (index->arena != NULL)
+    {
+        table = (unsigned char*)arena_allocate(index->arena, size);
+    }
+    else
+    {
+        table = (unsigned char*)global_hooks.allocate(size);
+    }
+    if (table == NULL)
+    {
+        invalidate_index(object);
+        return false;
+    }
+
+    /* pointers first to keep them aligned */
+    index->items = (cJSON**)table;
+    index->heads = (int*)(table + capacity * sizeof(cJSON*));
+    index->next = index->heads + capacity;
+    index->capacity = capacity;
+    index->count = 0;
+    for (i = 0; i < capacity; i++)
+    {
+        index->heads[i] = -1;
+    }
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        if (child->string == NULL)
+        {
+            continue; /* unnamed children can never be found by name */
+        }
+        index->items[index->count] = child;
+        index_link(index, (int)index->count);
+        index->count++;
+    }
+
+    return true;
+}
+
+/* Keep the index in sync with an item appended to object */
+static void index_append(cJSON * const object, cJSON * const item)
+{
+    struct cJSON_Index *index = object->index;
+
+    if ((index == NULL) || (index->capacity == 0) || (item->string == NULL))
+    {
+        return;
+    }
+
+    if (index->count == index->capacity)
+    {
+        /* full, rebuild with a bigger table on the next lookup */
+        invalidate_index(object);
+        return;
+    }
+
+    index->items[index->count] = item;
+    index_link(index, (int)index->count);
+    index->count++;
+}
+
+/* Returns true if the lookup in object can go through its index */
+static cJSON_bool use_index(cJSON * const object)
+{
+    const cJSON *child = NULL;
+    size_t count = 0;
+
+    if (object->type & cJSON_IsReference)
+    {
+        return false; /* the children belong to another item, which may change them */
+    }
+    if ((object->index != NULL) && (object->index->capacity != 0))
+    {
+        return true;
+    }
+    if ((object->index == NULL) && (object->type & cJSON_IsArena))
+    {
+        return false; /* small when parsed, the parser only prepares an index for big arena objects */
+    }
+
+    for (child = object->child; (child != NULL) && (count < CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD); child = child->next)
+    {
+        count++;
+    }
+    if (count < CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD)
+    {
+        return false;
+    }
+
+    return build_index(object);
+}
+
+static cJSON *index_lookup(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    int slot = index->heads[index_hash((const unsigned char*)name) & (index->capacity - 1)];
+
+    while (slot >= 0)
+    {
+        cJSON *item = index->items[slot];
+        if (case_sensitive ? (strcmp(name, item->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)item->string) == 0))
+        {
+            return item;
+        }
+        slot = index->next[slot];
+    }
+
+    return NULL;
+}
+#endif /* CONFIG_NETUTILS_JSON_OBJECT_INDEX */
+
 /* Delete a cJSON structure. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
@@ -193,7 +584,10 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             cJSON_Delete(item->child);
         }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+        drop_index(item);
+#endif
+        if (!(item->type & (cJSON_IsReference | cJSON_IsArena)) && (item->valuestring != NULL))
         {
             global_hooks.deallocate(item->valuestring);
         }
@@ -201,7 +595,10 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             global_hooks.deallocate(item->string);
         }
-        global_hooks.deallocate(item);
+        if (!(item->type & cJSON_IsArena))
+        {
+            global_hooks.deallocate(item);
+        }
         item = next;
     }
 }
@@ -296,7 +693,7 @@ loop_end:
         item->valueint = (int)number;
     }
 
-    item->type = cJSON_Number;
+    item->type = parse_flags(item) | cJSON_Number;
 
     input_buffer->offset += (size_t)(after_end - number_c_string);
     return true;
@@ -697,7 +1094,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
 
         /* This is at most how much we need for the output */
         allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        output = (unsigned char*)hooks_allocate(&input_buffer->hooks, allocation_length + sizeof(""));
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -764,7 +1161,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     /* zero terminate the output */
     *output_pointer = '\0';
 
-    item->type = cJSON_String;
+    item->type = parse_flags(item) | cJSON_String;
     item->valuestring = (char*)output;
 
     input_buffer->offset = (size_t) (input_end - input_buffer->content);
@@ -775,7 +1172,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
 fail:
     if (output != NULL)
     {
-        input_buffer->hooks.deallocate(output);
+        hooks_deallocate(&input_buffer->hooks, output);
     }
 
     if (input_pointer != NULL)
@@ -944,9 +1341,9 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
 }
 
 /* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+static cJSON *parse_with_hooks(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated, const internal_hooks * const hooks)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 } };
     cJSON *item = NULL;
 
     /* reset error position */
@@ -961,9 +1358,9 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
     buffer.content = (const unsigned char*)value;
     buffer.length = strlen((const char*)value) + sizeof("");
     buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    buffer.hooks = *hooks;
 
-    item = cJSON_New_Item(&global_hooks);
+    item = cJSON_New_Item(hooks);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -1025,12 +1422,35 @@ fail:
     return NULL;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_hooks(value, return_parse_end, require_null_terminated, &global_hooks);
+}
+
 /* Default options for cJSON_Parse */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
 {
     return cJSON_ParseWithOpts(value, 0, 0);
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArenaWithOpts(cJSON_Arena *arena, const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    internal_hooks hooks = global_hooks;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    hooks.arena = arena;
+    return parse_with_hooks(value, return_parse_end, require_null_terminated, &hooks);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(cJSON_Arena *arena, const char *value)
+{
+    return cJSON_ParseInArenaWithOpts(arena, value, 0, 0);
+}
+
 #define cjson_min(a, b) ((a < b) ? a : b)
 
 static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
@@ -1108,7 +1528,7 @@ CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
 
 CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 } };
 
     if (prebuffer < 0)
     {
@@ -1138,7 +1558,7 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buf, const int len, const cJSON_bool fmt)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 } };
 
     if ((len < 0) || (buf == NULL))
     {
@@ -1167,21 +1587,21 @@ static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buf
     /* null */
     if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
     {
-        item->type = cJSON_NULL;
+        item->type = parse_flags(item) | cJSON_NULL;
         input_buffer->offset += 4;
         return true;
     }
     /* false */
     if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
     {
-        item->type = cJSON_False;
+        item->type = parse_flags(item) | cJSON_False;
         input_buffer->offset += 5;
         return true;
     }
     /* true */
     if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
     {
-        item->type = cJSON_True;
+        item->type = parse_flags(item) | cJSON_True;
         item->valueint = 1;
         input_buffer->offset += 4;
         return true;
@@ -1367,7 +1787,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
 success:
     input_buffer->depth--;
 
-    item->type = cJSON_Array;
+    item->type = parse_flags(item) | cJSON_Array;
     item->child = head;
 
     input_buffer->offset++;
@@ -1450,6 +1870,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+    size_t count = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1514,6 +1935,12 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* swap valuestring and string, because we parsed the name */
         current_item->string = current_item->valuestring;
         current_item->valuestring = NULL;
+        if (input_buffer->hooks.arena != NULL)
+        {
+            /* the name belongs to the arena, cJSON_Delete must not free it */
+            current_item->type |= cJSON_StringIsConst;
+        }
+        count++;
 
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
@@ -1536,10 +1963,18 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         goto fail; /* expected end of object */
     }
 
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    /* arena objects cannot allocate an index later on, reserve its header now and build it on first lookup */
+    if ((input_buffer->hooks.arena != NULL) && (count >= CONFIG_NETUTILS_JSON_OBJECT_INDEX_THRESHOLD))
+    {
+        item->index = create_index(input_buffer->hooks.arena);
+    }
+#endif
+
 success:
     input_buffer->depth--;
 
-    item->type = cJSON_Object;
+    item->type = parse_flags(item) | cJSON_Object;
     item->child = head;
 
     input_buffer->offset++;
@@ -1730,6 +2165,13 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         return NULL;
     }
 
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    if (use_index((cJSON*)object))
+    {
+        return index_lookup(object->index, name, case_sensitive);
+    }
+#endif
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -1788,6 +2230,11 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    reference->index = NULL;
+#endif
+    /* the reference node itself is always heap allocated */
+    reference->type &= ~(cJSON_IsArena | cJSON_StringIsConst);
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -1819,6 +2266,10 @@ CJSON_PUBLIC(void) cJSON_AddItemToArray(cJSON *array, cJSON *item)
         }
         suffix_object(child, item);
     }
+
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    index_append(array, item);
+#endif
 }
 
 CJSON_PUBLIC(void) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item)
@@ -1887,6 +2338,10 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    invalidate_index(parent);
+#endif
+
     if (item->prev != NULL)
     {
         /* not the first element */
@@ -1966,6 +2421,10 @@ CJSON_PUBLIC(void) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newit
         return;
     }
 
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    invalidate_index(array);
+#endif
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -1991,6 +2450,10 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+#ifdef CONFIG_NETUTILS_JSON_OBJECT_INDEX
+    invalidate_index(parent);
+#endif
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2345,7 +2808,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = item->type & (~(cJSON_IsReference | cJSON_IsArena));
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring)
@@ -2358,7 +2821,16 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     }
     if (item->string)
     {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        /* arena names are flagged const, but must not outlive the arena */
+        if ((item->type & (cJSON_StringIsConst | cJSON_IsArena)) == cJSON_StringIsConst)
+        {
+            newitem->string = item->string;
+        }
+        else
+        {
+            newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+            newitem->type &= ~cJSON_StringIsConst;
+        }
         if (!newitem->string)
         {
             goto fail;
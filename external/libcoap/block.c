@@ -29,7 +29,10 @@
 #include <assert.h>
 #endif
 
+#include <string.h>
+
 #include <protocols/libcoap/debug.h>
+#include <protocols/libcoap/mem.h>
 #include <protocols/libcoap/block.h>
 
 #define min(a,b) ((a) < (b) ? (a) : (b))
@@ -153,4 +156,132 @@ int coap_add_block(coap_pdu_t *pdu, unsigned int len, const unsigned char *data,
 
 	return coap_add_data(pdu, min(len - start, (unsigned int)(1 << (block_szx + 4))), data + start);
 }
+
+int coap_add_block_stream(coap_pdu_t *pdu, size_t len, coap_block_read_t read, void *arg, unsigned int block_num, unsigned char block_szx)
+{
+	size_t start, want;
+	ssize_t got;
+
+	assert(pdu);
+	assert(pdu->data == NULL);
+
+	start = (size_t)block_num << (block_szx + 4);
+	if (len <= start) {
+		return 0;
+	}
+
+	want = min(len - start, (size_t)1 << (block_szx + 4));
+	if (pdu->length + want + 1 > pdu->max_size) {
+		warn("coap_add_block_stream: cannot add: block too large for PDU\n");
+		return 0;
+	}
+
+	/* let the reader write into the payload of pdu without an intermediate copy */
+	pdu->data = (unsigned char *)pdu->transport_hdr + pdu->length;
+	*pdu->data = COAP_PAYLOAD_START;
+	pdu->data++;
+
+	got = read(arg, start, pdu->data, want);
+	if (got < 0 || (size_t)got > want) {
+		debug("coap_add_block_stream: cannot read block %u\n", block_num);
+		pdu->data = NULL;
+		return 0;
+	}
+
+	/* a payload marker followed by no payload is a format error (RFC 7252 3) */
+	if (got == 0) {
+		pdu->data = NULL;
+		return 1;
+	}
+
+	pdu->length += got + 1;
+	return 1;
+}
+
+void coap_block_cache_init(coap_block_cache_t *cache, coap_block_render_t render, void *arg)
+{
+	assert(cache);
+
+	memset(cache, 0, sizeof(coap_block_cache_t));
+	cache->render = render;
+	cache->arg = arg;
+}
+
+int coap_block_cache_update(coap_block_cache_t *cache)
+{
+	unsigned char *data = NULL;
+	size_t length = 0;
+	coap_tick_t now;
+
+	assert(cache);
+
+	coap_ticks(&now);
+	if (cache->data && (COAP_BLOCK_CACHE_LIFETIME == 0 || now - cache->rendered < COAP_BLOCK_CACHE_LIFETIME * COAP_TICKS_PER_SECOND)) {
+		return 1;
+	}
+
+	if (!cache->render(cache->arg, &data, &length)) {
+		debug("coap_block_cache_update: cannot render representation\n");
+		return 0;
+	}
+
+	coap_block_cache_invalidate(cache);
+	cache->data = data;
+	cache->length = length;
+	cache->rendered = now;
+	memset(cache->etag, 0, sizeof(coap_key_t));
+	coap_hash_impl(data, length, cache->etag);
+
+	return 1;
+}
+
+void coap_block_cache_invalidate(coap_block_cache_t *cache)
+{
+	assert(cache);
+
+	if (cache->data) {
+		coap_free(cache->data);
+	}
+	cache->data = NULL;
+	cache->length = 0;
+}
+
+int coap_block_cache_etag_match(coap_block_cache_t *cache, coap_pdu_t *request, coap_transport_t transport)
+{
+	coap_opt_iterator_t opt_iter;
+	coap_opt_filter_t filter;
+	coap_opt_t *option;
+
+	assert(cache);
+
+	if (!cache->data) {
+		return 0;
+	}
+
+	coap_option_filter_clear(filter);
+	coap_option_setb(filter, COAP_OPTION_ETAG);
+	coap_option_iterator_init2(request, &opt_iter, filter, transport);
+
+	while ((option = coap_option_next(&opt_iter))) {
+		if (COAP_OPT_LENGTH(option) == sizeof(coap_key_t) && memcmp(COAP_OPT_VALUE(option), cache->etag, sizeof(coap_key_t)) == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+ssize_t coap_block_cache_read(void *arg, size_t offset, unsigned char *buf, size_t len)
+{
+	coap_block_cache_t *cache = (coap_block_cache_t *)arg;
+
+	if (!cache->data || offset > cache->length) {
+		return -1;
+	}
+
+	len = min(len, cache->length - offset);
+	memcpy(buf, cache->data + offset, len);
+
+	return len;
+}
 #endif							/* WITHOUT_BLOCK  */
@@ -58,6 +58,68 @@ void coap_pdu_resources_init()
 #include <protocols/libcoap/mem.h>
 #endif							/* WITH_CONTIKI */
 
+#if defined(WITH_POSIX) && COAP_PDU_POOL_SIZE > 0
+#include <pthread.h>
+
+/* Every request and response needs a PDU, most of them of COAP_MAX_PDU_SIZE.
+ * They are taken from a small static pool so that a busy server does not
+ * allocate and free from the heap for each message. Larger PDUs, and PDUs
+ * requested while all slots are in use, fall back to coap_malloc(). The pool
+ * is shared by all contexts, which may run in different threads. */
+typedef union coap_pdu_slot_t {
+	union coap_pdu_slot_t *next;
+	coap_pdu_t pdu;
+	unsigned char storage[sizeof(coap_pdu_t) + COAP_MAX_PDU_SIZE];
+} coap_pdu_slot_t;
+
+static coap_pdu_slot_t pdu_pool[COAP_PDU_POOL_SIZE];
+static coap_pdu_slot_t *pdu_pool_free;
+static int pdu_pool_initialized;
+static pthread_mutex_t pdu_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static coap_pdu_t *coap_pdu_pool_alloc(size_t size)
+{
+	coap_pdu_slot_t *slot;
+	int i;
+
+	if (size > COAP_MAX_PDU_SIZE) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&pdu_pool_lock);
+	if (!pdu_pool_initialized) {
+		for (i = 0; i < COAP_PDU_POOL_SIZE; i++) {
+			pdu_pool[i].next = pdu_pool_free;
+			pdu_pool_free = &pdu_pool[i];
+		}
+		pdu_pool_initialized = 1;
+	}
+	slot = pdu_pool_free;
+	if (slot) {
+		pdu_pool_free = slot->next;
+	}
+	pthread_mutex_unlock(&pdu_pool_lock);
+
+	return slot ? &slot->pdu : NULL;
+}
+
+static int coap_pdu_pool_free(coap_pdu_t *pdu)
+{
+	coap_pdu_slot_t *slot = (coap_pdu_slot_t *)pdu;
+
+	if (slot < &pdu_pool[0] || slot >= &pdu_pool[COAP_PDU_POOL_SIZE]) {
+		return 0;
+	}
+
+	pthread_mutex_lock(&pdu_pool_lock);
+	slot->next = pdu_pool_free;
+	pdu_pool_free = slot;
+	pthread_mutex_unlock(&pdu_pool_lock);
+
+	return 1;
+}
+#endif							/* WITH_POSIX && COAP_PDU_POOL_SIZE > 0 */
+
 void coap_pdu_clear(coap_pdu_t *pdu, size_t size)
 {
 	coap_pdu_clear2(pdu, size, COAP_UDP, 0);
@@ -159,7 +221,11 @@ coap_pdu_t *coap_pdu_init2(unsigned char type, unsigned char code, unsigned shor
 
 	/* size must be large enough for hdr */
 #ifdef WITH_POSIX
-	pdu = (coap_pdu_t *) coap_malloc(sizeof(coap_pdu_t) + size);
+#if COAP_PDU_POOL_SIZE > 0
+	pdu = coap_pdu_pool_alloc(size);
+	if (!pdu)
+#endif
+		pdu = (coap_pdu_t *) coap_malloc(sizeof(coap_pdu_t) + size);
 #endif
 #ifdef WITH_CONTIKI
 	pdu = (coap_pdu_t *) memb_alloc(&pdu_storage);
@@ -267,6 +333,11 @@ coap_pdu_t *coap_new_pdu2(coap_transport_t transport, unsigned int size)
 void coap_delete_pdu(coap_pdu_t *pdu)
 {
 #ifdef WITH_POSIX
+#if COAP_PDU_POOL_SIZE > 0
+	if (coap_pdu_pool_free(pdu)) {
+		return;
+	}
+#endif
 	coap_free(pdu);
 #endif
 #ifdef WITH_LWIP
@@ -36,20 +36,41 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <uv.h>
 
 //-----------------------------------------------------------------------------
 #define MAX_THREADPOOL_SIZE 4
 
+/*
+ * Each worker owns a queue per lane. Requests are spread over the queues
+ * round robin, a worker runs the requests of its own queues first and steals
+ * from the other workers when they are empty. CPU requests always go before
+ * slow I/O requests, and at most _slow_io_limit workers run slow I/O at the
+ * same time, so a long flash write does not delay a DNS lookup.
+ */
+struct uv__worker_s {
+	uv_thread_t thread;
+	uv_mutex_t mutex;			/* protects wq and stats */
+	QUEUE wq[UV__WORK_KINDS];
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+	uv_threadpool_stats_t stats[UV__WORK_KINDS];
+#endif
+};
+
 static uv_once_t _once = UV_ONCE_INIT;
 static uv_cond_t _cond;
-static uv_mutex_t _mutex;
+static uv_mutex_t _mutex;		/* protects the fields below */
+static unsigned int _generation;	/* changes when there may be new work */
+static unsigned int _idle;
+static unsigned int _next;
+static unsigned int _slow_io_running;
+static unsigned int _slow_io_limit;
+static int _exiting;
 static unsigned int _nthreads;
-static uv_thread_t *_threads;
-static uv_thread_t _default_threads[2];
-static QUEUE _exit_message;
-static QUEUE _wq;
+static struct uv__worker_s *_workers;
+static struct uv__worker_s _default_workers[2];
 static volatile int _initialized = 0;
 
 //-----------------------------------------------------------------------------
@@ -60,40 +81,141 @@ static void uv__cancelled(struct uv__work *w)
 	ABORT();
 }
 
-/* To avoid deadlock with uv_cancel() it's crucial that the worker
- * never holds the global _mutex and the loop-local mutex at the same time.
- */
-static void worker(void *arg)
+/* Must be called with _mutex held. */
+static void wakeup(void)
+{
+	_generation++;
+	if (_idle > 0) {
+		uv_cond_signal(&_cond);
+	}
+}
+
+static int slow_io_acquire(void)
+{
+	int acquired;
+
+	uv_mutex_lock(&_mutex);
+	acquired = _slow_io_running < _slow_io_limit;
+	if (acquired) {
+		_slow_io_running++;
+	}
+	uv_mutex_unlock(&_mutex);
+
+	return acquired;
+}
+
+static void slow_io_release(void)
+{
+	uv_mutex_lock(&_mutex);
+	_slow_io_running--;
+	/* A worker may be waiting for a free slow I/O slot. */
+	wakeup();
+	uv_mutex_unlock(&_mutex);
+}
+
+static struct uv__work *pop(struct uv__worker_s *victim, struct uv__worker_s *self, unsigned int kind)
 {
 	struct uv__work *w;
 	QUEUE *q;
 
-	(void)arg;
+	uv_mutex_lock(&victim->mutex);
 
-	for (;;) {
-		uv_mutex_lock(&_mutex);
+	if (QUEUE_EMPTY(&victim->wq[kind])) {
+		uv_mutex_unlock(&victim->mutex);
+		return NULL;
+	}
+
+	q = QUEUE_HEAD(&victim->wq[kind]);
+	QUEUE_REMOVE(q);
+	QUEUE_INIT(q);				/* Signal uv_cancel() that the work req is
+								   executing. */
+	w = QUEUE_DATA(q, struct uv__work, wq);
 
-		while (QUEUE_EMPTY(&_wq)) {
-			uv_cond_wait(&_cond, &_mutex);
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+	{
+		uv_threadpool_stats_t *stats = &victim->stats[kind];
+		uint64_t wait = uv__hrtime() - w->queued_time;
+
+		stats->started++;
+		if (victim != self) {
+			stats->stolen++;
+		}
+		stats->pending--;
+		stats->wait_total += wait;
+		if (wait > stats->wait_max) {
+			stats->wait_max = wait;
 		}
+	}
+#else
+	(void)self;
+#endif
 
-		q = QUEUE_HEAD(&_wq);
+	uv_mutex_unlock(&victim->mutex);
 
-		if (q == &_exit_message) {
-			uv_cond_signal(&_cond);
-		} else {
-			QUEUE_REMOVE(q);
-			QUEUE_INIT(q);		/* Signal uv_cancel() that the work req is
-								   executing. */
+	return w;
+}
+
+/* Take the oldest request of a lane, stealing from the other workers. */
+static struct uv__work *take(struct uv__worker_s *self, unsigned int kind)
+{
+	struct uv__worker_s *victim = self;
+	struct uv__work *w;
+	unsigned int i;
+
+	for (i = 0; i < _nthreads; i++) {
+		w = pop(victim, self, kind);
+		if (w != NULL) {
+			return w;
+		}
+
+		if (++victim == _workers + _nthreads) {
+			victim = _workers;
 		}
+	}
+
+	return NULL;
+}
+
+/* To avoid deadlock with uv_cancel() it's crucial that the worker
+ * never holds a queue mutex and the loop-local mutex at the same time.
+ */
+static void worker(void *arg)
+{
+	struct uv__worker_s *self = (struct uv__worker_s *)arg;
+	struct uv__work *w;
+	unsigned int seen = 0;
+	unsigned int kind;
 
-		uv_mutex_unlock(&_mutex);
+	for (;;) {
+		kind = UV__WORK_CPU;
+		w = take(self, kind);
+
+		if (w == NULL && slow_io_acquire()) {
+			kind = UV__WORK_SLOW_IO;
+			w = take(self, kind);
+			if (w == NULL) {
+				slow_io_release();
+			}
+		}
 
-		if (q == &_exit_message) {
-			break;
+		if (w == NULL) {
+			uv_mutex_lock(&_mutex);
+			if (_exiting) {
+				uv_mutex_unlock(&_mutex);
+				break;
+			}
+			/* Requests are queued before _generation is changed, so nothing
+			 * was missed by the scan above if it is still the same. */
+			if (_generation == seen) {
+				_idle++;
+				uv_cond_wait(&_cond, &_mutex);
+				_idle--;
+			}
+			seen = _generation;
+			uv_mutex_unlock(&_mutex);
+			continue;
 		}
 
-		w = QUEUE_DATA(q, struct uv__work, wq);
 		w->work(w);
 
 		uv_mutex_lock(&w->loop->wq_mutex);
@@ -102,16 +224,37 @@ static void worker(void *arg)
 		QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
 		uv_async_send(&w->loop->wq_async);
 		uv_mutex_unlock(&w->loop->wq_mutex);
+
+		/* w may be freed by the loop thread from here on. */
+		if (kind == UV__WORK_SLOW_IO) {
+			slow_io_release();
+		}
 	}
 }
 
-static void post(QUEUE *q)
+static void post(struct uv__work *w)
 {
+	struct uv__worker_s *owner;
+
 	uv_mutex_lock(&_mutex);
-	QUEUE_INSERT_TAIL(&_wq, q);
-	uv_mutex_unlock(&_mutex);
 
-	uv_cond_signal(&_cond);
+	w->owner = (unsigned char)_next;
+	if (++_next == _nthreads) {
+		_next = 0;
+	}
+
+	owner = &_workers[w->owner];
+	uv_mutex_lock(&owner->mutex);
+	QUEUE_INSERT_TAIL(&owner->wq[w->kind], &w->wq);
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+	w->queued_time = uv__hrtime();
+	owner->stats[w->kind].pending++;
+#endif
+	uv_mutex_unlock(&owner->mutex);
+
+	wakeup();
+
+	uv_mutex_unlock(&_mutex);
 }
 
 #if defined(__TINYARA__)
@@ -128,22 +271,35 @@ static void cleanup(void)
 		return;
 	}
 
-	post(&_exit_message);
+	/* The workers exit once the queued requests are done. */
+	uv_mutex_lock(&_mutex);
+	_exiting = 1;
+	uv_cond_broadcast(&_cond);
+	uv_mutex_unlock(&_mutex);
 
 	for (i = 0; i < _nthreads; i++)
-		if (uv_thread_join(_threads + i)) {
+		if (uv_thread_join(&_workers[i].thread)) {
 			ABORT();
 		}
 
-	if (_threads != _default_threads) {
-		free(_threads);
+	for (i = 0; i < _nthreads; i++) {
+		uv_mutex_destroy(&_workers[i].mutex);
+	}
+
+	if (_workers != _default_workers) {
+		free(_workers);
 	}
 
 	uv_mutex_destroy(&_mutex);
 	uv_cond_destroy(&_cond);
 
-	_threads = NULL;
+	_workers = NULL;
 	_nthreads = 0;
+	_generation = 0;
+	_idle = 0;
+	_next = 0;
+	_slow_io_running = 0;
+	_exiting = 0;
 	_initialized = 0;
 	_once = UV_ONCE_INIT;
 }
@@ -151,11 +307,12 @@ static void cleanup(void)
 static void init_once(void)
 {
 	unsigned int i;
+	unsigned int kind;
 	const char *val;
 
 	assert(_initialized == 0);
 
-	_nthreads = ARRAY_SIZE(_default_threads);
+	_nthreads = ARRAY_SIZE(_default_workers);
 	val = getenv("UV_THREADPOOL_SIZE");
 	if (val != NULL) {
 		_nthreads = atoi(val);
@@ -167,14 +324,18 @@ static void init_once(void)
 		_nthreads = MAX_THREADPOOL_SIZE;
 	}
 
-	_threads = _default_threads;
-	if (_nthreads > ARRAY_SIZE(_default_threads)) {
-		_threads = (uv_thread_t *)malloc(_nthreads * sizeof(_threads[0]));
-		if (_threads == NULL) {
-			_nthreads = ARRAY_SIZE(_default_threads);
-			_threads = _default_threads;
+	_workers = _default_workers;
+	if (_nthreads > ARRAY_SIZE(_default_workers)) {
+		_workers = (struct uv__worker_s *)malloc(_nthreads * sizeof(_workers[0]));
+		if (_workers == NULL) {
+			_nthreads = ARRAY_SIZE(_default_workers);
+			_workers = _default_workers;
 		}
 	}
+	memset(_workers, 0, _nthreads * sizeof(_workers[0]));
+
+	/* Slow I/O may use at most half of the workers (but at least one). */
+	_slow_io_limit = (_nthreads + 1) / 2;
 
 	if (uv_cond_init(&_cond)) {
 		TDLOG("init_once cond abort");
@@ -186,10 +347,18 @@ static void init_once(void)
 		ABORT();
 	}
 
-	QUEUE_INIT(&_wq);
+	for (i = 0; i < _nthreads; i++) {
+		if (uv_mutex_init(&_workers[i].mutex)) {
+			TDLOG("init_once worker mutex abort");
+			ABORT();
+		}
+		for (kind = 0; kind < UV__WORK_KINDS; kind++) {
+			QUEUE_INIT(&_workers[i].wq[kind]);
+		}
+	}
 
 	for (i = 0; i < _nthreads; i++) {
-		if (uv_thread_create(_threads + i, worker, NULL)) {
+		if (uv_thread_create(&_workers[i].thread, worker, &_workers[i])) {
 			TDLOG("init_once thread %d abort", i);
 			ABORT();
 		}
@@ -200,31 +369,37 @@ static void init_once(void)
 
 //-----------------------------------------------------------------------------
 
-void uv__work_submit(uv_loop_t *loop, struct uv__work *w, void (*work)(struct uv__work *w), void (*done)(struct uv__work *w, int status))
+void uv__work_submit(uv_loop_t *loop, struct uv__work *w, enum uv__work_kind kind, void (*work)(struct uv__work *w), void (*done)(struct uv__work *w, int status))
 {
 
 	uv_once(&_once, init_once);
 	w->loop = loop;
 	w->work = work;
 	w->done = done;
+	w->kind = (unsigned char)kind;
 	QUEUE_INIT(&w->wq);
-	post(&w->wq);
+	post(w);
 }
 
 static int uv__work_cancel(uv_loop_t *loop, uv_req_t *req, struct uv__work *w)
 {
+	struct uv__worker_s *owner;
 	int cancelled;
 
-	uv_mutex_lock(&_mutex);
+	owner = &_workers[w->owner];
+	uv_mutex_lock(&owner->mutex);
 	uv_mutex_lock(&w->loop->wq_mutex);
 
 	cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
 	if (cancelled) {
 		QUEUE_REMOVE(&w->wq);
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+		owner->stats[w->kind].pending--;
+#endif
 	}
 
 	uv_mutex_unlock(&w->loop->wq_mutex);
-	uv_mutex_unlock(&_mutex);
+	uv_mutex_unlock(&owner->mutex);
 
 	if (!cancelled) {
 		return UV_EBUSY;
@@ -300,7 +475,7 @@ int uv_queue_work(uv_loop_t *loop, uv_work_t *req, uv_work_cb work_cb, uv_after_
 	req->loop = loop;
 	req->work_cb = work_cb;
 	req->after_work_cb = after_work_cb;
-	uv__work_submit(loop, &req->work_req, uv__queue_work, uv__queue_done);
+	uv__work_submit(loop, &req->work_req, UV__WORK_CPU, uv__queue_work, uv__queue_done);
 	return 0;
 }
 
@@ -337,6 +512,40 @@ int uv_cancel(uv_req_t *req)
 	return uv__work_cancel(loop, req, wreq);
 }
 
+//-----------------------------------------------------------------------------
+#ifdef CONFIG_LIBTUV_THREADPOOL_STATS
+int uv_threadpool_get_stats(enum uv__work_kind kind, uv_threadpool_stats_t *stats)
+{
+	uv_threadpool_stats_t *s;
+	unsigned int i;
+
+	if (kind >= UV__WORK_KINDS || stats == NULL) {
+		return UV_EINVAL;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+	if (_initialized == 0) {
+		return 0;
+	}
+
+	for (i = 0; i < _nthreads; i++) {
+		uv_mutex_lock(&_workers[i].mutex);
+		s = &_workers[i].stats[kind];
+		stats->started += s->started;
+		stats->stolen += s->stolen;
+		stats->pending += s->pending;
+		stats->wait_total += s->wait_total;
+		if (s->wait_max > stats->wait_max) {
+			stats->wait_max = s->wait_max;
+		}
+		uv_mutex_unlock(&_workers[i].mutex);
+	}
+
+	return 0;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 #if defined(__TINYARA__)
 void uv_cleanup(void)
@@ -1697,10 +1697,13 @@ cleanup:
 
 /*
  * Multiplication R = m * P
+ *
+ * cache is a hint that P is a long-lived public key, see mbedtls_ecp_muladd()
  */
-int mbedtls_ecp_mul( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+static int ecp_mul( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
              const mbedtls_mpi *m, const mbedtls_ecp_point *P,
-             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng )
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+             int cache )
 {
     int ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
 #if defined(MBEDTLS_ECP_INTERNAL_ALT)
@@ -1729,9 +1732,17 @@ int mbedtls_ecp_mul( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
 #endif
 #if defined(ECP_SHORTWEIERSTRASS)
     if( ecp_get_type( grp ) == ECP_TYPE_SHORT_WEIERSTRASS )
-        ret = ecp_mul_comb( grp, R, m, P, f_rng, p_rng );
+    {
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+        if( grp->id == MBEDTLS_ECP_DP_SECP256R1 )
+            ret = mbedtls_ecp_p256_mul( grp, R, m, P, f_rng, p_rng, cache );
+        else
+#endif
+            ret = ecp_mul_comb( grp, R, m, P, f_rng, p_rng );
+    }
 
 #endif
+    ((void) cache);
 #if defined(MBEDTLS_ECP_INTERNAL_ALT)
 cleanup:
 
@@ -1744,6 +1755,13 @@ cleanup:
     return( ret );
 }
 
+int mbedtls_ecp_mul( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+             const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng )
+{
+    return( ecp_mul( grp, R, m, P, f_rng, p_rng, 0 ) );
+}
+
 #if defined(ECP_SHORTWEIERSTRASS)
 /*
  * Check that an affine point is valid as a public key,
@@ -1817,7 +1835,9 @@ static int mbedtls_ecp_mul_shortcuts( mbedtls_ecp_group *grp,
     }
     else
     {
-        MBEDTLS_MPI_CHK( mbedtls_ecp_mul( grp, R, m, P, NULL, NULL ) );
+        /* Points given to muladd() are public keys being verified against,
+         * which tend to come back: let them be cached */
+        MBEDTLS_MPI_CHK( ecp_mul( grp, R, m, P, NULL, NULL, 1 ) );
     }
 
 cleanup:
@@ -2087,6 +2107,113 @@ cleanup:
 
 #if defined(MBEDTLS_SELF_TEST)
 
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+/*
+ * Deterministic "RNG" for coordinates randomization in the tests below
+ */
+static int ecp_self_test_rng( void *ctx, unsigned char *out, size_t len )
+{
+    unsigned char *state = (unsigned char *) ctx;
+
+    while( len-- > 0 )
+        *out++ = (unsigned char)( ( *state += 0x3B ) ^ 0xA5 );
+
+    return( 0 );
+}
+
+/*
+ * Compare the secp256r1 engine with the generic comb method
+ */
+static int ecp_self_test_p256( void )
+{
+    int ret;
+    size_t i;
+    unsigned char rng_state = 0;
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R1, R2, P, Q;
+    mbedtls_mpi m, n;
+    const char *exponents[] =
+    {
+        "0000000000000000000000000000000000000000000000000000000000000001", /* one */
+        "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632550", /* N - 1 */
+        "5EA6F389A38B8BC81E767753B15AA5569E1782E30ABE7D25C1A1F26F7E3A9B4D", /* random */
+        "4000000000000000000000000000000000000000000000000000000000000000", /* one and zeros */
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", /* all ones */
+        "5555555555555555555555555555555555555555555555555555555555555555", /* 101010... */
+    };
+
+    mbedtls_ecp_group_init( &grp );
+    mbedtls_ecp_point_init( &R1 );
+    mbedtls_ecp_point_init( &R2 );
+    mbedtls_ecp_point_init( &P );
+    mbedtls_ecp_point_init( &Q );
+    mbedtls_mpi_init( &m );
+    mbedtls_mpi_init( &n );
+
+    MBEDTLS_MPI_CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+
+    /* Precomputed table for G */
+    if( ( ret = mbedtls_ecp_p256_self_test( &grp ) ) != 0 )
+        goto cleanup;
+
+    /* P = 2G, computed by the generic code */
+    MBEDTLS_MPI_CHK( mbedtls_mpi_lset( &m, 2 ) );
+    MBEDTLS_MPI_CHK( ecp_mul_comb( &grp, &P, &m, &grp.G, NULL, NULL ) );
+
+    for( i = 0; i < sizeof( exponents ) / sizeof( exponents[0] ); i++ )
+    {
+        MBEDTLS_MPI_CHK( mbedtls_mpi_read_string( &m, 16, exponents[i] ) );
+
+        MBEDTLS_MPI_CHK( mbedtls_ecp_mul( &grp, &R1, &m, &grp.G,
+                                          ecp_self_test_rng, &rng_state ) );
+        MBEDTLS_MPI_CHK( ecp_mul_comb( &grp, &R2, &m, &grp.G, NULL, NULL ) );
+        if( mbedtls_ecp_point_cmp( &R1, &R2 ) != 0 )
+        {
+            ret = 1;
+            goto cleanup;
+        }
+
+        MBEDTLS_MPI_CHK( mbedtls_ecp_mul( &grp, &R1, &m, &P,
+                                          ecp_self_test_rng, &rng_state ) );
+        MBEDTLS_MPI_CHK( ecp_mul_comb( &grp, &R2, &m, &P, NULL, NULL ) );
+        if( mbedtls_ecp_point_cmp( &R1, &R2 ) != 0 )
+        {
+            ret = 1;
+            goto cleanup;
+        }
+    }
+
+    /* m G + n P, twice to go through the cache of comb tables */
+    MBEDTLS_MPI_CHK( mbedtls_mpi_read_string( &n, 16, exponents[2] ) );
+    MBEDTLS_MPI_CHK( ecp_mul_comb( &grp, &R2, &m, &grp.G, NULL, NULL ) );
+    MBEDTLS_MPI_CHK( ecp_mul_comb( &grp, &Q, &n, &P, NULL, NULL ) );
+    MBEDTLS_MPI_CHK( ecp_add_mixed( &grp, &R2, &R2, &Q ) );
+    MBEDTLS_MPI_CHK( ecp_normalize_jac( &grp, &R2 ) );
+
+    for( i = 0; i < 2; i++ )
+    {
+        MBEDTLS_MPI_CHK( mbedtls_ecp_muladd( &grp, &R1, &m, &grp.G, &n, &P ) );
+        if( mbedtls_ecp_point_cmp( &R1, &R2 ) != 0 )
+        {
+            ret = 1;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+
+    mbedtls_ecp_group_free( &grp );
+    mbedtls_ecp_point_free( &R1 );
+    mbedtls_ecp_point_free( &R2 );
+    mbedtls_ecp_point_free( &P );
+    mbedtls_ecp_point_free( &Q );
+    mbedtls_mpi_free( &m );
+    mbedtls_mpi_free( &n );
+
+    return( ret );
+}
+#endif /* MBEDTLS_ECP_P256_OPTIM */
+
 /*
  * Checkup routine
  */
@@ -2198,6 +2325,22 @@ int mbedtls_ecp_self_test( int verbose )
     if( verbose != 0 )
         mbedtls_printf( "passed\n" );
 
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+    if( verbose != 0 )
+        mbedtls_printf( "  ECP test #3 (secp256r1 engine vs generic): " );
+
+    if( ( ret = ecp_self_test_p256() ) != 0 )
+    {
+        if( verbose != 0 && ret > 0 )
+            mbedtls_printf( "failed\n" );
+
+        goto cleanup;
+    }
+
+    if( verbose != 0 )
+        mbedtls_printf( "passed\n" );
+#endif
+
 cleanup:
 
     if( ret < 0 && verbose != 0 )
@@ -0,0 +1,1108 @@
+/****************************************************************************
+ *
+ * Copyright 2019 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ *  Dedicated secp256r1 (NIST P-256) scalar multiplication
+ *
+ *  The generic code in ecp.c works on mbedtls_mpi values: every field
+ *  operation goes through mbedtls_mpi_mul_mpi() and the NIST fast reduction,
+ *  with heap allocations for the intermediate values. For P-256 the field
+ *  elements always fit in eight 32-bit words, so this file implements the
+ *  field arithmetic on fixed arrays (Montgomery representation, R = 2^256)
+ *  and runs the same SPA-resistant comb method as ecp_mul_comb() on top of
+ *  it. Only the inputs and the result are converted from/to mbedtls_mpi.
+ *
+ *  Two kinds of comb tables are used:
+ *  - for the generator, a table with w = 6 is stored in ROM, so ECDSA
+ *    signatures, ECDH key generation and half of ECDSA verification never
+ *    pay for the precomputation;
+ *  - for other points, a table with w = 4 is computed on the fly. Tables of
+ *    points used for verification (mbedtls_ecp_muladd()) are kept in a small
+ *    LRU cache, since the same CA and server keys are seen over and over.
+ *
+ *  References:
+ *  - GECC = Guide to Elliptic Curve Cryptography, Hankerson, Menezes, Vanstone
+ *  - ecp.c for the comb method and its SPA countermeasures
+ */
+
+#include "mbedtls/config.h"
+
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_P256_OPTIM)
+
+#include "mbedtls/ecp.h"
+#include "mbedtls/ecp_internal.h"
+
+#if defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(MBEDTLS_ECP_ALT)
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdlib.h>
+#define mbedtls_calloc    calloc
+#define mbedtls_free       free
+#endif
+
+#if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
+    !defined(inline) && !defined(__cplusplus)
+#define inline __inline
+#endif
+
+/* Implementation that should never be optimized out by the compiler */
+static void mbedtls_zeroize( void *v, size_t n ) {
+    volatile unsigned char *p = v; while( n-- ) *p++ = 0;
+}
+
+/*
+ * Field element: 8 little-endian 32-bit words, in Montgomery form
+ */
+typedef uint32_t p256_fe[8];
+
+/* Point in jacobian coordinates, Z == 0 is the point at infinity */
+typedef struct
+{
+    p256_fe X, Y, Z;
+} p256_jac;
+
+/* Point in affine coordinates, never the point at infinity */
+typedef struct
+{
+    p256_fe x, y;
+} p256_aff;
+
+/*
+ * Comb parameters, see ecp_mul_comb(): d = ceil( 256 / w )
+ */
+#define P256_COMB_W_G       6       /* window for the generator (ROM table) */
+#define P256_COMB_D_G       43
+#define P256_COMB_PRE_G     ( 1 << ( P256_COMB_W_G - 1 ) )
+#define P256_COMB_W         4       /* window for other points */
+#define P256_COMB_D         64
+#define P256_COMB_PRE       ( 1 << ( P256_COMB_W - 1 ) )
+
+/* p = 2^256 - 2^224 + 2^192 + 2^96 - 1 */
+static const p256_fe p256_p = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF };
+
+/* 1 in Montgomery form: R mod p */
+static const p256_fe p256_one = {
+    0x00000001, 0x00000000, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x00000000 };
+
+/* R^2 mod p, to convert into Montgomery form */
+static const p256_fe p256_rr = {
+    0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB,
+    0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004 };
+
+/* Plain 1, to convert out of Montgomery form */
+static const p256_fe p256_unit = { 1, 0, 0, 0, 0, 0, 0, 0 };
+
+/*
+ * Comb table for the generator G, in Montgomery form:
+ * T[i] = i_{w-1} 2^{(w-1)d} G + ... + i_1 2^d G + G, with w = 6 and d = 43
+ * (see ecp_precompute_comb()). Checked by mbedtls_ecp_p256_self_test().
+ */
+static const p256_aff p256_comb_g[P256_COMB_PRE_G] = {
+    { { 0x18A9143C, 0x79E730D4, 0x5FEDB601, 0x75BA95FC,
+        0x77622510, 0x79FB732B, 0xA53755C6, 0x18905F76 },
+      { 0xCE95560A, 0xDDF25357, 0xBA19E45C, 0x8B4AB8E4,
+        0xDD21F325, 0xD2E88688, 0x25885D85, 0x8571FF18 } },
+    { { 0xABC3E190, 0xB9C0D276, 0xCB55B9CA, 0x610E3D4D,
+        0x5720F50A, 0xD16DBD02, 0xA607DE84, 0xD0ED73DC },
+      { 0x49219FB5, 0x3BBDE5BF, 0x57771843, 0x698E12C0,
+        0x63470A5E, 0xDB606A97, 0x853635D5, 0x61C71975 } },
+    { { 0xC1D85F12, 0x4615D912, 0xE1F4E302, 0x1F0880B0,
+        0x6F1FCA13, 0x336BCC89, 0xC70DEDBC, 0xDA59AD0D },
+      { 0xB0F62ECE, 0x3897EFAE, 0xF4990CFD, 0xBAED81CD,
+        0x60321BBB, 0xA3B1C2F2, 0xDDC84F79, 0x2AEFD95A } },
+    { { 0x9248FCE2, 0x3D8242D0, 0x7F49F33D, 0x32D4BF82,
+        0x29D41FD1, 0x78807BEB, 0xF8F562CB, 0xFCE48B99 },
+      { 0x9F38F097, 0x72A7D484, 0xA37059AD, 0x1B482C10,
+        0x472E5ED3, 0xC1AA8284, 0xEF23E9C9, 0xC5D6F3BB } },
+    { { 0x9FC3DF19, 0x569AACDF, 0xC34C6FB2, 0x0C6782C7,
+        0xC4EC873D, 0xBB5F98B2, 0x9FE9E475, 0x5578433B },
+      { 0x9CA84821, 0xFA14F386, 0x39589501, 0xB8EF658D,
+        0x07127B8E, 0x4022C48E, 0x5402EA12, 0xCBC4DFE3 } },
+    { { 0x2352B4FF, 0x0B885E96, 0xA6545766, 0x6BE320D2,
+        0xB9A59E72, 0xBD22A444, 0xCCC55D7D, 0x2F2D32D6 },
+      { 0xDDCEC70B, 0xD86E4C4C, 0x7A25C934, 0x19CDB0E9,
+        0x9CA97E28, 0x542ADE06, 0x746517F7, 0x58C5927C } },
+    { { 0xA9FEE73E, 0xA8F88EB5, 0x576EA39B, 0x72A84174,
+        0xE2692E7D, 0x671FA0AD, 0x96769F9E, 0x25562885 },
+      { 0xE850A6B0, 0x254323BC, 0xFFF6C89A, 0x74B61C18,
+        0xCFAE2690, 0x2E7C563F, 0x164AFB0F, 0x2CF454B7 } },
+    { { 0x1FAB7D71, 0x7201A1D6, 0x32CBBEE8, 0x65931F54,
+        0xDCB387EE, 0x202955D3, 0xC4678432, 0xA5045BA5 },
+      { 0xDCA85FF6, 0xCFB5EE87, 0xDFEC0F67, 0xDD25A7C6,
+        0x356A87C6, 0xFEE47169, 0xC3D7ECE9, 0x20A8F159 } },
+    { { 0xBC0A70C0, 0x21E07F9A, 0x989A0182, 0xECFDB3A2,
+        0xE40E8125, 0x360682C0, 0x2F837F32, 0x73A63795 },
+      { 0x9C0D326B, 0xF4EB8CEF, 0xEBF4C7A5, 0xEFB97FEC,
+        0xAF3D5D7E, 0xF9352123, 0x34E22AB1, 0xB71EF4EF } },
+    { { 0xB50B4E82, 0x5F94D8DE, 0x34BD93E9, 0xBCD9144E,
+        0x07C08623, 0x61C33921, 0x7E3DE8EE, 0xEDEC947E },
+      { 0x2F21B202, 0x9D2DA51D, 0x96692A89, 0xC0C885CD,
+        0xA5E7309C, 0x4A613462, 0x0F28DEE6, 0x22778855 } },
+    { { 0x49388995, 0x8F2EACFE, 0x841BE9ED, 0x000FC8D4,
+        0x6955C290, 0x2ED8085A, 0x6D8E176F, 0x1929CF60 },
+      { 0xFD1A09DB, 0x2EFD26A5, 0x6CB626CD, 0x58D767AD,
+        0xB26C6E05, 0x13A81B95, 0x8F61832B, 0x68FE6107 } },
+    { { 0xE3AB5F4E, 0xAF8E65CA, 0x7561A69C, 0x8B0B8B89,
+        0xB17C1E66, 0x37E83AA0, 0xF8D80EDC, 0xE894D84C },
+      { 0xCE514E22, 0xF1E465E7, 0xA72340EF, 0xC7FA324C,
+        0xE7370673, 0x08297FCA, 0xB119AE5E, 0x4F799682 } },
+    { { 0x3F031A88, 0x37221CD1, 0x0B5558D4, 0xE4D53D2F,
+        0xDAFC51CD, 0x2EDE8E8F, 0xA8A883EA, 0xB587284C },
+      { 0x44FA5251, 0xFA376740, 0x5C5E3528, 0x5E5E18F9,
+        0x6E10B958, 0x8AF51FAC, 0x2C429B30, 0x09BE7903 } },
+    { { 0x31B5DF76, 0xF5CCA5DA, 0x76A4ABC0, 0x94313186,
+        0x1877C7C7, 0x5DB8E6F7, 0x6031AC99, 0x3CE3F5F9 },
+      { 0x7E7CEF80, 0x585961D0, 0xD424F16A, 0x5ED6E841,
+        0x56B16A49, 0x18289CD0, 0x2E5770FA, 0x8008D03B } },
+    { { 0x7824D53A, 0xFB776AF0, 0x422DEA35, 0x04709096,
+        0x5FEC3AC7, 0x6F480B6B, 0xE27EDDA4, 0xDB2B1B62 },
+      { 0xDA78B494, 0x0BBA904C, 0x91A147F7, 0x37EF59B6,
+        0x26A4730A, 0xF8805177, 0xA8AB368E, 0xECC9D79A } },
+    { { 0xC56F6B04, 0x832DA983, 0x8EF098AE, 0x7AAA84EB,
+        0xA6A616A2, 0x602E3EEF, 0xB7B717A3, 0xC2824DDC },
+      { 0xDDB0A2E9, 0x19F50324, 0x5BEDFBBD, 0x04553A28,
+        0xAA1AEE0A, 0x37EA8B12, 0x945959A1, 0xC1844E79 } },
+    { { 0x43248E67, 0x651CFDEB, 0xEE561DE8, 0x2C3D72CE,
+        0x443DAC8B, 0xA48B8F33, 0x7991F986, 0xE6B042FE },
+      { 0xE810BCD2, 0xD091636D, 0xA97416D7, 0xFC1E96AE,
+        0x2892694D, 0x2B6087CB, 0x9985A628, 0x0F8AC245 } },
+    { { 0x03C5FE33, 0x13E44ACC, 0x0105BBC6, 0x13F4374E,
+        0xCB4451B8, 0x0CBA5018, 0xFA29A4E1, 0xA1A38E4A },
+      { 0xF4403917, 0x063FB9A8, 0x996EA7F2, 0x7AFE108F,
+        0xF93A1F87, 0xEC252363, 0x7E432609, 0xC029C811 } },
+    { { 0x9C2C0ABF, 0x3161EBDD, 0xF497CF35, 0x48B7EE7B,
+        0x94DD9C97, 0x9233E31D, 0xC5D2988F, 0x4AEF9A62 },
+      { 0xA03E6456, 0x89A54161, 0xC1F02B47, 0x9D25E003,
+        0xC1857782, 0x8784CDBF, 0x0222B49C, 0x7928CAFD } },
+    { { 0x5D75D310, 0x3AEF6BC0, 0x82476E5C, 0xF3E7F03C,
+        0x8419B8A0, 0x9DCF3D50, 0xEAF07F07, 0x221A3885 },
+      { 0x37BDCB7D, 0x16D533F3, 0xBB49550D, 0xD778066B,
+        0x36C2600C, 0xF6F45409, 0xC1C61709, 0x7544396F } },
+    { { 0x19E5A603, 0x7926625B, 0xE1BF712B, 0xF1B98E93,
+        0xE33ABECC, 0x933ECB52, 0xF826619B, 0x9EBFC506 },
+      { 0xA1692C52, 0xD2965F67, 0xFC4F9564, 0x8AC4012D,
+        0x6739F003, 0xA8AF5703, 0xBC715E13, 0x7DD2282D } },
+    { { 0x1BDD2AA2, 0x49F7E899, 0x34E3CAE9, 0x88FD2735,
+        0x82CBFEA2, 0x5AC05101, 0x4CF84578, 0x324C9D41 },
+      { 0x19F13061, 0xA2423117, 0x5F3B9932, 0x69D67CF1,
+        0xDDE2DFAD, 0x32ECDB3C, 0xB916F7A6, 0x2F74D995 } },
+    { { 0x0767CDF2, 0x35E751B5, 0x9D8E2838, 0x808372E6,
+        0x646914D7, 0xCBAD6B30, 0x6C7B3CAB, 0x4EEEB1DE },
+      { 0x8C965004, 0x3EF3AF96, 0xD281920B, 0xD162290F,
+        0x181F811B, 0x4626C313, 0xBE61DD14, 0x5FA42F4F } },
+    { { 0x86A2EE12, 0x30BF236C, 0x05ECB4C0, 0x74D5A127,
+        0x1601CCA9, 0x9EF43B0F, 0xAC4DD202, 0xBE1B1BF9 },
+      { 0x17B6F93B, 0x84943E47, 0xCD5214B3, 0x6F789757,
+        0x7F313DFA, 0x5E0DB1A9, 0xECE0B72B, 0x0515EFAC } },
+    { { 0x783490E7, 0x368ABEC6, 0xD925C359, 0xF26DA8BD,
+        0xE8FB0679, 0xF9B643E5, 0xB555D175, 0x7AB803D9 },
+      { 0x4EBAE595, 0x1B405999, 0xBA417A49, 0x07FBBF25,
+        0xC617957A, 0x02D7CF1C, 0x565C1FBB, 0x79070EA5 } },
+    { { 0xD2970FCF, 0x25C87C76, 0x4D5546A8, 0x7C9F60A0,
+        0x8DD8BF8C, 0x7DAB072F, 0xE8FF9F28, 0x3D10907C },
+      { 0x34BB2A29, 0xB08D6D0E, 0xC3FCFDAF, 0x5DFD4907,
+        0x47123BA6, 0xE4A2D4B1, 0x42DE6D8D, 0x6E9EEF0B } },
+    { { 0x0A04143F, 0x79A04104, 0xC700C616, 0x03F7410F,
+        0x91108CA6, 0xE8F2A3F2, 0xF5AC679A, 0xA26D67E8 },
+      { 0xB83FBD9A, 0xA15DBFEB, 0x3A0B5587, 0xF1AAEBD2,
+        0xCE0EAD44, 0x639A97DD, 0x71D12EE0, 0xF253B00C } },
+    { { 0x923AC000, 0xC1C81838, 0xC4ABC0EE, 0x42021F02,
+        0x47132A20, 0xCDE3BC9A, 0xC69F55FB, 0x6F52A864 },
+      { 0xDF89FF6A, 0x0BDFD3E4, 0xC88BD74E, 0x244C943B,
+        0x2612998B, 0x649E0B53, 0xD3413D4A, 0xCE61EBC3 } },
+    { { 0x8FD42692, 0xE4CCA34B, 0xE15F3ACF, 0xC86D49A6,
+        0xA6B18392, 0xBFE1F263, 0xDCD266F6, 0x0664C933 },
+      { 0x19399D88, 0x86738CF5, 0x749CE6BC, 0x1CBCC8C3,
+        0xC773B884, 0x28171F7B, 0x01ACF19E, 0x306FC957 } },
+    { { 0x43D7AD31, 0x767C3596, 0x49CCEF62, 0x7BA3A1AA,
+        0x0242BF5A, 0x5261C316, 0x9EB82DFB, 0x85F45219 },
+      { 0x37B42E47, 0x554CB382, 0x4CF66133, 0xC9771EC1,
+        0x153905A3, 0xDE70617A, 0xBC61316D, 0x2CAB26FC } },
+    { { 0xB6864CC0, 0x6E6B0FB8, 0xAB3B623C, 0x5D8A0027,
+        0x9A1CFC9C, 0x5E666538, 0x521E4FF3, 0x816B19DE },
+      { 0x0BC447F8, 0x56709AD0, 0x8F1464D7, 0x1D46CB1C,
+        0xA949873D, 0x49CEF820, 0xD9D3E65F, 0x02804692 } },
+    { { 0x44B06ED7, 0xF9C5E9DE, 0x4A597159, 0x6CE7C4F7,
+        0x833ACCB5, 0xD02EC441, 0x6296E8FC, 0xF3020599 },
+      { 0xC2AFBE06, 0x7DF6C5C6, 0x9C849B09, 0xFF429DDA,
+        0xF5DD78D6, 0x42170166, 0x830C388B, 0x2403EA21 } },
+};
+
+/*
+ * r = s - p if s >= p (or if there was a carry out of s), else r = s.
+ * Constant-time.
+ */
+static inline void p256_reduce_once( p256_fe r, const uint32_t s[8],
+                                     uint32_t carry )
+{
+    uint32_t d[8], mask;
+    uint64_t t, borrow = 0;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+    {
+        t = (uint64_t) s[i] - p256_p[i] - borrow;
+        d[i] = (uint32_t) t;
+        borrow = ( t >> 32 ) & 1;
+    }
+
+    /* keep d if there was a carry, or if the subtraction did not borrow */
+    mask = 0 - ( carry | ( (uint32_t) borrow ^ 1 ) );
+    for( i = 0; i < 8; i++ )
+        r[i] = ( d[i] & mask ) | ( s[i] & ~mask );
+}
+
+/* r = a + b mod p */
+static void p256_add( p256_fe r, const p256_fe a, const p256_fe b )
+{
+    uint32_t s[8];
+    uint64_t c = 0;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+    {
+        c += (uint64_t) a[i] + b[i];
+        s[i] = (uint32_t) c;
+        c >>= 32;
+    }
+
+    p256_reduce_once( r, s, (uint32_t) c );
+}
+
+/* r = a - b mod p */
+static void p256_sub( p256_fe r, const p256_fe a, const p256_fe b )
+{
+    uint32_t d[8], mask;
+    uint64_t t, c, borrow = 0;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+    {
+        t = (uint64_t) a[i] - b[i] - borrow;
+        d[i] = (uint32_t) t;
+        borrow = ( t >> 32 ) & 1;
+    }
+
+    /* add p back if we went negative */
+    mask = 0 - (uint32_t) borrow;
+    c = 0;
+    for( i = 0; i < 8; i++ )
+    {
+        c += (uint64_t) d[i] + ( p256_p[i] & mask );
+        r[i] = (uint32_t) c;
+        c >>= 32;
+    }
+}
+
+/*
+ * r = a * b / R mod p (Montgomery multiplication, CIOS)
+ *
+ * The multiplication rows are unrolled. The reduction step uses the shape
+ * of p: since -p^-1 = 1 mod 2^32, the multiplier for each row is t[0], and
+ * adding t[0] * p only touches words 3, 6, 7 and 8 (besides clearing word 0).
+ */
+#define P256_MULADD( j )                                        \
+    c += (uint64_t) a[j] * bi + t[j];                           \
+    t[j] = (uint32_t) c;                                        \
+    c >>= 32;
+
+static void p256_mul( p256_fe r, const p256_fe a, const p256_fe b )
+{
+    uint32_t t[10], m, bi;
+    uint64_t c;
+    int64_t s;
+    int i;
+
+    memset( t, 0, sizeof( t ) );
+
+    for( i = 0; i < 8; i++ )
+    {
+        /* t += a * b[i] */
+        bi = b[i];
+        c = 0;
+        P256_MULADD( 0 ); P256_MULADD( 1 ); P256_MULADD( 2 ); P256_MULADD( 3 );
+        P256_MULADD( 4 ); P256_MULADD( 5 ); P256_MULADD( 6 ); P256_MULADD( 7 );
+        c += t[8];
+        t[8] = (uint32_t) c;
+        t[9] = (uint32_t) ( c >> 32 );
+
+        /* t = ( t + m * p ) / 2^32, with m = t[0] */
+        m = t[0];
+        s = (int64_t) t[1];                             t[0] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[2];                            t[1] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[3] + m;                        t[2] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[4];                            t[3] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[5];                            t[4] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[6] + m;                        t[5] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[7] - m;                        t[6] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[8] + m;                        t[7] = (uint32_t) s; s >>= 32;
+        s += (int64_t) t[9];                            t[8] = (uint32_t) s;
+    }
+
+    /* t < 2p here */
+    p256_reduce_once( r, t, t[8] );
+}
+
+static inline void p256_sqr( p256_fe r, const p256_fe a )
+{
+    p256_mul( r, a, a );
+}
+
+/* r = a^(2^n) */
+static void p256_sqr_n( p256_fe r, const p256_fe a, int n )
+{
+    p256_sqr( r, a );
+    while( --n > 0 )
+        p256_sqr( r, r );
+}
+
+/*
+ * r = a^-1 = a^(p - 2), with a fixed addition chain:
+ * p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+ */
+static void p256_inv( p256_fe r, const p256_fe a )
+{
+    p256_fe x2, x4, x8, x16, x32, t;
+
+    p256_sqr( t, a );       p256_mul( x2, t, a );       /* 2^2 - 1 */
+    p256_sqr_n( t, x2, 2 ); p256_mul( x4, t, x2 );      /* 2^4 - 1 */
+    p256_sqr_n( t, x4, 4 ); p256_mul( x8, t, x4 );      /* 2^8 - 1 */
+    p256_sqr_n( t, x8, 8 ); p256_mul( x16, t, x8 );     /* 2^16 - 1 */
+    p256_sqr_n( t, x16, 16 ); p256_mul( x32, t, x16 );  /* 2^32 - 1 */
+
+    p256_sqr_n( t, x32, 32 ); p256_mul( t, t, a );      /* ffffffff 00000001 */
+    p256_sqr_n( t, t, 128 ); p256_mul( t, t, x32 );     /* 00000000 x 3, ffffffff */
+    p256_sqr_n( t, t, 32 ); p256_mul( t, t, x32 );      /* ffffffff */
+    p256_sqr_n( t, t, 16 ); p256_mul( t, t, x16 );      /* ffff */
+    p256_sqr_n( t, t, 8 ); p256_mul( t, t, x8 );        /* ff */
+    p256_sqr_n( t, t, 4 ); p256_mul( t, t, x4 );        /* f */
+    p256_sqr_n( t, t, 2 ); p256_mul( t, t, x2 );        /* 11 */
+    p256_sqr_n( t, t, 2 ); p256_mul( r, t, a );         /* 01 */
+
+    mbedtls_zeroize( t, sizeof( t ) );
+}
+
+static int p256_is_zero( const p256_fe a )
+{
+    uint32_t acc = 0;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+        acc |= a[i];
+
+    return( acc == 0 );
+}
+
+/* r = cond ? a : r, constant-time (cond must be 0 or 1) */
+static inline void p256_cmov( p256_fe r, const p256_fe a, uint32_t cond )
+{
+    uint32_t mask = 0 - cond;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+        r[i] = ( r[i] & ~mask ) | ( a[i] & mask );
+}
+
+/* a = cond ? -a : a, constant-time */
+static void p256_cneg( p256_fe a, uint32_t cond )
+{
+    static const p256_fe zero = { 0 };
+    p256_fe n;
+
+    p256_sub( n, zero, a );
+    p256_cmov( a, n, cond );
+}
+
+/*
+ * Conversions from/to mbedtls_mpi, big-endian through a byte buffer so that
+ * the code does not depend on the size of mbedtls_mpi_uint.
+ * The input is expected to be less than p.
+ */
+static int p256_from_mpi( p256_fe r, const mbedtls_mpi *X )
+{
+    int ret;
+    unsigned char buf[32];
+    int i;
+
+    MBEDTLS_MPI_CHK( mbedtls_mpi_write_binary( X, buf, sizeof( buf ) ) );
+
+    for( i = 0; i < 8; i++ )
+    {
+        const unsigned char *b = buf + 28 - 4 * i;
+        r[i] = ( (uint32_t) b[0] << 24 ) | ( (uint32_t) b[1] << 16 ) |
+               ( (uint32_t) b[2] <<  8 ) | ( (uint32_t) b[3]       );
+    }
+
+cleanup:
+    return( ret );
+}
+
+static int p256_to_mpi( mbedtls_mpi *X, const p256_fe a )
+{
+    unsigned char buf[32];
+    int i;
+
+    for( i = 0; i < 8; i++ )
+    {
+        unsigned char *b = buf + 28 - 4 * i;
+        b[0] = (unsigned char)( a[i] >> 24 );
+        b[1] = (unsigned char)( a[i] >> 16 );
+        b[2] = (unsigned char)( a[i] >>  8 );
+        b[3] = (unsigned char)( a[i]       );
+    }
+
+    return( mbedtls_mpi_read_binary( X, buf, sizeof( buf ) ) );
+}
+
+/*
+ * Point doubling R = 2 P, jacobian coordinates, a = -3
+ * (same formulas as ecp_double_jac(), GECC 3.21)
+ *
+ * Cost: 4M + 4S
+ */
+static void p256_double_jac( p256_jac *R, const p256_jac *P )
+{
+    p256_fe M, S, T, U;
+
+    /* M = 3(X + Z^2)(X - Z^2) */
+    p256_sqr( S, P->Z );
+    p256_add( T, P->X, S );
+    p256_sub( U, P->X, S );
+    p256_mul( S, T, U );
+    p256_add( M, S, S );
+    p256_add( M, M, S );
+
+    /* S = 4 X Y^2 */
+    p256_sqr( T, P->Y );
+    p256_add( T, T, T );
+    p256_mul( S, P->X, T );
+    p256_add( S, S, S );
+
+    /* U = 8 Y^4 */
+    p256_sqr( U, T );
+    p256_add( U, U, U );
+
+    /* Z' = 2 Y Z, before P->Y may be overwritten */
+    p256_mul( R->Z, P->Y, P->Z );
+    p256_add( R->Z, R->Z, R->Z );
+
+    /* X' = M^2 - 2S */
+    p256_sqr( T, M );
+    p256_sub( T, T, S );
+    p256_sub( T, T, S );
+
+    /* Y' = M(S - X') - U */
+    p256_sub( S, S, T );
+    p256_mul( S, S, M );
+    p256_sub( R->Y, S, U );
+    memcpy( R->X, T, sizeof( p256_fe ) );
+}
+
+/*
+ * Addition R = P + Q, mixed affine-jacobian coordinates (GECC 3.22),
+ * same formulas and special cases as ecp_add_mixed().
+ *
+ * Cost: 8M + 3S
+ */
+static void p256_add_mixed( p256_jac *R, const p256_jac *P, const p256_aff *Q )
+{
+    p256_fe T1, T2, T3, T4, X, Y;
+
+    /* Trivial case: P is zero */
+    if( p256_is_zero( P->Z ) )
+    {
+        memcpy( R->X, Q->x, sizeof( p256_fe ) );
+        memcpy( R->Y, Q->y, sizeof( p256_fe ) );
+        memcpy( R->Z, p256_one, sizeof( p256_fe ) );
+        return;
+    }
+
+    p256_sqr( T1, P->Z );
+    p256_mul( T2, T1, P->Z );
+    p256_mul( T1, T1, Q->x );
+    p256_mul( T2, T2, Q->y );
+    p256_sub( T1, T1, P->X );
+    p256_sub( T2, T2, P->Y );
+
+    /* Special cases (2) and (3) */
+    if( p256_is_zero( T1 ) )
+    {
+        if( p256_is_zero( T2 ) )
+        {
+            p256_jac Qj;
+
+            memcpy( Qj.X, Q->x, sizeof( p256_fe ) );
+            memcpy( Qj.Y, Q->y, sizeof( p256_fe ) );
+            memcpy( Qj.Z, p256_one, sizeof( p256_fe ) );
+            p256_double_jac( R, &Qj );
+        }
+        else
+            memset( R, 0, sizeof( p256_jac ) );
+
+        return;
+    }
+
+    p256_mul( R->Z, P->Z, T1 );
+    p256_sqr( T3, T1 );
+    p256_mul( T4, T3, T1 );
+    p256_mul( T3, T3, P->X );
+    p256_add( T1, T3, T3 );
+    p256_sqr( X, T2 );
+    p256_sub( X, X, T1 );
+    p256_sub( X, X, T4 );
+    p256_sub( T3, T3, X );
+    p256_mul( T3, T3, T2 );
+    p256_mul( T4, T4, P->Y );
+    p256_sub( Y, T3, T4 );
+
+    memcpy( R->X, X, sizeof( p256_fe ) );
+    memcpy( R->Y, Y, sizeof( p256_fe ) );
+}
+
+/*
+ * Normalize jacobian coordinates so that Z == 1 (GECC 3.2.1)
+ * The point must not be zero.
+ *
+ * Cost: 1N := 1I + 3M + 1S
+ */
+static void p256_normalize_jac( p256_jac *P )
+{
+    p256_fe zi, zzi;
+
+    p256_inv( zi, P->Z );
+    p256_sqr( zzi, zi );
+    p256_mul( P->X, P->X, zzi );
+    p256_mul( zzi, zzi, zi );
+    p256_mul( P->Y, P->Y, zzi );
+    memcpy( P->Z, p256_one, sizeof( p256_fe ) );
+}
+
+/*
+ * Normalize jacobian coordinates of an array of (pointers to) points,
+ * using Montgomery's trick to perform only one inversion mod p
+ * (see ecp_normalize_jac_many()). The points must not be zero.
+ *
+ * Cost: 1N(t) := 1I + (6t - 3)M + 1S
+ */
+static int p256_normalize_jac_many( p256_jac *T[], size_t t_len )
+{
+    int ret = 0;
+    size_t i;
+    p256_fe *c, u, zi, zzi;
+
+    if( t_len < 2 )
+    {
+        if( t_len == 1 )
+            p256_normalize_jac( T[0] );
+        return( 0 );
+    }
+
+    if( ( c = mbedtls_calloc( t_len, sizeof( p256_fe ) ) ) == NULL )
+        return( MBEDTLS_ERR_ECP_ALLOC_FAILED );
+
+    /* c[i] = Z_0 * ... * Z_i */
+    memcpy( c[0], T[0]->Z, sizeof( p256_fe ) );
+    for( i = 1; i < t_len; i++ )
+        p256_mul( c[i], c[i-1], T[i]->Z );
+
+    if( p256_is_zero( c[t_len-1] ) )
+    {
+        ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+        goto cleanup;
+    }
+
+    /* u = 1 / (Z_0 * ... * Z_n) */
+    p256_inv( u, c[t_len-1] );
+
+    for( i = t_len - 1; ; i-- )
+    {
+        /* zi = 1 / Z_i and u = 1 / (Z_0 * ... * Z_i-1) */
+        if( i == 0 )
+            memcpy( zi, u, sizeof( p256_fe ) );
+        else
+        {
+            p256_mul( zi, u, c[i-1] );
+            p256_mul( u, u, T[i]->Z );
+        }
+
+        p256_sqr( zzi, zi );
+        p256_mul( T[i]->X, T[i]->X, zzi );
+        p256_mul( zzi, zzi, zi );
+        p256_mul( T[i]->Y, T[i]->Y, zzi );
+        memcpy( T[i]->Z, p256_one, sizeof( p256_fe ) );
+
+        if( i == 0 )
+            break;
+    }
+
+cleanup:
+    mbedtls_free( c );
+
+    return( ret );
+}
+
+/*
+ * Precompute points for the comb method, see ecp_precompute_comb()
+ *
+ * T[i] = i_{w-1} 2^{(w-1)d} P + ... + i_1 2^d P + P
+ *
+ * T must be able to hold 2^{w - 1} elements.
+ */
+static int p256_precompute_comb( p256_aff T[], const p256_aff *P,
+                                 unsigned char w, size_t d )
+{
+    int ret;
+    size_t i, j, k, pre_len = (size_t) 1 << ( w - 1 );
+    p256_jac *J, *TT[P256_COMB_PRE_G];
+    p256_aff Ti;
+
+    if( ( J = mbedtls_calloc( pre_len, sizeof( p256_jac ) ) ) == NULL )
+        return( MBEDTLS_ERR_ECP_ALLOC_FAILED );
+
+    /*
+     * Set J[0] = P and
+     * J[2^{l-1}] = 2^{dl} P for l = 1 .. w-1 (this is not the final value)
+     */
+    memcpy( J[0].X, P->x, sizeof( p256_fe ) );
+    memcpy( J[0].Y, P->y, sizeof( p256_fe ) );
+    memcpy( J[0].Z, p256_one, sizeof( p256_fe ) );
+
+    k = 0;
+    for( i = 1; i < pre_len; i <<= 1 )
+    {
+        J[i] = J[i >> 1];
+        for( j = 0; j < d; j++ )
+            p256_double_jac( &J[i], &J[i] );
+
+        TT[k++] = &J[i];
+    }
+
+    MBEDTLS_MPI_CHK( p256_normalize_jac_many( TT, k ) );
+
+    /*
+     * Compute the remaining ones using the minimal number of additions
+     * Be careful to update J[2^l] only after using it!
+     */
+    k = 0;
+    for( i = 1; i < pre_len; i <<= 1 )
+    {
+        memcpy( Ti.x, J[i].X, sizeof( p256_fe ) );
+        memcpy( Ti.y, J[i].Y, sizeof( p256_fe ) );
+
+        j = i;
+        while( j-- )
+        {
+            p256_add_mixed( &J[i + j], &J[j], &Ti );
+            TT[k++] = &J[i + j];
+        }
+    }
+
+    MBEDTLS_MPI_CHK( p256_normalize_jac_many( TT, k ) );
+
+    for( i = 0; i < pre_len; i++ )
+    {
+        memcpy( T[i].x, J[i].X, sizeof( p256_fe ) );
+        memcpy( T[i].y, J[i].Y, sizeof( p256_fe ) );
+    }
+
+cleanup:
+    mbedtls_free( J );
+
+    return( ret );
+}
+
+/*
+ * Compute the representation of k used by the comb method, see
+ * ecp_comb_fixed() for the details. k must be odd.
+ */
+static void p256_comb_recode( unsigned char x[], size_t d, unsigned char w,
+                              const uint32_t k[8] )
+{
+    size_t i, j, b;
+    unsigned char c, cc, adjust;
+
+    memset( x, 0, d + 1 );
+
+    /* First get the classical comb values (except for x_d = 0) */
+    for( i = 0; i < d; i++ )
+        for( j = 0; j < w; j++ )
+        {
+            b = i + d * j;
+            if( b < 256 )
+                x[i] |= ( ( k[b >> 5] >> ( b & 31 ) ) & 1 ) << j;
+        }
+
+    /* Now make sure x_1 .. x_d are odd */
+    c = 0;
+    for( i = 1; i <= d; i++ )
+    {
+        /* Add carry and update it */
+        cc   = x[i] & c;
+        x[i] = x[i] ^ c;
+        c = cc;
+
+        /* Adjust if needed, avoiding branches */
+        adjust = 1 - ( x[i] & 0x01 );
+        c   |= x[i] & ( x[i-1] * adjust );
+        x[i] = x[i] ^ ( x[i-1] * adjust );
+        x[i-1] |= adjust << 7;
+    }
+}
+
+/*
+ * Select precomputed point: R = sign(i) * T[ abs(i) / 2 ]
+ * Reads the whole table to thwart cache-based timing attacks.
+ */
+static void p256_select_comb( p256_aff *R, const p256_aff T[],
+                              size_t t_len, unsigned char i )
+{
+    size_t j;
+    unsigned char ii = ( i & 0x7Fu ) >> 1;
+
+    memset( R, 0, sizeof( p256_aff ) );
+
+    for( j = 0; j < t_len; j++ )
+    {
+        p256_cmov( R->x, T[j].x, j == ii );
+        p256_cmov( R->y, T[j].y, j == ii );
+    }
+
+    /* Safely invert result if i is "negative" */
+    p256_cneg( R->y, i >> 7 );
+}
+
+/*
+ * Randomize jacobian coordinates:
+ * (X, Y, Z) -> (l^2 X, l^3 Y, l Z) for random l
+ * This is sort of the reverse operation of p256_normalize_jac().
+ */
+static int p256_randomize_jac( const mbedtls_ecp_group *grp, p256_jac *P,
+                               int (*f_rng)(void *, unsigned char *, size_t),
+                               void *p_rng )
+{
+    int ret;
+    int count = 0;
+    mbedtls_mpi l;
+    p256_fe fl, ll;
+
+    mbedtls_mpi_init( &l );
+
+    /* Generate l such that 1 < l < p */
+    do
+    {
+        MBEDTLS_MPI_CHK( mbedtls_mpi_fill_random( &l, 32, f_rng, p_rng ) );
+
+        while( mbedtls_mpi_cmp_mpi( &l, &grp->P ) >= 0 )
+            MBEDTLS_MPI_CHK( mbedtls_mpi_shift_r( &l, 1 ) );
+
+        if( count++ > 10 )
+        {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+    }
+    while( mbedtls_mpi_cmp_int( &l, 1 ) <= 0 );
+
+    /* Any value in ]1, p[ will do, no need to convert to Montgomery form */
+    MBEDTLS_MPI_CHK( p256_from_mpi( fl, &l ) );
+
+    p256_mul( P->Z, P->Z, fl );
+    p256_sqr( ll, fl );
+    p256_mul( P->X, P->X, ll );
+    p256_mul( ll, ll, fl );
+    p256_mul( P->Y, P->Y, ll );
+
+cleanup:
+    mbedtls_mpi_free( &l );
+    mbedtls_zeroize( fl, sizeof( fl ) );
+    mbedtls_zeroize( ll, sizeof( ll ) );
+
+    return( ret );
+}
+
+#if MBEDTLS_ECP_P256_CACHE_SIZE > 0
+/*
+ * Cache of comb tables for points other than the generator
+ */
+typedef struct
+{
+    p256_aff P;                         /* base point, Montgomery form */
+    p256_aff T[P256_COMB_PRE];          /* its comb table */
+    unsigned long stamp;                /* last use, 0 if the slot is free */
+} p256_cache_entry;
+
+static p256_cache_entry p256_cache[MBEDTLS_ECP_P256_CACHE_SIZE];
+static unsigned long p256_cache_clock;
+
+/*
+ * Copy the table of P to T if it is cached, return 1 on hit
+ */
+static int p256_cache_get( const p256_aff *P, p256_aff T[] )
+{
+    int hit = 0;
+    size_t i;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &mbedtls_threading_ecp_p256_mutex ) != 0 )
+        return( 0 );
+#endif
+
+    for( i = 0; i < MBEDTLS_ECP_P256_CACHE_SIZE; i++ )
+    {
+        if( p256_cache[i].stamp != 0 &&
+            memcmp( &p256_cache[i].P, P, sizeof( p256_aff ) ) == 0 )
+        {
+            memcpy( T, p256_cache[i].T, sizeof( p256_cache[i].T ) );
+            p256_cache[i].stamp = ++p256_cache_clock;
+            hit = 1;
+            break;
+        }
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &mbedtls_threading_ecp_p256_mutex );
+#endif
+
+    return( hit );
+}
+
+/*
+ * Store the table of P, replacing the least recently used entry
+ */
+static void p256_cache_put( const p256_aff *P, const p256_aff T[] )
+{
+    size_t i, lru = 0;
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &mbedtls_threading_ecp_p256_mutex ) != 0 )
+        return;
+#endif
+
+    for( i = 1; i < MBEDTLS_ECP_P256_CACHE_SIZE; i++ )
+    {
+        if( p256_cache[i].stamp < p256_cache[lru].stamp )
+            lru = i;
+    }
+
+    memcpy( &p256_cache[lru].P, P, sizeof( p256_aff ) );
+    memcpy( p256_cache[lru].T, T, sizeof( p256_cache[lru].T ) );
+    p256_cache[lru].stamp = ++p256_cache_clock;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &mbedtls_threading_ecp_p256_mutex );
+#endif
+}
+#endif /* MBEDTLS_ECP_P256_CACHE_SIZE > 0 */
+
+/*
+ * Drop all cached comb tables
+ */
+void mbedtls_ecp_p256_cache_flush( void )
+{
+#if MBEDTLS_ECP_P256_CACHE_SIZE > 0
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &mbedtls_threading_ecp_p256_mutex ) != 0 )
+        return;
+#endif
+
+    mbedtls_zeroize( p256_cache, sizeof( p256_cache ) );
+    p256_cache_clock = 0;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &mbedtls_threading_ecp_p256_mutex );
+#endif
+#endif /* MBEDTLS_ECP_P256_CACHE_SIZE > 0 */
+}
+
+/*
+ * Load an affine point into Montgomery form
+ */
+static int p256_load_point( p256_aff *A, const mbedtls_ecp_point *P )
+{
+    int ret;
+
+    MBEDTLS_MPI_CHK( p256_from_mpi( A->x, &P->X ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( A->y, &P->Y ) );
+    p256_mul( A->x, A->x, p256_rr );
+    p256_mul( A->y, A->y, p256_rr );
+
+cleanup:
+    return( ret );
+}
+
+/*
+ * Multiplication R = m * P with the comb method, see ecp_mul_comb()
+ */
+int mbedtls_ecp_p256_mul( const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                          int (*f_rng)(void *, unsigned char *, size_t),
+                          void *p_rng, int cache )
+{
+    int ret;
+    unsigned char w, m_is_odd;
+    unsigned char x[P256_COMB_D + 1];
+    size_t i, d, pre_len;
+    uint32_t k[8];
+    const p256_aff *T;
+    p256_aff Tl[P256_COMB_PRE], Pa, Txi;
+    p256_jac Rj;
+    mbedtls_mpi M, mm;
+
+    mbedtls_mpi_init( &M );
+    mbedtls_mpi_init( &mm );
+
+    /*
+     * The generator uses the table in ROM, other points get a table
+     * computed now, or found in the cache
+     */
+    if( mbedtls_mpi_cmp_mpi( &P->Y, &grp->G.Y ) == 0 &&
+        mbedtls_mpi_cmp_mpi( &P->X, &grp->G.X ) == 0 )
+    {
+        w = P256_COMB_W_G;
+        d = P256_COMB_D_G;
+        T = p256_comb_g;
+    }
+    else
+    {
+        w = P256_COMB_W;
+        d = P256_COMB_D;
+        T = Tl;
+
+        MBEDTLS_MPI_CHK( p256_load_point( &Pa, P ) );
+
+#if MBEDTLS_ECP_P256_CACHE_SIZE > 0
+        if( cache == 0 || p256_cache_get( &Pa, Tl ) == 0 )
+        {
+            MBEDTLS_MPI_CHK( p256_precompute_comb( Tl, &Pa, w, d ) );
+            if( cache != 0 )
+                p256_cache_put( &Pa, Tl );
+        }
+#else
+        ((void) cache);
+        MBEDTLS_MPI_CHK( p256_precompute_comb( Tl, &Pa, w, d ) );
+#endif
+    }
+    pre_len = (size_t) 1 << ( w - 1 );
+
+    /*
+     * Make sure M is odd (M = m or M = N - m, since N is odd)
+     * using the fact that m * P = - (N - m) * P
+     */
+    m_is_odd = ( mbedtls_mpi_get_bit( m, 0 ) == 1 );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_copy( &M, m ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_sub_mpi( &mm, &grp->N, m ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_safe_cond_assign( &M, &mm, ! m_is_odd ) );
+    MBEDTLS_MPI_CHK( p256_from_mpi( k, &M ) );
+
+    p256_comb_recode( x, d, w, k );
+
+    /*
+     * Comb core, see ecp_mul_comb_core(): start with a non-zero point and
+     * randomize its coordinates
+     */
+    i = d;
+    p256_select_comb( &Txi, T, pre_len, x[i] );
+    memcpy( Rj.X, Txi.x, sizeof( p256_fe ) );
+    memcpy( Rj.Y, Txi.y, sizeof( p256_fe ) );
+    memcpy( Rj.Z, p256_one, sizeof( p256_fe ) );
+    if( f_rng != 0 )
+        MBEDTLS_MPI_CHK( p256_randomize_jac( grp, &Rj, f_rng, p_rng ) );
+
+    while( i-- != 0 )
+    {
+        p256_double_jac( &Rj, &Rj );
+        p256_select_comb( &Txi, T, pre_len, x[i] );
+        p256_add_mixed( &Rj, &Rj, &Txi );
+    }
+
+    /*
+     * Now get m * P from M * P and normalize it
+     */
+    p256_cneg( Rj.Y, ! m_is_odd );
+
+    if( p256_is_zero( Rj.Z ) )
+    {
+        MBEDTLS_MPI_CHK( mbedtls_ecp_set_zero( R ) );
+        goto cleanup;
+    }
+
+    p256_normalize_jac( &Rj );
+    p256_mul( Rj.X, Rj.X, p256_unit );
+    p256_mul( Rj.Y, Rj.Y, p256_unit );
+
+    MBEDTLS_MPI_CHK( p256_to_mpi( &R->X, Rj.X ) );
+    MBEDTLS_MPI_CHK( p256_to_mpi( &R->Y, Rj.Y ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_lset( &R->Z, 1 ) );
+
+cleanup:
+
+    mbedtls_zeroize( k, sizeof( k ) );
+    mbedtls_zeroize( x, sizeof( x ) );
+    mbedtls_zeroize( &Rj, sizeof( Rj ) );
+    mbedtls_zeroize( &Txi, sizeof( Txi ) );
+    mbedtls_mpi_free( &M );
+    mbedtls_mpi_free( &mm );
+
+    if( ret != 0 )
+        mbedtls_ecp_point_free( R );
+
+    return( ret );
+}
+
+#if defined(MBEDTLS_SELF_TEST)
+
+/*
+ * Check the ROM table against a freshly computed one
+ */
+int mbedtls_ecp_p256_self_test( const mbedtls_ecp_group *grp )
+{
+    int ret;
+    p256_aff G, *T;
+
+    if( ( T = mbedtls_calloc( P256_COMB_PRE_G, sizeof( p256_aff ) ) ) == NULL )
+        return( MBEDTLS_ERR_ECP_ALLOC_FAILED );
+
+    MBEDTLS_MPI_CHK( p256_load_point( &G, &grp->G ) );
+    MBEDTLS_MPI_CHK( p256_precompute_comb( T, &G, P256_COMB_W_G, P256_COMB_D_G ) );
+
+    if( memcmp( T, p256_comb_g, sizeof( p256_comb_g ) ) != 0 )
+        ret = 1;
+
+cleanup:
+    mbedtls_free( T );
+
+    return( ret );
+}
+
+#endif /* MBEDTLS_SELF_TEST */
+
+#endif /* !MBEDTLS_ECP_ALT */
+
+#endif /* MBEDTLS_ECP_C && MBEDTLS_ECP_P256_OPTIM */
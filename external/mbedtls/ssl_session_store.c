@@ -0,0 +1,632 @@
+/****************************************************************************
+ *
+ * Copyright 2019 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ *  Client-side TLS session store
+ *
+ *  A fixed number of slots, each holding the serialized session for one
+ *  "host:port/sni" key. Sessions are serialized without the peer
+ *  certificate, which is not needed to resume, so that an entry costs a few
+ *  hundred bytes and can be written to a file as is.
+ */
+
+#include "mbedtls/config.h"
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_calloc    calloc
+#define mbedtls_free      free
+#define mbedtls_snprintf  snprintf
+#endif
+
+#include "mbedtls/ssl_session_store.h"
+
+#if defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+
+#include <string.h>
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+#include <stdio.h>
+#endif
+
+/* Implementation that should never be optimized out by the compiler */
+static void mbedtls_zeroize( void *v, size_t n ) {
+    volatile unsigned char *p = v; while( n-- ) *p++ = 0;
+}
+
+/*
+ * Serialized session, without the ticket:
+ *   0  ciphersuite (2)        2  compression (1)       3  id_len (1)
+ *   4  id (32)               36  master (48)          84  verify_result (4)
+ *  88  mfl_code (1)          89  trunc_hmac (1)       90  encrypt_then_mac (1)
+ *  91  peer record limit (2) 93  own record limit (2) 95  ticket_lifetime (4)
+ *  99  ticket_len (2)       101  ticket
+ */
+#define SSL_STORE_SESSION_LEN   101
+
+/* File header and per-entry header */
+#define SSL_STORE_FILE_MAGIC    "TSS1"
+#define SSL_STORE_RECORD_LEN    16
+
+/* Longest key: two host names, port and separators */
+#define SSL_STORE_MAX_KEY_LEN   ( 2 * MBEDTLS_SSL_MAX_HOST_NAME_LEN + 8 )
+
+typedef struct
+{
+    char *key;                  /*!< "host:port/sni", NULL if unused    */
+    unsigned char *data;        /*!< serialized session                 */
+    size_t len;                 /*!< length of data                     */
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_time_t stored;      /*!< time the session was saved         */
+#endif
+    uint32_t lifetime;          /*!< seconds the session can be resumed */
+    unsigned long stamp;        /*!< last use, for LRU replacement      */
+} ssl_store_entry;
+
+static ssl_store_entry ssl_store[MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES];
+static unsigned long ssl_store_clock;
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+static int ssl_store_loaded;
+#endif
+
+#define PUT_UINT16( p, v )                          \
+    do {                                            \
+        (p)[0] = (unsigned char)( (v) >> 8 );       \
+        (p)[1] = (unsigned char)( (v)      );       \
+    } while( 0 )
+
+#define PUT_UINT32( p, v )                          \
+    do {                                            \
+        (p)[0] = (unsigned char)( (v) >> 24 );      \
+        (p)[1] = (unsigned char)( (v) >> 16 );      \
+        (p)[2] = (unsigned char)( (v) >>  8 );      \
+        (p)[3] = (unsigned char)( (v)       );      \
+    } while( 0 )
+
+#define GET_UINT16( p )                             \
+    ( ( (uint16_t) (p)[0] << 8 ) | (uint16_t) (p)[1] )
+
+#define GET_UINT32( p )                             \
+    ( ( (uint32_t) (p)[0] << 24 ) | ( (uint32_t) (p)[1] << 16 ) |   \
+      ( (uint32_t) (p)[2] <<  8 ) | ( (uint32_t) (p)[3]       ) )
+
+static void ssl_store_entry_free( ssl_store_entry *e )
+{
+    mbedtls_free( e->key );
+
+    if( e->data != NULL )
+    {
+        mbedtls_zeroize( e->data, e->len );
+        mbedtls_free( e->data );
+    }
+
+    memset( e, 0, sizeof( ssl_store_entry ) );
+}
+
+static ssl_store_entry *ssl_store_find( const char *key )
+{
+    size_t i;
+
+    for( i = 0; i < MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES; i++ )
+    {
+        if( ssl_store[i].key != NULL && strcmp( ssl_store[i].key, key ) == 0 )
+            return( &ssl_store[i] );
+    }
+
+    return( NULL );
+}
+
+/*
+ * Free slot, or least recently used one
+ */
+static ssl_store_entry *ssl_store_victim( void )
+{
+    size_t i, lru = 0;
+
+    for( i = 0; i < MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES; i++ )
+    {
+        if( ssl_store[i].key == NULL )
+            return( &ssl_store[i] );
+
+        if( ssl_store[i].stamp < ssl_store[lru].stamp )
+            lru = i;
+    }
+
+    return( &ssl_store[lru] );
+}
+
+static int ssl_store_expired( const ssl_store_entry *e )
+{
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_time_t now = mbedtls_time( NULL );
+
+    /*
+     * A clock that went backwards (no RTC and not synchronized yet after a
+     * reboot) tells nothing: keep the entry, the server refuses it if it is
+     * too old and we fall back to a full handshake.
+     */
+    if( now < e->stored )
+        return( 0 );
+
+    return( (uint64_t)( now - e->stored ) > e->lifetime );
+#else
+    ((void) e);
+    return( 0 );
+#endif
+}
+
+/*
+ * Build the key of a connection: "host:port/sni"
+ */
+static char *ssl_store_key( const mbedtls_ssl_context *ssl,
+                            const char *host, int port )
+{
+    const char *sni = "";
+    size_t len;
+    char *key;
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if( ssl->hostname != NULL )
+        sni = ssl->hostname;
+#else
+    ((void) ssl);
+#endif
+
+    len = strlen( host ) + strlen( sni ) + 8;
+    if( len > SSL_STORE_MAX_KEY_LEN )
+        return( NULL );
+
+    if( ( key = mbedtls_calloc( 1, len ) ) == NULL )
+        return( NULL );
+
+    mbedtls_snprintf( key, len, "%s:%d/%s", host, port, sni );
+
+    return( key );
+}
+
+static int ssl_store_check_args( const mbedtls_ssl_context *ssl,
+                                 const char *host, int port )
+{
+    if( ssl == NULL || ssl->conf == NULL || host == NULL ||
+        port <= 0 || port > 0xFFFF ||
+        ssl->conf->endpoint != MBEDTLS_SSL_IS_CLIENT )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+/*
+ * Session serialization, see the layout above
+ */
+static void ssl_store_write_session( unsigned char *p,
+                                     const mbedtls_ssl_session *session,
+                                     size_t ticket_len )
+{
+    memset( p, 0, SSL_STORE_SESSION_LEN );
+
+    PUT_UINT16( p, session->ciphersuite );
+    p[2] = (unsigned char) session->compression;
+    p[3] = (unsigned char) session->id_len;
+    memcpy( p + 4, session->id, 32 );
+    memcpy( p + 36, session->master, 48 );
+    PUT_UINT32( p + 84, session->verify_result );
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    p[88] = session->mfl_code;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    p[89] = (unsigned char) session->trunc_hmac;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    p[90] = (unsigned char) session->encrypt_then_mac;
+#endif
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    PUT_UINT16( p + 91, session->peer_record_size_limit );
+    PUT_UINT16( p + 93, session->own_record_size_limit );
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    PUT_UINT32( p + 95, session->ticket_lifetime );
+    PUT_UINT16( p + 99, ticket_len );
+    if( ticket_len > 0 )
+        memcpy( p + SSL_STORE_SESSION_LEN, session->ticket, ticket_len );
+#else
+    ((void) ticket_len);
+#endif
+}
+
+static int ssl_store_read_session( mbedtls_ssl_session *session,
+                                   const unsigned char *p, size_t len )
+{
+    size_t ticket_len;
+
+    if( len < SSL_STORE_SESSION_LEN || p[3] > 32 )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    ticket_len = GET_UINT16( p + 99 );
+    if( len != SSL_STORE_SESSION_LEN + ticket_len )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    session->ciphersuite = GET_UINT16( p );
+    session->compression = p[2];
+    session->id_len = p[3];
+    memcpy( session->id, p + 4, 32 );
+    memcpy( session->master, p + 36, 48 );
+    session->verify_result = GET_UINT32( p + 84 );
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    session->mfl_code = p[88];
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    session->trunc_hmac = p[89];
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    session->encrypt_then_mac = p[90];
+#endif
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    session->peer_record_size_limit = GET_UINT16( p + 91 );
+    session->own_record_size_limit = GET_UINT16( p + 93 );
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    session->ticket_lifetime = GET_UINT32( p + 95 );
+    if( ticket_len > 0 )
+    {
+        if( ( session->ticket = mbedtls_calloc( 1, ticket_len ) ) == NULL )
+            return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+
+        memcpy( session->ticket, p + SSL_STORE_SESSION_LEN, ticket_len );
+        session->ticket_len = ticket_len;
+    }
+#else
+    /* A ticket is useless without ticket support */
+    if( ticket_len > 0 && session->id_len == 0 )
+        return( MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE );
+#endif
+
+    return( 0 );
+}
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+/*
+ * File format: magic, then for each entry
+ *   key_len (2) data_len (2) stored (8) lifetime (4) key data
+ */
+static void ssl_store_write_file( void )
+{
+    FILE *f;
+    size_t i;
+    uint64_t stored;
+    unsigned char hdr[SSL_STORE_RECORD_LEN];
+
+    if( ( f = fopen( MBEDTLS_SSL_SESSION_STORE_FILE, "wb" ) ) == NULL )
+        return;
+
+    if( fwrite( SSL_STORE_FILE_MAGIC, 1, 4, f ) != 4 )
+        goto exit;
+
+    for( i = 0; i < MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES; i++ )
+    {
+        const ssl_store_entry *e = &ssl_store[i];
+        size_t key_len;
+
+        if( e->key == NULL )
+            continue;
+
+        key_len = strlen( e->key );
+#if defined(MBEDTLS_HAVE_TIME)
+        stored = (uint64_t) e->stored;
+#else
+        stored = 0;
+#endif
+        PUT_UINT16( hdr, key_len );
+        PUT_UINT16( hdr + 2, e->len );
+        PUT_UINT32( hdr + 4, (uint32_t)( stored >> 32 ) );
+        PUT_UINT32( hdr + 8, (uint32_t) stored );
+        PUT_UINT32( hdr + 12, e->lifetime );
+
+        if( fwrite( hdr, 1, sizeof( hdr ), f ) != sizeof( hdr ) ||
+            fwrite( e->key, 1, key_len, f ) != key_len ||
+            fwrite( e->data, 1, e->len, f ) != e->len )
+            goto exit;
+    }
+
+exit:
+    fclose( f );
+}
+
+static void ssl_store_read_file( void )
+{
+    FILE *f;
+    size_t i, key_len, len;
+    uint64_t stored;
+    unsigned char hdr[SSL_STORE_RECORD_LEN];
+    ssl_store_entry *e;
+
+    if( ( f = fopen( MBEDTLS_SSL_SESSION_STORE_FILE, "rb" ) ) == NULL )
+        return;
+
+    if( fread( hdr, 1, 4, f ) != 4 ||
+        memcmp( hdr, SSL_STORE_FILE_MAGIC, 4 ) != 0 )
+        goto exit;
+
+    for( i = 0; i < MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES; i++ )
+    {
+        if( fread( hdr, 1, sizeof( hdr ), f ) != sizeof( hdr ) )
+            break;
+
+        key_len = GET_UINT16( hdr );
+        len = GET_UINT16( hdr + 2 );
+        if( key_len == 0 || key_len > SSL_STORE_MAX_KEY_LEN ||
+            len < SSL_STORE_SESSION_LEN ||
+            len > SSL_STORE_SESSION_LEN + MBEDTLS_SSL_SESSION_STORE_MAX_TICKET_LEN )
+            break;
+
+        e = &ssl_store[i];
+        e->key = mbedtls_calloc( 1, key_len + 1 );
+        e->data = mbedtls_calloc( 1, len );
+        if( e->key == NULL || e->data == NULL ||
+            fread( e->key, 1, key_len, f ) != key_len ||
+            fread( e->data, 1, len, f ) != len )
+        {
+            e->len = len;
+            ssl_store_entry_free( e );
+            break;
+        }
+
+        stored = ( (uint64_t) GET_UINT32( hdr + 4 ) << 32 ) | GET_UINT32( hdr + 8 );
+        e->len = len;
+#if defined(MBEDTLS_HAVE_TIME)
+        e->stored = (mbedtls_time_t) stored;
+#else
+        ((void) stored);
+#endif
+        e->lifetime = GET_UINT32( hdr + 12 );
+        e->stamp = ++ssl_store_clock;
+
+        if( ssl_store_expired( e ) )
+            ssl_store_entry_free( e );
+    }
+
+exit:
+    mbedtls_zeroize( hdr, sizeof( hdr ) );
+    fclose( f );
+}
+#endif /* MBEDTLS_SSL_SESSION_STORE_FILE */
+
+/*
+ * Take the store lock, reading the persistent copy on first use
+ */
+static int ssl_store_lock( void )
+{
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &mbedtls_threading_ssl_session_store_mutex ) != 0 )
+        return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+    if( ssl_store_loaded == 0 )
+    {
+        ssl_store_read_file();
+        ssl_store_loaded = 1;
+    }
+#endif
+
+    return( 0 );
+}
+
+static void ssl_store_unlock( int changed )
+{
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+    if( changed )
+        ssl_store_write_file();
+#else
+    ((void) changed);
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &mbedtls_threading_ssl_session_store_mutex );
+#endif
+}
+
+int mbedtls_ssl_session_store_load( mbedtls_ssl_context *ssl,
+                                    const char *host, int port )
+{
+    int ret = 1;
+    char *key;
+    ssl_store_entry *e;
+    mbedtls_ssl_session session;
+
+    if( ( ret = ssl_store_check_args( ssl, host, port ) ) != 0 )
+        return( ret );
+
+    if( ( key = ssl_store_key( ssl, host, port ) ) == NULL )
+        return( 1 );
+
+    mbedtls_ssl_session_init( &session );
+
+    if( ssl_store_lock() != 0 )
+    {
+        mbedtls_free( key );
+        return( 1 );
+    }
+
+    ret = 1;
+    e = ssl_store_find( key );
+    if( e != NULL && ssl_store_expired( e ) )
+    {
+        ssl_store_entry_free( e );
+        e = NULL;
+    }
+
+    if( e != NULL && ssl_store_read_session( &session, e->data, e->len ) == 0 )
+    {
+        /* Do not skip a verification the caller requires */
+        if( ssl->conf->authmode != MBEDTLS_SSL_VERIFY_REQUIRED ||
+            session.verify_result == 0 )
+        {
+            e->stamp = ++ssl_store_clock;
+            ret = 0;
+        }
+    }
+
+    ssl_store_unlock( 0 );
+
+    if( ret == 0 )
+        ret = mbedtls_ssl_set_session( ssl, &session );
+
+    mbedtls_ssl_session_free( &session );
+    mbedtls_free( key );
+
+    return( ret );
+}
+
+int mbedtls_ssl_session_store_save( const mbedtls_ssl_context *ssl,
+                                    const char *host, int port )
+{
+    int ret;
+    int changed = 1;
+    const mbedtls_ssl_session *session;
+    size_t len, ticket_len = 0;
+    uint32_t lifetime = MBEDTLS_SSL_SESSION_STORE_TIMEOUT;
+    unsigned char *data;
+    char *key;
+    ssl_store_entry *e;
+
+    if( ( ret = ssl_store_check_args( ssl, host, port ) ) != 0 )
+        return( ret );
+
+    if( ssl->session == NULL || ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    session = ssl->session;
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    if( session->ticket != NULL &&
+        session->ticket_len <= MBEDTLS_SSL_SESSION_STORE_MAX_TICKET_LEN )
+    {
+        ticket_len = session->ticket_len;
+        if( session->ticket_lifetime != 0 && session->ticket_lifetime < lifetime )
+            lifetime = session->ticket_lifetime;
+    }
+#endif
+
+    /* Nothing the server could resume */
+    if( session->id_len == 0 && ticket_len == 0 )
+    {
+        mbedtls_ssl_session_store_remove( ssl, host, port );
+        return( 0 );
+    }
+
+    if( ( key = ssl_store_key( ssl, host, port ) ) == NULL )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    len = SSL_STORE_SESSION_LEN + ticket_len;
+    if( ( data = mbedtls_calloc( 1, len ) ) == NULL )
+    {
+        mbedtls_free( key );
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+    }
+
+    ssl_store_write_session( data, session, ticket_len );
+
+    if( ( ret = ssl_store_lock() ) != 0 )
+    {
+        mbedtls_zeroize( data, len );
+        mbedtls_free( data );
+        mbedtls_free( key );
+        return( ret );
+    }
+
+    e = ssl_store_find( key );
+    if( e != NULL && e->len == len && memcmp( e->data, data, len ) == 0 )
+    {
+        /* Resumed session, nothing new to remember */
+        e->stamp = ++ssl_store_clock;
+        changed = 0;
+
+        mbedtls_zeroize( data, len );
+        mbedtls_free( data );
+        mbedtls_free( key );
+    }
+    else
+    {
+        if( e == NULL )
+            e = ssl_store_victim();
+
+        ssl_store_entry_free( e );
+        e->key = key;
+        e->data = data;
+        e->len = len;
+#if defined(MBEDTLS_HAVE_TIME)
+        e->stored = mbedtls_time( NULL );
+#endif
+        e->lifetime = lifetime;
+        e->stamp = ++ssl_store_clock;
+    }
+
+    ssl_store_unlock( changed );
+
+    return( 0 );
+}
+
+void mbedtls_ssl_session_store_remove( const mbedtls_ssl_context *ssl,
+                                       const char *host, int port )
+{
+    char *key;
+    ssl_store_entry *e;
+
+    if( ssl_store_check_args( ssl, host, port ) != 0 ||
+        ( key = ssl_store_key( ssl, host, port ) ) == NULL )
+        return;
+
+    if( ssl_store_lock() == 0 )
+    {
+        if( ( e = ssl_store_find( key ) ) != NULL )
+            ssl_store_entry_free( e );
+
+        ssl_store_unlock( e != NULL );
+    }
+
+    mbedtls_free( key );
+}
+
+void mbedtls_ssl_session_store_flush( void )
+{
+    size_t i;
+
+    if( ssl_store_lock() != 0 )
+        return;
+
+    for( i = 0; i < MBEDTLS_SSL_SESSION_STORE_MAX_ENTRIES; i++ )
+        ssl_store_entry_free( &ssl_store[i] );
+
+    ssl_store_clock = 0;
+
+#if defined(MBEDTLS_SSL_SESSION_STORE_FILE)
+    remove( MBEDTLS_SSL_SESSION_STORE_FILE );
+#endif
+
+    ssl_store_unlock( 0 );
+}
+
+#endif /* MBEDTLS_SSL_SESSION_STORE_C */
@@ -180,6 +180,259 @@ static unsigned int mfl_code_to_length[MBEDTLS_SSL_MAX_FRAG_LEN_INVALID] =
 };
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+/*
+ * Point the record layer fields into the I/O buffers. The header fields stay
+ * at fixed offsets, in_msg / out_msg move once a transform with an explicit
+ * IV is active.
+ */
+static void ssl_reset_in_pointers( mbedtls_ssl_context *ssl )
+{
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+    {
+        ssl->in_hdr = ssl->in_buf;
+        ssl->in_ctr = ssl->in_buf +  3;
+        ssl->in_len = ssl->in_buf + 11;
+        ssl->in_iv  = ssl->in_buf + 13;
+        ssl->in_msg = ssl->in_buf + 13;
+    }
+    else
+#endif
+    {
+        ssl->in_ctr = ssl->in_buf;
+        ssl->in_hdr = ssl->in_buf +  8;
+        ssl->in_len = ssl->in_buf + 11;
+        ssl->in_iv  = ssl->in_buf + 13;
+        ssl->in_msg = ssl->in_buf + 13;
+    }
+}
+
+static void ssl_reset_out_pointers( mbedtls_ssl_context *ssl )
+{
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+    {
+        ssl->out_hdr = ssl->out_buf;
+        ssl->out_ctr = ssl->out_buf +  3;
+        ssl->out_len = ssl->out_buf + 11;
+        ssl->out_iv  = ssl->out_buf + 13;
+        ssl->out_msg = ssl->out_buf + 13;
+    }
+    else
+#endif
+    {
+        ssl->out_ctr = ssl->out_buf;
+        ssl->out_hdr = ssl->out_buf +  8;
+        ssl->out_len = ssl->out_buf + 11;
+        ssl->out_iv  = ssl->out_buf + 13;
+        ssl->out_msg = ssl->out_buf + 13;
+    }
+}
+
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/*
+ * Variable length record buffers (stream transport only).
+ *
+ * The input buffer is allocated for MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN and
+ * grows in mbedtls_ssl_fetch_input() when a larger record arrives. The
+ * output buffer is full size during the handshake, since handshake messages
+ * are not fragmented on output, and is shrunk to the negotiated output limit
+ * afterwards. Application data is then split to that limit anyway.
+ *
+ * Resizing allocates the new buffer first, copies the live part over and
+ * rebases every pointer into the buffer, so a failed allocation leaves the
+ * context untouched.
+ */
+#define SSL_BUFFER_LEN_FOR( content_len )                   \
+    ( MBEDTLS_SSL_HEADER_LEN + ( content_len ) + MBEDTLS_SSL_PAYLOAD_OVERHEAD )
+
+#define SSL_REBASE( ptr, old, new )                         \
+    do { ( ptr ) = ( new ) + ( ( ptr ) - ( old ) ); } while( 0 )
+
+static int ssl_variable_buffers( const mbedtls_ssl_context *ssl )
+{
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+        return( 0 );
+#else
+    ((void) ssl);
+#endif
+    return( 1 );
+}
+
+static int ssl_resize_in_buf( mbedtls_ssl_context *ssl, size_t len )
+{
+    unsigned char *buf;
+    size_t keep;
+
+    if( len > MBEDTLS_SSL_IN_BUFFER_LEN )
+        len = MBEDTLS_SSL_IN_BUFFER_LEN;
+
+    if( ssl->in_buf == NULL || len == ssl->in_buf_len )
+        return( 0 );
+
+    /*
+     * Keep the counter / header area, the partial record read so far and
+     * whatever is left of the current (decrypted) message.
+     */
+    keep = (size_t)( ssl->in_hdr - ssl->in_buf ) + ssl->in_left;
+    if( keep < MBEDTLS_SSL_HEADER_LEN )
+        keep = MBEDTLS_SSL_HEADER_LEN;
+    if( ssl->in_msglen != 0 &&
+        (size_t)( ssl->in_msg - ssl->in_buf ) + ssl->in_msglen > keep )
+    {
+        keep = (size_t)( ssl->in_msg - ssl->in_buf ) + ssl->in_msglen;
+    }
+    if( keep > ssl->in_buf_len )
+        keep = ssl->in_buf_len;
+
+    /* Still in use, shrink later */
+    if( keep > len )
+        return( 0 );
+
+    if( ( buf = mbedtls_calloc( 1, len ) ) == NULL )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+    }
+
+    memcpy( buf, ssl->in_buf, keep );
+
+    SSL_REBASE( ssl->in_ctr, ssl->in_buf, buf );
+    SSL_REBASE( ssl->in_hdr, ssl->in_buf, buf );
+    SSL_REBASE( ssl->in_len, ssl->in_buf, buf );
+    SSL_REBASE( ssl->in_iv,  ssl->in_buf, buf );
+    SSL_REBASE( ssl->in_msg, ssl->in_buf, buf );
+    if( ssl->in_offt != NULL )
+        SSL_REBASE( ssl->in_offt, ssl->in_buf, buf );
+
+    mbedtls_zeroize( ssl->in_buf, ssl->in_buf_len );
+    mbedtls_free( ssl->in_buf );
+
+    MBEDTLS_SSL_DEBUG_MSG( 3, ( "input buffer resized from %d to %d bytes",
+                                ssl->in_buf_len, len ) );
+
+    ssl->in_buf = buf;
+    ssl->in_buf_len = len;
+
+    return( 0 );
+}
+
+static int ssl_resize_out_buf( mbedtls_ssl_context *ssl, size_t len )
+{
+    unsigned char *buf;
+    size_t keep;
+
+    if( len > MBEDTLS_SSL_OUT_BUFFER_LEN )
+        len = MBEDTLS_SSL_OUT_BUFFER_LEN;
+
+    if( ssl->out_buf == NULL || len == ssl->out_buf_len )
+        return( 0 );
+
+    /* Keep the counter / header area and a record not completely sent */
+    keep = MBEDTLS_SSL_HEADER_LEN;
+    if( ssl->out_left != 0 )
+        keep = (size_t)( ssl->out_msg - ssl->out_buf ) + ssl->out_msglen;
+    if( keep > ssl->out_buf_len )
+        keep = ssl->out_buf_len;
+
+    if( keep > len )
+        return( 0 );
+
+    if( ( buf = mbedtls_calloc( 1, len ) ) == NULL )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+    }
+
+    memcpy( buf, ssl->out_buf, keep );
+
+    SSL_REBASE( ssl->out_ctr, ssl->out_buf, buf );
+    SSL_REBASE( ssl->out_hdr, ssl->out_buf, buf );
+    SSL_REBASE( ssl->out_len, ssl->out_buf, buf );
+    SSL_REBASE( ssl->out_iv,  ssl->out_buf, buf );
+    SSL_REBASE( ssl->out_msg, ssl->out_buf, buf );
+
+    mbedtls_zeroize( ssl->out_buf, ssl->out_buf_len );
+    mbedtls_free( ssl->out_buf );
+
+    MBEDTLS_SSL_DEBUG_MSG( 3, ( "output buffer resized from %d to %d bytes",
+                                ssl->out_buf_len, len ) );
+
+    ssl->out_buf = buf;
+    ssl->out_buf_len = len;
+
+    return( 0 );
+}
+
+/*
+ * Size the buffers for the negotiated limits once the handshake is over.
+ * Failing to shrink is harmless, the larger buffers are simply kept.
+ */
+static void ssl_shrink_buffers( mbedtls_ssl_context *ssl )
+{
+    size_t in_len = MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN;
+
+    if( ! ssl_variable_buffers( ssl ) )
+        return;
+
+    if( in_len > mbedtls_ssl_get_input_max_frag_len( ssl ) )
+        in_len = mbedtls_ssl_get_input_max_frag_len( ssl );
+
+    (void) ssl_resize_out_buf( ssl,
+                SSL_BUFFER_LEN_FOR( mbedtls_ssl_get_output_max_frag_len( ssl ) ) );
+    (void) ssl_resize_in_buf( ssl, SSL_BUFFER_LEN_FOR( in_len ) );
+}
+
+/*
+ * Allocate the buffers again after mbedtls_ssl_release_buffers(), restoring
+ * the record counters and message offsets saved there.
+ */
+static int ssl_acquire_buffers( mbedtls_ssl_context *ssl )
+{
+    size_t len;
+
+    if( ssl->conf == NULL )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    if( ssl->in_buf == NULL )
+    {
+        len = SSL_BUFFER_LEN_FOR( MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN );
+        if( len > MBEDTLS_SSL_IN_BUFFER_LEN )
+            len = MBEDTLS_SSL_IN_BUFFER_LEN;
+
+        if( ( ssl->in_buf = mbedtls_calloc( 1, len ) ) == NULL )
+        {
+            MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+            return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+        }
+
+        ssl->in_buf_len = len;
+        ssl_reset_in_pointers( ssl );
+        ssl->in_msg = ssl->in_buf + ssl->in_msg_offset;
+        memcpy( ssl->in_ctr, ssl->in_ctr_saved, 8 );
+    }
+
+    if( ssl->out_buf == NULL )
+    {
+        len = SSL_BUFFER_LEN_FOR( mbedtls_ssl_get_output_max_frag_len( ssl ) );
+
+        if( ( ssl->out_buf = mbedtls_calloc( 1, len ) ) == NULL )
+        {
+            MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+            return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+        }
+
+        ssl->out_buf_len = len;
+        ssl_reset_out_pointers( ssl );
+        ssl->out_msg = ssl->out_buf + ssl->out_msg_offset;
+        memcpy( ssl->out_ctr, ssl->out_ctr_saved, 8 );
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
 #if defined(MBEDTLS_SSL_CLI_C)
 static int ssl_session_copy( mbedtls_ssl_session *dst, const mbedtls_ssl_session *src )
 {
@@ -1348,11 +1601,13 @@ static int ssl_encrypt_buf( mbedtls_ssl_context *ssl )
     MBEDTLS_SSL_DEBUG_BUF( 4, "before encrypt: output payload",
                       ssl->out_msg, ssl->out_msglen );
 
-    if( ssl->out_msglen > MBEDTLS_SSL_MAX_CONTENT_LEN )
+    if( ssl->out_msglen > MBEDTLS_SSL_OUT_CONTENT_LEN ||
+        ssl->out_msglen > mbedtls_ssl_out_buf_len( ssl ) -
+                          MBEDTLS_SSL_HEADER_LEN - MBEDTLS_SSL_PAYLOAD_OVERHEAD )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "Record content %u too large, maximum %d",
                                     (unsigned) ssl->out_msglen,
-                                    MBEDTLS_SSL_MAX_CONTENT_LEN ) );
+                                    MBEDTLS_SSL_OUT_CONTENT_LEN ) );
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
     }
 
@@ -1985,14 +2240,14 @@ static int ssl_decrypt_buf( mbedtls_ssl_context *ssl )
              * Padding is guaranteed to be incorrect if:
              *   1. padlen > ssl->in_msglen
              *
-             *   2. padding_idx > MBEDTLS_SSL_MAX_CONTENT_LEN +
+             *   2. padding_idx > MBEDTLS_SSL_IN_CONTENT_LEN +
              *                     ssl->transform_in->maclen
              *
              * In both cases we reset padding_idx to a safe value (0) to
              * prevent out-of-buffer reads.
              */
             correct &= ( padlen <= ssl->in_msglen );
-            correct &= ( padding_idx <= MBEDTLS_SSL_MAX_CONTENT_LEN +
+            correct &= ( padding_idx <= MBEDTLS_SSL_IN_CONTENT_LEN +
                                        ssl->transform_in->maclen );
 
             padding_idx *= correct;
@@ -2281,7 +2536,7 @@ static int ssl_compress_buf( mbedtls_ssl_context *ssl )
     ssl->transform_out->ctx_deflate.next_in = msg_pre;
     ssl->transform_out->ctx_deflate.avail_in = len_pre;
     ssl->transform_out->ctx_deflate.next_out = msg_post;
-    ssl->transform_out->ctx_deflate.avail_out = MBEDTLS_SSL_BUFFER_LEN - bytes_written;
+    ssl->transform_out->ctx_deflate.avail_out = mbedtls_ssl_out_buf_len( ssl ) - bytes_written;
 
     ret = deflate( &ssl->transform_out->ctx_deflate, Z_SYNC_FLUSH );
     if( ret != Z_OK )
@@ -2290,7 +2545,7 @@ static int ssl_compress_buf( mbedtls_ssl_context *ssl )
         return( MBEDTLS_ERR_SSL_COMPRESSION_FAILED );
     }
 
-    ssl->out_msglen = MBEDTLS_SSL_BUFFER_LEN -
+    ssl->out_msglen = mbedtls_ssl_out_buf_len( ssl ) -
                       ssl->transform_out->ctx_deflate.avail_out - bytes_written;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "after compression: msglen = %d, ",
@@ -2328,7 +2583,7 @@ static int ssl_decompress_buf( mbedtls_ssl_context *ssl )
     ssl->transform_in->ctx_inflate.next_in = msg_pre;
     ssl->transform_in->ctx_inflate.avail_in = len_pre;
     ssl->transform_in->ctx_inflate.next_out = msg_post;
-    ssl->transform_in->ctx_inflate.avail_out = MBEDTLS_SSL_BUFFER_LEN -
+    ssl->transform_in->ctx_inflate.avail_out = mbedtls_ssl_in_buf_len( ssl ) -
                                                header_bytes;
 
     ret = inflate( &ssl->transform_in->ctx_inflate, Z_SYNC_FLUSH );
@@ -2338,7 +2593,7 @@ static int ssl_decompress_buf( mbedtls_ssl_context *ssl )
         return( MBEDTLS_ERR_SSL_COMPRESSION_FAILED );
     }
 
-    ssl->in_msglen = MBEDTLS_SSL_BUFFER_LEN -
+    ssl->in_msglen = mbedtls_ssl_in_buf_len( ssl ) -
                      ssl->transform_in->ctx_inflate.avail_out - header_bytes;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "after decompression: msglen = %d, ",
@@ -2413,7 +2668,31 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
     }
 
-    if( nb_want > MBEDTLS_SSL_BUFFER_LEN - (size_t)( ssl->in_hdr - ssl->in_buf ) )
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ssl->in_buf == NULL &&
+        ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+    {
+        return( ret );
+    }
+
+    /*
+     * Grow the input buffer straight to the largest record the peer may
+     * send, rather than step by step for each larger record.
+     */
+    if( nb_want > ssl->in_buf_len - (size_t)( ssl->in_hdr - ssl->in_buf ) &&
+        ssl_variable_buffers( ssl ) )
+    {
+        size_t target = SSL_BUFFER_LEN_FOR( mbedtls_ssl_get_input_max_frag_len( ssl ) );
+
+        if( target < (size_t)( ssl->in_hdr - ssl->in_buf ) + nb_want )
+            target = (size_t)( ssl->in_hdr - ssl->in_buf ) + nb_want;
+
+        if( ( ret = ssl_resize_in_buf( ssl, target ) ) != 0 )
+            return( ret );
+    }
+#endif
+
+    if( nb_want > mbedtls_ssl_in_buf_len( ssl ) - (size_t)( ssl->in_hdr - ssl->in_buf ) )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "requesting more data than fits" ) );
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
@@ -2496,7 +2775,7 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
             ret = MBEDTLS_ERR_SSL_TIMEOUT;
         else
         {
-            len = MBEDTLS_SSL_BUFFER_LEN - ( ssl->in_hdr - ssl->in_buf );
+            len = mbedtls_ssl_in_buf_len( ssl ) - ( ssl->in_hdr - ssl->in_buf );
 
             if( ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER )
                 timeout = ssl->handshake->retransmit_timeout;
@@ -2958,12 +3237,12 @@ int mbedtls_ssl_write_record( mbedtls_ssl_context *ssl )
         if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
         {
             /* Make room for the additional DTLS fields */
-            if( MBEDTLS_SSL_MAX_CONTENT_LEN - ssl->out_msglen < 8 )
+            if( MBEDTLS_SSL_OUT_CONTENT_LEN - ssl->out_msglen < 8 )
             {
                 MBEDTLS_SSL_DEBUG_MSG( 1, ( "DTLS handshake message too large: "
                               "size %u, maximum %u",
                                (unsigned) ( ssl->in_hslen - 4 ),
-                               (unsigned) ( MBEDTLS_SSL_MAX_CONTENT_LEN - 12 ) ) );
+                               (unsigned) ( MBEDTLS_SSL_OUT_CONTENT_LEN - 12 ) ) );
                 return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
             }
 
@@ -3176,7 +3455,7 @@ static int ssl_reassemble_dtls_handshake( mbedtls_ssl_context *ssl )
         MBEDTLS_SSL_DEBUG_MSG( 2, ( "initialize reassembly, total length = %d",
                             msg_len ) );
 
-        if( ssl->in_hslen > MBEDTLS_SSL_MAX_CONTENT_LEN )
+        if( ssl->in_hslen > MBEDTLS_SSL_IN_CONTENT_LEN )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "handshake message too large" ) );
             return( MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE );
@@ -3280,7 +3559,7 @@ static int ssl_reassemble_dtls_handshake( mbedtls_ssl_context *ssl )
         ssl->next_record_offset = new_remain - ssl->in_hdr;
         ssl->in_left = ssl->next_record_offset + remain_len;
 
-        if( ssl->in_left > MBEDTLS_SSL_BUFFER_LEN -
+        if( ssl->in_left > mbedtls_ssl_in_buf_len( ssl ) -
                            (size_t)( ssl->in_hdr - ssl->in_buf ) )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "reassembled message too large for buffer" ) );
@@ -3655,7 +3934,7 @@ static int ssl_handle_possible_reconnect( mbedtls_ssl_context *ssl )
             ssl->conf->p_cookie,
             ssl->cli_id, ssl->cli_id_len,
             ssl->in_buf, ssl->in_left,
-            ssl->out_buf, MBEDTLS_SSL_MAX_CONTENT_LEN, &len );
+            ssl->out_buf, MBEDTLS_SSL_OUT_CONTENT_LEN, &len );
 
     MBEDTLS_SSL_DEBUG_RET( 2, "ssl_check_dtls_clihlo_cookie", ret );
 
@@ -3751,8 +4030,8 @@ static int ssl_parse_record_header( mbedtls_ssl_context *ssl )
         return( MBEDTLS_ERR_SSL_INVALID_RECORD );
     }
 
-    /* Check length against the size of our buffer */
-    if( ssl->in_msglen > MBEDTLS_SSL_BUFFER_LEN
+    /* Check length against the (largest) size of our buffer */
+    if( ssl->in_msglen > MBEDTLS_SSL_IN_BUFFER_LEN
                          - (size_t)( ssl->in_msg - ssl->in_buf ) )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
@@ -3763,7 +4042,7 @@ static int ssl_parse_record_header( mbedtls_ssl_context *ssl )
     if( ssl->transform_in == NULL )
     {
         if( ssl->in_msglen < 1 ||
-            ssl->in_msglen > MBEDTLS_SSL_MAX_CONTENT_LEN )
+            ssl->in_msglen > MBEDTLS_SSL_IN_CONTENT_LEN )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
             return( MBEDTLS_ERR_SSL_INVALID_RECORD );
@@ -3779,7 +4058,7 @@ static int ssl_parse_record_header( mbedtls_ssl_context *ssl )
 
 #if defined(MBEDTLS_SSL_PROTO_SSL3)
         if( ssl->minor_ver == MBEDTLS_SSL_MINOR_VERSION_0 &&
-            ssl->in_msglen > ssl->transform_in->minlen + MBEDTLS_SSL_MAX_CONTENT_LEN )
+            ssl->in_msglen > ssl->transform_in->minlen + MBEDTLS_SSL_IN_CONTENT_LEN )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
             return( MBEDTLS_ERR_SSL_INVALID_RECORD );
@@ -3792,7 +4071,7 @@ static int ssl_parse_record_header( mbedtls_ssl_context *ssl )
          */
         if( ssl->minor_ver >= MBEDTLS_SSL_MINOR_VERSION_1 &&
             ssl->in_msglen > ssl->transform_in->minlen +
-                             MBEDTLS_SSL_MAX_CONTENT_LEN + 256 )
+                             MBEDTLS_SSL_IN_CONTENT_LEN + 256 )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
             return( MBEDTLS_ERR_SSL_INVALID_RECORD );
@@ -3916,7 +4195,7 @@ static int ssl_prepare_record_content( mbedtls_ssl_context *ssl )
         MBEDTLS_SSL_DEBUG_BUF( 4, "input payload after decrypt",
                        ssl->in_msg, ssl->in_msglen );
 
-        if( ssl->in_msglen > MBEDTLS_SSL_MAX_CONTENT_LEN )
+        if( ssl->in_msglen > MBEDTLS_SSL_IN_CONTENT_LEN )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
             return( MBEDTLS_ERR_SSL_INVALID_RECORD );
@@ -4371,6 +4650,11 @@ int mbedtls_ssl_send_alert_message( mbedtls_ssl_context *ssl,
     if( ssl == NULL || ssl->conf == NULL )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+        return( ret );
+#endif
+
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> send alert message" ) );
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "send alert level=%u message=%u", level, message ));
 
@@ -4528,9 +4812,9 @@ int mbedtls_ssl_write_certificate( mbedtls_ssl_context *ssl )
         if (pk) {
             n = mbedtls_pk_write_pubkey_der( pk, buf, PUB_DER_MAX_BYTES );
 
-            if (n > MBEDTLS_SSL_MAX_CONTENT_LEN - 3 - i) {
+            if (n > MBEDTLS_SSL_OUT_CONTENT_LEN - 3 - i) {
                 MBEDTLS_SSL_DEBUG_MSG( 1, ( "public key too large, %d > %d",
-                               i + 3 + n, MBEDTLS_SSL_MAX_CONTENT_LEN ) );
+                               i + 3 + n, MBEDTLS_SSL_OUT_CONTENT_LEN ) );
                 return( MBEDTLS_ERR_SSL_CERTIFICATE_TOO_LARGE );
             }
 
@@ -4550,10 +4834,10 @@ int mbedtls_ssl_write_certificate( mbedtls_ssl_context *ssl )
         while( crt != NULL )
         {
             n = crt->raw.len;
-            if( n > MBEDTLS_SSL_MAX_CONTENT_LEN - 3 - i )
+            if( n > MBEDTLS_SSL_OUT_CONTENT_LEN - 3 - i )
             {
                 MBEDTLS_SSL_DEBUG_MSG( 1, ( "certificate too large, %d > %d",
-                               i + 3 + n, MBEDTLS_SSL_MAX_CONTENT_LEN ) );
+                               i + 3 + n, MBEDTLS_SSL_OUT_CONTENT_LEN ) );
                 return( MBEDTLS_ERR_SSL_CERTIFICATE_TOO_LARGE );
             }
 
@@ -5554,6 +5838,10 @@ void mbedtls_ssl_handshake_wrapup( mbedtls_ssl_context *ssl )
 #endif
         ssl_handshake_wrapup_free_hs_transform( ssl );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl_shrink_buffers( ssl );
+#endif
+
     ssl->state++;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "<= handshake wrapup" ) );
@@ -5939,53 +6227,41 @@ int mbedtls_ssl_setup( mbedtls_ssl_context *ssl,
                        const mbedtls_ssl_config *conf )
 {
     int ret;
-    const size_t len = MBEDTLS_SSL_BUFFER_LEN;
+    size_t in_len = MBEDTLS_SSL_IN_BUFFER_LEN;
+    size_t out_len = MBEDTLS_SSL_OUT_BUFFER_LEN;
 
     ssl->conf = conf;
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* Datagrams must be read in one go, only TLS starts small */
+    if( ssl_variable_buffers( ssl ) &&
+        SSL_BUFFER_LEN_FOR( MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN ) < in_len )
+    {
+        in_len = SSL_BUFFER_LEN_FOR( MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN );
+    }
+#endif
+
     /*
      * Prepare base structures
      */
     ssl->in_buf = NULL;
     ssl->out_buf = NULL;
-    if( ( ssl-> in_buf = mbedtls_calloc( 1, len ) ) == NULL ||
-        ( ssl->out_buf = mbedtls_calloc( 1, len ) ) == NULL )
+    if( ( ssl->in_buf = mbedtls_calloc( 1, in_len ) ) == NULL ||
+        ( ssl->out_buf = mbedtls_calloc( 1, out_len ) ) == NULL )
     {
-        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed",
+                                    ssl->in_buf == NULL ? in_len : out_len ) );
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
         goto error;
     }
 
-#if defined(MBEDTLS_SSL_PROTO_DTLS)
-    if( conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
-    {
-        ssl->out_hdr = ssl->out_buf;
-        ssl->out_ctr = ssl->out_buf +  3;
-        ssl->out_len = ssl->out_buf + 11;
-        ssl->out_iv  = ssl->out_buf + 13;
-        ssl->out_msg = ssl->out_buf + 13;
-
-        ssl->in_hdr = ssl->in_buf;
-        ssl->in_ctr = ssl->in_buf +  3;
-        ssl->in_len = ssl->in_buf + 11;
-        ssl->in_iv  = ssl->in_buf + 13;
-        ssl->in_msg = ssl->in_buf + 13;
-    }
-    else
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->in_buf_len = in_len;
+    ssl->out_buf_len = out_len;
 #endif
-    {
-        ssl->out_ctr = ssl->out_buf;
-        ssl->out_hdr = ssl->out_buf +  8;
-        ssl->out_len = ssl->out_buf + 11;
-        ssl->out_iv  = ssl->out_buf + 13;
-        ssl->out_msg = ssl->out_buf + 13;
 
-        ssl->in_ctr = ssl->in_buf;
-        ssl->in_hdr = ssl->in_buf +  8;
-        ssl->in_len = ssl->in_buf + 11;
-        ssl->in_iv  = ssl->in_buf + 13;
-        ssl->in_msg = ssl->in_buf + 13;
-    }
+    ssl_reset_in_pointers( ssl );
+    ssl_reset_out_pointers( ssl );
 
     if( ( ret = ssl_handshake_init( ssl ) ) != 0 )
         goto error;
@@ -6001,6 +6277,11 @@ error:
     ssl->in_buf = NULL;
     ssl->out_buf = NULL;
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->in_buf_len = 0;
+    ssl->out_buf_len = 0;
+#endif
+
     ssl->in_hdr = NULL;
     ssl->in_ctr = NULL;
     ssl->in_len = NULL;
@@ -6027,6 +6308,11 @@ static int ssl_session_reset_int( mbedtls_ssl_context *ssl, int partial )
 {
     int ret;
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+        return( ret );
+#endif
+
     ssl->state = MBEDTLS_SSL_HELLO_REQUEST;
 
     /* Cancel any possibly running timer */
@@ -6077,10 +6363,23 @@ static int ssl_session_reset_int( mbedtls_ssl_context *ssl, int partial )
     ssl->session_in = NULL;
     ssl->session_out = NULL;
 
-    memset( ssl->out_buf, 0, MBEDTLS_SSL_BUFFER_LEN );
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* The next handshake starts from the initial sizes again */
+    if( ssl_variable_buffers( ssl ) )
+    {
+        if( ( ret = ssl_resize_out_buf( ssl, MBEDTLS_SSL_OUT_BUFFER_LEN ) ) != 0 )
+            return( ret );
+
+        if( partial == 0 )
+            (void) ssl_resize_in_buf( ssl,
+                        SSL_BUFFER_LEN_FOR( MBEDTLS_SSL_IN_INITIAL_CONTENT_LEN ) );
+    }
+#endif
+
+    memset( ssl->out_buf, 0, mbedtls_ssl_out_buf_len( ssl ) );
 
     if( partial == 0 )
-        memset( ssl->in_buf, 0, MBEDTLS_SSL_BUFFER_LEN );
+        memset( ssl->in_buf, 0, mbedtls_ssl_in_buf_len( ssl ) );
 
 #if defined(MBEDTLS_SSL_HW_RECORD_ACCEL)
     if( mbedtls_ssl_hw_record_reset != NULL )
@@ -6757,6 +7056,19 @@ int mbedtls_ssl_conf_max_frag_len( mbedtls_ssl_config *conf, unsigned char mfl_c
 }
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+int mbedtls_ssl_conf_record_size_limit( mbedtls_ssl_config *conf, uint16_t limit )
+{
+    /* RFC 8449 section 4: values below 64 are illegal */
+    if( limit < 64 || limit > MBEDTLS_SSL_IN_CONTENT_LEN )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    conf->record_size_limit = limit;
+
+    return( 0 );
+}
+#endif /* MBEDTLS_SSL_RECORD_SIZE_LIMIT */
+
 #if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
 void mbedtls_ssl_conf_truncated_hmac( mbedtls_ssl_config *conf, int truncate )
 {
@@ -6965,6 +7277,51 @@ size_t mbedtls_ssl_get_max_frag_len( const mbedtls_ssl_context *ssl )
 }
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+size_t mbedtls_ssl_get_output_max_frag_len( const mbedtls_ssl_context *ssl )
+{
+    size_t max_len = MBEDTLS_SSL_OUT_CONTENT_LEN;
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if( mbedtls_ssl_get_max_frag_len( ssl ) < max_len )
+        max_len = mbedtls_ssl_get_max_frag_len( ssl );
+#endif
+
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    if( ssl->session_out != NULL &&
+        ssl->session_out->peer_record_size_limit != 0 &&
+        ssl->session_out->peer_record_size_limit < max_len )
+    {
+        max_len = ssl->session_out->peer_record_size_limit;
+    }
+#endif
+
+    return( max_len );
+}
+
+size_t mbedtls_ssl_get_input_max_frag_len( const mbedtls_ssl_context *ssl )
+{
+    size_t max_len = MBEDTLS_SSL_IN_CONTENT_LEN;
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if( ssl->session_in != NULL &&
+        mfl_code_to_length[ssl->session_in->mfl_code] < max_len )
+    {
+        max_len = mfl_code_to_length[ssl->session_in->mfl_code];
+    }
+#endif
+
+#if defined(MBEDTLS_SSL_RECORD_SIZE_LIMIT)
+    if( ssl->session_in != NULL &&
+        ssl->session_in->own_record_size_limit != 0 &&
+        ssl->session_in->own_record_size_limit < max_len )
+    {
+        max_len = ssl->session_in->own_record_size_limit;
+    }
+#endif
+
+    return( max_len );
+}
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 const mbedtls_x509_crt *mbedtls_ssl_get_peer_cert( const mbedtls_ssl_context *ssl )
 {
@@ -7000,6 +7357,11 @@ int mbedtls_ssl_handshake_step( mbedtls_ssl_context *ssl )
     if( ssl == NULL || ssl->conf == NULL )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+        return( ret );
+#endif
+
 #if defined(MBEDTLS_SSL_CLI_C)
     if( ssl->conf->endpoint == MBEDTLS_SSL_IS_CLIENT )
         ret = mbedtls_ssl_handshake_client_step( ssl );
@@ -7058,6 +7420,11 @@ static int ssl_write_hello_request( mbedtls_ssl_context *ssl )
 
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> write hello request" ) );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+        return( ret );
+#endif
+
     ssl->out_msglen  = 4;
     ssl->out_msgtype = MBEDTLS_SSL_MSG_HANDSHAKE;
     ssl->out_msg[0]  = MBEDTLS_SSL_HS_HELLO_REQUEST;
@@ -7089,6 +7456,15 @@ static int ssl_start_renegotiation( mbedtls_ssl_context *ssl )
 
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> renegotiate" ) );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* Handshake messages are not fragmented, give them the full buffer */
+    if( ssl_variable_buffers( ssl ) &&
+        ( ret = ssl_resize_out_buf( ssl, MBEDTLS_SSL_OUT_BUFFER_LEN ) ) != 0 )
+    {
+        return( ret );
+    }
+#endif
+
     if( ( ret = ssl_handshake_init( ssl ) ) != 0 )
         return( ret );
 
@@ -7504,11 +7880,8 @@ static int ssl_write_real( mbedtls_ssl_context *ssl,
                            const unsigned char *buf, size_t len )
 {
     int ret;
-#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
-    size_t max_len = mbedtls_ssl_get_max_frag_len( ssl );
-#else
-    size_t max_len = MBEDTLS_SSL_MAX_CONTENT_LEN;
-#endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
+    size_t max_len = mbedtls_ssl_get_output_max_frag_len( ssl );
+
     if( len > max_len )
     {
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
@@ -7609,6 +7982,11 @@ int mbedtls_ssl_write( mbedtls_ssl_context *ssl, const unsigned char *buf, size_
     if( ssl == NULL || ssl->conf == NULL )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( ( ret = ssl_acquire_buffers( ssl ) ) != 0 )
+        return( ret );
+#endif
+
 #if defined(MBEDTLS_SSL_RENEGOTIATION)
     if( ( ret = ssl_check_ctr_renegotiate( ssl ) ) != 0 )
     {
@@ -7668,6 +8046,77 @@ int mbedtls_ssl_close_notify( mbedtls_ssl_context *ssl )
     return( 0 );
 }
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/*
+ * Free the record buffers of an idle connection. The record counters live
+ * in the buffers, so they are parked in the context until the buffers are
+ * allocated again by ssl_acquire_buffers().
+ */
+int mbedtls_ssl_release_buffers( mbedtls_ssl_context *ssl )
+{
+    if( ssl == NULL || ssl->conf == NULL )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    if( ! ssl_variable_buffers( ssl ) ||
+        ( ssl->in_buf == NULL && ssl->out_buf == NULL ) )
+    {
+        return( 0 );
+    }
+
+    if( ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER || ssl->handshake != NULL ||
+        ssl->in_left != 0 || ssl->out_left != 0 || ssl->in_offt != NULL ||
+        ssl->keep_current_message != 0 ||
+        ( ssl->in_hslen != 0 && ssl->in_hslen < ssl->in_msglen ) )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 2, ( "connection busy, keeping buffers" ) );
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+    }
+
+    MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> release buffers" ) );
+
+    if( ssl->in_buf != NULL )
+    {
+        memcpy( ssl->in_ctr_saved, ssl->in_ctr, 8 );
+        ssl->in_msg_offset = ssl->in_msg - ssl->in_buf;
+
+        mbedtls_zeroize( ssl->in_buf, ssl->in_buf_len );
+        mbedtls_free( ssl->in_buf );
+
+        ssl->in_buf = NULL;
+        ssl->in_buf_len = 0;
+        ssl->in_ctr = ssl->in_ctr_saved;
+        ssl->in_hdr = NULL;
+        ssl->in_len = NULL;
+        ssl->in_iv = NULL;
+        ssl->in_msg = NULL;
+        ssl->in_msglen = 0;
+        ssl->in_hslen = 0;
+    }
+
+    if( ssl->out_buf != NULL )
+    {
+        memcpy( ssl->out_ctr_saved, ssl->out_ctr, 8 );
+        ssl->out_msg_offset = ssl->out_msg - ssl->out_buf;
+
+        mbedtls_zeroize( ssl->out_buf, ssl->out_buf_len );
+        mbedtls_free( ssl->out_buf );
+
+        ssl->out_buf = NULL;
+        ssl->out_buf_len = 0;
+        ssl->out_ctr = ssl->out_ctr_saved;
+        ssl->out_hdr = NULL;
+        ssl->out_len = NULL;
+        ssl->out_iv = NULL;
+        ssl->out_msg = NULL;
+        ssl->out_msglen = 0;
+    }
+
+    MBEDTLS_SSL_DEBUG_MSG( 2, ( "<= release buffers" ) );
+
+    return( 0 );
+}
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
 void mbedtls_ssl_transform_free( mbedtls_ssl_transform *transform )
 {
     if( transform == NULL )
@@ -7809,13 +8258,13 @@ void mbedtls_ssl_free( mbedtls_ssl_context *ssl )
 
     if( ssl->out_buf != NULL )
     {
-        mbedtls_zeroize( ssl->out_buf, MBEDTLS_SSL_BUFFER_LEN );
+        mbedtls_zeroize( ssl->out_buf, mbedtls_ssl_out_buf_len( ssl ) );
         mbedtls_free( ssl->out_buf );
     }
 
     if( ssl->in_buf != NULL )
     {
-        mbedtls_zeroize( ssl->in_buf, MBEDTLS_SSL_BUFFER_LEN );
+        mbedtls_zeroize( ssl->in_buf, mbedtls_ssl_in_buf_len( ssl ) );
         mbedtls_free( ssl->in_buf );
     }
 
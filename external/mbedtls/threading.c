@@ -135,6 +135,12 @@ void mbedtls_threading_set_alt( void (*mutex_init)( mbedtls_threading_mutex_t *
 #if defined(MBEDTLS_HAVE_TIME_DATE)
     mbedtls_mutex_init( &mbedtls_threading_gmtime_mutex );
 #endif
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+    mbedtls_mutex_init( &mbedtls_threading_ecp_p256_mutex );
+#endif
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+    mbedtls_mutex_init( &mbedtls_threading_ssl_session_store_mutex );
+#endif
 }
 
 /*
@@ -148,6 +154,12 @@ void mbedtls_threading_free_alt( void )
 #if defined(MBEDTLS_HAVE_TIME_DATE)
     mbedtls_mutex_free( &mbedtls_threading_gmtime_mutex );
 #endif
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+    mbedtls_mutex_free( &mbedtls_threading_ecp_p256_mutex );
+#endif
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+    mbedtls_mutex_free( &mbedtls_threading_ssl_session_store_mutex );
+#endif
 }
 #endif /* MBEDTLS_THREADING_ALT */
 
@@ -163,5 +175,11 @@ mbedtls_threading_mutex_t mbedtls_threading_readdir_mutex MUTEX_INIT;
 #if defined(MBEDTLS_HAVE_TIME_DATE)
 mbedtls_threading_mutex_t mbedtls_threading_gmtime_mutex MUTEX_INIT;
 #endif
+#if defined(MBEDTLS_ECP_P256_OPTIM)
+mbedtls_threading_mutex_t mbedtls_threading_ecp_p256_mutex MUTEX_INIT;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+mbedtls_threading_mutex_t mbedtls_threading_ssl_session_store_mutex MUTEX_INIT;
+#endif
 
 #endif /* MBEDTLS_THREADING_C */
@@ -48,6 +48,29 @@
 #	define EPROTO ECONNABORTED
 #endif
 
+/* ============================================================
+ * Packet buffers
+ * ============================================================ */
+
+#ifdef __TINYARA__
+#include <tinyara/config.h>
+#endif
+
+/* Free packet buffers kept for reuse in each size class, 0 to disable */
+#ifdef CONFIG_NETUTILS_MQTT_PACKET_POOL_DEPTH
+#	define MOSQ_PACKET_POOL_DEPTH CONFIG_NETUTILS_MQTT_PACKET_POOL_DEPTH
+#else
+#	define MOSQ_PACKET_POOL_DEPTH 8
+#endif
+
+/* Queued packets smaller than this are gathered into a single write, 0 to
+ * write each packet on its own. */
+#ifdef CONFIG_NETUTILS_MQTT_WRITE_COALESCE_SIZE
+#	define MOSQ_WRITE_COALESCE_SIZE CONFIG_NETUTILS_MQTT_WRITE_COALESCE_SIZE
+#else
+#	define MOSQ_WRITE_COALESCE_SIZE 512
+#endif
+
 #ifdef WITH_MBEDTLS
 #include "mbedtls/ssl.h"
 #include "mbedtls/net.h"
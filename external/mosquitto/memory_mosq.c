@@ -33,9 +33,14 @@ Contributors:
 
 #include <config.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(WITH_THREADING) && !defined(WITH_BROKER)
+#	include <pthread.h>
+#endif
+
 #include <memory_mosq.h>
 
 #ifdef REAL_WITH_MEMORY_TRACKING
@@ -138,3 +143,167 @@ char *_mosquitto_strdup(const char *s)
 
 	return str;
 }
+
+/* Packet buffers
+ *
+ * Every packet sent or received needs a buffer for its payload, plus the
+ * packet structure itself for outgoing packets. Buffers up to the largest
+ * size class are rounded up to their class and, once freed, kept on a per
+ * class free list (shared by all clients) for the next packet, so that a
+ * steady flow of small messages does not go through the heap at all.
+ */
+#if MOSQ_PACKET_POOL_DEPTH > 0
+
+static const size_t packet_pool_size[] = { 32, 128, 512, 2048 };
+
+#define PACKET_POOL_CLASSES (sizeof(packet_pool_size) / sizeof(packet_pool_size[0]))
+#define PACKET_POOL_LARGE 0xff
+
+/* Prepended to each buffer, keeps the payload 8 byte aligned */
+union packet_buf_hdr {
+	union packet_buf_hdr *next;	/* on a free list */
+	uint8_t cls;				/* in use */
+	uint64_t align;
+};
+
+static union packet_buf_hdr *packet_pool[PACKET_POOL_CLASSES];
+static unsigned int packet_pool_count[PACKET_POOL_CLASSES];
+
+#if defined(WITH_THREADING) && !defined(WITH_BROKER)
+static pthread_mutex_t packet_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+#	define packet_pool_lock() pthread_mutex_lock(&packet_pool_mutex)
+#	define packet_pool_unlock() pthread_mutex_unlock(&packet_pool_mutex)
+#else
+#	define packet_pool_lock()
+#	define packet_pool_unlock()
+#endif
+
+void *_mosquitto_packet_buf_alloc(size_t size)
+{
+	union packet_buf_hdr *hdr = NULL;
+	uint8_t cls;
+
+	for (cls = 0; cls < PACKET_POOL_CLASSES; cls++) {
+		if (size <= packet_pool_size[cls]) {
+			break;
+		}
+	}
+
+	if (cls < PACKET_POOL_CLASSES) {
+		packet_pool_lock();
+		hdr = packet_pool[cls];
+		if (hdr) {
+			packet_pool[cls] = hdr->next;
+			packet_pool_count[cls]--;
+		}
+		packet_pool_unlock();
+		if (!hdr) {
+			hdr = _mosquitto_malloc(sizeof(union packet_buf_hdr) + packet_pool_size[cls]);
+		}
+	} else {
+		cls = PACKET_POOL_LARGE;
+		hdr = _mosquitto_malloc(sizeof(union packet_buf_hdr) + size);
+	}
+	if (!hdr) {
+		return NULL;
+	}
+
+	hdr->cls = cls;
+	return hdr + 1;
+}
+
+void _mosquitto_packet_buf_free(void *buf)
+{
+	union packet_buf_hdr *hdr;
+	uint8_t cls;
+
+	if (!buf) {
+		return;
+	}
+
+	hdr = (union packet_buf_hdr *)buf - 1;
+	cls = hdr->cls;
+	if (cls != PACKET_POOL_LARGE) {
+		packet_pool_lock();
+		if (packet_pool_count[cls] < MOSQ_PACKET_POOL_DEPTH) {
+			hdr->next = packet_pool[cls];
+			packet_pool[cls] = hdr;
+			packet_pool_count[cls]++;
+			hdr = NULL;
+		}
+		packet_pool_unlock();
+	}
+	_mosquitto_free(hdr);
+}
+
+/* Grow a buffer from _mosquitto_packet_buf_alloc(), keeping its contents.
+ * On failure the old buffer is left untouched.
+ */
+void *_mosquitto_packet_buf_realloc(void *buf, size_t size)
+{
+	union packet_buf_hdr *hdr;
+	void *newbuf;
+
+	if (!buf) {
+		return _mosquitto_packet_buf_alloc(size);
+	}
+
+	hdr = (union packet_buf_hdr *)buf - 1;
+	if (hdr->cls == PACKET_POOL_LARGE) {
+		hdr = _mosquitto_realloc(hdr, sizeof(union packet_buf_hdr) + size);
+		return hdr ? hdr + 1 : NULL;
+	}
+
+	if (size <= packet_pool_size[hdr->cls]) {
+		return buf;
+	}
+
+	newbuf = _mosquitto_packet_buf_alloc(size);
+	if (!newbuf) {
+		return NULL;
+	}
+
+	memcpy(newbuf, buf, packet_pool_size[hdr->cls]);
+	_mosquitto_packet_buf_free(buf);
+	return newbuf;
+}
+
+void _mosquitto_packet_pool_cleanup(void)
+{
+	union packet_buf_hdr *hdr;
+	unsigned int i;
+
+	packet_pool_lock();
+	for (i = 0; i < PACKET_POOL_CLASSES; i++) {
+		while (packet_pool[i]) {
+			hdr = packet_pool[i];
+			packet_pool[i] = hdr->next;
+			_mosquitto_free(hdr);
+		}
+		packet_pool_count[i] = 0;
+	}
+	packet_pool_unlock();
+}
+
+#else
+
+void *_mosquitto_packet_buf_alloc(size_t size)
+{
+	return _mosquitto_malloc(size);
+}
+
+void _mosquitto_packet_buf_free(void *buf)
+{
+	_mosquitto_free(buf);
+}
+
+void *_mosquitto_packet_buf_realloc(void *buf, size_t size)
+{
+	return _mosquitto_realloc(buf, size);
+}
+
+void _mosquitto_packet_pool_cleanup(void)
+{
+}
+
+#endif
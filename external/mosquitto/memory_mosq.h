@@ -51,4 +51,9 @@ unsigned long _mosquitto_max_memory_used(void);
 void *_mosquitto_realloc(void *ptr, size_t size);
 char *_mosquitto_strdup(const char *s);
 
+void *_mosquitto_packet_buf_alloc(size_t size);
+void _mosquitto_packet_buf_free(void *buf);
+void *_mosquitto_packet_buf_realloc(void *buf, size_t size);
+void _mosquitto_packet_pool_cleanup(void);
+
 #endif
@@ -63,6 +63,190 @@ void _mosquitto_message_cleanup(struct mosquitto_message_all **message)
 	_mosquitto_free(msg);
 }
 
+/* Buckets allocated on the first insertion; the table doubles whenever it
+ * holds as many messages as buckets. Mids are allocated sequentially, so
+ * masking the low bits spreads them evenly. */
+#define MOSQ_MESSAGE_INDEX_MIN 16
+#define MOSQ_MESSAGE_INDEX_MAX 65536
+
+static void _mosquitto_message_index_link(struct _mosquitto_message_index *index, struct mosquitto_message_all *message)
+{
+	struct mosquitto_message_all **slot;
+
+	/* Keep the chain in arrival order so that a duplicate mid finds the
+	 * oldest message first, as the list walk did. */
+	slot = &index->buckets[message->msg.mid & (index->size - 1)];
+	while (*slot) {
+		slot = &(*slot)->hash_next;
+	}
+	message->hash_next = NULL;
+	*slot = message;
+}
+
+static void _mosquitto_message_index_grow(struct _mosquitto_message_index *index)
+{
+	struct mosquitto_message_all **old_buckets;
+	struct mosquitto_message_all *message;
+	struct mosquitto_message_all *next;
+	unsigned int old_size;
+	unsigned int size;
+	unsigned int i;
+
+	size = index->size ? index->size * 2 : MOSQ_MESSAGE_INDEX_MIN;
+	if (size > MOSQ_MESSAGE_INDEX_MAX) {
+		return;
+	}
+	old_buckets = index->buckets;
+	old_size = index->size;
+	index->buckets = _mosquitto_calloc(size, sizeof(struct mosquitto_message_all *));
+	if (!index->buckets) {
+		/* Keep using the current table with longer chains */
+		index->buckets = old_buckets;
+		return;
+	}
+	index->size = size;
+	for (i = 0; i < old_size; i++) {
+		for (message = old_buckets[i]; message; message = next) {
+			next = message->hash_next;
+			_mosquitto_message_index_link(index, message);
+		}
+	}
+	if (old_buckets) {
+		_mosquitto_free(old_buckets);
+	}
+}
+
+/* Called once the message is on the list. While no table could be allocated
+ * lookups walk the list; the first table allocated indexes the whole list. */
+static void _mosquitto_message_index_add(struct _mosquitto_message_index *index, struct mosquitto_message_all *messages, struct mosquitto_message_all *message)
+{
+	if (index->count >= index->size) {
+		if (!index->size) {
+			_mosquitto_message_index_grow(index);
+			if (index->size) {
+				for (; messages; messages = messages->next) {
+					_mosquitto_message_index_link(index, messages);
+					index->count++;
+				}
+			}
+			return;
+		}
+		_mosquitto_message_index_grow(index);
+	}
+	_mosquitto_message_index_link(index, message);
+	index->count++;
+}
+
+static void _mosquitto_message_index_del(struct _mosquitto_message_index *index, struct mosquitto_message_all *message)
+{
+	struct mosquitto_message_all **slot;
+
+	if (!index->size) {
+		return;
+	}
+	for (slot = &index->buckets[message->msg.mid & (index->size - 1)]; *slot; slot = &(*slot)->hash_next) {
+		if (*slot == message) {
+			*slot = message->hash_next;
+			message->hash_next = NULL;
+			index->count--;
+			return;
+		}
+	}
+}
+
+static struct mosquitto_message_all *_mosquitto_message_find(struct mosquitto_message_all *messages, struct _mosquitto_message_index *index, uint16_t mid)
+{
+	struct mosquitto_message_all *message;
+
+	if (index->size) {
+		message = index->buckets[mid & (index->size - 1)];
+		while (message && message->msg.mid != mid) {
+			message = message->hash_next;
+		}
+		return message;
+	}
+	for (message = messages; message; message = message->next) {
+		if (message->msg.mid == mid) {
+			return message;
+		}
+	}
+	return NULL;
+}
+
+static void _mosquitto_message_index_free(struct _mosquitto_message_index *index)
+{
+	if (index->buckets) {
+		_mosquitto_free(index->buckets);
+	}
+	index->buckets = NULL;
+	index->size = 0;
+	index->count = 0;
+}
+
+static bool _mosquitto_message_awaits_reply(struct mosquitto_message_all *message)
+{
+	switch (message->state) {
+	case mosq_ms_wait_for_puback:
+	case mosq_ms_wait_for_pubrec:
+	case mosq_ms_wait_for_pubrel:
+	case mosq_ms_wait_for_pubcomp:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void _mosquitto_message_retry_unlink(struct _mosquitto_retry_queue *queue, struct mosquitto_message_all *message)
+{
+	if (!message->retry_prev && queue->head != message) {
+		return;
+	}
+	if (message->retry_prev) {
+		message->retry_prev->retry_next = message->retry_next;
+	} else {
+		queue->head = message->retry_next;
+	}
+	if (message->retry_next) {
+		message->retry_next->retry_prev = message->retry_prev;
+	} else {
+		queue->tail = message->retry_prev;
+	}
+	message->retry_next = NULL;
+	message->retry_prev = NULL;
+}
+
+/* (Re)schedule a message after its timestamp was set to the current time */
+static void _mosquitto_message_retry_touch(struct _mosquitto_retry_queue *queue, struct mosquitto_message_all *message)
+{
+	_mosquitto_message_retry_unlink(queue, message);
+	if (!_mosquitto_message_awaits_reply(message)) {
+		return;
+	}
+	message->retry_prev = queue->tail;
+	if (queue->tail) {
+		queue->tail->retry_next = message;
+	} else {
+		queue->head = message;
+	}
+	queue->tail = message;
+}
+
+static void _mosquitto_message_unlink(struct mosquitto_message_all **head, struct mosquitto_message_all **last, struct mosquitto_message_all *message)
+{
+	if (message->prev) {
+		message->prev->next = message->next;
+	} else {
+		*head = message->next;
+	}
+	if (message->next) {
+		message->next->prev = message->prev;
+	} else {
+		*last = message->prev;
+	}
+	message->next = NULL;
+	message->prev = NULL;
+}
+
 void _mosquitto_message_cleanup_all(struct mosquitto *mosq)
 {
 	struct mosquitto_message_all *tmp;
@@ -79,6 +263,13 @@ void _mosquitto_message_cleanup_all(struct mosquitto *mosq)
 		_mosquitto_message_cleanup(&mosq->out_messages);
 		mosq->out_messages = tmp;
 	}
+	mosq->in_messages_last = NULL;
+	mosq->out_messages_last = NULL;
+	mosq->out_messages_pending = NULL;
+	_mosquitto_message_index_free(&mosq->in_index);
+	_mosquitto_message_index_free(&mosq->out_index);
+	mosq->in_retry.head = mosq->in_retry.tail = NULL;
+	mosq->out_retry.head = mosq->out_retry.tail = NULL;
 }
 
 int mosquitto_message_copy(struct mosquitto_message *dst, const struct mosquitto_message *src)
@@ -144,6 +335,10 @@ void mosquitto_message_free(struct mosquitto_message **message)
 /*
  * Function: _mosquitto_message_queue
  *
+ * Outgoing messages are given their initial state here: waiting for the
+ * first acknowledgement if an in-flight slot is free, mosq_ms_invalid
+ * otherwise. Incoming messages keep the state set by the caller.
+ *
  * Returns:
  *	0 - to indicate an outgoing message can be started
  *	1 - to indicate that the outgoing message queue is full (inflight limit has been reached)
@@ -156,31 +351,48 @@ int _mosquitto_message_queue(struct mosquitto *mosq, struct mosquitto_message_al
 	assert(mosq);
 	assert(message);
 
+	message->next = NULL;
+	message->hash_next = NULL;
+	message->retry_next = NULL;
+	message->retry_prev = NULL;
 	if (dir == mosq_md_out) {
 		mosq->out_queue_len++;
-		message->next = NULL;
+		message->prev = mosq->out_messages_last;
 		if (mosq->out_messages_last) {
 			mosq->out_messages_last->next = message;
 		} else {
 			mosq->out_messages = message;
 		}
 		mosq->out_messages_last = message;
+		_mosquitto_message_index_add(&mosq->out_index, mosq->out_messages, message);
 		if (message->msg.qos > 0) {
-			if (mosq->max_inflight_messages == 0 || mosq->inflight_messages < mosq->max_inflight_messages) {
+			if (!mosq->out_messages_pending && (mosq->max_inflight_messages == 0 || mosq->inflight_messages < mosq->max_inflight_messages)) {
 				mosq->inflight_messages++;
+				if (message->msg.qos == 1) {
+					message->state = mosq_ms_wait_for_puback;
+				} else {
+					message->state = mosq_ms_wait_for_pubrec;
+				}
+				_mosquitto_message_retry_touch(&mosq->out_retry, message);
 			} else {
+				message->state = mosq_ms_invalid;
+				if (!mosq->out_messages_pending) {
+					mosq->out_messages_pending = message;
+				}
 				rc = 1;
 			}
 		}
 	} else {
 		mosq->in_queue_len++;
-		message->next = NULL;
+		message->prev = mosq->in_messages_last;
 		if (mosq->in_messages_last) {
 			mosq->in_messages_last->next = message;
 		} else {
 			mosq->in_messages = message;
 		}
 		mosq->in_messages_last = message;
+		_mosquitto_message_index_add(&mosq->in_index, mosq->in_messages, message);
+		_mosquitto_message_retry_touch(&mosq->in_retry, message);
 	}
 	return rc;
 }
@@ -188,152 +400,131 @@ int _mosquitto_message_queue(struct mosquitto *mosq, struct mosquitto_message_al
 void _mosquitto_messages_reconnect_reset(struct mosquitto *mosq)
 {
 	struct mosquitto_message_all *message;
-	struct mosquitto_message_all *prev = NULL;
+	struct mosquitto_message_all *next;
 	assert(mosq);
 
+	/* All timestamps go back to 0, so the retry queues are rebuilt in list
+	 * order and everything still unacknowledged is resent on the next check. */
 	pthread_mutex_lock(&mosq->in_message_mutex);
-	message = mosq->in_messages;
+	mosq->in_retry.head = mosq->in_retry.tail = NULL;
 	mosq->in_queue_len = 0;
-	while (message) {
-		mosq->in_queue_len++;
-		message->timestamp = 0;
+	for (message = mosq->in_messages; message; message = next) {
+		next = message->next;
+		message->retry_next = NULL;
+		message->retry_prev = NULL;
 		if (message->msg.qos != 2) {
-			if (prev) {
-				prev->next = message->next;
-				_mosquitto_message_cleanup(&message);
-				message = prev;
-			} else {
-				mosq->in_messages = message->next;
-				_mosquitto_message_cleanup(&message);
-				message = mosq->in_messages;
-			}
+			_mosquitto_message_index_del(&mosq->in_index, message);
+			_mosquitto_message_unlink(&mosq->in_messages, &mosq->in_messages_last, message);
+			_mosquitto_message_cleanup(&message);
 		} else {
 			/* Message state can be preserved here because it should match
 			 * whatever the client has got. */
+			mosq->in_queue_len++;
+			message->timestamp = 0;
+			_mosquitto_message_retry_touch(&mosq->in_retry, message);
 		}
-		prev = message;
-		message = message->next;
 	}
-	mosq->in_messages_last = prev;
 	pthread_mutex_unlock(&mosq->in_message_mutex);
 
 	pthread_mutex_lock(&mosq->out_message_mutex);
+	mosq->out_retry.head = mosq->out_retry.tail = NULL;
+	mosq->out_messages_pending = NULL;
 	mosq->inflight_messages = 0;
-	message = mosq->out_messages;
 	mosq->out_queue_len = 0;
-	while (message) {
+	for (message = mosq->out_messages; message; message = message->next) {
 		mosq->out_queue_len++;
 		message->timestamp = 0;
+		message->retry_next = NULL;
+		message->retry_prev = NULL;
 
-		if (mosq->max_inflight_messages == 0 || mosq->inflight_messages < mosq->max_inflight_messages) {
+		if (!mosq->out_messages_pending && (mosq->max_inflight_messages == 0 || mosq->inflight_messages < mosq->max_inflight_messages)) {
 			if (message->msg.qos > 0) {
 				mosq->inflight_messages++;
 			}
 			if (message->msg.qos == 1) {
 				message->state = mosq_ms_wait_for_puback;
 			} else if (message->msg.qos == 2) {
-				/* Should be able to preserve state. */
+				/* Should be able to preserve state, unless the message
+				 * had not been sent yet. */
+				if (message->state == mosq_ms_invalid) {
+					message->state = mosq_ms_wait_for_pubrec;
+				}
 			}
+			_mosquitto_message_retry_touch(&mosq->out_retry, message);
 		} else {
 			message->state = mosq_ms_invalid;
+			if (!mosq->out_messages_pending) {
+				mosq->out_messages_pending = message;
+			}
 		}
-		prev = message;
-		message = message->next;
 	}
-	mosq->out_messages_last = prev;
 	pthread_mutex_unlock(&mosq->out_message_mutex);
 }
 
 int _mosquitto_message_remove(struct mosquitto *mosq, uint16_t mid, enum mosquitto_msg_direction dir, struct mosquitto_message_all **message)
 {
-	struct mosquitto_message_all *cur, *prev = NULL;
-	bool found = false;
+	struct mosquitto_message_all *cur;
 	int rc;
 	assert(mosq);
 	assert(message);
 
 	if (dir == mosq_md_out) {
 		pthread_mutex_lock(&mosq->out_message_mutex);
-		cur = mosq->out_messages;
-		while (cur) {
-			if (cur->msg.mid == mid) {
-				if (prev) {
-					prev->next = cur->next;
-				} else {
-					mosq->out_messages = cur->next;
-				}
-				*message = cur;
-				mosq->out_queue_len--;
-				if (cur->next == NULL) {
-					mosq->out_messages_last = prev;
-				} else if (!mosq->out_messages) {
-					mosq->out_messages_last = NULL;
-				}
-				if (cur->msg.qos > 0) {
-					mosq->inflight_messages--;
-				}
-				found = true;
-				break;
-			}
-			prev = cur;
-			cur = cur->next;
+		cur = _mosquitto_message_find(mosq->out_messages, &mosq->out_index, mid);
+		if (!cur) {
+			pthread_mutex_unlock(&mosq->out_message_mutex);
+			return MOSQ_ERR_NOT_FOUND;
 		}
 
-		if (found) {
-			cur = mosq->out_messages;
-			while (cur) {
-				if (mosq->max_inflight_messages == 0 || mosq->inflight_messages < mosq->max_inflight_messages) {
-					if (cur->msg.qos > 0 && cur->state == mosq_ms_invalid) {
-						mosq->inflight_messages++;
-						if (cur->msg.qos == 1) {
-							cur->state = mosq_ms_wait_for_puback;
-						} else if (cur->msg.qos == 2) {
-							cur->state = mosq_ms_wait_for_pubrec;
-						}
-						rc = _mosquitto_send_publish(mosq, cur->msg.mid, cur->msg.topic, cur->msg.payloadlen, cur->msg.payload, cur->msg.qos, cur->msg.retain, cur->dup);
-						if (rc) {
-							pthread_mutex_unlock(&mosq->out_message_mutex);
-							return rc;
-						}
-					}
-				} else {
+		if (mosq->out_messages_pending == cur) {
+			mosq->out_messages_pending = cur->next;
+		}
+		_mosquitto_message_index_del(&mosq->out_index, cur);
+		_mosquitto_message_retry_unlink(&mosq->out_retry, cur);
+		_mosquitto_message_unlink(&mosq->out_messages, &mosq->out_messages_last, cur);
+		*message = cur;
+		mosq->out_queue_len--;
+		if (cur->msg.qos > 0 && cur->state != mosq_ms_invalid) {
+			mosq->inflight_messages--;
+		}
+
+		/* Start the messages that were waiting for a free slot. They are
+		 * all at the end of the list, from out_messages_pending on. */
+		while ((cur = mosq->out_messages_pending) != NULL) {
+			if (mosq->max_inflight_messages != 0 && mosq->inflight_messages >= mosq->max_inflight_messages) {
+				break;
+			}
+			mosq->out_messages_pending = cur->next;
+			if (cur->msg.qos > 0 && cur->state == mosq_ms_invalid) {
+				mosq->inflight_messages++;
+				if (cur->msg.qos == 1) {
+					cur->state = mosq_ms_wait_for_puback;
+				} else if (cur->msg.qos == 2) {
+					cur->state = mosq_ms_wait_for_pubrec;
+				}
+				cur->timestamp = mosquitto_time();
+				_mosquitto_message_retry_touch(&mosq->out_retry, cur);
+				rc = _mosquitto_send_publish(mosq, cur->msg.mid, cur->msg.topic, cur->msg.payloadlen, cur->msg.payload, cur->msg.qos, cur->msg.retain, cur->dup);
+				if (rc) {
 					pthread_mutex_unlock(&mosq->out_message_mutex);
-					return MOSQ_ERR_SUCCESS;
+					return rc;
 				}
-				cur = cur->next;
 			}
-			pthread_mutex_unlock(&mosq->out_message_mutex);
-			return MOSQ_ERR_SUCCESS;
-		} else {
-			pthread_mutex_unlock(&mosq->out_message_mutex);
-			return MOSQ_ERR_NOT_FOUND;
 		}
+		pthread_mutex_unlock(&mosq->out_message_mutex);
+		return MOSQ_ERR_SUCCESS;
 	} else {
 		pthread_mutex_lock(&mosq->in_message_mutex);
-		cur = mosq->in_messages;
-		while (cur) {
-			if (cur->msg.mid == mid) {
-				if (prev) {
-					prev->next = cur->next;
-				} else {
-					mosq->in_messages = cur->next;
-				}
-				*message = cur;
-				mosq->in_queue_len--;
-				if (cur->next == NULL) {
-					mosq->in_messages_last = prev;
-				} else if (!mosq->in_messages) {
-					mosq->in_messages_last = NULL;
-				}
-				found = true;
-				break;
-			}
-			prev = cur;
-			cur = cur->next;
+		cur = _mosquitto_message_find(mosq->in_messages, &mosq->in_index, mid);
+		if (cur) {
+			_mosquitto_message_index_del(&mosq->in_index, cur);
+			_mosquitto_message_retry_unlink(&mosq->in_retry, cur);
+			_mosquitto_message_unlink(&mosq->in_messages, &mosq->in_messages_last, cur);
+			*message = cur;
+			mosq->in_queue_len--;
 		}
-
 		pthread_mutex_unlock(&mosq->in_message_mutex);
-		if (found) {
+		if (cur) {
 			return MOSQ_ERR_SUCCESS;
 		} else {
 			return MOSQ_ERR_NOT_FOUND;
@@ -342,11 +533,12 @@ int _mosquitto_message_remove(struct mosquitto *mosq, uint16_t mid, enum mosquit
 }
 
 #ifdef WITH_THREADING
-void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct mosquitto_message_all *messages, pthread_mutex_t *mutex)
+void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct _mosquitto_retry_queue *queue, pthread_mutex_t *mutex)
 #else
-void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct mosquitto_message_all *messages)
+void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct _mosquitto_retry_queue *queue)
 #endif
 {
+	struct mosquitto_message_all *messages;
 	time_t now = mosquitto_time();
 	assert(mosq);
 
@@ -354,30 +546,30 @@ void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct mosqui
 	pthread_mutex_lock(mutex);
 #endif
 
-	while (messages) {
-		if (messages->timestamp + mosq->message_retry < now) {
-			switch (messages->state) {
-			case mosq_ms_wait_for_puback:
-			case mosq_ms_wait_for_pubrec:
-				messages->timestamp = now;
-				messages->dup = true;
-				_mosquitto_send_publish(mosq, messages->msg.mid, messages->msg.topic, messages->msg.payloadlen, messages->msg.payload, messages->msg.qos, messages->msg.retain, messages->dup);
-				break;
-			case mosq_ms_wait_for_pubrel:
-				messages->timestamp = now;
-				messages->dup = true;
-				_mosquitto_send_pubrec(mosq, messages->msg.mid);
-				break;
-			case mosq_ms_wait_for_pubcomp:
-				messages->timestamp = now;
-				messages->dup = true;
-				_mosquitto_send_pubrel(mosq, messages->msg.mid);
-				break;
-			default:
-				break;
-			}
+	/* Resent messages go to the tail with the current time, which ends the
+	 * loop once every expired message has been handled. */
+	while ((messages = queue->head) != NULL && messages->timestamp + mosq->message_retry < now) {
+		switch (messages->state) {
+		case mosq_ms_wait_for_puback:
+		case mosq_ms_wait_for_pubrec:
+			messages->timestamp = now;
+			messages->dup = true;
+			_mosquitto_send_publish(mosq, messages->msg.mid, messages->msg.topic, messages->msg.payloadlen, messages->msg.payload, messages->msg.qos, messages->msg.retain, messages->dup);
+			break;
+		case mosq_ms_wait_for_pubrel:
+			messages->timestamp = now;
+			messages->dup = true;
+			_mosquitto_send_pubrec(mosq, messages->msg.mid);
+			break;
+		case mosq_ms_wait_for_pubcomp:
+			messages->timestamp = now;
+			messages->dup = true;
+			_mosquitto_send_pubrel(mosq, messages->msg.mid);
+			break;
+		default:
+			break;
 		}
-		messages = messages->next;
+		_mosquitto_message_retry_touch(queue, messages);
 	}
 #ifdef WITH_THREADING
 	pthread_mutex_unlock(mutex);
@@ -387,11 +579,11 @@ void _mosquitto_message_retry_check_actual(struct mosquitto *mosq, struct mosqui
 void _mosquitto_message_retry_check(struct mosquitto *mosq)
 {
 #ifdef WITH_THREADING
-	_mosquitto_message_retry_check_actual(mosq, mosq->out_messages, &mosq->out_message_mutex);
-	_mosquitto_message_retry_check_actual(mosq, mosq->in_messages, &mosq->in_message_mutex);
+	_mosquitto_message_retry_check_actual(mosq, &mosq->out_retry, &mosq->out_message_mutex);
+	_mosquitto_message_retry_check_actual(mosq, &mosq->in_retry, &mosq->in_message_mutex);
 #else
-	_mosquitto_message_retry_check_actual(mosq, mosq->out_messages);
-	_mosquitto_message_retry_check_actual(mosq, mosq->in_messages);
+	_mosquitto_message_retry_check_actual(mosq, &mosq->out_retry);
+	_mosquitto_message_retry_check_actual(mosq, &mosq->in_retry);
 #endif
 }
 
@@ -409,15 +601,13 @@ int _mosquitto_message_out_update(struct mosquitto *mosq, uint16_t mid, enum mos
 	assert(mosq);
 
 	pthread_mutex_lock(&mosq->out_message_mutex);
-	message = mosq->out_messages;
-	while (message) {
-		if (message->msg.mid == mid) {
-			message->state = state;
-			message->timestamp = mosquitto_time();
-			pthread_mutex_unlock(&mosq->out_message_mutex);
-			return MOSQ_ERR_SUCCESS;
-		}
-		message = message->next;
+	message = _mosquitto_message_find(mosq->out_messages, &mosq->out_index, mid);
+	if (message) {
+		message->state = state;
+		message->timestamp = mosquitto_time();
+		_mosquitto_message_retry_touch(&mosq->out_retry, message);
+		pthread_mutex_unlock(&mosq->out_message_mutex);
+		return MOSQ_ERR_SUCCESS;
 	}
 	pthread_mutex_unlock(&mosq->out_message_mutex);
 	return MOSQ_ERR_NOT_FOUND;
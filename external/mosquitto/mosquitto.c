@@ -488,8 +488,7 @@ void _mosquitto_destroy(struct mosquitto *mosq)
 			mosq->out_packet = mosq->out_packet->next;
 		}
 
-		_mosquitto_packet_cleanup(packet);
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 	}
 
 	_mosquitto_packet_cleanup(&mosq->in_packet);
@@ -570,6 +569,10 @@ static int _mosquitto_connect_init(struct mosquitto *mosq, const char *host, int
 		mosq->sockpairW = INVALID_SOCKET;
 	}
 
+	pthread_mutex_lock(&mosq->out_packet_mutex);
+	mosq->sockpair_pending = false;
+	pthread_mutex_unlock(&mosq->out_packet_mutex);
+
 	if (_mosquitto_socketpair(&mosq->sockpairR, &mosq->sockpairW)) {
 		_mosquitto_log_printf(mosq, MOSQ_LOG_WARNING, "Warning: Unable to open socket pair, outgoing publish commands may be delayed.");
 	}
@@ -673,8 +676,7 @@ static int _mosquitto_reconnect(struct mosquitto *mosq, bool blocking)
 			mosq->out_packet = mosq->out_packet->next;
 		}
 
-		_mosquitto_packet_cleanup(packet);
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 	}
 	pthread_mutex_unlock(&mosq->out_packet_mutex);
 	pthread_mutex_unlock(&mosq->current_out_packet_mutex);
@@ -778,15 +780,9 @@ int mosquitto_publish(struct mosquitto *mosq, int *mid, const char *topic, int p
 		pthread_mutex_lock(&mosq->out_message_mutex);
 		queue_status = _mosquitto_message_queue(mosq, message, mosq_md_out);
 		if (queue_status == 0) {
-			if (qos == 1) {
-				message->state = mosq_ms_wait_for_puback;
-			} else if (qos == 2) {
-				message->state = mosq_ms_wait_for_pubrec;
-			}
 			pthread_mutex_unlock(&mosq->out_message_mutex);
 			return _mosquitto_send_publish(mosq, message->msg.mid, message->msg.topic, message->msg.payloadlen, message->msg.payload, message->msg.qos, message->msg.retain, message->dup);
 		} else {
-			message->state = mosq_ms_invalid;
 			pthread_mutex_unlock(&mosq->out_message_mutex);
 			return MOSQ_ERR_SUCCESS;
 		}
@@ -1147,7 +1143,13 @@ int mosquitto_loop(struct mosquitto *mosq, int timeout, int max_packets)
 	fd_set readfds, writefds;
 	int fdcount;
 	int rc;
+#if defined(__TINYARA__)
+	char pairdrain[16];
+	ssize_t pairlen;
+	ssize_t i;
+#else
 	char pairbuf;
+#endif
 	int maxfd = 0;
 	time_t now;
 
@@ -1266,6 +1268,19 @@ int mosquitto_loop(struct mosquitto *mosq, int timeout, int max_packets)
 			return MOSQ_ERR_ERRNO;
 		}
 	} else {
+#if defined(WITH_MBEDTLS) && defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+		/* Nothing happened before the timeout: the connection is idle, so
+		 * give its TLS record buffers back until the next packet. */
+		if (fdcount == 0 && mosq->sock != INVALID_SOCKET && (mosq->mbedtls_state == mosq_mbedtls_state_enabled) && mosq->ssl_ctx && !mosq->want_connect) {
+			pthread_mutex_lock(&mosq->current_out_packet_mutex);
+			pthread_mutex_lock(&mosq->out_packet_mutex);
+			if (!mosq->out_packet && !mosq->current_out_packet) {
+				mbedtls_ssl_release_buffers(mosq->ssl_ctx);
+			}
+			pthread_mutex_unlock(&mosq->out_packet_mutex);
+			pthread_mutex_unlock(&mosq->current_out_packet_mutex);
+		}
+#endif
 		if (mosq->sock != INVALID_SOCKET) {
 			if (FD_ISSET(mosq->sock, &readfds)) {
 #ifdef WITH_TLS
@@ -1294,10 +1309,17 @@ int mosquitto_loop(struct mosquitto *mosq, int timeout, int max_packets)
 					}
 			}
 			if (mosq->sockpairR != INVALID_SOCKET && FD_ISSET(mosq->sockpairR, &readfds)) {
+				/* Clear the flag before reading so that a packet queued from
+				 * now on writes a new wakeup byte. */
+				pthread_mutex_lock(&mosq->out_packet_mutex);
+				mosq->sockpair_pending = false;
+				pthread_mutex_unlock(&mosq->out_packet_mutex);
 #ifndef WIN32
 #if defined(__TINYARA__)
-				if (read(mosq->sockpairR, &pairbuf, 1) == 1) {
-					if (pairbuf == 0xff) {
+				/* The exit request (0xff) may follow a wakeup byte */
+				pairlen = read(mosq->sockpairR, pairdrain, sizeof(pairdrain));
+				for (i = 0; i < pairlen; i++) {
+					if ((unsigned char)pairdrain[i] == 0xff) {
 						return MOSQ_ERR_FORCE_EXIT;
 					}
 				}
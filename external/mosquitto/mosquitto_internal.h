@@ -172,6 +172,10 @@ struct _mosquitto_packet {
 
 struct mosquitto_message_all {
 	struct mosquitto_message_all *next;
+	struct mosquitto_message_all *prev;
+	struct mosquitto_message_all *hash_next;
+	struct mosquitto_message_all *retry_next;
+	struct mosquitto_message_all *retry_prev;
 	time_t timestamp;
 	//enum mosquitto_msg_direction direction;
 	enum mosquitto_msg_state state;
@@ -179,10 +183,26 @@ struct mosquitto_message_all {
 	struct mosquitto_message msg;
 };
 
+/* Messages of one direction indexed by mid, chained through hash_next. */
+struct _mosquitto_message_index {
+	struct mosquitto_message_all **buckets;
+	unsigned int size;			/* power of two, 0 if not allocated */
+	unsigned int count;
+};
+
+/* Messages waiting for a reply, oldest timestamp first. Every message uses the
+ * same retry interval and is moved to the tail when it is (re)sent, so the
+ * queue stays sorted and only its head has to be checked. */
+struct _mosquitto_retry_queue {
+	struct mosquitto_message_all *head;
+	struct mosquitto_message_all *tail;
+};
+
 struct mosquitto {
 	mosq_sock_t sock;
 #ifndef WITH_BROKER
 	mosq_sock_t sockpairR, sockpairW;
+	bool sockpair_pending;		/* wakeup byte written and not read yet, protected by out_packet_mutex */
 #endif
 	enum _mosquitto_protocol protocol;
 	char *address;
@@ -198,6 +218,9 @@ struct mosquitto {
 	struct _mosquitto_packet in_packet;
 	struct _mosquitto_packet *current_out_packet;
 	struct _mosquitto_packet *out_packet;
+#ifndef WITH_BROKER
+	uint32_t out_retry_len;		/* length of a write to repeat as is, 0 if none */
+#endif
 	struct mosquitto_message *will;
 #ifdef WITH_MBEDTLS
 	int mbedtls_state;
@@ -289,6 +312,11 @@ struct mosquitto {
 	struct mosquitto_message_all *in_messages_last;
 	struct mosquitto_message_all *out_messages;
 	struct mosquitto_message_all *out_messages_last;
+	struct mosquitto_message_all *out_messages_pending;	/* first message waiting for an in-flight slot */
+	struct _mosquitto_message_index in_index;
+	struct _mosquitto_message_index out_index;
+	struct _mosquitto_retry_queue in_retry;
+	struct _mosquitto_retry_queue out_retry;
 	void (*on_connect)(struct mosquitto *, void *userdata, int rc);
 	void (*on_disconnect)(struct mosquitto *, void *userdata, int rc);
 	void (*on_publish)(struct mosquitto *, void *userdata, int mid);
@@ -74,6 +74,10 @@ Contributors:
 #	include <tls_mosq.h>
 #endif
 
+#ifdef WITH_MBEDTLS
+#	include "mbedtls/ssl_session_store.h"
+#endif
+
 #ifdef WITH_BROKER
 #	include <mosquitto_broker.h>
 #	ifdef WITH_SYS_TREE
@@ -143,6 +147,19 @@ void _mosquitto_net_cleanup(void)
 #ifdef WIN32
 	WSACleanup();
 #endif
+
+	_mosquitto_packet_pool_cleanup();
+}
+
+struct _mosquitto_packet *_mosquitto_packet_new(void)
+{
+	struct _mosquitto_packet *packet;
+
+	packet = _mosquitto_packet_buf_alloc(sizeof(struct _mosquitto_packet));
+	if (packet) {
+		memset(packet, 0, sizeof(struct _mosquitto_packet));
+	}
+	return packet;
 }
 
 void _mosquitto_packet_cleanup(struct _mosquitto_packet *packet)
@@ -157,17 +174,24 @@ void _mosquitto_packet_cleanup(struct _mosquitto_packet *packet)
 	packet->remaining_mult = 1;
 	packet->remaining_length = 0;
 	if (packet->payload) {
-		_mosquitto_free(packet->payload);
+		_mosquitto_packet_buf_free(packet->payload);
 	}
 	packet->payload = NULL;
 	packet->to_process = 0;
 	packet->pos = 0;
 }
 
+void _mosquitto_packet_free(struct _mosquitto_packet *packet)
+{
+	_mosquitto_packet_cleanup(packet);
+	_mosquitto_packet_buf_free(packet);
+}
+
 int _mosquitto_packet_queue(struct mosquitto *mosq, struct _mosquitto_packet *packet)
 {
 #ifndef WITH_BROKER
 	char sockpair_data = 0;
+	bool wake;
 #endif
 	assert(mosq);
 	assert(packet);
@@ -183,6 +207,12 @@ int _mosquitto_packet_queue(struct mosquitto *mosq, struct _mosquitto_packet *pa
 		mosq->out_packet = packet;
 	}
 	mosq->out_packet_last = packet;
+#ifndef WITH_BROKER
+	/* One wakeup byte is enough until the loop thread has read it: packets
+	 * queued in the meantime are picked up by the same write pass. */
+	wake = !mosq->sockpair_pending;
+	mosq->sockpair_pending = true;
+#endif
 	pthread_mutex_unlock(&mosq->out_packet_mutex);
 #ifdef WITH_BROKER
 #ifdef WITH_WEBSOCKETS
@@ -199,7 +229,7 @@ int _mosquitto_packet_queue(struct mosquitto *mosq, struct _mosquitto_packet *pa
 
 	/* Write a single byte to sockpairW (connected to sockpairR) to break out
 	 * of select() if in threaded mode. */
-	if (mosq->sockpairW != INVALID_SOCKET) {
+	if (wake && mosq->sockpairW != INVALID_SOCKET) {
 #ifndef WIN32
 		if (write(mosq->sockpairW, &sockpair_data, 1)) {
 		}
@@ -270,6 +300,8 @@ int _mosquitto_socket_close(struct mosquitto *mosq)
 		assert(mosq->listener->client_count >= 0);
 		mosq->listener = NULL;
 	}
+#else
+	mosq->out_retry_len = 0;
 #endif
 
 	return rc;
@@ -538,9 +570,19 @@ int _mosquitto_socket_connect(struct mosquitto *mosq, const char *host, uint16_t
 		((mbedtls_net_context *)mosq->net)->fd = (int)sock;
 		mbedtls_ssl_set_bio(mosq->ssl_ctx, mosq->net, mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+		/* Resume the last session with this broker, if any */
+		mbedtls_ssl_session_store_load(mosq->ssl_ctx, host, port);
+#endif
 		if (mosquitto__socket_connect_tls(mosq)) {
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+			mbedtls_ssl_session_store_remove(mosq->ssl_ctx, host, port);
+#endif
 			return MOSQ_ERR_TLS;
 		}
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+		mbedtls_ssl_session_store_save(mosq->ssl_ctx, host, port);
+#endif
 	}
 #endif
 
@@ -924,6 +966,102 @@ ssize_t _mosquitto_net_write(struct mosquitto *mosq, void *buf, size_t count)
 #endif
 }
 
+#ifndef WITH_BROKER
+/* Write the rest of the current packet. Small packets queued behind it are
+ * copied after it and go out in the same write, so that a burst of PUBACKs or
+ * QoS 0 publishes costs one send() (and one TLS record) instead of one each.
+ * Bytes written beyond the current packet are accounted to the following
+ * packets, which the caller then completes without writing them again.
+ *
+ * A TLS write that could not complete must be repeated with the same length,
+ * so the length of a failed write is kept in out_retry_len and the next call
+ * gathers exactly the same packets again.
+ *
+ * Returns the number of bytes of the current packet written, or what
+ * _mosquitto_net_write() returned on error. */
+static ssize_t _mosquitto_packet_write_some(struct mosquitto *mosq, struct _mosquitto_packet *packet)
+{
+	ssize_t write_length;
+#if MOSQ_WRITE_COALESCE_SIZE > 0
+	struct _mosquitto_packet *next;
+	struct _mosquitto_packet *last;
+	uint8_t *buf;
+	uint32_t limit;
+	uint32_t len;
+	uint32_t part;
+
+	limit = mosq->out_retry_len ? mosq->out_retry_len : MOSQ_WRITE_COALESCE_SIZE;
+	if (packet->to_process >= limit || ((packet->command) & 0xF0) == DISCONNECT) {
+		goto single;
+	}
+
+	pthread_mutex_lock(&mosq->out_packet_mutex);
+	last = NULL;
+	len = packet->to_process;
+	for (next = mosq->out_packet; next; next = next->next) {
+		if (len + next->to_process > limit) {
+			break;
+		}
+		len += next->to_process;
+		last = next;
+		if (((next->command) & 0xF0) == DISCONNECT) {
+			break;
+		}
+	}
+	pthread_mutex_unlock(&mosq->out_packet_mutex);
+
+	/* Packets are only removed from out_packet by this thread, which holds
+	 * current_out_packet_mutex, so the gathered ones stay valid. */
+	if (!last || (mosq->out_retry_len && len != mosq->out_retry_len)) {
+		goto single;
+	}
+
+	buf = _mosquitto_packet_buf_alloc(len);
+	if (!buf) {
+		goto single;
+	}
+
+	memcpy(buf, &(packet->payload[packet->pos]), packet->to_process);
+	len = packet->to_process;
+	next = packet;
+	do {
+		next = (next == packet) ? mosq->out_packet : next->next;
+		memcpy(&buf[len], &(next->payload[next->pos]), next->to_process);
+		len += next->to_process;
+	} while (next != last);
+
+	write_length = _mosquitto_net_write(mosq, buf, len);
+	_mosquitto_packet_buf_free(buf);
+	if (write_length <= 0) {
+		mosq->out_retry_len = len;
+		return write_length;
+	}
+	mosq->out_retry_len = 0;
+	if (write_length <= packet->to_process) {
+		return write_length;
+	}
+
+	/* The current packet is advanced by the caller */
+	len = write_length - packet->to_process;
+	write_length = packet->to_process;
+	next = packet;
+	while (len > 0) {
+		next = (next == packet) ? mosq->out_packet : next->next;
+		part = next->to_process < len ? next->to_process : len;
+		next->to_process -= part;
+		next->pos += part;
+		len -= part;
+	}
+	return write_length;
+
+single:
+#endif
+	write_length = _mosquitto_net_write(mosq, &(packet->payload[packet->pos]), packet->to_process);
+	mosq->out_retry_len = (write_length <= 0) ? packet->to_process : 0;
+	return write_length;
+}
+#endif
+
 int _mosquitto_packet_write(struct mosquitto *mosq)
 {
 	ssize_t write_length;
@@ -956,7 +1094,11 @@ int _mosquitto_packet_write(struct mosquitto *mosq)
 		packet = mosq->current_out_packet;
 
 		while (packet->to_process > 0) {
+#ifdef WITH_BROKER
 			write_length = _mosquitto_net_write(mosq, &(packet->payload[packet->pos]), packet->to_process);
+#else
+			write_length = _mosquitto_packet_write_some(mosq, packet);
+#endif
 			if (write_length > 0) {
 #if defined(WITH_BROKER) && defined(WITH_SYS_TREE)
 				g_bytes_sent += write_length;
@@ -1017,8 +1159,7 @@ int _mosquitto_packet_write(struct mosquitto *mosq)
 			}
 			pthread_mutex_unlock(&mosq->out_packet_mutex);
 
-			_mosquitto_packet_cleanup(packet);
-			_mosquitto_free(packet);
+			_mosquitto_packet_free(packet);
 
 			pthread_mutex_lock(&mosq->msgtime_mutex);
 			mosq->next_msg_out = mosquitto_time() + mosq->keepalive;
@@ -1048,8 +1189,7 @@ int _mosquitto_packet_write(struct mosquitto *mosq)
 		}
 		pthread_mutex_unlock(&mosq->out_packet_mutex);
 
-		_mosquitto_packet_cleanup(packet);
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 
 		pthread_mutex_lock(&mosq->msgtime_mutex);
 		mosq->next_msg_out = mosquitto_time() + mosq->keepalive;
@@ -1175,7 +1315,7 @@ int _mosquitto_packet_read(struct mosquitto *mosq)
 		mosq->in_packet.remaining_count *= -1;
 
 		if (mosq->in_packet.remaining_length > 0) {
-			mosq->in_packet.payload = _mosquitto_malloc(mosq->in_packet.remaining_length * sizeof(uint8_t));
+			mosq->in_packet.payload = _mosquitto_packet_buf_alloc(mosq->in_packet.remaining_length * sizeof(uint8_t));
 			if (!mosq->in_packet.payload) {
 				return MOSQ_ERR_NOMEM;
 			}
@@ -69,7 +69,9 @@ struct mosquitto_db;
 void _mosquitto_net_init(void);
 void _mosquitto_net_cleanup(void);
 
+struct _mosquitto_packet *_mosquitto_packet_new(void);
 void _mosquitto_packet_cleanup(struct _mosquitto_packet *packet);
+void _mosquitto_packet_free(struct _mosquitto_packet *packet);
 int _mosquitto_packet_queue(struct mosquitto *mosq, struct _mosquitto_packet *packet);
 int _mosquitto_socket_connect(struct mosquitto *mosq, const char *host, uint16_t port, const char *bind_address, bool blocking);
 #ifdef WITH_BROKER
@@ -86,7 +86,7 @@ int _mosquitto_send_connect(struct mosquitto *mosq, uint16_t keepalive, bool cle
 		return MOSQ_ERR_INVAL;
 	}
 
-	packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+	packet = _mosquitto_packet_new();
 	if (!packet) {
 		return MOSQ_ERR_NOMEM;
 	}
@@ -109,7 +109,7 @@ int _mosquitto_send_connect(struct mosquitto *mosq, uint16_t keepalive, bool cle
 	packet->remaining_length = headerlen + payloadlen;
 	rc = _mosquitto_packet_alloc(packet);
 	if (rc) {
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 		return rc;
 	}
 
@@ -187,7 +187,7 @@ int _mosquitto_send_subscribe(struct mosquitto *mosq, int *mid, const char *topi
 	assert(mosq);
 	assert(topic);
 
-	packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+	packet = _mosquitto_packet_new();
 	if (!packet) {
 		return MOSQ_ERR_NOMEM;
 	}
@@ -198,7 +198,7 @@ int _mosquitto_send_subscribe(struct mosquitto *mosq, int *mid, const char *topi
 	packet->remaining_length = packetlen;
 	rc = _mosquitto_packet_alloc(packet);
 	if (rc) {
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 		return rc;
 	}
 
@@ -235,7 +235,7 @@ int _mosquitto_send_unsubscribe(struct mosquitto *mosq, int *mid, const char *to
 	assert(mosq);
 	assert(topic);
 
-	packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+	packet = _mosquitto_packet_new();
 	if (!packet) {
 		return MOSQ_ERR_NOMEM;
 	}
@@ -246,7 +246,7 @@ int _mosquitto_send_unsubscribe(struct mosquitto *mosq, int *mid, const char *to
 	packet->remaining_length = packetlen;
 	rc = _mosquitto_packet_alloc(packet);
 	if (rc) {
-		_mosquitto_free(packet);
+		_mosquitto_packet_free(packet);
 		return rc;
 	}
 
@@ -118,7 +118,7 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 	int ulen, plen;
 
 	if (mosq->state == mosq_cs_socks5_new) {
-		packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+		packet = _mosquitto_packet_new();
 		if (!packet) {
 			return MOSQ_ERR_NOMEM;
 		}
@@ -128,7 +128,7 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 		} else {
 			packet->packet_length = 3;
 		}
-		packet->payload = _mosquitto_malloc(sizeof(uint8_t) * packet->packet_length);
+		packet->payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * packet->packet_length);
 
 		packet->payload[0] = 0x05;
 		if (mosq->socks5_username) {
@@ -147,22 +147,21 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 		mosq->in_packet.pos = 0;
 		mosq->in_packet.packet_length = 2;
 		mosq->in_packet.to_process = 2;
-		mosq->in_packet.payload = _mosquitto_malloc(sizeof(uint8_t) * 2);
+		mosq->in_packet.payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * 2);
 		if (!mosq->in_packet.payload) {
-			_mosquitto_free(packet->payload);
-			_mosquitto_free(packet);
+			_mosquitto_packet_free(packet);
 			return MOSQ_ERR_NOMEM;
 		}
 
 		return _mosquitto_packet_queue(mosq, packet);
 	} else if (mosq->state == mosq_cs_socks5_auth_ok) {
-		packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+		packet = _mosquitto_packet_new();
 		if (!packet) {
 			return MOSQ_ERR_NOMEM;
 		}
 
 		packet->packet_length = 7 + strlen(mosq->host);
-		packet->payload = _mosquitto_malloc(sizeof(uint8_t) * packet->packet_length);
+		packet->payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * packet->packet_length);
 
 		slen = strlen(mosq->host);
 
@@ -182,16 +181,15 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 		mosq->in_packet.pos = 0;
 		mosq->in_packet.packet_length = 5;
 		mosq->in_packet.to_process = 5;
-		mosq->in_packet.payload = _mosquitto_malloc(sizeof(uint8_t) * 5);
+		mosq->in_packet.payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * 5);
 		if (!mosq->in_packet.payload) {
-			_mosquitto_free(packet->payload);
-			_mosquitto_free(packet);
+			_mosquitto_packet_free(packet);
 			return MOSQ_ERR_NOMEM;
 		}
 
 		return _mosquitto_packet_queue(mosq, packet);
 	} else if (mosq->state == mosq_cs_socks5_send_userpass) {
-		packet = _mosquitto_calloc(1, sizeof(struct _mosquitto_packet));
+		packet = _mosquitto_packet_new();
 		if (!packet) {
 			return MOSQ_ERR_NOMEM;
 		}
@@ -199,7 +197,7 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 		ulen = strlen(mosq->socks5_username);
 		plen = strlen(mosq->socks5_password);
 		packet->packet_length = 3 + ulen + plen;
-		packet->payload = _mosquitto_malloc(sizeof(uint8_t) * packet->packet_length);
+		packet->payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * packet->packet_length);
 
 		packet->payload[0] = 0x01;
 		packet->payload[1] = ulen;
@@ -214,10 +212,9 @@ int mosquitto__socks5_send(struct mosquitto *mosq)
 		mosq->in_packet.pos = 0;
 		mosq->in_packet.packet_length = 2;
 		mosq->in_packet.to_process = 2;
-		mosq->in_packet.payload = _mosquitto_malloc(sizeof(uint8_t) * 2);
+		mosq->in_packet.payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * 2);
 		if (!mosq->in_packet.payload) {
-			_mosquitto_free(packet->payload);
-			_mosquitto_free(packet);
+			_mosquitto_packet_free(packet);
 			return MOSQ_ERR_NOMEM;
 		}
 
@@ -373,7 +370,7 @@ int mosquitto__socks5_read(struct mosquitto *mosq)
 				_mosquitto_packet_cleanup(&mosq->in_packet);
 				return MOSQ_ERR_PROTOCOL;
 			}
-			payload = _mosquitto_realloc(mosq->in_packet.payload, mosq->in_packet.packet_length);
+			payload = _mosquitto_packet_buf_realloc(mosq->in_packet.payload, mosq->in_packet.packet_length);
 			if (payload) {
 				mosq->in_packet.payload = payload;
 			} else {
@@ -80,9 +80,9 @@ int _mosquitto_packet_alloc(struct _mosquitto_packet *packet)
 	}
 	packet->packet_length = packet->remaining_length + 1 + packet->remaining_count;
 #ifdef WITH_WEBSOCKETS
-	packet->payload = _mosquitto_malloc(sizeof(uint8_t) * packet->packet_length + LWS_SEND_BUFFER_PRE_PADDING + LWS_SEND_BUFFER_POST_PADDING);
+	packet->payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * packet->packet_length + LWS_SEND_BUFFER_PRE_PADDING + LWS_SEND_BUFFER_POST_PADDING);
 #else
-	packet->payload = _mosquitto_malloc(sizeof(uint8_t) * packet->packet_length);
+	packet->payload = _mosquitto_packet_buf_alloc(sizeof(uint8_t) * packet->packet_length);
 #endif
 	if (!packet->payload) {
 		return MOSQ_ERR_NOMEM;
@@ -705,6 +705,11 @@ int nghttp2_hd_deflate_init2(nghttp2_hd_deflater *deflater,
   deflater->deflate_hd_table_bufsize_max = max_deflate_dynamic_table_size;
   deflater->min_hd_table_bufsize_max = UINT32_MAX;
 
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  memset(deflater->cache, 0, sizeof(deflater->cache));
+  deflater->cache_next = 0;
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
   return 0;
 }
 
@@ -752,7 +757,21 @@ static void hd_inflate_keep_free(nghttp2_hd_inflater *inflater) {
   inflater->nv_name_keep = NULL;
 }
 
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+static void hd_deflate_cache_clear(nghttp2_hd_deflater *deflater) {
+  size_t i;
+
+  for (i = 0; i < NGHTTP2_HD_DEFLATE_CACHE_ENTRIES; ++i) {
+    nghttp2_mem_free(deflater->ctx.mem, deflater->cache[i].data);
+    deflater->cache[i].data = NULL;
+  }
+}
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
 void nghttp2_hd_deflate_free(nghttp2_hd_deflater *deflater) {
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  hd_deflate_cache_clear(deflater);
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
   hd_context_free(&deflater->ctx);
 }
 
@@ -1241,6 +1260,13 @@ int nghttp2_hd_deflate_change_table_size(
   deflater->notify_table_size_change = 1;
 
   hd_context_shrink_table_size(&deflater->ctx, &deflater->map);
+
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  /* Shrinking evicts entries without changing ctx.next_seq, and the
+     indexing decision depends on the table size. */
+  hd_deflate_cache_clear(deflater);
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
   return 0;
 }
 
@@ -1421,16 +1447,185 @@ static int deflate_nv(nghttp2_hd_deflater *deflater, nghttp2_bufs *bufs,
   return 0;
 }
 
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+/*
+ * Returns the length of the copy of the header fields |nva| of length
+ * |nvlen| kept in a cache entry.  Each header field is stored as its
+ * name length, value length, NGHTTP2_NV_FLAG_NO_INDEX flag, name and
+ * value.
+ */
+static size_t hd_deflate_cache_keylen(const nghttp2_nv *nva, size_t nvlen) {
+  size_t i;
+  size_t n = 0;
+
+  for (i = 0; i < nvlen; ++i) {
+    n += sizeof(size_t) * 2 + 1 + nva[i].namelen + nva[i].valuelen;
+  }
+
+  return n;
+}
+
+static int hd_deflate_cache_match(const uint8_t *key, const nghttp2_nv *nva,
+                                  size_t nvlen) {
+  size_t i;
+  size_t len[2];
+
+  for (i = 0; i < nvlen; ++i) {
+    memcpy(len, key, sizeof(len));
+    key += sizeof(len);
+
+    if (len[0] != nva[i].namelen || len[1] != nva[i].valuelen ||
+        *key++ != (nva[i].flags & NGHTTP2_NV_FLAG_NO_INDEX) ||
+        !memeq(key, nva[i].name, len[0]) ||
+        !memeq(key + len[0], nva[i].value, len[1])) {
+      return 0;
+    }
+
+    key += len[0] + len[1];
+  }
+
+  return 1;
+}
+
+static nghttp2_hd_deflate_cache_entry *
+hd_deflate_cache_find(nghttp2_hd_deflater *deflater, const nghttp2_nv *nva,
+                      size_t nvlen, size_t keylen) {
+  size_t i;
+  nghttp2_hd_deflate_cache_entry *ent;
+
+  for (i = 0; i < NGHTTP2_HD_DEFLATE_CACHE_ENTRIES; ++i) {
+    ent = &deflater->cache[i];
+
+    if (ent->data && ent->seq == deflater->ctx.next_seq &&
+        ent->hd_table_bufsize == deflater->ctx.hd_table_bufsize &&
+        ent->nvlen == nvlen && ent->keylen == keylen &&
+        hd_deflate_cache_match(ent->data, nva, nvlen)) {
+      return ent;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Stores the header block which was written to |bufs| from |last| in
+ * |chain| for the header fields |nva|.  Failing to allocate the entry
+ * is not an error; the block is just not cached.
+ */
+static void hd_deflate_cache_store(nghttp2_hd_deflater *deflater,
+                                   const nghttp2_nv *nva, size_t nvlen,
+                                   size_t keylen, nghttp2_buf_chain *chain,
+                                   uint8_t *last) {
+  nghttp2_hd_deflate_cache_entry *ent = NULL;
+  nghttp2_buf_chain *ci;
+  size_t blocklen;
+  size_t i;
+  uint8_t *p;
+
+  blocklen = (size_t)(chain->buf.last - last);
+  for (ci = chain->next; ci; ci = ci->next) {
+    blocklen += nghttp2_buf_len(&ci->buf);
+  }
+
+  if (keylen + blocklen > NGHTTP2_HD_DEFLATE_CACHE_MAX_SIZE) {
+    return;
+  }
+
+  /* Entries encoded against an older dynamic table can never match
+     again, so they are replaced first. */
+  for (i = 0; i < NGHTTP2_HD_DEFLATE_CACHE_ENTRIES; ++i) {
+    if (deflater->cache[i].data == NULL ||
+        deflater->cache[i].seq != deflater->ctx.next_seq ||
+        deflater->cache[i].hd_table_bufsize !=
+            deflater->ctx.hd_table_bufsize) {
+      ent = &deflater->cache[i];
+      break;
+    }
+  }
+
+  if (ent == NULL) {
+    ent = &deflater->cache[deflater->cache_next];
+    deflater->cache_next =
+        (deflater->cache_next + 1) % NGHTTP2_HD_DEFLATE_CACHE_ENTRIES;
+  }
+
+  nghttp2_mem_free(deflater->ctx.mem, ent->data);
+  ent->data = nghttp2_mem_malloc(deflater->ctx.mem, keylen + blocklen);
+  if (ent->data == NULL) {
+    return;
+  }
+
+  p = ent->data;
+  for (i = 0; i < nvlen; ++i) {
+    size_t len[2];
+
+    len[0] = nva[i].namelen;
+    len[1] = nva[i].valuelen;
+    memcpy(p, len, sizeof(len));
+    p += sizeof(len);
+    *p++ = nva[i].flags & NGHTTP2_NV_FLAG_NO_INDEX;
+    p = nghttp2_cpymem(p, nva[i].name, len[0]);
+    p = nghttp2_cpymem(p, nva[i].value, len[1]);
+  }
+
+  p = nghttp2_cpymem(p, last, (size_t)(chain->buf.last - last));
+  for (ci = chain->next; ci; ci = ci->next) {
+    p = nghttp2_cpymem(p, ci->buf.pos, nghttp2_buf_len(&ci->buf));
+  }
+
+  ent->keylen = keylen;
+  ent->blocklen = blocklen;
+  ent->nvlen = nvlen;
+  ent->seq = deflater->ctx.next_seq;
+  ent->hd_table_bufsize = deflater->ctx.hd_table_bufsize;
+}
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
 int nghttp2_hd_deflate_hd_bufs(nghttp2_hd_deflater *deflater,
                                nghttp2_bufs *bufs, const nghttp2_nv *nv,
                                size_t nvlen) {
   size_t i;
   int rv = 0;
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  nghttp2_hd_deflate_cache_entry *ent;
+  nghttp2_buf_chain *chain = NULL;
+  uint8_t *last = NULL;
+  size_t keylen = 0;
+  uint32_t seq = 0;
+  size_t hd_table_bufsize = 0;
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
 
   if (deflater->ctx.bad) {
     return NGHTTP2_ERR_HEADER_COMP;
   }
 
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  /* A block which starts with a table size update is not cached. */
+  if (!deflater->notify_table_size_change && nvlen > 0) {
+    keylen = hd_deflate_cache_keylen(nv, nvlen);
+
+    if (keylen < NGHTTP2_HD_DEFLATE_CACHE_MAX_SIZE) {
+      ent = hd_deflate_cache_find(deflater, nv, nvlen, keylen);
+      if (ent) {
+        DEBUGF("deflatehd: reuse cached header block, length=%zu\n",
+               ent->blocklen);
+
+        rv = nghttp2_bufs_add(bufs, ent->data + ent->keylen, ent->blocklen);
+        if (rv != 0) {
+          goto fail;
+        }
+
+        return 0;
+      }
+
+      chain = bufs->cur;
+      last = bufs->cur->buf.last;
+      seq = deflater->ctx.next_seq;
+      hd_table_bufsize = deflater->ctx.hd_table_bufsize;
+    }
+  }
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
   if (deflater->notify_table_size_change) {
     size_t min_hd_table_bufsize_max;
 
@@ -1464,6 +1659,15 @@ int nghttp2_hd_deflate_hd_bufs(nghttp2_hd_deflater *deflater,
 
   DEBUGF("deflatehd: all input name/value pairs were deflated\n");
 
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  /* Replaying a block which added entries to the dynamic table would
+     not add them again. */
+  if (chain && deflater->ctx.next_seq == seq &&
+      deflater->ctx.hd_table_bufsize == hd_table_bufsize) {
+    hd_deflate_cache_store(deflater, nv, nvlen, keylen, chain, last);
+  }
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
+
   return 0;
 fail:
   DEBUGF("deflatehd: error return %d\n", rv);
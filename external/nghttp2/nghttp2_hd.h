@@ -29,6 +29,7 @@
 #include <nghttp2_config.h>
 #endif /* HAVE_CONFIG_H */
 
+#include <tinyara/config.h>
 #include <nghttp2/nghttp2.h>
 
 #include "nghttp2_hd_huffman.h"
@@ -52,6 +53,18 @@
 /* Exported for unit test */
 #define NGHTTP2_STATIC_TABLE_LENGTH 61
 
+/* The number of encoded header blocks the deflater keeps for reuse.
+   0 disables the cache. */
+#ifdef CONFIG_NGHTTP2_HD_DEFLATE_CACHE_ENTRIES
+#define NGHTTP2_HD_DEFLATE_CACHE_ENTRIES CONFIG_NGHTTP2_HD_DEFLATE_CACHE_ENTRIES
+#else
+#define NGHTTP2_HD_DEFLATE_CACHE_ENTRIES 0
+#endif
+
+/* The maximum size of a cached header block plus the copy of the
+   header fields it was encoded from. */
+#define NGHTTP2_HD_DEFLATE_CACHE_MAX_SIZE 1024
+
 /* Generated by genlibtokenlookup.py */
 typedef enum {
   NGHTTP2_TOKEN__AUTHORITY = 0,
@@ -215,6 +228,25 @@ typedef struct {
   nghttp2_hd_entry *table[HD_MAP_SIZE];
 } nghttp2_hd_map;
 
+/* Header block which the deflater produced without changing the
+   dynamic table.  It is valid as long as the dynamic table is the
+   same, so the same header fields encode to the same bytes. */
+typedef struct {
+  /* The copy of the header fields, followed by the encoded header
+     block.  NULL if this entry is unused. */
+  uint8_t *data;
+  /* The length of the copy of the header fields */
+  size_t keylen;
+  /* The length of the encoded header block */
+  size_t blocklen;
+  /* The number of header fields */
+  size_t nvlen;
+  /* ctx.next_seq and ctx.hd_table_bufsize when the block was
+     encoded. */
+  uint32_t seq;
+  size_t hd_table_bufsize;
+} nghttp2_hd_deflate_cache_entry;
+
 struct nghttp2_hd_deflater {
   nghttp2_hd_context ctx;
   nghttp2_hd_map map;
@@ -225,6 +257,13 @@ struct nghttp2_hd_deflater {
   /* If nonzero, send header table size using encoding context update
      in the next deflate process */
   uint8_t notify_table_size_change;
+#if NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0
+  /* Recently encoded header blocks, for clients which send the same
+     request headers over and over (e.g., gRPC). */
+  nghttp2_hd_deflate_cache_entry cache[NGHTTP2_HD_DEFLATE_CACHE_ENTRIES];
+  /* The index of the entry replaced next if all entries are valid */
+  size_t cache_next;
+#endif /* NGHTTP2_HD_DEFLATE_CACHE_ENTRIES > 0 */
 };
 
 struct nghttp2_hd_inflater {
@@ -191,41 +191,96 @@ int nghttp2_hd_huff_encode(nghttp2_bufs *bufs, const uint8_t *src,
 }
 
 void nghttp2_hd_huff_decode_context_init(nghttp2_hd_huff_decode_context *ctx) {
-  ctx->state = 0;
-  ctx->accept = 1;
+  ctx->bits = 0;
+  ctx->nbits = 0;
+}
+
+/*
+ * Decodes the code longer than 8 bits at the top of the |*pnbits|
+ * bits in |bits|.  The code is at least |len| bits long.  The codes
+ * are canonical, so it is the first prefix which is less than the
+ * limit of its length.
+ *
+ * This function returns the decoded symbol and subtracts its length
+ * from |*pnbits|, or returns -1 if |bits| is too short to hold the
+ * code.
+ */
+static int huff_decode_long(uint64_t bits, size_t *pnbits, size_t len) {
+  uint32_t code;
+
+  for (; len <= *pnbits; ++len) {
+    code = (uint32_t)(bits >> (*pnbits - len)) & ((1u << len) - 1);
+    if (code < huff_decode_limit[len]) {
+      *pnbits -= len;
+      return huff_decode_sym[huff_decode_base[len] + (int32_t)code];
+    }
+  }
+
+  return -1;
 }
 
 ssize_t nghttp2_hd_huff_decode(nghttp2_hd_huff_decode_context *ctx,
                                nghttp2_buf *buf, const uint8_t *src,
                                size_t srclen, int final) {
-  size_t i;
+  const uint8_t *end = src + srclen;
+  const nghttp2_huff_decode *t;
+  uint64_t bits = ctx->bits;
+  size_t nbits = ctx->nbits;
+  size_t padlen;
+  int sym;
 
-  /* We use the decoding algorithm described in
-     http://graphics.ics.uci.edu/pub/Prefix.pdf */
-  for (i = 0; i < srclen; ++i) {
-    const nghttp2_huff_decode *t;
+  /* Every code of up to 8 bits, which covers nearly all characters
+     of header fields, is decoded with a single lookup of the next 8
+     bits.  Longer codes are resolved by huff_decode_long(). */
+  for (; src != end; ++src) {
+    bits = (bits << 8) | *src;
+    nbits += 8;
 
-    t = &huff_decode_table[ctx->state][src[i] >> 4];
-    if (t->flags & NGHTTP2_HUFF_FAIL) {
-      return NGHTTP2_ERR_HEADER_COMP;
-    }
-    if (t->flags & NGHTTP2_HUFF_SYM) {
-      *buf->last++ = t->sym;
+    while (nbits >= 8) {
+      t = &huff_decode_table[(bits >> (nbits - 8)) & 0xff];
+      if (t->nbits <= 8) {
+        *buf->last++ = t->sym;
+        nbits -= t->nbits;
+        continue;
+      }
+
+      sym = huff_decode_long(bits, &nbits, t->nbits);
+      if (sym == -1) {
+        break;
+      }
+      if (sym == 256) {
+        /* EOS must not appear in the encoded string */
+        return NGHTTP2_ERR_HEADER_COMP;
+      }
+      *buf->last++ = (uint8_t)sym;
     }
+  }
 
-    t = &huff_decode_table[t->state][src[i] & 0xf];
-    if (t->flags & NGHTTP2_HUFF_FAIL) {
+  if (final) {
+    /* Less than 8 bits are left, unless a long code is truncated.
+       They may still hold short codes, followed by the padding which
+       must be the most significant bits of EOS, that is all ones. */
+    if (nbits >= 8) {
       return NGHTTP2_ERR_HEADER_COMP;
     }
-    if (t->flags & NGHTTP2_HUFF_SYM) {
+    while (nbits) {
+      padlen = 8 - nbits;
+      t = &huff_decode_table[((bits << padlen) | ((1u << padlen) - 1)) &
+                             0xff];
+      if (t->nbits > nbits) {
+        break;
+      }
       *buf->last++ = t->sym;
+      nbits -= t->nbits;
     }
-
-    ctx->state = t->state;
-    ctx->accept = (t->flags & NGHTTP2_HUFF_ACCEPTED) != 0;
-  }
-  if (final && !ctx->accept) {
-    return NGHTTP2_ERR_HEADER_COMP;
+    if ((bits & ((1u << nbits) - 1)) != (1u << nbits) - 1) {
+      return NGHTTP2_ERR_HEADER_COMP;
+    }
+    nbits = 0;
   }
-  return (ssize_t)i;
+
+  ctx->bits = bits;
+  ctx->nbits = (uint8_t)nbits;
+
+  return (ssize_t)srclen;
 }
@@ -172,6 +172,11 @@ static void prv_deleteObservedList(lwm2m_context_t * contextP)
 
         lwm2m_free(targetP);
     }
+    contextP->observedDirtyList = NULL;
+    if (contextP->watcherHeap != NULL) lwm2m_free(contextP->watcherHeap);
+    contextP->watcherHeap = NULL;
+    contextP->watcherHeapCount = 0;
+    contextP->watcherHeapSize = 0;
 }
 #endif
 
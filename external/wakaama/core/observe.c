@@ -94,6 +94,222 @@ static void prv_unlinkObserved(lwm2m_context_t * contextP,
     }
 }
 
+static void prv_markDirty(lwm2m_context_t * contextP,
+                          lwm2m_observed_t * observedP)
+{
+    if (observedP->dirty == true) return;
+
+    observedP->dirty = true;
+    observedP->nextDirty = contextP->observedDirtyList;
+    contextP->observedDirtyList = observedP;
+}
+
+static void prv_unlinkDirty(lwm2m_context_t * contextP,
+                            lwm2m_observed_t * observedP)
+{
+    lwm2m_observed_t ** parentP;
+
+    if (observedP->dirty == false) return;
+
+    parentP = &contextP->observedDirtyList;
+    while (*parentP != NULL && *parentP != observedP)
+    {
+        parentP = &(*parentP)->nextDirty;
+    }
+    if (*parentP != NULL)
+    {
+        *parentP = observedP->nextDirty;
+    }
+    observedP->dirty = false;
+    observedP->nextDirty = NULL;
+}
+
+/*
+ * Watchers with a pmin or pmax deadline are kept in a binary min-heap ordered
+ * by nextTime, so that observe_step() only visits the ones that are due and
+ * can compute the exact time to the next one.
+ * heapIndex is 1-based: heap[heapIndex - 1] == watcherP, 0 means not scheduled.
+ */
+
+static void prv_heapSet(lwm2m_context_t * contextP,
+                        size_t index,
+                        lwm2m_watcher_t * watcherP)
+{
+    contextP->watcherHeap[index] = watcherP;
+    watcherP->heapIndex = index + 1;
+}
+
+static void prv_heapSiftUp(lwm2m_context_t * contextP,
+                           size_t index)
+{
+    lwm2m_watcher_t * watcherP = contextP->watcherHeap[index];
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (contextP->watcherHeap[parent]->nextTime <= watcherP->nextTime) break;
+        prv_heapSet(contextP, index, contextP->watcherHeap[parent]);
+        index = parent;
+    }
+    prv_heapSet(contextP, index, watcherP);
+}
+
+static void prv_heapSiftDown(lwm2m_context_t * contextP,
+                             size_t index)
+{
+    lwm2m_watcher_t * watcherP = contextP->watcherHeap[index];
+    size_t count = contextP->watcherHeapCount;
+
+    while (2 * index + 1 < count)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child + 1 < count
+         && contextP->watcherHeap[child + 1]->nextTime < contextP->watcherHeap[child]->nextTime)
+        {
+            child++;
+        }
+        if (watcherP->nextTime <= contextP->watcherHeap[child]->nextTime) break;
+        prv_heapSet(contextP, index, contextP->watcherHeap[child]);
+        index = child;
+    }
+    prv_heapSet(contextP, index, watcherP);
+}
+
+static void prv_unscheduleWatcher(lwm2m_context_t * contextP,
+                                  lwm2m_watcher_t * watcherP)
+{
+    size_t index;
+    lwm2m_watcher_t * lastP;
+
+    if (watcherP->heapIndex == 0) return;
+
+    index = watcherP->heapIndex - 1;
+    watcherP->heapIndex = 0;
+    contextP->watcherHeapCount--;
+    if (index == contextP->watcherHeapCount) return;
+
+    lastP = contextP->watcherHeap[contextP->watcherHeapCount];
+    prv_heapSet(contextP, index, lastP);
+    if (index > 0 && contextP->watcherHeap[(index - 1) / 2]->nextTime > lastP->nextTime)
+    {
+        prv_heapSiftUp(contextP, index);
+    }
+    else
+    {
+        prv_heapSiftDown(contextP, index);
+    }
+}
+
+// Returns false if the watcher has no deadline: it will only be evaluated on a value change.
+static bool prv_getDeadline(lwm2m_watcher_t * watcherP,
+                            time_t * deadlineP)
+{
+    bool found = false;
+
+    if (watcherP->active == false || watcherP->parameters == NULL) return false;
+
+    if (watcherP->update == true
+     && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MIN_PERIOD) != 0)
+    {
+        *deadlineP = watcherP->lastTime + watcherP->parameters->minPeriod;
+        found = true;
+    }
+    if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MAX_PERIOD) != 0)
+    {
+        time_t maxTime = watcherP->lastTime + watcherP->parameters->maxPeriod;
+
+        if (found == false || maxTime < *deadlineP) *deadlineP = maxTime;
+        found = true;
+    }
+
+    return found;
+}
+
+// Deadlines earlier than minTime are moved to minTime.
+static int prv_scheduleWatcher(lwm2m_context_t * contextP,
+                               lwm2m_watcher_t * watcherP,
+                               time_t minTime)
+{
+    time_t deadline;
+    time_t oldTime;
+
+    if (prv_getDeadline(watcherP, &deadline) == false)
+    {
+        prv_unscheduleWatcher(contextP, watcherP);
+        return 0;
+    }
+    if (deadline < minTime) deadline = minTime;
+
+    if (watcherP->heapIndex != 0)
+    {
+        oldTime = watcherP->nextTime;
+        watcherP->nextTime = deadline;
+        if (deadline < oldTime)
+        {
+            prv_heapSiftUp(contextP, watcherP->heapIndex - 1);
+        }
+        else if (deadline > oldTime)
+        {
+            prv_heapSiftDown(contextP, watcherP->heapIndex - 1);
+        }
+        return 0;
+    }
+
+    if (contextP->watcherHeapCount == contextP->watcherHeapSize)
+    {
+        lwm2m_watcher_t ** heapP;
+        size_t size;
+
+        size = contextP->watcherHeapSize ? 2 * contextP->watcherHeapSize : 8;
+        heapP = (lwm2m_watcher_t **)lwm2m_malloc(size * sizeof(lwm2m_watcher_t *));
+        if (heapP == NULL)
+        {
+            LOG("Memory allocation failed");
+            return -1;
+        }
+        if (contextP->watcherHeap != NULL)
+        {
+            memcpy(heapP, contextP->watcherHeap, contextP->watcherHeapCount * sizeof(lwm2m_watcher_t *));
+            lwm2m_free(contextP->watcherHeap);
+        }
+        contextP->watcherHeap = heapP;
+        contextP->watcherHeapSize = size;
+    }
+
+    watcherP->nextTime = deadline;
+    contextP->watcherHeap[contextP->watcherHeapCount] = watcherP;
+    contextP->watcherHeapCount++;
+    prv_heapSiftUp(contextP, contextP->watcherHeapCount - 1);
+
+    return 0;
+}
+
+static void prv_freeWatcher(lwm2m_context_t * contextP,
+                            lwm2m_watcher_t * watcherP)
+{
+    prv_unscheduleWatcher(contextP, watcherP);
+    if (watcherP->parameters != NULL) lwm2m_free(watcherP->parameters);
+    lwm2m_free(watcherP);
+}
+
+static void prv_freeObserved(lwm2m_context_t * contextP,
+                             lwm2m_observed_t * observedP)
+{
+    while (observedP->watcherList != NULL)
+    {
+        lwm2m_watcher_t * watcherP;
+
+        watcherP = observedP->watcherList;
+        observedP->watcherList = watcherP->next;
+        prv_freeWatcher(contextP, watcherP);
+    }
+    prv_unlinkDirty(contextP, observedP);
+    prv_unlinkObserved(contextP, observedP);
+    lwm2m_free(observedP);
+}
+
 static lwm2m_watcher_t * prv_findWatcher(lwm2m_observed_t * observedP,
                                          lwm2m_server_t * serverP)
 {
@@ -146,6 +362,7 @@ static lwm2m_watcher_t * prv_getWatcher(lwm2m_context_t * contextP,
         memset(watcherP, 0, sizeof(lwm2m_watcher_t));
         watcherP->active = false;
         watcherP->server = serverP;
+        watcherP->observed = observedP;
         watcherP->next = observedP->watcherList;
         observedP->watcherList = watcherP;
     }
@@ -198,6 +415,8 @@ coap_status_t observe_handleRequest(lwm2m_context_t * contextP,
             }
         }
 
+        if (prv_scheduleWatcher(contextP, watcherP, 0) != 0) return COAP_500_INTERNAL_SERVER_ERROR;
+
         coap_set_header_observe(response, watcherP->counter++);
 
         return COAP_205_CONTENT;
@@ -251,11 +470,10 @@ void observe_cancel(lwm2m_context_t * contextP,
         }
         if (targetP != NULL)
         {
-            lwm2m_free(targetP);
+            prv_freeWatcher(contextP, targetP);
             if (observedP->watcherList == NULL)
             {
-                prv_unlinkObserved(contextP, observedP);
-                lwm2m_free(observedP);
+                prv_freeObserved(contextP, observedP);
             }
             return;
         }
@@ -276,18 +494,10 @@ void observe_clear(lwm2m_context_t *contextP,
 				|| observedP->uri.instanceId == uriP->instanceId))
 		{
 			lwm2m_observed_t * nextP;
-			 lwm2m_watcher_t * watcherP;
 
 			 nextP = observedP->next;
 
-			 for (watcherP = observedP->watcherList; watcherP != NULL; watcherP = watcherP->next)
-			 {
-				 if (watcherP->parameters != NULL) lwm2m_free(watcherP->parameters);
-			 }
-			 LWM2M_LIST_FREE(observedP->watcherList);
-
-			 prv_unlinkObserved(contextP, observedP);
-			 lwm2m_free(observedP);
+			 prv_freeObserved(contextP, observedP);
 
 			 observedP = nextP;
 		 }
@@ -396,6 +606,10 @@ coap_status_t observe_setParameters(lwm2m_context_t * contextP,
     LOG_ARG("Final toSet: %08X, minPeriod: %d, maxPeriod: %d, greaterThan: %f, lessThan: %f, step: %f",
             watcherP->parameters->toSet, watcherP->parameters->minPeriod, watcherP->parameters->maxPeriod, watcherP->parameters->greaterThan, watcherP->parameters->lessThan, watcherP->parameters->step);
 
+    // new periods move the deadlines, new conditions may allow a pending update to be sent
+    if (prv_scheduleWatcher(contextP, watcherP, 0) != 0) return COAP_500_INTERNAL_SERVER_ERROR;
+    if (watcherP->update == true) prv_markDirty(contextP, watcherP->observed);
+
     return COAP_204_CHANGED;
 }
 
@@ -459,6 +673,7 @@ void lwm2m_resource_value_changed(lwm2m_context_t * contextP,
                         {
                             LOG("Tagging a watcher");
                             watcherP->update = true;
+                            prv_markDirty(contextP, targetP);
                         }
                     }
                 }
@@ -468,266 +683,295 @@ void lwm2m_resource_value_changed(lwm2m_context_t * contextP,
     }
 }
 
-void observe_step(lwm2m_context_t * contextP,
-                  time_t currentTime,
-                  time_t * timeoutP)
+static void prv_stepObserved(lwm2m_context_t * contextP,
+                             lwm2m_observed_t * targetP,
+                             time_t currentTime)
 {
-    lwm2m_observed_t * targetP;
     coap_protocol_t proto = contextP->protocol;
-
-    LOG("Entering");
-    for (targetP = contextP->observedList ; targetP != NULL ; targetP = targetP->next)
+    lwm2m_watcher_t * watcherP;
+    uint8_t * buffer = NULL;
+    size_t length = 0;
+    lwm2m_data_t * dataP = NULL;
+    int size = 0;
+    double floatValue = 0;
+    int64_t integerValue = 0;
+    bool storeValue = false;
+    lwm2m_media_type_t format = LWM2M_CONTENT_TEXT;
+    coap_packet_t message[1];
+
+    LOG_URI(&(targetP->uri));
+    if (LWM2M_URI_IS_SET_RESOURCE(&targetP->uri))
     {
-        lwm2m_watcher_t * watcherP;
-        uint8_t * buffer = NULL;
-        size_t length = 0;
-        lwm2m_data_t * dataP = NULL;
-        int size = 0;
-        double floatValue = 0;
-        int64_t integerValue = 0;
-        bool storeValue = false;
-        lwm2m_media_type_t format = LWM2M_CONTENT_TEXT;
-        coap_packet_t message[1];
-        time_t interval;
-
-        LOG_URI(&(targetP->uri));
-        if (LWM2M_URI_IS_SET_RESOURCE(&targetP->uri))
+        if (COAP_205_CONTENT != object_readData(contextP, &targetP->uri, &size, &dataP)) goto reschedule;
+        switch (dataP->type)
         {
-            if (COAP_205_CONTENT != object_readData(contextP, &targetP->uri, &size, &dataP)) continue;
-            switch (dataP->type)
-            {
-            case LWM2M_TYPE_INTEGER:
-                if (1 != lwm2m_data_decode_int(dataP, &integerValue)) continue;
-                storeValue = true;
-                break;
-            case LWM2M_TYPE_FLOAT:
-                if (1 != lwm2m_data_decode_float(dataP, &floatValue)) continue;
-                storeValue = true;
-                break;
-            default:
-                break;
-            }
+        case LWM2M_TYPE_INTEGER:
+            if (1 != lwm2m_data_decode_int(dataP, &integerValue)) goto reschedule;
+            storeValue = true;
+            break;
+        case LWM2M_TYPE_FLOAT:
+            if (1 != lwm2m_data_decode_float(dataP, &floatValue)) goto reschedule;
+            storeValue = true;
+            break;
+        default:
+            break;
         }
-        for (watcherP = targetP->watcherList ; watcherP != NULL ; watcherP = watcherP->next)
+    }
+    for (watcherP = targetP->watcherList ; watcherP != NULL ; watcherP = watcherP->next)
+    {
+        if (watcherP->active == true)
         {
-            if (watcherP->active == true)
+            bool notify = false;
+
+            if (watcherP->update == true)
             {
-                bool notify = false;
+                // value changed, should we notify the server ?
 
-                if (watcherP->update == true)
+                if (watcherP->parameters == NULL || watcherP->parameters->toSet == 0)
                 {
-                    // value changed, should we notify the server ?
-
-                    if (watcherP->parameters == NULL || watcherP->parameters->toSet == 0)
-                    {
-                        // no conditions
-                        notify = true;
-                        LOG("Notify with no conditions");
-                        LOG_URI(&(targetP->uri));
-                    }
+                    // no conditions
+                    notify = true;
+                    LOG("Notify with no conditions");
+                    LOG_URI(&(targetP->uri));
+                }
 
-                    if (notify == false
-                     && watcherP->parameters != NULL
-                     && (watcherP->parameters->toSet & ATTR_FLAG_NUMERIC) != 0)
+                if (notify == false
+                 && watcherP->parameters != NULL
+                 && (watcherP->parameters->toSet & ATTR_FLAG_NUMERIC) != 0)
+                {
+                    if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_LESS_THAN) != 0)
                     {
-                        if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_LESS_THAN) != 0)
+                        LOG("Checking lower treshold");
+                        // Did we cross the lower treshold ?
+                        switch (dataP->type)
                         {
-                            LOG("Checking lower treshold");
-                            // Did we cross the lower treshold ?
-                            switch (dataP->type)
+                        case LWM2M_TYPE_INTEGER:
+                            if ((integerValue <= watcherP->parameters->lessThan
+                              && watcherP->lastValue.asInteger > watcherP->parameters->lessThan)
+                             || (integerValue >= watcherP->parameters->lessThan
+                              && watcherP->lastValue.asInteger < watcherP->parameters->lessThan))
                             {
-                            case LWM2M_TYPE_INTEGER:
-                                if ((integerValue <= watcherP->parameters->lessThan
-                                  && watcherP->lastValue.asInteger > watcherP->parameters->lessThan)
-                                 || (integerValue >= watcherP->parameters->lessThan
-                                  && watcherP->lastValue.asInteger < watcherP->parameters->lessThan))
-                                {
-                                    LOG("Notify on lower treshold crossing");
-                                    notify = true;
-                                }
-                                break;
-                            case LWM2M_TYPE_FLOAT:
-                                if ((floatValue <= watcherP->parameters->lessThan
-                                  && watcherP->lastValue.asFloat > watcherP->parameters->lessThan)
-                                 || (floatValue >= watcherP->parameters->lessThan
-                                  && watcherP->lastValue.asFloat < watcherP->parameters->lessThan))
-                                {
-                                    LOG("Notify on lower treshold crossing");
-                                    notify = true;
-                                }
-                                break;
-                            default:
-                                break;
+                                LOG("Notify on lower treshold crossing");
+                                notify = true;
                             }
-                        }
-                        if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_GREATER_THAN) != 0)
-                        {
-                            LOG("Checking upper treshold");
-                            // Did we cross the upper treshold ?
-                            switch (dataP->type)
+                            break;
+                        case LWM2M_TYPE_FLOAT:
+                            if ((floatValue <= watcherP->parameters->lessThan
+                              && watcherP->lastValue.asFloat > watcherP->parameters->lessThan)
+                             || (floatValue >= watcherP->parameters->lessThan
+                              && watcherP->lastValue.asFloat < watcherP->parameters->lessThan))
                             {
-                            case LWM2M_TYPE_INTEGER:
-                                if ((integerValue <= watcherP->parameters->greaterThan
-                                  && watcherP->lastValue.asInteger > watcherP->parameters->greaterThan)
-                                 || (integerValue >= watcherP->parameters->greaterThan
-                                  && watcherP->lastValue.asInteger < watcherP->parameters->greaterThan))
-                                {
-                                    LOG("Notify on lower upper crossing");
-                                    notify = true;
-                                }
-                                break;
-                            case LWM2M_TYPE_FLOAT:
-                                if ((floatValue <= watcherP->parameters->greaterThan
-                                  && watcherP->lastValue.asFloat > watcherP->parameters->greaterThan)
-                                 || (floatValue >= watcherP->parameters->greaterThan
-                                  && watcherP->lastValue.asFloat < watcherP->parameters->greaterThan))
-                                {
-                                    LOG("Notify on lower upper crossing");
-                                    notify = true;
-                                }
-                                break;
-                            default:
-                                break;
+                                LOG("Notify on lower treshold crossing");
+                                notify = true;
                             }
+                            break;
+                        default:
+                            break;
                         }
-                        if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_STEP) != 0)
+                    }
+                    if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_GREATER_THAN) != 0)
+                    {
+                        LOG("Checking upper treshold");
+                        // Did we cross the upper treshold ?
+                        switch (dataP->type)
                         {
-                            LOG("Checking step");
-
-                            switch (dataP->type)
+                        case LWM2M_TYPE_INTEGER:
+                            if ((integerValue <= watcherP->parameters->greaterThan
+                              && watcherP->lastValue.asInteger > watcherP->parameters->greaterThan)
+                             || (integerValue >= watcherP->parameters->greaterThan
+                              && watcherP->lastValue.asInteger < watcherP->parameters->greaterThan))
                             {
-                            case LWM2M_TYPE_INTEGER:
-                            {
-                                int64_t diff;
-
-                                diff = integerValue - watcherP->lastValue.asInteger;
-                                if ((diff < 0 && (0 - diff) >= watcherP->parameters->step)
-                                 || (diff >= 0 && diff >= watcherP->parameters->step))
-                                {
-                                    LOG("Notify on step condition");
-                                    notify = true;
-                                }
+                                LOG("Notify on lower upper crossing");
+                                notify = true;
                             }
-                                break;
-                            case LWM2M_TYPE_FLOAT:
+                            break;
+                        case LWM2M_TYPE_FLOAT:
+                            if ((floatValue <= watcherP->parameters->greaterThan
+                              && watcherP->lastValue.asFloat > watcherP->parameters->greaterThan)
+                             || (floatValue >= watcherP->parameters->greaterThan
+                              && watcherP->lastValue.asFloat < watcherP->parameters->greaterThan))
                             {
-                                double diff;
-
-                                diff = floatValue - watcherP->lastValue.asFloat;
-                                if ((diff < 0 && (0 - diff) >= watcherP->parameters->step)
-                                 || (diff >= 0 && diff >= watcherP->parameters->step))
-                                {
-                                    LOG("Notify on step condition");
-                                    notify = true;
-                                }
-                            }
-                                break;
-                            default:
-                                break;
+                                LOG("Notify on lower upper crossing");
+                                notify = true;
                             }
+                            break;
+                        default:
+                            break;
                         }
                     }
-
-                    if (watcherP->parameters != NULL
-                     && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MIN_PERIOD) != 0)
+                    if ((watcherP->parameters->toSet & LWM2M_ATTR_FLAG_STEP) != 0)
                     {
-                        LOG_ARG("Checking minimal period (%d s)", watcherP->parameters->minPeriod);
+                        LOG("Checking step");
 
-                        if (watcherP->lastTime + watcherP->parameters->minPeriod > currentTime)
+                        switch (dataP->type)
                         {
-                            // Minimum Period did not elapse yet
-                            interval = watcherP->lastTime + watcherP->parameters->minPeriod - currentTime;
-                            if (*timeoutP > interval) *timeoutP = interval;
-                            notify = false;
+                        case LWM2M_TYPE_INTEGER:
+                        {
+                            int64_t diff;
+
+                            diff = integerValue - watcherP->lastValue.asInteger;
+                            if ((diff < 0 && (0 - diff) >= watcherP->parameters->step)
+                             || (diff >= 0 && diff >= watcherP->parameters->step))
+                            {
+                                LOG("Notify on step condition");
+                                notify = true;
+                            }
                         }
-                        else
+                            break;
+                        case LWM2M_TYPE_FLOAT:
                         {
-                            LOG("Notify on minimal period");
-                            notify = true;
+                            double diff;
+
+                            diff = floatValue - watcherP->lastValue.asFloat;
+                            if ((diff < 0 && (0 - diff) >= watcherP->parameters->step)
+                             || (diff >= 0 && diff >= watcherP->parameters->step))
+                            {
+                                LOG("Notify on step condition");
+                                notify = true;
+                            }
+                        }
+                            break;
+                        default:
+                            break;
                         }
                     }
                 }
 
-                // Is the Maximum Period reached ?
-                if (notify == false
-                 && watcherP->parameters != NULL
-                 && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MAX_PERIOD) != 0)
+                if (watcherP->parameters != NULL
+                 && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MIN_PERIOD) != 0)
                 {
-                    LOG_ARG("Checking maximal period (%d s)", watcherP->parameters->minPeriod);
+                    LOG_ARG("Checking minimal period (%d s)", watcherP->parameters->minPeriod);
 
-                    if (watcherP->lastTime + watcherP->parameters->maxPeriod <= currentTime)
+                    if (watcherP->lastTime + watcherP->parameters->minPeriod > currentTime)
+                    {
+                        // Minimum Period did not elapse yet
+                        notify = false;
+                    }
+                    else
                     {
-                        LOG("Notify on maximal period");
+                        LOG("Notify on minimal period");
                         notify = true;
                     }
                 }
+            }
 
-                if (notify == true)
+            // Is the Maximum Period reached ?
+            if (notify == false
+             && watcherP->parameters != NULL
+             && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MAX_PERIOD) != 0)
+            {
+                LOG_ARG("Checking maximal period (%d s)", watcherP->parameters->minPeriod);
+
+                if (watcherP->lastTime + watcherP->parameters->maxPeriod <= currentTime)
                 {
-                    if (buffer == NULL)
-                    {
-                        if (dataP != NULL)
-                        {
-                            int res;
+                    LOG("Notify on maximal period");
+                    notify = true;
+                }
+            }
 
-                            res = lwm2m_data_serialize(&targetP->uri, size, dataP, &format, &buffer);
-                            if (res < 0)
-                            {
-                                break;
-                            }
-                            else
-                            {
-                                length = (size_t)res;
-                            }
+            if (notify == true)
+            {
+                if (buffer == NULL)
+                {
+                    if (dataP != NULL)
+                    {
+                        int res;
 
+                        res = lwm2m_data_serialize(&targetP->uri, size, dataP, &format, &buffer);
+                        if (res < 0)
+                        {
+                            break;
                         }
                         else
                         {
-                            if (COAP_205_CONTENT != object_read(contextP, &targetP->uri, &format, &buffer, &length))
-                            {
-                                buffer = NULL;
-                                break;
-                            }
+                            length = (size_t)res;
                         }
-                        coap_init_message(message, proto, COAP_TYPE_NON, COAP_205_CONTENT, 0);
-                        coap_set_header_content_type(message, format);
-                        coap_set_payload(message, buffer, length);
-                    }
-                    watcherP->lastTime = currentTime;
-                    watcherP->lastMid = contextP->nextMID++;
-                    message->mid = watcherP->lastMid;
-                    coap_set_header_token(message, watcherP->token, watcherP->tokenLen);
-                    coap_set_header_observe(message, watcherP->counter++);
-                    (void)message_send(contextP, message, watcherP->server->sessionH);
-                    watcherP->update = false;
-                }
 
-                // Store this value
-                if (notify == true && storeValue == true)
-                {
-                    switch (dataP->type)
+                    }
+                    else
                     {
-                    case LWM2M_TYPE_INTEGER:
-                        watcherP->lastValue.asInteger = integerValue;
-                        break;
-                    case LWM2M_TYPE_FLOAT:
-                        watcherP->lastValue.asFloat = floatValue;
-                        break;
-                    default:
-                        break;
+                        if (COAP_205_CONTENT != object_read(contextP, &targetP->uri, &format, &buffer, &length))
+                        {
+                            buffer = NULL;
+                            break;
+                        }
                     }
+                    coap_init_message(message, proto, COAP_TYPE_NON, COAP_205_CONTENT, 0);
+                    coap_set_header_content_type(message, format);
+                    coap_set_payload(message, buffer, length);
                 }
+                watcherP->lastTime = currentTime;
+                watcherP->lastMid = contextP->nextMID++;
+                message->mid = watcherP->lastMid;
+                coap_set_header_token(message, watcherP->token, watcherP->tokenLen);
+                coap_set_header_observe(message, watcherP->counter++);
+                (void)message_send(contextP, message, watcherP->server->sessionH);
+                watcherP->update = false;
+            }
 
-                if (watcherP->parameters != NULL && (watcherP->parameters->toSet & LWM2M_ATTR_FLAG_MAX_PERIOD) != 0)
+            // Store this value
+            if (notify == true && storeValue == true)
+            {
+                switch (dataP->type)
                 {
-                    // update timers
-                    interval = watcherP->lastTime + watcherP->parameters->maxPeriod - currentTime;
-                    if (*timeoutP > interval) *timeoutP = interval;
+                case LWM2M_TYPE_INTEGER:
+                    watcherP->lastValue.asInteger = integerValue;
+                    break;
+                case LWM2M_TYPE_FLOAT:
+                    watcherP->lastValue.asFloat = floatValue;
+                    break;
+                default:
+                    break;
                 }
             }
         }
-        if (dataP != NULL) lwm2m_data_free(size, dataP);
-        if (buffer != NULL) lwm2m_free(buffer);
+    }
+
+reschedule:
+    // A deadline still in the past means the notification could not be sent: retry in a second.
+    for (watcherP = targetP->watcherList ; watcherP != NULL ; watcherP = watcherP->next)
+    {
+        (void)prv_scheduleWatcher(contextP, watcherP, currentTime + 1);
+    }
+    if (dataP != NULL) lwm2m_data_free(size, dataP);
+    if (buffer != NULL) lwm2m_free(buffer);
+}
+
+void observe_step(lwm2m_context_t * contextP,
+                  time_t currentTime,
+                  time_t * timeoutP)
+{
+    lwm2m_observed_t * targetP;
+
+    LOG("Entering");
+
+    // Watchers whose pmin or pmax deadline is reached
+    while (contextP->watcherHeapCount > 0
+        && contextP->watcherHeap[0]->nextTime <= currentTime)
+    {
+        lwm2m_watcher_t * watcherP = contextP->watcherHeap[0];
+
+        prv_unscheduleWatcher(contextP, watcherP);
+        prv_markDirty(contextP, watcherP->observed);
+    }
+
+    // Observed URIs with a value change or a due watcher
+    while (contextP->observedDirtyList != NULL)
+    {
+        targetP = contextP->observedDirtyList;
+        contextP->observedDirtyList = targetP->nextDirty;
+        targetP->nextDirty = NULL;
+        targetP->dirty = false;
+
+        prv_stepObserved(contextP, targetP, currentTime);
+    }
+
+    if (contextP->watcherHeapCount > 0)
+    {
+        time_t interval;
+
+        interval = contextP->watcherHeap[0]->nextTime - currentTime;
+        if (*timeoutP > interval) *timeoutP = interval;
     }
 }
 
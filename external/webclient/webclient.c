@@ -601,7 +601,7 @@ void wget_tls_ssl_release(struct http_client_tls_t *client)
 	mbedtls_ssl_free(&(client->tls_ssl));
 }
 
-int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname)
+int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname, int port)
 {
 	int result = 0;
 
@@ -640,15 +640,27 @@ int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname)
 	mbedtls_ssl_set_bio(&(client->tls_ssl), &(client->tls_client_fd),
 						mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+	/* Resume the last session with this server, if any */
+	mbedtls_ssl_session_store_load(&(client->tls_ssl), hostname, port);
+#endif
+
 	/* Handshake */
 	while ((result = mbedtls_ssl_handshake(&(client->tls_ssl))) != 0) {
 		if (result != MBEDTLS_ERR_SSL_WANT_READ &&
 			result != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			ndbg("Error: TLS Handshake fail returned -%4x\n", -result);
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+			mbedtls_ssl_session_store_remove(&(client->tls_ssl), hostname, port);
+#endif
 			goto HANDSHAKE_FAIL;
 		}
 	}
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+	mbedtls_ssl_session_store_save(&(client->tls_ssl), hostname, port);
+#endif
+
 	ndbg("TLS Handshake Success\n");
 
 	return 0;
@@ -991,7 +1003,7 @@ retry:
 	}
 
 	client_tls->client_fd = sockfd;
-	if (param->tls && (ret = wget_tls_handshake(client_tls, ws.hostname))) {
+	if (param->tls && (ret = wget_tls_handshake(client_tls, ws.hostname, ws.port))) {
 		if (handshake_retry-- > 0) {
 			if (ret == MBEDTLS_ERR_NET_SEND_FAILED ||
 				ret == MBEDTLS_ERR_NET_RECV_FAILED ||
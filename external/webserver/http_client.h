@@ -34,6 +34,7 @@
 #include "mbedtls/error.h"
 #include "mbedtls/debug.h"
 #include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_session_store.h"
 #endif
 
 enum {
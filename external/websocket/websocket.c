@@ -40,6 +40,7 @@
 #include <sys/time.h>
 #include "mbedtls/sha1.h"
 #include "mbedtls/base64.h"
+#include "mbedtls/ssl_session_store.h"
 #include <netutils/netlib.h>
 #include <protocols/websocket.h>
 #include <protocols/wslay/wslay.h>
@@ -67,7 +68,7 @@ websocket_t ws_srv_table[WEBSOCKET_MAX_CLIENT];
 
 /****** websocket common functions *****/
 
-int websocket_tls_handshake(websocket_t *data, char *hostname, int auth_mode)
+int websocket_tls_handshake(websocket_t *data, char *hostname, const char *port, int auth_mode)
 {
 	int r;
 
@@ -98,16 +99,34 @@ int websocket_tls_handshake(websocket_t *data, char *hostname, int auth_mode)
 
 	mbedtls_ssl_set_bio(data->tls_ssl, &(data->tls_net), mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+	/* Client side: resume the last session with this server, if any */
+	if (hostname != NULL && port != NULL) {
+		mbedtls_ssl_session_store_load(data->tls_ssl, hostname, atoi(port));
+	}
+#endif
+
 	/* Handshake */
 	WEBSOCKET_DEBUG("  . Performing the SSL/TLS handshake...");
 
 	while ((r = mbedtls_ssl_handshake(data->tls_ssl)) != 0) {
 		if (r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			WEBSOCKET_DEBUG("Error: mbedtls_ssl_handshake returned -%4x\n", -r);
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+			if (hostname != NULL && port != NULL) {
+				mbedtls_ssl_session_store_remove(data->tls_ssl, hostname, atoi(port));
+			}
+#endif
 			return r;
 		}
 	}
 
+#if defined(MBEDTLS_SSL_SESSION_STORE_C)
+	if (hostname != NULL && port != NULL) {
+		mbedtls_ssl_session_store_save(data->tls_ssl, hostname, atoi(port));
+	}
+#endif
+
 	WEBSOCKET_DEBUG("OK\n");
 	return WEBSOCKET_SUCCESS;
 }
@@ -210,6 +229,12 @@ int websocket_handler(websocket_t *websocket)
 			WEBSOCKET_DEBUG("select function returned errno == %d\n", errno);
 			return WEBSOCKET_SOCKET_ERROR;
 		} else if (r == 0) {
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+			/* The connection is idle, give its TLS record buffers back */
+			if (websocket->tls_enabled) {
+				mbedtls_ssl_release_buffers(websocket->tls_ssl);
+			}
+#endif
 			if (WEBSOCKET_HANDLER_TIMEOUT != 0) {
 				timeout++;
 				if ((WEBSOCKET_HANDLER_TIMEOUT * timeout) >= (WEBSOCKET_PING_INTERVAL * 10)) {
@@ -413,7 +438,7 @@ TLS_HS_RETRY:
 	}
 
 	if (client->tls_enabled) {
-		if ((r = websocket_tls_handshake(client, host, client->auth_mode)) != WEBSOCKET_SUCCESS) {
+		if ((r = websocket_tls_handshake(client, host, port, client->auth_mode)) != WEBSOCKET_SUCCESS) {
 			if (r == MBEDTLS_ERR_NET_SEND_FAILED || r == MBEDTLS_ERR_NET_RECV_FAILED || r == MBEDTLS_ERR_SSL_CONN_EOF) {
 				if (tls_hs_retry-- > 0) {
 					WEBSOCKET_DEBUG("Handshake again.... \n");
@@ -536,7 +561,7 @@ int websocket_server_authenticate(websocket_t *server)
 		mbedtls_ssl_init(server->tls_ssl);
 		mbedtls_net_init(&(server->tls_net));
 
-		if ((r = websocket_tls_handshake(server, NULL, server->auth_mode)) != WEBSOCKET_SUCCESS) {
+		if ((r = websocket_tls_handshake(server, NULL, NULL, server->auth_mode)) != WEBSOCKET_SUCCESS) {
 			WEBSOCKET_DEBUG("fail to tls handshake\n");
 			r = WEBSOCKET_TLS_HANDSHAKE_ERROR;
 			goto EXIT_SERVER_START;
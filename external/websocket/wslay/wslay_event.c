@@ -804,7 +804,16 @@ int wslay_event_send(wslay_event_context_ptr ctx)
 			iocb.data = ctx->omsg->data + ctx->opayloadoff;
 			iocb.data_length = ctx->opayloadlen - ctx->opayloadoff;
 			iocb.payload_length = ctx->opayloadlen;
-			r = wslay_frame_send(ctx->frame_ctx, &iocb);
+			/*
+			 * The message is our own copy: mask it in place. Control
+			 * frames are small and the close status is read back from
+			 * the data once sent, so they keep the copying path.
+			 */
+			if (wslay_is_ctrl_frame(iocb.opcode)) {
+				r = wslay_frame_send(ctx->frame_ctx, &iocb);
+			} else {
+				r = wslay_frame_send_inplace(ctx->frame_ctx, &iocb);
+			}
 			if (r >= 0) {
 				ctx->opayloadoff += r;
 				if (ctx->opayloadoff == ctx->opayloadlen) {
@@ -857,7 +866,7 @@ int wslay_event_send(wslay_event_context_ptr ctx)
 			iocb.data = ctx->obufmark;
 			iocb.data_length = ctx->obuflimit - ctx->obufmark;
 			iocb.payload_length = ctx->opayloadlen;
-			r = wslay_frame_send(ctx->frame_ctx, &iocb);
+			r = wslay_frame_send_inplace(ctx->frame_ctx, &iocb);
 			if (r >= 0) {
 				ctx->obufmark += r;
 				if (ctx->obufmark == ctx->obuflimit) {
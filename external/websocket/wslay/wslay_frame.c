@@ -42,6 +42,7 @@
 #include "wslay_frame.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 
@@ -70,8 +71,52 @@ void wslay_frame_context_free(wslay_frame_context_ptr ctx)
 	free(ctx);
 }
 
-ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb)
+/*
+ * Apply the masking key to len bytes of src, storing the result in dst
+ * (which may be src). off is the payload offset of src[0]. Once dst is
+ * aligned, the key is applied a machine word at a time.
+ */
+static void wslay_mask(uint8_t *dst, const uint8_t *src, size_t len, const uint8_t *maskkey, uint64_t off)
+{
+	uint8_t key[sizeof(size_t)];
+	size_t word;
+	size_t v;
+	size_t i;
+
+	while (len > 0 && ((uintptr_t)dst & (sizeof(size_t) - 1)) != 0) {
+		*dst++ = *src++ ^ maskkey[off++ & 3];
+		--len;
+	}
+	if (len >= sizeof(size_t)) {
+		/* The word size is a multiple of 4: the key phase does not change */
+		for (i = 0; i < sizeof(size_t); ++i) {
+			key[i] = maskkey[(off + i) & 3];
+		}
+		memcpy(&word, key, sizeof(word));
+		for (; len >= sizeof(size_t); len -= sizeof(size_t)) {
+			memcpy(&v, src, sizeof(v));
+			v ^= word;
+			memcpy(dst, &v, sizeof(v));
+			src += sizeof(size_t);
+			dst += sizeof(size_t);
+		}
+	}
+	while (len > 0) {
+		*dst++ = *src++ ^ maskkey[off++ & 3];
+		--len;
+	}
+}
+
+/*
+ * inplace is iocb->data when the caller allows the payload to be masked
+ * in its own buffer, NULL otherwise.
+ */
+static ssize_t wslay_frame_send_common(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb, uint8_t *inplace)
 {
+	uint8_t temp[4096];
+	size_t totallen = 0;
+	ssize_t r;
+
 	if (iocb->data_length > iocb->payload_length) {
 		return WSLAY_ERR_INVALID_ARGUMENT;
 	}
@@ -105,6 +150,7 @@ ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *i
 			/* Too large payload length */
 			return WSLAY_ERR_INVALID_ARGUMENT;
 		}
+		ctx->omask = 0;
 		if (iocb->mask) {
 			if (ctx->callbacks.genmask_callback(ctx->omaskkey, 4, ctx->user_data) != 0) {
 				return WSLAY_ERR_INVALID_CALLBACK;
@@ -119,72 +165,82 @@ ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *i
 		ctx->oheaderlimit = hdptr;
 		ctx->opayloadlen = iocb->payload_length;
 		ctx->opayloadoff = 0;
+		ctx->omaskoff = 0;
 	}
 	if (ctx->ostate == SEND_HEADER) {
-		ptrdiff_t len = ctx->oheaderlimit - ctx->oheadermark;
-		ssize_t r;
+		size_t len = ctx->oheaderlimit - ctx->oheadermark;
+		size_t datalen = 0;
 		int flags = 0;
-		if (iocb->data_length > 0) {
-			flags |= WSLAY_MSG_MORE;
-		};
-		r = ctx->callbacks.send_callback(ctx->oheadermark, len, flags, ctx->user_data);
-		if (r > 0) {
-			if (r > len) {
-				return WSLAY_ERR_INVALID_CALLBACK;
+
+		/*
+		 * Send the header and the start of the payload in one call. The
+		 * payload goes through temp anyway when it has to be masked;
+		 * otherwise it is only worth copying if the whole frame fits.
+		 */
+		if ((ctx->omask && inplace == NULL) || iocb->data_length <= sizeof(temp) - len) {
+			datalen = wslay_min(iocb->data_length, sizeof(temp) - len);
+		}
+		memcpy(temp, ctx->oheadermark, len);
+		if (datalen > 0) {
+			if (ctx->omask) {
+				wslay_mask(temp + len, iocb->data, datalen, ctx->omaskkey, ctx->opayloadoff);
 			} else {
-				ctx->oheadermark += r;
-				if (ctx->oheadermark == ctx->oheaderlimit) {
-					ctx->ostate = SEND_PAYLOAD;
-				} else {
-					return WSLAY_ERR_WANT_WRITE;
-				}
+				memcpy(temp + len, iocb->data, datalen);
 			}
-		} else {
+		}
+		if (iocb->data_length > datalen) {
+			flags |= WSLAY_MSG_MORE;
+		}
+		r = ctx->callbacks.send_callback(temp, len + datalen, flags, ctx->user_data);
+		if (r <= 0) {
 			return WSLAY_ERR_WANT_WRITE;
+		} else if ((size_t)r > len + datalen) {
+			return WSLAY_ERR_INVALID_CALLBACK;
+		} else if ((size_t)r < len) {
+			ctx->oheadermark += r;
+			return WSLAY_ERR_WANT_WRITE;
+		}
+		ctx->oheadermark = ctx->oheaderlimit;
+		ctx->ostate = SEND_PAYLOAD;
+		totallen = r - len;
+		ctx->opayloadoff += totallen;
+		if (totallen < datalen) {
+			return totallen;
 		}
 	}
 	if (ctx->ostate == SEND_PAYLOAD) {
-		size_t totallen = 0;
-		if (iocb->data_length > 0) {
-			if (ctx->omask) {
-				uint8_t temp[4096];
-				const uint8_t *datamark = iocb->data, *datalimit = iocb->data + iocb->data_length;
-				while (datamark < datalimit) {
-					size_t datalen = datalimit - datamark;
-					const uint8_t *writelimit = datamark + wslay_min(sizeof(temp), datalen);
-					size_t writelen = writelimit - datamark;
-					ssize_t r;
-					size_t i;
-					for (i = 0; i < writelen; ++i) {
-						temp[i] = datamark[i] ^ ctx->omaskkey[(ctx->opayloadoff + i) % 4];
-					}
-					r = ctx->callbacks.send_callback(temp, writelen, 0, ctx->user_data);
-					if (r > 0) {
-						if ((size_t)r > writelen) {
-							return WSLAY_ERR_INVALID_CALLBACK;
-						} else {
-							datamark += r;
-							ctx->opayloadoff += r;
-							totallen += r;
-						}
-					} else {
-						if (totallen > 0) {
-							break;
-						} else {
-							return WSLAY_ERR_WANT_WRITE;
-						}
-					}
+		const uint8_t *datamark = iocb->data + totallen, *datalimit = iocb->data + iocb->data_length;
+		while (datamark < datalimit) {
+			size_t datalen = datalimit - datamark;
+			const uint8_t *sendbuf = datamark;
+			size_t writelen = datalen;
+			if (ctx->omask && inplace != NULL) {
+				/* Bytes masked by an earlier, partial, send are not masked again */
+				uint8_t *p = inplace + (datamark - iocb->data);
+				uint64_t masked = ctx->omaskoff > ctx->opayloadoff ? ctx->omaskoff - ctx->opayloadoff : 0;
+				if (masked < datalen) {
+					wslay_mask(p + masked, p + masked, datalen - masked, ctx->omaskkey, ctx->opayloadoff + masked);
+					ctx->omaskoff = ctx->opayloadoff + datalen;
+				}
+			} else if (ctx->omask) {
+				writelen = wslay_min(sizeof(temp), datalen);
+				wslay_mask(temp, datamark, writelen, ctx->omaskkey, ctx->opayloadoff);
+				sendbuf = temp;
+			}
+			r = ctx->callbacks.send_callback(sendbuf, writelen, 0, ctx->user_data);
+			if (r > 0) {
+				if ((size_t)r > writelen) {
+					return WSLAY_ERR_INVALID_CALLBACK;
+				}
+				datamark += r;
+				ctx->opayloadoff += r;
+				totallen += r;
+				if (sendbuf != temp) {
+					break;
 				}
 			} else {
-				ssize_t r;
-				r = ctx->callbacks.send_callback(iocb->data, iocb->data_length, 0, ctx->user_data);
-				if (r > 0) {
-					if ((size_t)r > iocb->data_length) {
-						return WSLAY_ERR_INVALID_CALLBACK;
-					} else {
-						ctx->opayloadoff += r;
-						totallen = r;
-					}
+				if (totallen > 0) {
+					break;
 				} else {
 					return WSLAY_ERR_WANT_WRITE;
 				}
@@ -198,6 +254,16 @@ ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *i
 	return WSLAY_ERR_INVALID_ARGUMENT;
 }
 
+ssize_t wslay_frame_send(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb)
+{
+	return wslay_frame_send_common(ctx, iocb, NULL);
+}
+
+ssize_t wslay_frame_send_inplace(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *iocb)
+{
+	return wslay_frame_send_common(ctx, iocb, (uint8_t *)iocb->data);
+}
+
 static void wslay_shift_ibuf(wslay_frame_context_ptr ctx)
 {
 	ptrdiff_t len = ctx->ibuflimit - ctx->ibufmark;
@@ -318,13 +384,10 @@ ssize_t wslay_frame_recv(wslay_frame_context_ptr ctx, struct wslay_frame_iocb *i
 		readmark = ctx->ibufmark;
 		readlimit = WSLAY_AVAIL_IBUF(ctx) < rempayloadlen ? ctx->ibuflimit : ctx->ibufmark + rempayloadlen;
 		if (ctx->imask) {
-			for (; ctx->ibufmark != readlimit; ++ctx->ibufmark, ++ctx->ipayloadoff) {
-				ctx->ibufmark[0] ^= ctx->imaskkey[ctx->ipayloadoff % 4];
-			}
-		} else {
-			ctx->ibufmark = readlimit;
-			ctx->ipayloadoff += readlimit - readmark;
+			wslay_mask(readmark, readmark, readlimit - readmark, ctx->imaskkey, ctx->ipayloadoff);
 		}
+		ctx->ibufmark = readlimit;
+		ctx->ipayloadoff += readlimit - readmark;
 		iocb->fin = ctx->iom.fin;
 		iocb->rsv = ctx->iom.rsv;
 		iocb->opcode = ctx->iom.opcode;
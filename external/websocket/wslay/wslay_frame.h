@@ -81,6 +81,8 @@ struct wslay_frame_context {
 	uint64_t opayloadoff;
 	uint8_t omask;
 	uint8_t omaskkey[4];
+	/* payload bytes already masked in the caller's buffer (in place send) */
+	uint64_t omaskoff;
 	enum wslay_frame_state ostate;
 
 	struct wslay_frame_callbacks callbacks;
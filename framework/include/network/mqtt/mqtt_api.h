@@ -132,6 +132,7 @@ struct _mqtt_client_config_s {
 	/**< on_unsubscribe call back function */
 
 	void *user_data; /**< user defined data */
+	int max_inflight; /**< maximum number of QoS 1 and 2 messages in flight, 0 for the default (20), negative for no limit */
 };
 
 typedef struct _mqtt_client_config_s mqtt_client_config_t;
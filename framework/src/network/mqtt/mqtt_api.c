@@ -272,6 +272,11 @@ mqtt_client_t *mqtt_init_client(mqtt_client_config_t *config)
 		ndbg("ERROR: fail to set mqtt protocol version.\n");
 		goto done;
 	}
+
+	/* set in-flight window */
+	if (config->max_inflight != 0) {
+		mosquitto_max_inflight_messages_set((struct mosquitto *)mqtt_client->mosq, config->max_inflight > 0 ? config->max_inflight : 0);
+	}
 #if defined(CONFIG_NETUTILS_MQTT_SECURITY)
 	if (config->tls) {
 		struct mosquitto *tmp = (struct mosquitto *)mqtt_client->mosq;
@@ -61,6 +61,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <limits.h>
 #include <semaphore.h>
@@ -137,10 +138,33 @@
 
 #define LIB_BUFLEN_UNKNOWN INT_MAX
 
+/* Helpers of the word-at-a-time string functions.  LIB_WORD_HASZERO() is
+ * true if any byte of the word is zero.
+ */
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+#define LIB_WORD_SIZE       sizeof(lib_word_t)
+#define LIB_WORD_MASK       (LIB_WORD_SIZE - 1)
+#define LIB_WORD_ALIGNED(p) (((uintptr_t)(p) & LIB_WORD_MASK) == 0)
+#define LIB_WORD_ONES       ((lib_word_t)-1 / 0xff)
+#define LIB_WORD_HIGHS      (LIB_WORD_ONES << 7)
+#define LIB_WORD_HASZERO(w) ((((w) - LIB_WORD_ONES) & ~(w) & LIB_WORD_HIGHS) != 0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* A machine word used to access byte arrays of any type.  Aligned word
+ * loads may read bytes past the end of a string, but never past the word
+ * holding its last byte, so they cannot cross into another page or MPU
+ * region.
+ */
+
+typedef uintptr_t __attribute__((__may_alias__)) lib_word_t;
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -58,6 +58,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -188,9 +189,9 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
 		 * Move the data down in the buffer to handle this (rare) case
 		 */
 
-		while (nbuffer) {
-			*stream->fs_bufpos++ = *src++;
-			--nbuffer;
+		if (nbuffer > 0) {
+			memmove(stream->fs_bufpos, src, nbuffer);
+			stream->fs_bufpos += nbuffer;
 		}
 	}
 
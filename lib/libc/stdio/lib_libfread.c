@@ -154,11 +154,19 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
 		while (count > 0) {
 			/* Is there readable data in the buffer? */
 
-			while ((count > 0) && (stream->fs_bufpos < stream->fs_bufread)) {
-				/* Yes, copy a byte into the user buffer */
+			if (stream->fs_bufpos < stream->fs_bufread) {
+				/* Yes, copy as much of it as needed into the user buffer */
 
-				*dest++ = *stream->fs_bufpos++;
-				count--;
+				size_t nbuffered = stream->fs_bufread - stream->fs_bufpos;
+
+				if (nbuffered > count) {
+					nbuffered = count;
+				}
+
+				memcpy(dest, stream->fs_bufpos, nbuffered);
+				dest += nbuffered;
+				stream->fs_bufpos += nbuffered;
+				count -= nbuffered;
 			}
 
 			/* The buffer is empty OR we have already supplied the number of
@@ -59,6 +59,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -107,7 +108,7 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 	FAR const unsigned char *start = ptr;
 	FAR const unsigned char *src = ptr;
 	ssize_t ret = ERROR;
-	unsigned char *dest;
+	ssize_t nwritten;
 
 	/* Make sure that writing to this stream is allowed */
 
@@ -129,12 +130,31 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 		goto errout_with_semaphore;
 	}
 
-	/* Loop until all of the bytes have been buffered */
+	/* Loop until all of the bytes have been buffered or written */
 
 	while (count > 0) {
+		size_t gulp_size;
+
+		/* If the buffer is empty and the user data would fill all of it,
+		 * there is nothing to gain from copying: write the data directly.
+		 */
+
+		if (stream->fs_bufpos == stream->fs_bufstart && count >= (size_t)(stream->fs_bufend - stream->fs_bufstart)) {
+			nwritten = write(stream->fs_fd, src, count);
+			if (nwritten < 0) {
+				goto errout_with_semaphore;
+			} else if (nwritten == 0) {
+				break;
+			}
+
+			src += nwritten;
+			count -= nwritten;
+			continue;
+		}
+
 		/* Determine the number of bytes left in the buffer */
 
-		size_t gulp_size = stream->fs_bufend - stream->fs_bufpos;
+		gulp_size = stream->fs_bufend - stream->fs_bufpos;
 
 		/* Will the user data fit into the amount of buffer space
 		 * that we have left?
@@ -154,15 +174,13 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
 		/* Transfer the data into the buffer */
 
-		for (dest = stream->fs_bufpos; gulp_size > 0; gulp_size--) {
-			*dest++ = *src++;
-		}
-
-		stream->fs_bufpos = dest;
+		memcpy(stream->fs_bufpos, src, gulp_size);
+		src += gulp_size;
+		stream->fs_bufpos += gulp_size;
 
 		/* Is the buffer full? */
 
-		if (dest >= stream->fs_bufend) {
+		if (stream->fs_bufpos >= stream->fs_bufend) {
 			/* Flush the buffered data to the IO stream */
 
 			int bytes_buffered = lib_fflush(stream, false);
@@ -58,6 +58,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -158,6 +159,18 @@ enum {
 	FMT_CENTER
 };
 
+/* Integer conversions are done in the widest type that is enabled */
+
+#ifndef CONFIG_NOPRINTF_LONGLONG_TO_ASCII
+typedef unsigned long long uprintf_t;
+#else
+typedef unsigned long uprintf_t;
+#endif
+
+/* Enough for the binary digits of uprintf_t plus a sign or an "0x" prefix */
+
+#define NUMBUF_SIZE              (8 * sizeof(uprintf_t) + 2)
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -167,48 +180,23 @@ enum {
 #ifdef CONFIG_PTR_IS_NOT_INT
 static void ptohex(FAR struct lib_outstream_s *obj, uint8_t flags, FAR void *p);
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static int getsizesize(uint8_t fmt, uint8_t flags, FAR void *p)
+static int getpsize(uint8_t flags, FAR void *p);
 #endif							/* CONFIG_NOPRINTF_FIELDWIDTH */
 #endif							/* CONFIG_PTR_IS_NOT_INT */
-/* Unsigned int to ASCII conversion */
-static void utodec(FAR struct lib_outstream_s *obj, unsigned int n);
-static void utohex(FAR struct lib_outstream_s *obj, unsigned int n, uint8_t a);
-static void utooct(FAR struct lib_outstream_s *obj, unsigned int n);
-static void utobin(FAR struct lib_outstream_s *obj, unsigned int n);
-static void utoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned int lln);
-
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void fixup(uint8_t fmt, FAR uint8_t *flags, int *n);
-static int getusize(uint8_t fmt, uint8_t flags, unsigned int lln);
-#endif
 
-/* Unsigned long int to ASCII conversion */
+/* Output of character spans and padding */
 
-#ifdef CONFIG_LONG_IS_NOT_INT
-static void lutodec(FAR struct lib_outstream_s *obj, unsigned long ln);
-static void lutohex(FAR struct lib_outstream_s *obj, unsigned long ln, uint8_t a);
-static void lutooct(FAR struct lib_outstream_s *obj, unsigned long ln);
-static void lutobin(FAR struct lib_outstream_s *obj, unsigned long ln);
-static void lutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned long ln);
+static void putspan(FAR struct lib_outstream_s *obj, FAR const char *buf, size_t len);
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void lfixup(uint8_t fmt, FAR uint8_t *flags, long *ln);
-static int getlusize(uint8_t fmt, FAR uint8_t flags, unsigned long ln);
-#endif
+static void putpad(FAR struct lib_outstream_s *obj, char ch, int count);
 #endif
 
-/* Unsigned long long int to ASCII conversions */
+/* Unsigned integer to ASCII conversion */
 
-#ifndef CONFIG_NOPRINTF_LONGLONG_TO_ASCII
-static void llutodec(FAR struct lib_outstream_s *obj, unsigned long long lln);
-static void llutohex(FAR struct lib_outstream_s *obj, unsigned long long lln, uint8_t a);
-static void llutooct(FAR struct lib_outstream_s *obj, unsigned long long lln);
-static void llutobin(FAR struct lib_outstream_s *obj, unsigned long long lln);
-static void llutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned long long lln);
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void llfixup(uint8_t fmt, FAR uint8_t *flags, FAR long long *lln);
-static int getllusize(uint8_t fmt, FAR uint8_t flags, FAR unsigned long long lln);
-#endif
-#endif
+static FAR char *utodec(FAR char *ptr, uprintf_t n);
+static FAR char *utobase(FAR char *ptr, uprintf_t n, uint8_t shift, FAR const char *digits);
+static FAR char *utoascii(FAR char *ptr, uint8_t fmt, uint8_t flags, uprintf_t n);
+static bool fixup(uint8_t fmt, FAR uint8_t *flags, bool negative);
 
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, int fieldwidth, int valwidth);
@@ -229,6 +217,30 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t fl
 
 static const char g_nullstring[] = "(null)";
 
+/* Two ASCII digits for each value 0..99, so that decimal conversion needs
+ * one division per pair of digits.
+ */
+
+static const char g_digitpairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const char g_lowerdigits[] = "0123456789abcdef";
+static const char g_upperdigits[] = "0123456789ABCDEF";
+
+#ifndef CONFIG_NOPRINTF_FIELDWIDTH
+static const char g_spaces[] = "                ";
+static const char g_zeroes[] = "0000000000000000";
+#endif
+
 /****************************************************************************
  * Private Variables
  ****************************************************************************/
@@ -296,670 +308,200 @@ static int getpsize(uint8_t flags, FAR void *p)
 #endif							/* CONFIG_PTR_IS_NOT_INT */
 
 /****************************************************************************
- * Name: utodec
- ****************************************************************************/
-
-static void utodec(FAR struct lib_outstream_s *obj, unsigned int n)
-{
-	unsigned int remainder = n % 10;
-	unsigned int dividend = n / 10;
-
-	if (dividend) {
-		utodec(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: utohex
+ * Name: putspan
+ *
+ * Description:
+ *   Output len characters, in one call if the stream supports it.
+ *
  ****************************************************************************/
 
-static void utohex(FAR struct lib_outstream_s *obj, unsigned int n, uint8_t a)
+static void putspan(FAR struct lib_outstream_s *obj, FAR const char *buf, size_t len)
 {
-	bool nonzero = false;
-	uint8_t bits;
-
-	for (bits = 8 * sizeof(unsigned int); bits > 0; bits -= 4) {
-		uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-		if (nibble || nonzero) {
-			nonzero = true;
-
-			if (nibble < 10) {
-				obj->put(obj, nibble + '0');
-			} else {
-				obj->put(obj, nibble + a - 10);
-			}
+	if (obj->write) {
+		obj->write(obj, buf, len);
+	} else {
+		while (len-- > 0) {
+			obj->put(obj, *buf++);
 		}
 	}
-
-	if (!nonzero) {
-		obj->put(obj, '0');
-	}
-}
-
-/****************************************************************************
- * Name: utooct
- ****************************************************************************/
-
-static void utooct(FAR struct lib_outstream_s *obj, unsigned int n)
-{
-	unsigned int remainder = n & 0x7;
-	unsigned int dividend = n >> 3;
-
-	if (dividend) {
-		utooct(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: utobin
- ****************************************************************************/
-
-static void utobin(FAR struct lib_outstream_s *obj, unsigned int n)
-{
-	unsigned int remainder = n & 1;
-	unsigned int dividend = n >> 1;
-
-	if (dividend) {
-		utobin(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
 }
 
 /****************************************************************************
- * Name: utoascii
- ****************************************************************************/
-
-static void utoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned int n)
-{
-	/* Perform the integer conversion according to the format specifier */
-
-	switch (fmt) {
-	case 'd':
-	case 'i':
-		/* Signed base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if ((int)n < 0) {
-			obj->put(obj, '-');
-			n = (unsigned int)(-(int)n);
-		} else if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
-#endif
-		/* Convert the unsigned value to a string. */
-
-		utodec(obj, n);
-	}
-	break;
-
-	case 'u':
-		/* Unigned base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
-#endif
-		/* Convert the unsigned value to a string. */
-
-		utodec(obj, n);
-	}
-	break;
-
-#ifndef CONFIG_PTR_IS_NOT_INT
-	case 'p':
-#endif
-	case 'x':
-	case 'X':
-		/* Hexadecimal */
-	{
-		/* Check for alternate form */
-
-		if (IS_ALTFORM(flags)) {
-			/* Prefix the number with "0x" */
-
-			obj->put(obj, '0');
-			obj->put(obj, 'x');
-		}
-
-		/* Convert the unsigned value to a string. */
-
-		if (fmt == 'X') {
-			utohex(obj, n, 'A');
-		} else {
-			utohex(obj, n, 'a');
-		}
-	}
-	break;
-
-	case 'o':
-		/* Octal */
-	{
-		/* Check for alternate form */
-
-		if (IS_ALTFORM(flags)) {
-			/* Prefix the number with '0' */
-
-			obj->put(obj, '0');
-		}
-
-		/* Convert the unsigned value to a string. */
-
-		utooct(obj, n);
-	}
-	break;
-
-	case 'b':
-		/* Binary */
-	{
-		/* Convert the unsigned value to a string. */
-
-		utobin(obj, n);
-	}
-	break;
-
-#ifdef CONFIG_PTR_IS_NOT_INT
-	case 'p':
-#endif
-	default:
-		break;
-	}
-}
-
-/****************************************************************************
- * Name: fixup
+ * Name: putpad
  ****************************************************************************/
 
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void fixup(uint8_t fmt, FAR uint8_t *flags, FAR int *n)
+static void putpad(FAR struct lib_outstream_s *obj, char ch, int count)
 {
-	/* Perform the integer conversion according to the format specifier */
-
-	switch (fmt) {
-	case 'd':
-	case 'i':
-		/* Signed base 10 */
-
-		if (*n < 0) {
-			SET_NEGATE(*flags);
-			CLR_SHOWPLUS(*flags);
-			*n = -*n;
-		}
-		break;
+	FAR const char *pad = (ch == '0') ? g_zeroes : g_spaces;
+	int chunk;
 
-	case 'u':
-		/* Unsigned base 10 */
-		break;
-
-	case 'p':
-	case 'x':
-	case 'X':
-	/* Hexadecimal */
-	case 'o':
-	/* Octal */
-	case 'b':
-		/* Binary */
-		CLR_SIGNED(*flags);
-		break;
-
-	default:
-		break;
+	while (count > 0) {
+		chunk = count < (int)(sizeof(g_spaces) - 1) ? count : (int)(sizeof(g_spaces) - 1);
+		putspan(obj, pad, chunk);
+		count -= chunk;
 	}
 }
-
-/****************************************************************************
- * Name: getusize
- ****************************************************************************/
-
-static int getusize(uint8_t fmt, uint8_t flags, unsigned int n)
-{
-	struct lib_outstream_s nulloutstream;
-	lib_nulloutstream(&nulloutstream);
-
-	utoascii(&nulloutstream, fmt, flags, n);
-	return nulloutstream.nput;
-}
-
-/****************************************************************************
- * Name: getdblsize
- ****************************************************************************/
-
-#ifdef CONFIG_LIBC_FLOATINGPOINT
-static int getdblsize(uint8_t fmt, int trunc, uint8_t flags, double n)
-{
-	struct lib_outstream_s nulloutstream;
-	lib_nulloutstream(&nulloutstream);
-
-	lib_dtoa(&nulloutstream, fmt, trunc, flags, n);
-	return nulloutstream.nput;
-}
 #endif
-#endif							/* CONFIG_NOPRINTF_FIELDWIDTH */
-
-#ifdef CONFIG_LONG_IS_NOT_INT
-/****************************************************************************
- * Name: lutodec
- ****************************************************************************/
-
-static void lutodec(FAR struct lib_outstream_s *obj, unsigned long n)
-{
-	unsigned int remainder = n % 10;
-	unsigned long dividend = n / 10;
-
-	if (dividend) {
-		lutodec(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
 
 /****************************************************************************
- * Name: lutohex
+ * Name: utodec
+ *
+ * Description:
+ *   Convert n to decimal, storing the digits backward from ptr.  Returns a
+ *   pointer to the first digit.  Digits are produced in pairs and the wide
+ *   division is only used while n does not fit in an unsigned int.
+ *
  ****************************************************************************/
 
-static void lutohex(FAR struct lib_outstream_s *obj, unsigned long n, uint8_t a)
+static FAR char *utodec(FAR char *ptr, uprintf_t n)
 {
-	bool nonzero = false;
-	uint8_t bits;
+	unsigned int un;
+	unsigned int q;
 
-	for (bits = 8 * sizeof(unsigned long); bits > 0; bits -= 4) {
-		uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-		if (nibble || nonzero) {
-			nonzero = true;
+	while (n > UINT_MAX) {
+		uprintf_t lq = n / 100;
 
-			if (nibble < 10) {
-				obj->put(obj, nibble + '0');
-			} else {
-				obj->put(obj, nibble + a - 10);
-			}
-		}
+		ptr -= 2;
+		memcpy(ptr, &g_digitpairs[2 * (unsigned int)(n - lq * 100)], 2);
+		n = lq;
 	}
 
-	if (!nonzero) {
-		obj->put(obj, '0');
+	un = (unsigned int)n;
+	while (un >= 100) {
+		q = un / 100;
+		ptr -= 2;
+		memcpy(ptr, &g_digitpairs[2 * (un - q * 100)], 2);
+		un = q;
 	}
-}
-
-/****************************************************************************
- * Name: lutooct
- ****************************************************************************/
-
-static void lutooct(FAR struct lib_outstream_s *obj, unsigned long n)
-{
-	unsigned int remainder = n & 0x7;
-	unsigned long dividend = n >> 3;
 
-	if (dividend) {
-		lutooct(obj, dividend);
+	if (un >= 10) {
+		ptr -= 2;
+		memcpy(ptr, &g_digitpairs[2 * un], 2);
+	} else {
+		*--ptr = (char)('0' + un);
 	}
 
-	obj->put(obj, (remainder + (unsigned int)'0'));
+	return ptr;
 }
 
 /****************************************************************************
- * Name: lutobin
+ * Name: utobase
+ *
+ * Description:
+ *   Convert n to a power-of-two base of 1 << shift, storing the digits
+ *   backward from ptr.  Returns a pointer to the first digit.
+ *
  ****************************************************************************/
 
-static void lutobin(FAR struct lib_outstream_s *obj, unsigned long n)
+static FAR char *utobase(FAR char *ptr, uprintf_t n, uint8_t shift, FAR const char *digits)
 {
-	unsigned int remainder = n & 1;
-	unsigned long dividend = n >> 1;
+	unsigned int mask = (1u << shift) - 1;
+	unsigned int un;
 
-	if (dividend) {
-		lutobin(obj, dividend);
+	while (n > UINT_MAX) {
+		*--ptr = digits[(unsigned int)n & mask];
+		n >>= shift;
 	}
 
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: lutoascii
- ****************************************************************************/
-
-static void lutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned long ln)
-{
-	/* Perform the integer conversion according to the format specifier */
+	un = (unsigned int)n;
+	do {
+		*--ptr = digits[un & mask];
+		un >>= shift;
+	} while (un);
 
-	switch (fmt) {
-	case 'd':
-	case 'i':
-		/* Signed base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if ((long)ln < 0) {
-			obj->put(obj, '-');
-			ln = (unsigned long)(-(long)ln);
-		} else if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
-#endif
-		/* Convert the unsigned value to a string. */
-
-		lutodec(obj, ln);
-	}
-	break;
-
-	case 'u':
-		/* Unigned base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
-#endif
-		/* Convert the unsigned value to a string. */
-
-		lutodec(obj, ln);
-	}
-	break;
-
-	case 'x':
-	case 'X':
-		/* Hexadecimal */
-	{
-		/* Check for alternate form */
-
-		if (IS_ALTFORM(flags)) {
-			/* Prefix the number with "0x" */
-
-			obj->put(obj, '0');
-			obj->put(obj, 'x');
-		}
-
-		/* Convert the unsigned value to a string. */
-
-		if (fmt == 'X') {
-			lutohex(obj, ln, 'A');
-		} else {
-			lutohex(obj, ln, 'a');
-		}
-	}
-	break;
-
-	case 'o':
-		/* Octal */
-	{
-		/* Check for alternate form */
-
-		if (IS_ALTFORM(flags)) {
-			/* Prefix the number with '0' */
-
-			obj->put(obj, '0');
-		}
-
-		/* Convert the unsigned value to a string. */
-
-		lutooct(obj, ln);
-	}
-	break;
-
-	case 'b':
-		/* Binary */
-	{
-		/* Convert the unsigned value to a string. */
-
-		lutobin(obj, ln);
-	}
-	break;
-
-	case 'p':
-	default:
-		break;
-	}
+	return ptr;
 }
 
 /****************************************************************************
- * Name: lfixup
+ * Name: utoascii
+ *
+ * Description:
+ *   Convert n according to the format specifier, storing the characters
+ *   backward from ptr.  The sign is not included.  Returns a pointer to the
+ *   first character; nothing is stored for an unknown format.
+ *
  ****************************************************************************/
 
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void lfixup(uint8_t fmt, FAR uint8_t *flags, FAR long *ln)
+static FAR char *utoascii(FAR char *ptr, uint8_t fmt, uint8_t flags, uprintf_t n)
 {
 	/* Perform the integer conversion according to the format specifier */
 
 	switch (fmt) {
 	case 'd':
 	case 'i':
-		/* Signed base 10 */
-
-		if (*ln < 0) {
-			SET_NEGATE(*flags);
-			CLR_SHOWPLUS(*flags);
-			*ln = -*ln;
-		}
-		break;
-
 	case 'u':
-		/* Unsigned base 10 */
-		break;
-
-	case 'p':
-	case 'x':
-	case 'X':
-	/* Hexadecimal */
-	case 'o':
-	/* Octal */
-	case 'b':
-		/* Binary */
-		CLR_SIGNED(*flags);
-		break;
+		/* Base 10 */
 
-	default:
+		ptr = utodec(ptr, n);
 		break;
-	}
-}
-
-/****************************************************************************
- * Name: getlusize
- ****************************************************************************/
-
-static int getlusize(uint8_t fmt, uint8_t flags, unsigned long ln)
-{
-	struct lib_outstream_s nulloutstream;
-	lib_nulloutstream(&nulloutstream);
-
-	lutoascii(&nulloutstream, fmt, flags, ln);
-	return nulloutstream.nput;
-}
-
-#endif							/* CONFIG_NOPRINTF_FIELDWIDTH */
-#endif							/* CONFIG_LONG_IS_NOT_INT */
-
-#ifndef CONFIG_NOPRINTF_LONGLONG_TO_ASCII
-/****************************************************************************
- * Name: llutodec
- ****************************************************************************/
-
-static void llutodec(FAR struct lib_outstream_s *obj, unsigned long long n)
-{
-	unsigned int remainder = n % 10;
-	unsigned long long dividend = n / 10;
-
-	if (dividend) {
-		llutodec(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: llutohex
- ****************************************************************************/
-
-static void llutohex(FAR struct lib_outstream_s *obj, unsigned long long n, uint8_t a)
-{
-	bool nonzero = false;
-	uint8_t bits;
-
-	for (bits = 8 * sizeof(unsigned long long); bits > 0; bits -= 4) {
-		uint8_t nibble = (uint8_t)((n >> (bits - 4)) & 0xf);
-		if (nibble || nonzero) {
-			nonzero = true;
-
-			if (nibble < 10) {
-				obj->put(obj, (nibble + '0'));
-			} else {
-				obj->put(obj, (nibble + a - 10));
-			}
-		}
-	}
-
-	if (!nonzero) {
-		obj->put(obj, '0');
-	}
-}
-
-/****************************************************************************
- * Name: llutooct
- ****************************************************************************/
-
-static void llutooct(FAR struct lib_outstream_s *obj, unsigned long long n)
-{
-	unsigned int remainder = n & 0x7;
-	unsigned long long dividend = n >> 3;
-
-	if (dividend) {
-		llutooct(obj, dividend);
-	}
 
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: llutobin
- ****************************************************************************/
-
-static void llutobin(FAR struct lib_outstream_s *obj, unsigned long long n)
-{
-	unsigned int remainder = n & 1;
-	unsigned long long dividend = n >> 1;
-
-	if (dividend) {
-		llutobin(obj, dividend);
-	}
-
-	obj->put(obj, (remainder + (unsigned int)'0'));
-}
-
-/****************************************************************************
- * Name: llutoascii
- ****************************************************************************/
-
-static void llutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, unsigned long long lln)
-{
-	/* Perform the integer conversion according to the format specifier */
-
-	switch (fmt) {
-	case 'd':
-	case 'i':
-		/* Signed base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if ((long long)lln < 0) {
-			obj->put(obj, '-');
-			lln = (unsigned long long)(-(long long)lln);
-		} else if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
-#endif
-		/* Convert the unsigned value to a string. */
-
-		llutodec(obj, (unsigned long long)lln);
-	}
-	break;
-
-	case 'u':
-		/* Unigned base 10 */
-	{
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-		if (IS_SHOWPLUS(flags)) {
-			obj->put(obj, '+');
-		}
+#ifndef CONFIG_PTR_IS_NOT_INT
+	case 'p':
 #endif
-		/* Convert the unsigned value to a string. */
-
-		llutodec(obj, (unsigned long long)lln);
-	}
-	break;
-
 	case 'x':
 	case 'X':
 		/* Hexadecimal */
-	{
+
+		ptr = utobase(ptr, n, 4, fmt == 'X' ? g_upperdigits : g_lowerdigits);
+
 		/* Check for alternate form */
 
 		if (IS_ALTFORM(flags)) {
 			/* Prefix the number with "0x" */
 
-			obj->put(obj, '0');
-			obj->put(obj, 'x');
-		}
-
-		/* Convert the unsigned value to a string. */
-
-		if (fmt == 'X') {
-			llutohex(obj, (unsigned long long)lln, 'A');
-		} else {
-			llutohex(obj, (unsigned long long)lln, 'a');
+			*--ptr = 'x';
+			*--ptr = '0';
 		}
-	}
-	break;
+		break;
 
 	case 'o':
 		/* Octal */
-	{
+
+		ptr = utobase(ptr, n, 3, g_lowerdigits);
+
 		/* Check for alternate form */
 
 		if (IS_ALTFORM(flags)) {
 			/* Prefix the number with '0' */
 
-			obj->put(obj, '0');
+			*--ptr = '0';
 		}
-
-		/* Convert the unsigned value to a string. */
-
-		llutooct(obj, (unsigned long long)lln);
-	}
-	break;
+		break;
 
 	case 'b':
 		/* Binary */
-	{
-		/* Convert the unsigned value to a string. */
 
-		llutobin(obj, (unsigned long long)lln);
-	}
-	break;
+		ptr = utobase(ptr, n, 1, g_lowerdigits);
+		break;
 
-	case 'p':
 	default:
 		break;
 	}
+
+	return ptr;
 }
 
 /****************************************************************************
- * Name: llfixup
+ * Name: fixup
+ *
+ * Description:
+ *   Resolve the sign flags for the format specifier.  Returns true if the
+ *   value is negative and must be output as its magnitude.
+ *
  ****************************************************************************/
 
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-static void llfixup(uint8_t fmt, FAR uint8_t *flags, FAR long long *lln)
+static bool fixup(uint8_t fmt, FAR uint8_t *flags, bool negative)
 {
-	/* Perform the integer conversion according to the format specifier */
-
 	switch (fmt) {
 	case 'd':
 	case 'i':
 		/* Signed base 10 */
 
-		if (*lln < 0) {
+		if (negative) {
 			SET_NEGATE(*flags);
 			CLR_SHOWPLUS(*flags);
-			*lln = -*lln;
+			return true;
 		}
 		break;
 
@@ -981,23 +523,24 @@ static void llfixup(uint8_t fmt, FAR uint8_t *flags, FAR long long *lln)
 	default:
 		break;
 	}
+
+	return false;
 }
 
 /****************************************************************************
- * Name: getllusize
+ * Name: getdblsize
  ****************************************************************************/
 
-static int getllusize(uint8_t fmt, uint8_t flags, unsigned long long lln)
+#if !defined(CONFIG_NOPRINTF_FIELDWIDTH) && defined(CONFIG_LIBC_FLOATINGPOINT)
+static int getdblsize(uint8_t fmt, int trunc, uint8_t flags, double n)
 {
 	struct lib_outstream_s nulloutstream;
 	lib_nulloutstream(&nulloutstream);
 
-	llutoascii(&nulloutstream, fmt, flags, lln);
+	lib_dtoa(&nulloutstream, fmt, trunc, flags, n);
 	return nulloutstream.nput;
 }
-
-#endif							/* CONFIG_NOPRINTF_FIELDWIDTH */
-#endif							/* CONFIG_NOPRINTF_LONGLONG_TO_ASCII */
+#endif
 
 /****************************************************************************
  * Name: prejustify
@@ -1006,8 +549,6 @@ static int getllusize(uint8_t fmt, uint8_t flags, unsigned long long lln)
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, int fieldwidth, int valwidth)
 {
-	int i;
-
 	switch (fmt) {
 	default:
 	case FMT_RJUST:
@@ -1015,9 +556,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t fla
 			valwidth++;
 		}
 
-		for (i = fieldwidth - valwidth; i > 0; i--) {
-			obj->put(obj, ' ');
-		}
+		putpad(obj, ' ', fieldwidth - valwidth);
 
 		if (IS_NEGATE(flags)) {
 			obj->put(obj, '-');
@@ -1035,9 +574,7 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t fla
 			valwidth++;
 		}
 
-		for (i = fieldwidth - valwidth; i > 0; i--) {
-			obj->put(obj, '0');
-		}
+		putpad(obj, '0', fieldwidth - valwidth);
 		break;
 
 	case FMT_LJUST:
@@ -1058,8 +595,6 @@ static void prejustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t fla
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void postjustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t flags, int fieldwidth, int valwidth)
 {
-	int i;
-
 	/* Apply field justification to the integer value. */
 
 	switch (fmt) {
@@ -1073,9 +608,7 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t fmt, uint8_t fl
 			valwidth++;
 		}
 
-		for (i = fieldwidth - valwidth; i > 0; i--) {
-			obj->put(obj, ' ');
-		}
+		putpad(obj, ' ', fieldwidth - valwidth);
 		break;
 	}
 }
@@ -1109,9 +642,27 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 		/* Just copy regular characters */
 
 		if (FMT_CHAR != '%') {
+#ifdef CONFIG_ARCH_ROMGETC
 			/* Output the character */
 
 			obj->put(obj, FMT_CHAR);
+#else
+			/* Output the run of regular characters at once.  With line
+			 * buffering, the run ends at a newline so it can be flushed.
+			 */
+
+			FAR const char *span = src;
+
+#ifdef CONFIG_STDIO_LINEBUFFER
+			while (*src != '\n' && src[1] != '\0' && src[1] != '%') {
+#else
+			while (src[1] != '\0' && src[1] != '%') {
+#endif
+				src++;
+			}
+
+			putspan(obj, span, src - span + 1);
+#endif
 
 			/* Flush the buffer if a newline is encountered */
 
@@ -1279,19 +830,14 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
 			/* Concatenate the string into the output */
 
-			if (trunc_sfmt) {
-				while (*ptmp && trunc_sfmt--) {
-					obj->put(obj, *ptmp);
-					ptmp++;
-				}
-			} else
-#endif
-			{
-				while (*ptmp) {
-					obj->put(obj, *ptmp);
-					ptmp++;
-				}
+			if (trunc_sfmt && trunc_sfmt < swidth) {
+				putspan(obj, ptmp, trunc_sfmt);
+			} else {
+				putspan(obj, ptmp, swidth);
 			}
+#else
+			putspan(obj, ptmp, strlen(ptmp));
+#endif
 
 			/* Perform left-justification operations. */
 
@@ -1328,78 +874,35 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 		/* Handle integer conversions */
 
 		if (strchr("diuxXpob", FMT_CHAR)) {
-#ifndef CONFIG_NOPRINTF_LONGLONG_TO_ASCII
-			if (IS_LONGLONGPRECISION(flags) && FMT_CHAR != 'p') {
-				long long lln;
+			char numbuf[NUMBUF_SIZE];
+			FAR char *end = &numbuf[NUMBUF_SIZE];
+			uprintf_t un;
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
-				int lluwidth;
+			int uwidth;
 #endif
-				/* Extract the long long value. */
-
-				lln = va_arg(ap, long long);
-
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-				/* Output the number */
-
-				llutoascii(obj, FMT_CHAR, flags, (unsigned long long)lln);
-#else
-				/* Resolve sign-ness and format issues */
-
-				llfixup(FMT_CHAR, &flags, &lln);
-
-				/* Get the width of the output */
-
-				lluwidth = getllusize(FMT_CHAR, flags, lln);
-
-				/* Perform left field justification actions */
-
-				prejustify(obj, fmt, flags, width, lluwidth);
 
-				/* Output the number */
-
-				llutoascii(obj, FMT_CHAR, flags, (unsigned long long)lln);
+#ifndef CONFIG_NOPRINTF_LONGLONG_TO_ASCII
+			if (IS_LONGLONGPRECISION(flags) && FMT_CHAR != 'p') {
+				/* Extract the long long value and resolve sign-ness */
 
-				/* Perform right field justification actions */
+				long long lln = va_arg(ap, long long);
 
-				postjustify(obj, fmt, flags, width, lluwidth);
-#endif
+				un = (unsigned long long)lln;
+				if (fixup(FMT_CHAR, &flags, lln < 0)) {
+					un = -(unsigned long long)lln;
+				}
 			} else
 #endif							/* CONFIG_NOPRINTF_LONGLONG_TO_ASCII */
 #ifdef CONFIG_LONG_IS_NOT_INT
 			if (IS_LONGPRECISION(flags) && FMT_CHAR != 'p') {
-				long ln;
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-				int luwidth;
-#endif
-				/* Extract the long value. */
+				/* Extract the long value and resolve sign-ness */
 
-				ln = va_arg(ap, long);
-
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-				/* Output the number */
-
-				lutoascii(obj, FMT_CHAR, flags, (unsigned long)ln);
-#else
-				/* Resolve sign-ness and format issues */
-
-				lfixup(FMT_CHAR, &flags, &ln);
-
-				/* Get the width of the output */
+				long ln = va_arg(ap, long);
 
-				luwidth = getlusize(FMT_CHAR, flags, ln);
-
-				/* Perform left field justification actions */
-
-				prejustify(obj, fmt, flags, width, luwidth);
-
-				/* Output the number */
-
-				lutoascii(obj, FMT_CHAR, flags, (unsigned long)ln);
-
-				/* Perform right field justification actions */
-
-				postjustify(obj, fmt, flags, width, luwidth);
-#endif
+				un = (unsigned long)ln;
+				if (fixup(FMT_CHAR, &flags, ln < 0)) {
+					un = -(unsigned long)ln;
+				}
 			} else
 #endif							/* CONFIG_LONG_IS_NOT_INT */
 #ifdef CONFIG_PTR_IS_NOT_INT
@@ -1419,11 +922,11 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 #else
 				/* Resolve sign-ness and format issues */
 
-				lfixup(FMT_CHAR, &flags, &ln);
+				CLR_SIGNED(flags);
 
 				/* Get the width of the output */
 
-				pwidth = getpsize(FMT_CHAR, flags, p);
+				pwidth = getpsize(flags, p);
 
 				/* Perform left field justification actions */
 
@@ -1437,43 +940,53 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
 				postjustify(obj, fmt, flags, width, pwidth);
 #endif
+				continue;
 			} else
 #endif
 			{
-				int n;
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
-				int uwidth;
-#endif
-				/* Extract the long long value. */
+				/* Extract the integer value and resolve sign-ness */
 
-				n = va_arg(ap, int);
+				int n = va_arg(ap, int);
 
-#ifdef CONFIG_NOPRINTF_FIELDWIDTH
-				/* Output the number */
+				un = (unsigned int)n;
+				if (fixup(FMT_CHAR, &flags, n < 0)) {
+					un = -(unsigned int)n;
+				}
+			}
 
-				utoascii(obj, FMT_CHAR, flags, (unsigned int)n);
-#else
-				/* Resolve sign-ness and format issues */
+			/* Convert the number backward from the end of the buffer */
 
-				fixup(FMT_CHAR, &flags, &n);
+			ptmp = utoascii(end, FMT_CHAR, flags, un);
 
-				/* Get the width of the output */
+#ifdef CONFIG_NOPRINTF_FIELDWIDTH
+			/* Prefix the sign and output the number */
 
-				uwidth = getusize(FMT_CHAR, flags, n);
+			if (ptmp != end) {
+				if (IS_NEGATE(flags)) {
+					*--ptmp = '-';
+				} else if (IS_SHOWPLUS(flags)) {
+					*--ptmp = '+';
+				}
+			}
 
-				/* Perform left field justification actions */
+			putspan(obj, ptmp, end - ptmp);
+#else
+			/* Get the width of the output */
 
-				prejustify(obj, fmt, flags, width, uwidth);
+			uwidth = end - ptmp;
 
-				/* Output the number */
+			/* Perform left field justification actions */
 
-				utoascii(obj, FMT_CHAR, flags, (unsigned int)n);
+			prejustify(obj, fmt, flags, width, uwidth);
 
-				/* Perform right field justification actions */
+			/* Output the number */
+
+			putspan(obj, ptmp, uwidth);
 
-				postjustify(obj, fmt, flags, width, uwidth);
+			/* Perform right field justification actions */
+
+			postjustify(obj, fmt, flags, width, uwidth);
 #endif
-			}
 		}
 
 		/* Handle floating point conversions */
@@ -108,6 +108,7 @@ static void lowoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_lowoutstream(FAR struct lib_outstream_s *stream)
 {
 	stream->put = lowoutstream_putc;
+	stream->write = NULL;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	stream->flush = lib_noflush;
 #endif
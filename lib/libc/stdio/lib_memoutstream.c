@@ -55,6 +55,7 @@
  ****************************************************************************/
 
 #include <assert.h>
+#include <string.h>
 
 #include "lib_internal.h"
 
@@ -84,6 +85,29 @@ static void memoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 	}
 }
 
+/****************************************************************************
+ * Name: memoutstream_write
+ ****************************************************************************/
+
+static void memoutstream_write(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len)
+{
+	FAR struct lib_memoutstream_s *mthis = (FAR struct lib_memoutstream_s *)this;
+
+	DEBUGASSERT(this);
+
+	/* Write as much as fits, like memoutstream_putc() does one by one */
+
+	if (this->nput < mthis->buflen) {
+		if (len > mthis->buflen - this->nput) {
+			len = mthis->buflen - this->nput;
+		}
+
+		memcpy(mthis->buffer + this->nput, buf, len);
+		this->nput += len;
+		mthis->buffer[this->nput] = '\0';
+	}
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -108,6 +132,7 @@ static void memoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_memoutstream(FAR struct lib_memoutstream_s *outstream, FAR char *bufstart, int buflen)
 {
 	outstream->public.put = memoutstream_putc;
+	outstream->public.write = memoutstream_write;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	outstream->public.flush = lib_noflush;
 #endif
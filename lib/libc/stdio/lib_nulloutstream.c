@@ -70,6 +70,12 @@ static void nulloutstream_putc(FAR struct lib_outstream_s *this, int ch)
 	this->nput++;
 }
 
+static void nulloutstream_write(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len)
+{
+	DEBUGASSERT(this);
+	this->nput += len;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +99,7 @@ static void nulloutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_nulloutstream(FAR struct lib_outstream_s *nulloutstream)
 {
 	nulloutstream->put = nulloutstream_putc;
+	nulloutstream->write = nulloutstream_write;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	nulloutstream->flush = lib_noflush;
 #endif
@@ -98,6 +98,33 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 	} while (errcode == EINTR);
 }
 
+/****************************************************************************
+ * Name: rawoutstream_write
+ ****************************************************************************/
+
+static void rawoutstream_write(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len)
+{
+	FAR struct lib_rawoutstream_s *rthis = (FAR struct lib_rawoutstream_s *)this;
+	ssize_t nwritten;
+
+	DEBUGASSERT(this && rthis->fd >= 0);
+
+	/* Loop until all characters are transferred or until an irrecoverable
+	 * error occurs.  A short write is continued with the rest.
+	 */
+
+	while (len > 0) {
+		nwritten = write(rthis->fd, buf, len);
+		if (nwritten > 0) {
+			this->nput += nwritten;
+			buf += nwritten;
+			len -= nwritten;
+		} else if (nwritten == 0 || get_errno() != EINTR) {
+			break;
+		}
+	}
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -122,6 +149,7 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_rawoutstream(FAR struct lib_rawoutstream_s *outstream, int fd)
 {
 	outstream->public.put = rawoutstream_putc;
+	outstream->public.write = rawoutstream_write;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	outstream->public.flush = lib_noflush;
 #endif
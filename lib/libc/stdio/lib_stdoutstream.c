@@ -57,6 +57,7 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
 
 #include "lib_internal.h"
 
@@ -92,6 +93,42 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 	} while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_write
+ ****************************************************************************/
+
+static void stdoutstream_write(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len)
+{
+	FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+	FAR const char *start = buf;
+	ssize_t nwritten;
+
+	DEBUGASSERT(this && sthis->stream);
+
+	/* Loop until all characters are transferred or an irrecoverable error
+	 * occurs, as stdoutstream_putc() does.
+	 */
+
+	while (len > 0) {
+		nwritten = lib_fwrite(buf, len, sthis->stream);
+		if (nwritten > 0) {
+			this->nput += nwritten;
+			buf += nwritten;
+			len -= nwritten;
+		} else if (nwritten == 0 || get_errno() != EINTR) {
+			break;
+		}
+	}
+
+#ifdef CONFIG_STDIO_LINEBUFFER
+	/* fputc() flushes the stream when a newline is output */
+
+	if (memchr(start, '\n', buf - start) != NULL) {
+		(void)lib_fflush(sthis->stream, true);
+	}
+#endif
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -130,6 +167,7 @@ void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream, FAR FILE *stream
 	/* Select the put operation */
 
 	outstream->public.put = stdoutstream_putc;
+	outstream->public.write = stdoutstream_write;
 
 	/* Select the correct flush operation.  This flush is only called when
 	 * a newline is encountered in the output stream.  However, we do not
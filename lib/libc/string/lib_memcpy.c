@@ -62,6 +62,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -75,6 +77,77 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
 	FAR unsigned char *pout = (FAR unsigned char *)dest;
 	FAR unsigned char *pin = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+	/* Merging misaligned words costs more per word, so short copies of
+	 * them are left to the byte loop.
+	 */
+
+	if (n >= 2 * LIB_WORD_SIZE && (LIB_WORD_ALIGNED((uintptr_t)pout ^ (uintptr_t)pin) || n >= 4 * LIB_WORD_SIZE)) {
+		FAR lib_word_t *wout;
+		FAR const lib_word_t *win;
+
+		/* Align the destination to a word boundary */
+
+		while (!LIB_WORD_ALIGNED(pout)) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR lib_word_t *)pout;
+
+		if (LIB_WORD_ALIGNED(pin)) {
+			win = (FAR const lib_word_t *)pin;
+
+			while (n >= 4 * LIB_WORD_SIZE) {
+				wout[0] = win[0];
+				wout[1] = win[1];
+				wout[2] = win[2];
+				wout[3] = win[3];
+				wout += 4;
+				win += 4;
+				n -= 4 * LIB_WORD_SIZE;
+			}
+
+			while (n >= LIB_WORD_SIZE) {
+				*wout++ = *win++;
+				n -= LIB_WORD_SIZE;
+			}
+
+			pin = (FAR unsigned char *)win;
+		} else {
+			/* The source is not aligned: read aligned words and merge
+			 * each two of them.  Every word read holds at least one byte
+			 * of the source, so no other page or MPU region is touched.
+			 */
+
+			unsigned int offset = (uintptr_t)pin & LIB_WORD_MASK;
+			unsigned int lshift = 8 * offset;
+			unsigned int rshift = 8 * (LIB_WORD_SIZE - offset);
+			lib_word_t w0;
+			lib_word_t w1;
+
+			win = (FAR const lib_word_t *)(pin - offset);
+			w0 = *win++;
+
+			while (n >= LIB_WORD_SIZE) {
+				w1 = *win++;
+#ifdef CONFIG_ENDIAN_BIG
+				*wout++ = (w0 << lshift) | (w1 >> rshift);
+#else
+				*wout++ = (w0 >> lshift) | (w1 << rshift);
+#endif
+				w0 = w1;
+				n -= LIB_WORD_SIZE;
+			}
+
+			pin = (FAR unsigned char *)win - LIB_WORD_SIZE + offset;
+		}
+
+		pout = (FAR unsigned char *)wout;
+	}
+#endif
+
 	while (n-- > 0) {
 		*pout++ = *pin++;
 	}
@@ -82,14 +82,14 @@
 #ifndef CONFIG_ARCH_MEMSET
 void *memset(void *s, int c, size_t n)
 {
-#ifdef CONFIG_MEMSET_OPTSPEED
+#if defined(CONFIG_MEMSET_OPTSPEED) || defined(CONFIG_LIBC_STRING_OPTSPEED)
 	/* This version is optimized for speed (you could do better
 	 * still by exploiting processor caching or memory burst
 	 * knowledge.)
 	 */
 
 	uintptr_t addr = (uintptr_t)s;
-	uint16_t val16 = ((uint16_t)c << 8) | (uint16_t)c;
+	uint16_t val16 = ((uint16_t)(uint8_t)c << 8) | (uint16_t)(uint8_t)c;
 	uint32_t val32 = ((uint32_t)val16 << 16) | (uint32_t)val16;
 #ifdef CONFIG_MEMSET_64BIT
 	uint64_t val64 = ((uint64_t)val32 << 32) | (uint64_t)val32;
@@ -119,7 +119,18 @@ void *memset(void *s, int c, size_t n)
 				n -= 2;
 			}
 #ifndef CONFIG_MEMSET_64BIT
-			/* Loop while there are at least 32-bits left to be written */
+			/* Loop while there are at least 32-bits left to be written,
+			 * four words at a time first.
+			 */
+
+			while (n >= 16) {
+				((uint32_t *)addr)[0] = val32;
+				((uint32_t *)addr)[1] = val32;
+				((uint32_t *)addr)[2] = val32;
+				((uint32_t *)addr)[3] = val32;
+				addr += 16;
+				n -= 16;
+			}
 
 			while (n >= 4) {
 				*(uint32_t *)addr = val32;
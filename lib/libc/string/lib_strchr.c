@@ -58,6 +58,8 @@
 
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -79,9 +81,31 @@
 #ifndef CONFIG_ARCH_STRCHR
 FAR char *strchr(FAR const char *s, int c)
 {
+	char ch = (char)c;
+
 	if (s) {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+		FAR const lib_word_t *w;
+		lib_word_t mask = LIB_WORD_ONES * (unsigned char)ch;
+
+		for (; !LIB_WORD_ALIGNED(s); s++) {
+			if (*s == ch) {
+				return (FAR char *)s;
+			}
+
+			if (!*s) {
+				return NULL;
+			}
+		}
+
+		/* Skip the words which hold neither the terminator nor 'c' */
+
+		for (w = (FAR const lib_word_t *)s; !LIB_WORD_HASZERO(*w) && !LIB_WORD_HASZERO(*w ^ mask); w++);
+		s = (FAR const char *)w;
+#endif
+
 		for (;; s++) {
-			if (*s == c) {
+			if (*s == ch) {
 				return (FAR char *)s;
 			}
 
@@ -58,6 +58,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -66,7 +68,23 @@
 size_t strlen(const char *s)
 {
 	const char *sc;
-	for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+	FAR const lib_word_t *w;
+
+	for (sc = s; !LIB_WORD_ALIGNED(sc); ++sc) {
+		if (*sc == '\0') {
+			return sc - s;
+		}
+	}
+
+	for (w = (FAR const lib_word_t *)sc; !LIB_WORD_HASZERO(*w); ++w);
+	sc = (const char *)w;
+#else
+	sc = s;
+#endif
+
+	for (; *sc != '\0'; ++sc);
 	return sc - s;
 }
 #endif
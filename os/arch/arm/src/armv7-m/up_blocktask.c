@@ -157,6 +157,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 
 			/* Then switch contexts */
 
@@ -174,6 +177,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(nexttcb);
 #endif
 			up_switchcontext(rtcb->xcp.regs, nexttcb->xcp.regs);
 
@@ -125,6 +125,9 @@ void up_release_pending(void)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
 #endif
 			/* Then switch contexts */
 
@@ -142,6 +145,9 @@ void up_release_pending(void)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(nexttcb);
 #endif
 			up_switchcontext(rtcb->xcp.regs, nexttcb->xcp.regs);
 
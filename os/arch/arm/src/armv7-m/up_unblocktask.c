@@ -148,6 +148,9 @@ void up_unblock_task(struct tcb_s *tcb)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 
 			/* Then switch contexts */
 
@@ -165,6 +168,9 @@ void up_unblock_task(struct tcb_s *tcb)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(nexttcb);
 #endif
 			up_switchcontext(rtcb->xcp.regs, nexttcb->xcp.regs);
 
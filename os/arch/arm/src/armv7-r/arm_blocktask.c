@@ -147,6 +147,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 
 			/* Then switch contexts. */
 			up_restorestate(rtcb->xcp.regs);
@@ -168,6 +171,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 
 			/* Then switch contexts */
 			up_fullcontextrestore(rtcb->xcp.regs);
@@ -167,6 +167,9 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 				/* Save the task name which will be scheduled */
 				save_task_scheduling_status(rtcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+				sched_taskstats_switch(rtcb);
 #endif
 				up_restorestate(rtcb->xcp.regs);
 			}
@@ -187,6 +190,9 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 #ifdef CONFIG_TASK_SCHED_HISTORY
 				/* Save the task name which will be scheduled */
 				save_task_scheduling_status(rtcb);
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+				sched_taskstats_switch(rtcb);
 #endif
 				up_fullcontextrestore(rtcb->xcp.regs);
 			}
@@ -191,6 +191,9 @@ void _exit(int status)
 	/*Save the task name which will be scheduled */
 	save_task_scheduling_status(tcb);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+	sched_taskstats_switch(tcb);
+#endif
 
 	/* Then switch contexts */
 
@@ -146,6 +146,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			 * changes will be made when the interrupt returns.
 			 */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_restorestate(rtcb->xcp.regs);
 		}
 
@@ -189,6 +192,9 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 
 			/* Then switch contexts */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_context_restore(rtcb->xcp.regs);
 		}
 	}
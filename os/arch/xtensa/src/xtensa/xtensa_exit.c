@@ -204,6 +204,9 @@ void _exit(int status)
 
 	/* Then switch contexts */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+	sched_taskstats_switch(tcb);
+#endif
 	xtensa_context_restore(tcb->xcp.regs);
 
 	/* xtensa_full_context_restore() should not return but could if the software
@@ -117,6 +117,9 @@ void up_release_pending(void)
 			 * changes will be made when the interrupt returns.
 			 */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_restorestate(rtcb->xcp.regs);
 		}
 
@@ -158,6 +161,9 @@ void up_release_pending(void)
 
 			/* Then switch contexts */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_context_restore(rtcb->xcp.regs);
 		}
 	}
@@ -161,6 +161,9 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 				 * changes will be made when the interrupt returns.
 				 */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+				sched_taskstats_switch(rtcb);
+#endif
 				xtensa_restorestate(rtcb->xcp.regs);
 			}
 
@@ -201,6 +204,9 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 
 				/* Then switch contexts */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+				sched_taskstats_switch(rtcb);
+#endif
 				xtensa_context_restore(rtcb->xcp.regs);
 			}
 		}
@@ -135,6 +135,9 @@ void up_unblock_task(struct tcb_s *tcb)
 			 * changes will be made when the interrupt returns.
 			 */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_restorestate(rtcb->xcp.regs);
 		}
 
@@ -182,6 +185,9 @@ void up_unblock_task(struct tcb_s *tcb)
 
 			/* Then switch contexts */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+			sched_taskstats_switch(rtcb);
+#endif
 			xtensa_context_restore(rtcb->xcp.regs);
 
 		}
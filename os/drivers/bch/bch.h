@@ -69,20 +69,55 @@
 #define bchlib_semgive(d)	sem_post(&(d)->sem)	/* To match bchlib_semtake */
 #define MAX_OPENCNT			(255)				/* Limit of uint8_t */
 
+#ifndef CONFIG_BCH_NSECTORS
+#define CONFIG_BCH_NSECTORS	1
+#endif
+
+#ifndef CONFIG_BCH_READAHEAD
+#define CONFIG_BCH_READAHEAD	0
+#endif
+
+#if CONFIG_BCH_NSECTORS < 1
+#error "CONFIG_BCH_NSECTORS must be at least 1"
+#endif
+
+/* The sector read and the sectors read ahead must fit in the cache */
+
+#if CONFIG_BCH_READAHEAD >= CONFIG_BCH_NSECTORS
+#error "CONFIG_BCH_READAHEAD must be less than CONFIG_BCH_NSECTORS"
+#endif
+
+#define BCH_NOSECTOR		((size_t)-1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
+/* One sector of the cache.  The buffers of the sectors are consecutive in
+ * memory, so that consecutive device sectors held in consecutive cache
+ * sectors can be read and written with one request to the block driver.
+ */
+
+struct bch_sector_s {
+	size_t sector;				/* The device sector in the buffer or BCH_NOSECTOR */
+	uint32_t stamp;				/* Time of the last access, for LRU replacement */
+	bool dirty;					/* true: Data has been written to the buffer */
+	FAR uint8_t *buffer;		/* One sector buffer */
+};
+
 struct bchlib_s {
 	FAR struct inode *inode;	/* I-node of the block driver */
 	uint32_t sectsize;			/* The size of one sector on the device */
 	size_t nsectors;			/* Number of sectors supported by the device */
-	size_t sector;				/* The current sector in the buffer */
+	size_t nextsector;			/* The sector after the last one accessed */
 	sem_t sem;					/* For atomic accesses to this structure */
 	uint8_t refs;				/* Number of references */
-	bool dirty;					/* true: Data has been written to the buffer */
 	bool readonly;				/* true: Only read operations are supported */
 	bool unlinked;				/* true: The driver has been unlinked */
-	FAR uint8_t *buffer;		/* One sector buffer */
+	uint32_t stamp;				/* Incremented by each access to the cache */
+	FAR uint8_t *buffer;		/* Buffers of all of the cached sectors */
+	FAR struct bch_sector_s *current;	/* The sector last read by bchlib_readsector() */
+	struct bch_sector_s cache[CONFIG_BCH_NSECTORS];
+	struct bchstats_s stats;	/* Cache statistics */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
 	uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];	/* Encryption key */
@@ -108,6 +143,8 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector, size_t nsectors);
+EXTERN void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector, size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
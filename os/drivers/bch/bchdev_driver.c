@@ -331,6 +331,25 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 		bchlib_semgive(bch);
 	}
+	/* Is this a request to get the cache statistics? */
+	else if (cmd == DIOC_GETSTATS) {
+		FAR struct bchstats_s *stats = (FAR struct bchstats_s *)((uintptr_t)arg);
+
+		if (!stats) {
+			ret = -EINVAL;
+		} else {
+			bchlib_semtake(bch);
+			memcpy(stats, &bch->stats, sizeof(struct bchstats_s));
+			bchlib_semgive(bch);
+			ret = OK;
+		}
+	}
+	/* Is this a request to write the cached sectors to the media? */
+	else if (cmd == DIOC_FLUSH) {
+		bchlib_semtake(bch);
+		ret = bchlib_flushsector(bch);
+		bchlib_semgive(bch);
+	}
 #ifdef CONFIG_BCH_ENCRYPTION
 	/* Is this a request to set the encryption key? */
 	else if (cmd == DIOC_SETKEY) {
@@ -344,7 +363,18 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 		/* Does the block driver support the ioctl method? */
 		if (bchinode->u.i_bops->ioctl != NULL) {
-			ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+			/*
+			 * The command may change the media (e.g. an erase), so write
+			 * back and forget the cached sectors first.
+			 */
+			bchlib_semtake(bch);
+			ret = bchlib_flushsector(bch);
+			if (ret >= 0) {
+				bchlib_invalidate(bch, 0, bch->nsectors);
+				ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+			}
+
+			bchlib_semgive(bch);
 		}
 	}
 
@@ -88,16 +88,16 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  * Name: bch_cypher
  ****************************************************************************/
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR struct bch_sector_s *cache, int encrypt)
 {
 	int blocks = bch->sectsize / 16;
-	FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+	FAR uint32_t *buffer = (FAR uint32_t *)cache->buffer;
 	int i;
 
 	for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t)) {
 		uint32_t T[4];
 		uint32_t X[4] = {
-			bch->sector, 0, 0, i
+			cache->sector, 0, 0, i
 		};
 
 		aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -115,61 +115,286 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Name: bchlib_findsector
+ *
+ * Description:
+ *   Return the cache sector holding 'sector' or NULL if it is not cached
+ *
  ****************************************************************************/
+static FAR struct bch_sector_s *bchlib_findsector(FAR struct bchlib_s *bch, size_t sector)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_NSECTORS; i++) {
+		if (bch->cache[i].sector == sector) {
+			return &bch->cache[i];
+		}
+	}
+
+	return NULL;
+}
+
 /****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bchlib_victim
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Select the cache sector to be replaced: an unused one if there is one,
+ *   otherwise the least recently used one.
  *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ ****************************************************************************/
+static FAR struct bch_sector_s *bchlib_victim(FAR struct bchlib_s *bch)
+{
+	FAR struct bch_sector_s *victim = &bch->cache[0];
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_NSECTORS; i++) {
+		if (bch->cache[i].sector == BCH_NOSECTOR) {
+			return &bch->cache[i];
+		}
+
+		if ((int32_t)(bch->cache[i].stamp - victim->stamp) < 0) {
+			victim = &bch->cache[i];
+		}
+	}
+
+	return victim;
+}
+
+/****************************************************************************
+ * Name: bchlib_flushcache
+ *
+ * Description:
+ *   Write a cache sector to the media if it is dirty.  Dirty neighbours
+ *   holding the adjacent device sectors are written with it, so that
+ *   sequential writes reach the block driver in as few requests as
+ *   possible.
  *
  ****************************************************************************/
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+static int bchlib_flushcache(FAR struct bchlib_s *bch, FAR struct bch_sector_s *cache)
 {
-	FAR struct inode *inode;
-	ssize_t ret = OK;
+	FAR struct inode *inode = bch->inode;
+	FAR struct bch_sector_s *first = cache;
+	FAR struct bch_sector_s *last = cache;
+	FAR struct bch_sector_s *end = &bch->cache[CONFIG_BCH_NSECTORS];
+	FAR struct bch_sector_s *tmp;
+	ssize_t ret;
+
+	if (!cache->dirty) {
+		return OK;
+	}
+
+	while (first > bch->cache && first[-1].dirty && first[-1].sector == first->sector - 1) {
+		first--;
+	}
 
+	while (last + 1 < end && last[1].dirty && last[1].sector == last->sector + 1) {
+		last++;
+	}
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+	/* Encrypt data as necessary */
+	for (tmp = first; tmp <= last; tmp++) {
+		bch_cypher(bch, tmp, CYPHER_ENCRYPT);
+	}
+#endif
+
+	/* Write the sectors to the media */
+	ret = inode->u.i_bops->write(inode, first->buffer, first->sector, last - first + 1);
+	bch->stats.devwrites++;
+
+#if defined(CONFIG_BCH_ENCRYPTION)
 	/*
-	 * Check if the sector has been modified and is out of sync with the
-	 * media.
+	 * Computation overhead to save memory for extra sector buffer
+	 * TODO: Add configuration switch for extra sector buffer
 	 */
-	if (bch->dirty) {
-		inode = bch->inode;
+	for (tmp = first; tmp <= last; tmp++) {
+		bch_cypher(bch, tmp, CYPHER_DECRYPT);
+	}
+#endif
+
+	if (ret < 0) {
+		fdbg("Write failed: %d\n", ret);
+		return (int)ret;
+	}
+
+	/* The sectors are now in sync with the media */
+	for (tmp = first; tmp <= last; tmp++) {
+		tmp->dirty = false;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_fill
+ *
+ * Description:
+ *   Read 'nsectors' device sectors from 'sector' into consecutive cache
+ *   sectors beginning with 'cache', which must not be dirty.
+ *
+ ****************************************************************************/
+static int bchlib_fill(FAR struct bchlib_s *bch, FAR struct bch_sector_s *cache, size_t sector, size_t nsectors)
+{
+	FAR struct inode *inode = bch->inode;
+	ssize_t ret;
+	size_t i;
+
+	for (i = 0; i < nsectors; i++) {
+		cache[i].sector = BCH_NOSECTOR;
+	}
 
+	ret = inode->u.i_bops->read(inode, cache->buffer, sector, nsectors);
+	bch->stats.devreads++;
+	if (ret < 0) {
+		fdbg("Read failed: %d\n", ret);
+		return (int)ret;
+	}
+
+	for (i = 0; i < nsectors; i++) {
+		cache[i].sector = sector + i;
+		cache[i].stamp = ++bch->stamp;
 #if defined(CONFIG_BCH_ENCRYPTION)
-		/* Encrypt data as necessary */
-		bch_cypher(bch, CYPHER_ENCRYPT);
+		bch_cypher(bch, &cache[i], CYPHER_DECRYPT);
 #endif
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_readahead
+ *
+ * Description:
+ *   Read 'sector' together with up to CONFIG_BCH_READAHEAD of the sectors
+ *   following it.  They replace a group of consecutive cache sectors
+ *   around the least recently used one.
+ *
+ ****************************************************************************/
+#if CONFIG_BCH_READAHEAD > 0
+static FAR struct bch_sector_s *bchlib_readahead(FAR struct bchlib_s *bch, size_t sector, FAR int *result)
+{
+	FAR struct bch_sector_s *first;
+	size_t nsectors;
+	int ret;
+	int i;
 
-		/* Write the sector to the media */
-		ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+	first = bchlib_victim(bch);
+	if (first > &bch->cache[CONFIG_BCH_NSECTORS - 1 - CONFIG_BCH_READAHEAD]) {
+		first = &bch->cache[CONFIG_BCH_NSECTORS - 1 - CONFIG_BCH_READAHEAD];
+	}
+
+	for (i = 0; i <= CONFIG_BCH_READAHEAD; i++) {
+		ret = bchlib_flushcache(bch, &first[i]);
 		if (ret < 0) {
-			fdbg("Write failed: %d\n");
+			*result = ret;
+			return NULL;
 		}
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-		/*
-		 * Computation overhead to save memory for extra sector buffer
-		 * TODO: Add configuration switch for extra sector buffer
-		 */
-		bch_cypher(bch, CYPHER_DECRYPT);
+		first[i].sector = BCH_NOSECTOR;
+	}
+
+	/* Stop before the end of the device or a sector that is cached already */
+	for (nsectors = 1; nsectors <= CONFIG_BCH_READAHEAD; nsectors++) {
+		if (sector + nsectors >= bch->nsectors || bchlib_findsector(bch, sector + nsectors)) {
+			break;
+		}
+	}
+
+	ret = bchlib_fill(bch, first, sector, nsectors);
+	if (ret < 0) {
+		*result = ret;
+		return NULL;
+	}
+
+	bch->stats.readahead += nsectors - 1;
+	*result = OK;
+	return first;
+}
 #endif
 
-		/* The sector is now in sync with the media */
-		bch->dirty = false;
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush all of the dirty sectors in the cache to the media
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+	return bchlib_flushrange(bch, 0, bch->nsectors);
+}
+
+/****************************************************************************
+ * Name: bchlib_flushrange
+ *
+ * Description:
+ *   Flush the dirty cached sectors from 'sector' to 'sector + nsectors - 1'
+ *   to the media.  This must precede a read of those sectors that bypasses
+ *   the cache.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+int bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector, size_t nsectors)
+{
+	FAR struct bch_sector_s *cache;
+	int result = OK;
+	int ret;
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_NSECTORS; i++) {
+		cache = &bch->cache[i];
+		if (cache->dirty && cache->sector >= sector && cache->sector - sector < nsectors) {
+			ret = bchlib_flushcache(bch, cache);
+			if (ret < 0 && result == OK) {
+				result = ret;
+			}
+		}
 	}
 
-	return (int)ret;
+	return result;
+}
+
+/****************************************************************************
+ * Name: bchlib_invalidate
+ *
+ * Description:
+ *   Forget the cached sectors from 'sector' to 'sector + nsectors - 1',
+ *   dirty or not.  This must precede a write of those sectors that
+ *   bypasses the cache.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector, size_t nsectors)
+{
+	FAR struct bch_sector_s *cache;
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_NSECTORS; i++) {
+		cache = &bch->cache[i];
+		if (cache->sector != BCH_NOSECTOR && cache->sector >= sector && cache->sector - sector < nsectors) {
+			cache->sector = BCH_NOSECTOR;
+			cache->dirty = false;
+		}
+	}
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make 'sector' the current sector (bch->current), reading it into the
+ *   cache if it is not cached already.  When the sector before it was just
+ *   accessed or is still cached, the sectors that follow are read ahead.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -177,24 +402,42 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
  ****************************************************************************/
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
-	FAR struct inode *inode;
-	ssize_t ret = OK;
+	FAR struct bch_sector_s *cache;
+	int ret = OK;
 
-	if (bch->sector != sector) {
-		inode = bch->inode;
+	cache = bchlib_findsector(bch, sector);
+	if (cache) {
+		bch->stats.hits++;
+		cache->stamp = ++bch->stamp;
+	} else {
+		bch->stats.misses++;
 
-		(void)bchlib_flushsector(bch);
-		bch->sector = (size_t)-1;
+#if CONFIG_BCH_READAHEAD > 0
+		/* A sector following the last one accessed or a cached one
+		 * continues a sequential stream, even if accesses to other
+		 * sectors (e.g. file system metadata) come in between.
+		 */
+		if (sector == bch->nextsector || (sector > 0 && bchlib_findsector(bch, sector - 1))) {
+			cache = bchlib_readahead(bch, sector, &ret);
+		} else
+#endif
+		{
+			cache = bchlib_victim(bch);
+			ret = bchlib_flushcache(bch, cache);
+			if (ret == OK) {
+				ret = bchlib_fill(bch, cache, sector, 1);
+			}
+		}
 
-		ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
 		if (ret < 0) {
-			fdbg("Read failed: %d\n");
+			return ret;
 		}
-		bch->sector = sector;
-#if defined(CONFIG_BCH_ENCRYPTION)
-		bch_cypher(bch, CYPHER_DECRYPT);
-#endif
+
+		/* The sector asked for is the most recently used */
+		cache->stamp = ++bch->stamp;
 	}
-	return (int)ret;
-}
 
+	bch->current = cache;
+	bch->nextsector = sector + 1;
+	return OK;
+}
@@ -121,7 +121,10 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 	bytesread = 0;
 	if (sectoffset > 0) {
 		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		ret = bchlib_readsector(bch, sector);
+		if (ret < 0) {
+			return ret;
+		}
 
 		/* Copy the tail end of the sector to the user buffer */
 		if (sectoffset + len > bch->sectsize) {
@@ -130,7 +133,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nbytes = len;
 		}
 
-		memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+		memcpy(buffer, &bch->current->buffer[sectoffset], nbytes);
 
 		/* Adjust pointers and counts */
 		sector++;
@@ -154,8 +157,15 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nsectors = bch->nsectors - sector;
 		}
 
+		/* Cached sectors may be newer than the media */
+		ret = bchlib_flushrange(bch, sector, nsectors);
+		if (ret < 0) {
+			return ret;
+		}
+
 		ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
 						sector, nsectors);
+		bch->stats.devreads++;
 		if (ret < 0) {
 			fdbg("ERROR: Read failed: %d\n");
 			return ret;
@@ -177,10 +187,13 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 	/* Then read any partial final sector */
 	if (len > 0) {
 		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		ret = bchlib_readsector(bch, sector);
+		if (ret < 0) {
+			return ret;
+		}
 
 		/* Copy the head end of the sector to the user buffer */
-		memcpy(buffer, bch->buffer, len);
+		memcpy(buffer, bch->current->buffer, len);
 
 		/* Adjust counts */
 		bytesread += len;
@@ -385,6 +385,8 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 	FAR uint8_t *start = (uint8_t *)buffer;
 #endif
 	ssize_t nread = 0;
+	size_t nbytes;
+	size_t ndx;
 	int sval;
 	int ret;
 
@@ -432,12 +434,27 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 	/* Then return whatever is available in the pipe (which is at least one byte) */
 
 	nread = 0;
-	while (nread < len && dev->d_wrndx != dev->d_rdndx) {
-		*buffer++ = dev->d_buffer[dev->d_rdndx];
-		if (++dev->d_rdndx >= CONFIG_DEV_PIPE_SIZE) {
-			dev->d_rdndx = 0;
+	while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx) {
+		/* Copy the contiguous data up to the write index or to the end of
+		 * the buffer.  A wrapped buffer takes a second pass.
+		 */
+
+		if (dev->d_wrndx > dev->d_rdndx) {
+			nbytes = dev->d_wrndx - dev->d_rdndx;
+		} else {
+			nbytes = CONFIG_DEV_PIPE_SIZE - dev->d_rdndx;
 		}
-		nread++;
+
+		if (nbytes > len - nread) {
+			nbytes = len - nread;
+		}
+
+		memcpy(buffer, &dev->d_buffer[dev->d_rdndx], nbytes);
+		buffer += nbytes;
+		nread += nbytes;
+
+		ndx = dev->d_rdndx + nbytes;
+		dev->d_rdndx = ndx >= CONFIG_DEV_PIPE_SIZE ? 0 : ndx;
 	}
 
 	/* Notify all waiting writers that bytes have been removed from the buffer */
@@ -465,7 +482,8 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 	struct pipe_dev_s *dev = inode->i_private;
 	ssize_t nwritten = 0;
 	ssize_t last;
-	int nxtwrndx;
+	size_t nbytes;
+	size_t ndx;
 	int sval;
 
 	DEBUGASSERT(dev);
@@ -498,24 +516,39 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 
 	last = 0;
 	for (;;) {
-		/* Calculate the write index AFTER the next byte is written */
+		/* Calculate the contiguous space from the write index.  One byte is
+		 * always left free so that a full buffer differs from an empty one.
+		 */
 
-		nxtwrndx = dev->d_wrndx + 1;
-		if (nxtwrndx >= CONFIG_DEV_PIPE_SIZE) {
-			nxtwrndx = 0;
+		if (dev->d_rdndx > dev->d_wrndx) {
+			nbytes = dev->d_rdndx - dev->d_wrndx - 1;
+		} else if (dev->d_rdndx == 0) {
+			nbytes = CONFIG_DEV_PIPE_SIZE - dev->d_wrndx - 1;
+		} else {
+			nbytes = CONFIG_DEV_PIPE_SIZE - dev->d_wrndx;
 		}
 
 		/* Would the next write overflow the circular buffer? */
 
-		if (nxtwrndx != dev->d_rdndx) {
-			/* No... copy the byte */
+		if (nbytes > 0) {
+			/* No... copy as much as fits.  A wrapped buffer takes a second
+			 * pass.
+			 */
+
+			if (nbytes > len - nwritten) {
+				nbytes = len - nwritten;
+			}
+
+			memcpy(&dev->d_buffer[dev->d_wrndx], buffer, nbytes);
+			buffer += nbytes;
+			nwritten += nbytes;
 
-			dev->d_buffer[dev->d_wrndx] = *buffer++;
-			dev->d_wrndx = nxtwrndx;
+			ndx = dev->d_wrndx + nbytes;
+			dev->d_wrndx = ndx >= CONFIG_DEV_PIPE_SIZE ? 0 : ndx;
 
 			/* Is the write complete? */
 
-			if (++nwritten >= len) {
+			if ((size_t)nwritten >= len) {
 				/* Yes.. Notify all of the waiting readers that more data is available */
 
 				while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
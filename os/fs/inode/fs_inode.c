@@ -56,6 +56,9 @@
 
 #include <tinyara/config.h>
 
+#include <stdbool.h>
+#include <unistd.h>
+#include <sched.h>
 #include <assert.h>
 #include <semaphore.h>
 #include <errno.h>
@@ -86,6 +89,9 @@ struct inode_sem_s {
 	sem_t sem;					/* The semaphore */
 	pid_t holder;				/* The current holder of the semaphore */
 	int16_t count;				/* Number of counts held */
+	int16_t nshared;			/* Number of tasks with shared access */
+	bool drainwait;				/* The holder waits for shared access to end */
+	sem_t drain;				/* Posted when the last shared access ends */
 };
 
 /****************************************************************************
@@ -191,6 +197,15 @@ void inode_initialize(void)
 	g_inode_sem.holder = NO_HOLDER;
 	g_inode_sem.count = 0;
 
+	/* The drain semaphore is posted by the last task that gives up its
+	 * shared access.  It keeps the default priority inheritance like the
+	 * other inode locks.
+	 */
+
+	(void)sem_init(&g_inode_sem.drain, 0, 0);
+	g_inode_sem.nshared = 0;
+	g_inode_sem.drainwait = false;
+
 	/* Initialize files array (if it is used) */
 
 #ifdef CONFIG_HAVE_WEAKFUNCTIONS
@@ -238,6 +253,20 @@ void inode_semtake(void)
 
 		g_inode_sem.holder = me;
 		g_inode_sem.count = 1;
+
+		/* No new shared access can begin now, but wait for the tasks that
+		 * already have it to finish.
+		 */
+
+		sched_lock();
+		while (g_inode_sem.nshared > 0) {
+			g_inode_sem.drainwait = true;
+			while (sem_wait(&g_inode_sem.drain) != 0) {
+				ASSERT(get_errno() == EINTR);
+			}
+		}
+
+		sched_unlock();
 	}
 }
 
@@ -270,6 +299,68 @@ void inode_semgive(void)
 	}
 }
 
+/****************************************************************************
+ * Name: inode_semtake_shared
+ *
+ * Description:
+ *   Get access to the in-memory inode tree that is shared with other tasks
+ *   that only look up nodes.
+ *
+ ****************************************************************************/
+
+void inode_semtake_shared(void)
+{
+	/* If we have exclusive access, this is just one more count of it */
+
+	if (getpid() == g_inode_sem.holder) {
+		g_inode_sem.count++;
+		DEBUGASSERT(g_inode_sem.count > 0);
+		return;
+	}
+
+	/* Pass through the semaphore, so that we wait for any task with
+	 * exclusive access, and a task waiting for exclusive access is not
+	 * starved by a stream of tasks with shared access.
+	 */
+
+	while (sem_wait(&g_inode_sem.sem) != 0) {
+		ASSERT(get_errno() == EINTR);
+	}
+
+	sched_lock();
+	g_inode_sem.nshared++;
+	sched_unlock();
+
+	sem_post(&g_inode_sem.sem);
+}
+
+/****************************************************************************
+ * Name: inode_semgive_shared
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+void inode_semgive_shared(void)
+{
+	if (getpid() == g_inode_sem.holder) {
+		inode_semgive();
+		return;
+	}
+
+	/* Wake up the task waiting for exclusive access if we were the last */
+
+	sched_lock();
+	DEBUGASSERT(g_inode_sem.nshared > 0);
+	if (--g_inode_sem.nshared == 0 && g_inode_sem.drainwait) {
+		g_inode_sem.drainwait = false;
+		sem_post(&g_inode_sem.drain);
+	}
+
+	sched_unlock();
+}
+
 /****************************************************************************
  * Name: inode_search
  *
@@ -289,6 +380,51 @@ FAR struct inode *inode_search(FAR const char **path, FAR struct inode **peer, F
 	FAR struct inode *left = NULL;
 	FAR struct inode *above = NULL;
 
+#if CONFIG_FS_INODE_PATHCACHE > 0
+	FAR const char *fullpath = *path;
+
+	if (!peer && !parent) {
+		node = inode_pcache_find(path, relpath);
+		if (node) {
+			return node;
+		}
+
+		node = root_inode;
+	}
+#endif
+
+#if CONFIG_FS_INODE_HASHSIZE > 0
+	/* Unless the caller needs the peer node to the left, which only the
+	 * sorted list of siblings can tell, look up each segment of the path
+	 * in the hash table.
+	 */
+
+	if (!peer) {
+		for (;;) {
+			node = inode_hashfind(above, name);
+			if (!node) {
+				break;
+			}
+
+			/* The same possibilities as for a match below */
+
+			name = inode_nextname(name);
+			if (!*name || INODE_IS_MOUNTPT(node)) {
+				if (relpath) {
+					*relpath = name;
+				}
+				break;
+			}
+
+			above = node;
+		}
+
+		/* Skip the walk of the sibling lists */
+
+		goto found;
+	}
+#endif
+
 	while (node) {
 		int result = _inode_compare(name, node);
 
@@ -359,6 +495,9 @@ FAR struct inode *inode_search(FAR const char **path, FAR struct inode **peer, F
 	 *   (4) When the node matching the full path is found
 	 */
 
+#if CONFIG_FS_INODE_HASHSIZE > 0
+found:
+#endif
 	if (peer) {
 		*peer = left;
 	}
@@ -367,6 +506,12 @@ FAR struct inode *inode_search(FAR const char **path, FAR struct inode **peer, F
 		*parent = above;
 	}
 
+#if CONFIG_FS_INODE_PATHCACHE > 0
+	if (node && !peer && !parent) {
+		inode_pcache_add(fullpath, name, node);
+	}
+#endif
+
 	*path = name;
 	return node;
 }
@@ -384,6 +529,7 @@ void inode_free(FAR struct inode *node)
 	if (node) {
 		inode_free(node->i_peer);
 		inode_free(node->i_child);
+		inode_hashdel(node);
 		kmm_free(node);
 	}
 }
@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <errno.h>
+#include <sched.h>
 #include <tinyara/fs/fs.h>
 
 #include "inode/inode.h"
@@ -99,15 +100,18 @@ FAR struct inode *inode_find(FAR const char *path, FAR const char **relpath)
 	}
 
 	/* Find the node matching the path.  If found, increment the count of
-	 * references on the node.
+	 * references on the node.  Other tasks may be looking up nodes at the
+	 * same time, so the count is updated with pre-emption disabled.
 	 */
 
-	inode_semtake();
+	inode_semtake_shared();
 	node = inode_search(&path, (FAR struct inode **)NULL, (FAR struct inode **)NULL, relpath);
 	if (node) {
+		sched_lock();
 		node->i_crefs++;
+		sched_unlock();
 	}
 
-	inode_semgive();
+	inode_semgive_shared();
 	return node;
 }
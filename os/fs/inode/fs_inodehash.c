@@ -0,0 +1,323 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ * Lookup accelerators for the pseudo-filesystem tree:
+ *
+ * - A hash table that finds a node from its parent and its name, so that
+ *   inode_search() need not walk the sorted list of siblings at each level
+ *   of the path.  Every node in the tree is in the table; the nodes of a
+ *   bucket are chained through i_hnext.
+ *
+ * - A small cache of recently looked up paths and the nodes that they
+ *   resolved to.  Any change to the shape of the tree flushes it.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+
+#include <tinyara/fs/fs.h>
+
+#include "inode/inode.h"
+
+#if CONFIG_FS_INODE_HASHSIZE > 0 || CONFIG_FS_INODE_PATHCACHE > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_HASHSIZE > 0 && (CONFIG_FS_INODE_HASHSIZE & (CONFIG_FS_INODE_HASHSIZE - 1)) != 0
+#error CONFIG_FS_INODE_HASHSIZE must be a power of two
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_PATHCACHE > 0
+struct inode_pcache_s {
+	FAR struct inode *node;		/* The node that the path refers to */
+	uint32_t gen;				/* Tree generation when cached (0: unused) */
+	uint8_t reloff;				/* Offset of the relative path in path */
+	char path[CONFIG_FS_INODE_PATHCACHE_NAMELEN];
+};
+#endif
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_HASHSIZE > 0
+static FAR struct inode *g_inode_hash[CONFIG_FS_INODE_HASHSIZE];
+#endif
+
+#if CONFIG_FS_INODE_PATHCACHE > 0
+static struct inode_pcache_s g_inode_pcache[CONFIG_FS_INODE_PATHCACHE];
+static uint32_t g_inode_gen = 1;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_strhash
+ *
+ * Description:
+ *   Hash a string up to its end or, if 'stop' is non-zero, up to the
+ *   first 'stop' character.  The length hashed is returned in 'len'.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_strhash(uint32_t hash, FAR const char *str, char stop, FAR int *len)
+{
+	FAR const char *ptr = str;
+
+	while (*ptr && *ptr != stop) {
+		hash = (hash ^ (uint8_t)*ptr++) * 16777619u;
+	}
+
+	*len = ptr - str;
+	return hash;
+}
+
+#if CONFIG_FS_INODE_HASHSIZE > 0
+static int inode_hashslot(FAR struct inode *parent, FAR const char *name, FAR int *len)
+{
+	uint32_t hash = 2166136261u ^ (uint32_t)((uintptr_t)parent >> 2);
+
+	hash = inode_strhash(hash, name, '/', len);
+	return (int)(hash & (CONFIG_FS_INODE_HASHSIZE - 1));
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_HASHSIZE > 0
+/****************************************************************************
+ * Name: inode_hashadd
+ *
+ * Description:
+ *   Enter a node that was just linked below 'parent' (NULL for the top
+ *   level) into the hash table.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore exclusively.
+ *
+ ****************************************************************************/
+
+void inode_hashadd(FAR struct inode *parent, FAR struct inode *node)
+{
+	int len;
+	int slot = inode_hashslot(parent, node->i_name, &len);
+
+	node->i_parent = parent;
+	node->i_hnext = g_inode_hash[slot];
+	g_inode_hash[slot] = node;
+
+	inode_pcache_flush();
+}
+
+/****************************************************************************
+ * Name: inode_hashdel
+ *
+ * Description:
+ *   Remove a node from the hash table.  Nothing is done if the node is not
+ *   in the table.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore exclusively.
+ *
+ ****************************************************************************/
+
+void inode_hashdel(FAR struct inode *node)
+{
+	FAR struct inode **link;
+	int len;
+
+	for (link = &g_inode_hash[inode_hashslot(node->i_parent, node->i_name, &len)]; *link; link = &(*link)->i_hnext) {
+		if (*link == node) {
+			*link = node->i_hnext;
+			node->i_hnext = NULL;
+			break;
+		}
+	}
+
+	inode_pcache_flush();
+}
+
+/****************************************************************************
+ * Name: inode_rehash
+ *
+ * Description:
+ *   Re-enter the children of 'parent' into the hash table after they were
+ *   moved there from another node.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore exclusively.
+ *
+ ****************************************************************************/
+
+void inode_rehash(FAR struct inode *parent)
+{
+	FAR struct inode *child;
+
+	for (child = parent->i_child; child; child = child->i_peer) {
+		inode_hashdel(child);
+		inode_hashadd(parent, child);
+	}
+}
+
+/****************************************************************************
+ * Name: inode_hashfind
+ *
+ * Description:
+ *   Find the child of 'parent' (NULL for the top level) whose name is the
+ *   first segment of 'name'.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore, shared or exclusively.
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_hashfind(FAR struct inode *parent, FAR const char *name)
+{
+	FAR struct inode *node;
+	int len;
+
+	for (node = g_inode_hash[inode_hashslot(parent, name, &len)]; node; node = node->i_hnext) {
+		if (node->i_parent == parent && strncmp(node->i_name, name, len) == 0 && node->i_name[len] == '\0') {
+			break;
+		}
+	}
+
+	return node;
+}
+#endif							/* CONFIG_FS_INODE_HASHSIZE > 0 */
+
+#if CONFIG_FS_INODE_PATHCACHE > 0
+/****************************************************************************
+ * Name: inode_pcache_flush
+ *
+ * Description:
+ *   Forget all cached paths.  This is called whenever a node is added to
+ *   or removed from the tree.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore exclusively.
+ *
+ ****************************************************************************/
+
+void inode_pcache_flush(void)
+{
+	/* Entries of older generations are stale.  On wrap-around, clear them
+	 * all so that none of them can match again.
+	 */
+
+	if (++g_inode_gen == 0) {
+		memset(g_inode_pcache, 0, sizeof(g_inode_pcache));
+		g_inode_gen = 1;
+	}
+}
+
+/****************************************************************************
+ * Name: inode_pcache_find
+ *
+ * Description:
+ *   Look up an absolute path in the cache.  On a hit, 'path' is advanced
+ *   and 'relpath' is set just as inode_search() would have done.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore, shared or exclusively.
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_pcache_find(FAR const char **path, FAR const char **relpath)
+{
+	FAR struct inode_pcache_s *entry;
+	FAR struct inode *node = NULL;
+	uint32_t hash;
+	int len;
+
+	hash = inode_strhash(2166136261u, *path, '\0', &len);
+	if (len >= CONFIG_FS_INODE_PATHCACHE_NAMELEN) {
+		return NULL;
+	}
+
+	/* Tasks sharing the inode semaphore may update the cache concurrently */
+
+	entry = &g_inode_pcache[hash % CONFIG_FS_INODE_PATHCACHE];
+
+	sched_lock();
+	if (entry->gen == g_inode_gen && memcmp(entry->path, *path, len + 1) == 0) {
+		node = entry->node;
+		*path += entry->reloff;
+		if (relpath) {
+			*relpath = *path;
+		}
+	}
+
+	sched_unlock();
+	return node;
+}
+
+/****************************************************************************
+ * Name: inode_pcache_add
+ *
+ * Description:
+ *   Remember that the absolute path 'path' resolved to 'node', with the
+ *   relative path (for a mountpoint) starting at 'relpath'.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore, shared or exclusively.
+ *
+ ****************************************************************************/
+
+void inode_pcache_add(FAR const char *path, FAR const char *relpath, FAR struct inode *node)
+{
+	FAR struct inode_pcache_s *entry;
+	uint32_t hash;
+	int len;
+
+	hash = inode_strhash(2166136261u, path, '\0', &len);
+	if (len >= CONFIG_FS_INODE_PATHCACHE_NAMELEN || relpath - path > UINT8_MAX) {
+		return;
+	}
+
+	entry = &g_inode_pcache[hash % CONFIG_FS_INODE_PATHCACHE];
+
+	sched_lock();
+	entry->node = node;
+	entry->gen = g_inode_gen;
+	entry->reloff = (uint8_t)(relpath - path);
+	memcpy(entry->path, path, len + 1);
+	sched_unlock();
+}
+#endif							/* CONFIG_FS_INODE_PATHCACHE > 0 */
+
+#endif							/* CONFIG_FS_INODE_HASHSIZE > 0 || CONFIG_FS_INODE_PATHCACHE > 0 */
@@ -56,7 +56,9 @@
 
 #include <tinyara/config.h>
 
+#include <stdbool.h>
 #include <errno.h>
+#include <sched.h>
 
 #include <tinyara/kmalloc.h>
 #include <tinyara/fs/fs.h>
@@ -93,25 +95,36 @@
 
 void inode_release(FAR struct inode *node)
 {
+	bool last;
+
 	if (node) {
-		/* Decrement the references of the inode */
+		/* Decrement the references of the inode.  This does not change the
+		 * tree, so shared access is enough, but other tasks with shared
+		 * access may update the count at the same time.
+		 */
 
-		inode_semtake();
+		inode_semtake_shared();
+		sched_lock();
 		if (node->i_crefs) {
 			node->i_crefs--;
 		}
 
 		/* If the subtree was previously deleted and the reference
 		 * count has decrement to zero,  then delete the inode
-		 * now.
+		 * now.  A deleted inode can no longer be found, so nobody else
+		 * can take a new reference to it.  Its children are still in the
+		 * lookup hash table, which needs exclusive access.
 		 */
 
-		if (node->i_crefs <= 0 && (node->i_flags & FSNODEFLAG_DELETED) != 0) {
-			inode_semgive();
+		last = (node->i_crefs <= 0 && (node->i_flags & FSNODEFLAG_DELETED) != 0);
+		sched_unlock();
+		inode_semgive_shared();
+
+		if (last) {
+			inode_semtake();
 			inode_free(node->i_child);
-			kmm_free(node);
-		} else {
 			inode_semgive();
+			kmm_free(node);
 		}
 	}
 }
@@ -136,6 +136,7 @@ FAR struct inode *inode_unlink(FAR const char *path)
 		}
 
 		node->i_peer = NULL;
+		inode_hashdel(node);
 	}
 
 	return node;
@@ -151,6 +151,10 @@ static void inode_insert(FAR struct inode *node, FAR struct inode *peer, FAR str
 		node->i_peer = root_inode;
 		root_inode = node;
 	}
+
+	/* Either way, the node can now be found below its parent */
+
+	inode_hashadd(parent, node);
 }
 
 /****************************************************************************
@@ -69,6 +69,15 @@
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
+
+#ifndef CONFIG_FS_INODE_HASHSIZE
+#define CONFIG_FS_INODE_HASHSIZE 0
+#endif
+
+#ifndef CONFIG_FS_INODE_PATHCACHE
+#define CONFIG_FS_INODE_PATHCACHE 0
+#endif
+
 /* Inode i_flag values */
 
 #define FSNODEFLAG_TYPE_MASK       0x00000007	/* Isolates type field        */
@@ -172,6 +181,29 @@ void inode_semtake(void);
 
 void inode_semgive(void);
 
+/****************************************************************************
+ * Name: inode_semtake_shared
+ *
+ * Description:
+ *   Get access to the in-memory inode tree that is shared with other tasks
+ *   that only look up nodes.  Tasks holding exclusive access are excluded.
+ *   The tree must not be changed and inode_semtake() must not be called
+ *   while this access is held.
+ *
+ ****************************************************************************/
+
+void inode_semtake_shared(void);
+
+/****************************************************************************
+ * Name: inode_semgive_shared
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+void inode_semgive_shared(void);
+
 /****************************************************************************
  * Name: inode_search
  *
@@ -179,8 +211,11 @@ void inode_semgive(void);
  *   Find the inode associated with 'path' returning the inode references
  *   and references to its companion nodes.
  *
+ *   If 'peer' and 'parent' are both NULL, the lookup may be answered from
+ *   the path cache.
+ *
  * Assumptions:
- *   The caller holds the tree_sem
+ *   The caller holds the tree_sem (shared or exclusively)
  *
  ****************************************************************************/
 
@@ -231,6 +266,47 @@ void inode_free(FAR struct inode *node);
 
 const char *inode_nextname(FAR const char *name);
 
+/* fs_inodehash.c ***********************************************************/
+/****************************************************************************
+ * Name: inode_hashadd, inode_hashdel, inode_rehash
+ *
+ * Description:
+ *   Keep the inode hash table in step with the tree: a node is added after
+ *   it is linked below 'parent', deleted when it is unlinked or freed, and
+ *   the children of 'parent' are rehashed after they were moved there.
+ *   Each of these also flushes the path cache.
+ *
+ *   The caller must hold the inode semaphore exclusively.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_HASHSIZE > 0
+void inode_hashadd(FAR struct inode *parent, FAR struct inode *node);
+void inode_hashdel(FAR struct inode *node);
+void inode_rehash(FAR struct inode *parent);
+FAR struct inode *inode_hashfind(FAR struct inode *parent, FAR const char *name);
+#else
+#define inode_hashadd(p, n) inode_pcache_flush()
+#define inode_hashdel(n)    inode_pcache_flush()
+#define inode_rehash(p)     inode_pcache_flush()
+#endif
+
+/****************************************************************************
+ * Name: inode_pcache_flush, inode_pcache_find, inode_pcache_add
+ *
+ * Description:
+ *   Path lookup cache used by inode_search().
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_PATHCACHE > 0
+void inode_pcache_flush(void);
+FAR struct inode *inode_pcache_find(FAR const char **path, FAR const char **relpath);
+void inode_pcache_add(FAR const char *path, FAR const char *relpath, FAR struct inode *node);
+#else
+#define inode_pcache_flush()
+#endif
+
 /* fs_inodereserver.c *******************************************************/
 /****************************************************************************
  * Name: inode_reserve
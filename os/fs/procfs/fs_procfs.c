@@ -94,6 +94,7 @@
 
 extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
+extern const struct procfs_operations sched_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 
@@ -128,6 +129,10 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"cpuload", &cpuload_operations},
 #endif
 
+#if defined(CONFIG_SCHED_TASKSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SCHED)
+	{"sched", &sched_operations},
+#endif
+
 #if defined(CONFIG_FS_SMARTFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	{"fs/smartfs**", &smartfs_procfsoperations},
 #endif
@@ -122,6 +122,9 @@ enum proc_node_e {
 	PROC_CMDLINE,				/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	PROC_LOADAVG,				/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+	PROC_SCHED,					/* Scheduling statistics */
 #endif
 	PROC_STACK,					/* Task stack info */
 	PROC_GROUP,					/* Group directory */
@@ -169,6 +172,9 @@ static ssize_t proc_entry_cmdline(FAR struct proc_file_s *procfile, FAR struct t
 #ifdef CONFIG_SCHED_CPULOAD
 static ssize_t proc_entry_loadavg(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 #endif
+#ifdef CONFIG_SCHED_TASKSTATS
+static ssize_t proc_entry_sched(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
+#endif
 static ssize_t proc_entry_stack(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 static ssize_t proc_entry_groupstatus(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 static ssize_t proc_entry_groupfd(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
@@ -241,6 +247,12 @@ static const struct proc_node_s g_loadavg = {
 };
 #endif
 
+#ifdef CONFIG_SCHED_TASKSTATS
+static const struct proc_node_s g_sched = {
+	"sched", "sched", (uint8_t)PROC_SCHED, DTYPE_FILE	/* Scheduling statistics */
+};
+#endif
+
 static const struct proc_node_s g_stack = {
 	"stack", "stack", (uint8_t)PROC_STACK, DTYPE_FILE	/* Task stack info */
 };
@@ -265,6 +277,9 @@ static FAR const struct proc_node_s *const g_nodeinfo[] = {
 	&g_cmdline,					/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	&g_loadavg,					/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+	&g_sched,					/* Scheduling statistics */
 #endif
 	&g_stack,					/* Task stack info */
 	&g_group,					/* Group directory */
@@ -282,6 +297,9 @@ static const struct proc_node_s *const g_level0info[] = {
 	&g_cmdline,					/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	&g_loadavg,					/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+	&g_sched,					/* Scheduling statistics */
 #endif
 	&g_stack,					/* Task stack info */
 	&g_group,					/* Group directory */
@@ -645,6 +663,81 @@ static ssize_t proc_entry_loadavg(FAR struct proc_file_s *procfile, FAR struct t
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_sched
+ ****************************************************************************/
+#ifdef CONFIG_SCHED_TASKSTATS
+static ssize_t proc_entry_sched(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset)
+{
+	struct taskstats_s stats;
+	size_t remaining;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+	unsigned long avglatency;
+	int i;
+
+	sched_taskstats(tcb, &stats);
+	avglatency = stats.nwakeups > 0 ? (unsigned long)(stats.sumlatency / stats.nwakeups) : 0;
+
+	remaining = buflen;
+	totalsize = 0;
+
+	/* Show the counters */
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n%-12s%lu\n%-12s%lu\n", "Switches:", (unsigned long)stats.nswitches, "Preempted:", (unsigned long)stats.npreempted, "Wakeups:", (unsigned long)stats.nwakeups);
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+
+	/* Show the run time in milliseconds and the wakeup latencies in
+	 * microseconds
+	 */
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu ms\n", "RunTime:", (unsigned long)(stats.runtime / 1000));
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu us\n%-12s%lu us\n", "LatencyAvg:", avglatency, "LatencyMax:", (unsigned long)stats.maxlatency);
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	/* Show the latency histogram */
+
+	for (i = 0; i < SCHED_TASKSTATS_NBUCKETS && totalsize < buflen; i++) {
+		if (i < SCHED_TASKSTATS_NBUCKETS - 1) {
+			linesize = snprintf(procfile->line, STATUS_LINELEN, "Latency < %6lu us: %lu\n", SCHED_TASKSTATS_LIMIT(i), (unsigned long)stats.latency[i]);
+		} else {
+			linesize = snprintf(procfile->line, STATUS_LINELEN, "Latency >=%6lu us: %lu\n", SCHED_TASKSTATS_LIMIT(i - 1), (unsigned long)stats.latency[i]);
+		}
+
+		copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+		totalsize += copysize;
+		buffer += copysize;
+		remaining -= copysize;
+	}
+
+	return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -1068,6 +1161,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 	case PROC_LOADAVG:			/* Average CPU utilization */
 		ret = proc_entry_loadavg(procfile, tcb, buffer, buflen, filep->f_pos);
 		break;
+#endif
+#ifdef CONFIG_SCHED_TASKSTATS
+	case PROC_SCHED:			/* Scheduling statistics */
+		ret = proc_entry_sched(procfile, tcb, buffer, buflen, filep->f_pos);
+		break;
 #endif
 	case PROC_STACK:			/* Task stack info */
 		ret = proc_entry_stack(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -0,0 +1,419 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfssched.c
+ *
+ * /proc/sched shows the scheduling statistics of the whole system (context
+ * switches, preemptions and the wakeup latency histogram) followed by one
+ * line for each task, so that the tasks that wait long to run can be found.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#include <arch/irq.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_TASKSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SCHED)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define SCHED_LINELEN (64 + CONFIG_TASK_NAME_SIZE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct sched_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	char line[SCHED_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read() */
+
+struct sched_read_s {
+	FAR struct sched_file_s *attr;	/* The open file */
+	FAR char *buffer;			/* Where to transfer the next data */
+	size_t remaining;			/* Space left in the user buffer */
+	size_t totalsize;			/* Number of bytes transferred */
+	off_t offset;				/* Number of bytes still to be skipped */
+	int npids;					/* Number of entries in pid[] */
+	pid_t pid[CONFIG_MAX_TASKS];	/* Snapshot of all active task IDs */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int sched_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int sched_close(FAR struct file *filep);
+static ssize_t sched_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+static int sched_dup(FAR const struct file *oldp, FAR struct file *newp);
+static int sched_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations sched_operations = {
+	sched_open,					/* open */
+	sched_close,				/* close */
+	sched_read,					/* read */
+	NULL,						/* write */
+
+	sched_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	sched_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_copyline
+ *
+ * Description:
+ *   Transfer the line formatted in attr->line to the user buffer.
+ *
+ ****************************************************************************/
+
+static void sched_copyline(FAR struct sched_read_s *info, size_t linesize)
+{
+	size_t copysize;
+
+	copysize = procfs_memcpy(info->attr->line, linesize, info->buffer, info->remaining, &info->offset);
+
+	info->totalsize += copysize;
+	info->buffer += copysize;
+	info->remaining -= copysize;
+}
+
+/****************************************************************************
+ * Name: sched_enum
+ *
+ * Description:
+ *   Add the PID of one task to the snapshot.  This is called by
+ *   sched_foreach() with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void sched_enum(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	FAR struct sched_read_s *info = (FAR struct sched_read_s *)arg;
+
+	DEBUGASSERT(info->npids < CONFIG_MAX_TASKS);
+	info->pid[info->npids++] = tcb->pid;
+}
+
+/****************************************************************************
+ * Name: sched_taskline
+ *
+ * Description:
+ *   Show the statistics of one task.  Only the copy of the counters is
+ *   done with interrupts disabled, the line is formatted afterwards.
+ *
+ ****************************************************************************/
+
+static void sched_taskline(FAR struct sched_read_s *info, pid_t pid)
+{
+	FAR struct tcb_s *tcb;
+	struct taskstats_s stats;
+	unsigned long avglatency;
+	irqstate_t flags;
+	size_t linesize;
+	int priority;
+#if CONFIG_TASK_NAME_SIZE > 0
+	char name[CONFIG_TASK_NAME_SIZE + 1];
+#else
+	const char *name = "";
+#endif
+
+	/* Skip the task if it has exited since the snapshot */
+
+	flags = irqsave();
+	tcb = sched_gettcb(pid);
+	if (!tcb) {
+		irqrestore(flags);
+		return;
+	}
+
+	sched_taskstats(tcb, &stats);
+	priority = tcb->sched_priority;
+#if CONFIG_TASK_NAME_SIZE > 0
+	strncpy(name, tcb->name, CONFIG_TASK_NAME_SIZE);
+	name[CONFIG_TASK_NAME_SIZE] = '\0';
+#endif
+	irqrestore(flags);
+
+	avglatency = stats.nwakeups > 0 ? (unsigned long)(stats.sumlatency / stats.nwakeups) : 0;
+
+	linesize = snprintf(info->attr->line, SCHED_LINELEN, "%5d %3d %9lu %9lu %9lu %8lu %8lu %s\n", (int)pid, priority, (unsigned long)stats.nswitches, (unsigned long)stats.npreempted, (unsigned long)stats.nwakeups, avglatency, (unsigned long)stats.maxlatency, name);
+
+	sched_copyline(info, linesize);
+}
+
+/****************************************************************************
+ * Name: sched_open
+ ****************************************************************************/
+
+static int sched_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct sched_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "sched" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "sched") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct sched_file_s *)kmm_zalloc(sizeof(struct sched_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: sched_close
+ ****************************************************************************/
+
+static int sched_close(FAR struct file *filep)
+{
+	FAR struct sched_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct sched_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: sched_read
+ ****************************************************************************/
+
+static ssize_t sched_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	struct sched_read_s info;
+	struct taskstats_s stats;
+	unsigned long avglatency;
+	irqstate_t flags;
+	size_t linesize;
+	int i;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	info.attr = (FAR struct sched_file_s *)filep->f_priv;
+	DEBUGASSERT(info.attr);
+
+	info.buffer = buffer;
+	info.remaining = buflen;
+	info.totalsize = 0;
+	info.offset = filep->f_pos;
+
+	/* Show the totals of the whole system */
+
+	sched_taskstats(NULL, &stats);
+	avglatency = stats.nwakeups > 0 ? (unsigned long)(stats.sumlatency / stats.nwakeups) : 0;
+
+	linesize = snprintf(info.attr->line, SCHED_LINELEN, "%-12s%lu\n%-12s%lu\n%-12s%lu\n", "Switches:", (unsigned long)stats.nswitches, "Preempted:", (unsigned long)stats.npreempted, "Wakeups:", (unsigned long)stats.nwakeups);
+	sched_copyline(&info, linesize);
+
+	linesize = snprintf(info.attr->line, SCHED_LINELEN, "%-12s%lu us\n%-12s%lu us\n", "LatencyAvg:", avglatency, "LatencyMax:", (unsigned long)stats.maxlatency);
+	sched_copyline(&info, linesize);
+
+	for (i = 0; i < SCHED_TASKSTATS_NBUCKETS && info.remaining > 0; i++) {
+		if (i < SCHED_TASKSTATS_NBUCKETS - 1) {
+			linesize = snprintf(info.attr->line, SCHED_LINELEN, "Latency < %6lu us: %lu\n", SCHED_TASKSTATS_LIMIT(i), (unsigned long)stats.latency[i]);
+		} else {
+			linesize = snprintf(info.attr->line, SCHED_LINELEN, "Latency >=%6lu us: %lu\n", SCHED_TASKSTATS_LIMIT(i - 1), (unsigned long)stats.latency[i]);
+		}
+
+		sched_copyline(&info, linesize);
+	}
+
+	/* Then one line for each task */
+
+	if (info.remaining > 0) {
+		linesize = snprintf(info.attr->line, SCHED_LINELEN, "\n%5s %3s %9s %9s %9s %8s %8s %s\n", "PID", "PRI", "SWITCHES", "PREEMPTED", "WAKEUPS", "AVG(us)", "MAX(us)", "NAME");
+		sched_copyline(&info, linesize);
+
+		/* Take a snapshot of the active tasks first, so that interrupts
+		 * are not kept disabled while the lines are formatted.
+		 */
+
+		info.npids = 0;
+		flags = irqsave();
+		sched_foreach(sched_enum, &info);
+		irqrestore(flags);
+
+		for (i = 0; i < info.npids && info.remaining > 0; i++) {
+			sched_taskline(&info, info.pid[i]);
+		}
+	}
+
+	/* Update the file offset */
+
+	if (info.totalsize > 0) {
+		filep->f_pos += info.totalsize;
+	}
+
+	return info.totalsize;
+}
+
+/****************************************************************************
+ * Name: sched_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int sched_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct sched_file_s *oldattr;
+	FAR struct sched_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct sched_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct sched_file_s *)kmm_malloc(sizeof(struct sched_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct sched_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: sched_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int sched_stat(const char *relpath, struct stat *buf)
+{
+	/* "sched" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "sched") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "sched" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif							/* CONFIG_SCHED_TASKSTATS && !CONFIG_FS_PROCFS_EXCLUDE_SCHED */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -254,6 +254,16 @@ static int romfs_open(FAR struct file *filep, FAR const char *relpath, int oflag
 	rf->rf_size = dirinfo.rd_size;
 	rf->rf_type = (uint8_t)(dirinfo.rd_next & RFNEXT_ALLMODEMASK);
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	/* Compressed files are presented with their decompressed size */
+
+	if (dirinfo.rd_usize != 0) {
+		rf->rf_csize = dirinfo.rd_size;
+		rf->rf_size = dirinfo.rd_usize;
+		rf->rf_rlepos = (uint32_t)-1;
+	}
+#endif
+
 	/* Get the start of the file data */
 
 	ret = romfs_datastart(rm, dirinfo.rd_dir.fr_curroffset, &rf->rf_startoffset);
@@ -390,6 +400,22 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer, size_t bufle
 		buflen = bytesleft;
 	}
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	/* Compressed files are decoded into the user buffer */
+
+	if (rf->rf_csize != 0) {
+		ret = romfs_rleread(rm, rf, filep->f_pos, userbuffer, buflen);
+		if (ret < 0) {
+			fdbg("romfs_rleread failed: %d\n", ret);
+			goto errout_with_semaphore;
+		}
+
+		filep->f_pos += ret;
+		romfs_semgive(rm);
+		return ret;
+	}
+#endif
+
 	/* Loop until either (1) all data has been transferred, or (2) an
 	 * error occurs.
 	 */
@@ -572,9 +598,15 @@ static int romfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 	DEBUGASSERT(rm != NULL);
 
-	/* Only one ioctl command is supported */
+	/* Only one ioctl command is supported.  Compressed files cannot be
+	 * mapped.
+	 */
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	if (cmd == FIOC_MMAP && rm->rm_xipbase && ppv && rf->rf_csize == 0) {
+#else
 	if (cmd == FIOC_MMAP && rm->rm_xipbase && ppv) {
+#endif
 		/* Return the address on the media corresponding to the start of
 		 * the file.
 		 */
@@ -639,6 +671,11 @@ static int romfs_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 	newrf->rf_startoffset = oldrf->rf_startoffset;
 	newrf->rf_size = oldrf->rf_size;
+	newrf->rf_type = oldrf->rf_type;
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	newrf->rf_csize = oldrf->rf_csize;
+	newrf->rf_rlepos = (uint32_t)-1;
+#endif
 
 	/* Configure buffering to support access to this file */
 
@@ -1153,6 +1190,7 @@ static int romfs_stat(FAR struct inode *mountpt, FAR const char *relpath, FAR st
 {
 	FAR struct romfs_mountpt_s *rm;
 	FAR struct romfs_dirinfo_s dirinfo;
+	uint32_t size;
 	uint8_t type;
 	int ret;
 
@@ -1190,7 +1228,14 @@ static int romfs_stat(FAR struct inode *mountpt, FAR const char *relpath, FAR st
 		/* It's a read-only directory name */
 
 	type = (uint8_t)(dirinfo.rd_next & RFNEXT_ALLMODEMASK);
-	ret  = romfs_stat_common(type, dirinfo.rd_size, rm->rm_hwsectorsize, buf);
+	size = dirinfo.rd_size;
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	if (dirinfo.rd_usize != 0) {
+		size = dirinfo.rd_usize;
+	}
+#endif
+
+	ret  = romfs_stat_common(type, size, rm->rm_hwsectorsize, buf);
 
 errout_with_semaphore:
 	romfs_semgive(rm);
@@ -81,6 +81,7 @@
 								 *        16 byte boundary. */
 
 #define ROMFS_VHDR_MAGIC   "-rom1fs-"
+#define ROMFS_VHDR_XMAGIC  "-rom1fx-"	/* Extended volume, see below */
 
 /* File header offset (multi-byte values are big-endian) */
 
@@ -122,6 +123,46 @@
  * RFNEXT_FIFO are not presently supported in TinyAra.
  */
 
+/* Extended volumes (made by tools/mkromfsx) differ from plain ones only in
+ * the magic number and in the use of some header fields that are otherwise
+ * zero:
+ *
+ * - The first entry of the root directory is "." and is a directory header.
+ * - The size field of a directory header holds the offset to the index of
+ *   that directory (zero if it has none).  The index holds the file header
+ *   offsets of all of the entries of the directory, sorted by the hash of
+ *   their names, so that a name is found by a binary search.
+ * - The info field of a regular file header holds the size of the file
+ *   after decompression (zero if the file is stored as is).  The size
+ *   field holds the number of bytes stored.
+ */
+
+#define ROMFS_INDEX_COUNT   0	/*  0-3:  Number of entries in the index */
+#define ROMFS_INDEX_ENTRY   8	/*  8-..: Index entries */
+
+#define ROMFS_IENTRY_HASH   0	/*  0-3:  Hash of the entry name */
+#define ROMFS_IENTRY_OFFSET 4	/*  4-7:  Offset to the file header */
+#define ROMFS_IENTRY_SIZE   8
+
+/* Entry names are hashed with 32-bit FNV-1a */
+
+#define ROMFS_HASH_BASIS    2166136261ul
+#define ROMFS_HASH_PRIME    16777619ul
+
+/* Compressed file data starts with a table of big-endian 32-bit offsets
+ * (relative to the start of the file data) to each ROMFS_RLE_BLOCKSIZE
+ * bytes of the decompressed file, so that seeks do not have to decompress
+ * the file from its beginning.  Each block is encoded as a sequence of
+ * control bytes c, each followed by:
+ *
+ * - c < 128:  c + 1 literal bytes
+ * - c >= 128: one byte to be repeated c - 125 times (3..130)
+ */
+
+#define ROMFS_RLE_BLOCKSIZE 4096
+#define ROMFS_RLE_RUN       128
+#define ROMFS_RLE_MINRUN    3
+
 /* Alignment macros */
 
 #define ROMFS_ALIGNMENT       16
@@ -167,6 +208,10 @@ struct romfs_mountpt_s {
 	uint32_t rm_cachesector;	/* Current sector in the rm_buffer */
 	uint8_t *rm_xipbase;		/* Base address of directly accessible media */
 	uint8_t *rm_buffer;			/* Device sector buffer, allocated if rm_xipbase==0 */
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	bool rm_extended;			/* true: Extended volume */
+	uint32_t rm_rootindex;		/* Offset to the index of the root directory */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -181,6 +226,16 @@ struct romfs_file_s {
 	uint32_t rf_cachesector;	/* Current sector in the rf_buffer */
 	uint8_t *rf_buffer;			/* File sector buffer, allocated if rm_xipbase==0 */
 	uint8_t rf_type;            /* File type (for fstat()) */
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	bool rf_rleliteral;			/* true: Decoding literal bytes, false: a run */
+	uint8_t rf_rlebyte;			/* The byte repeated by the current run */
+	uint32_t rf_csize;			/* Bytes stored if compressed (rf_size is the
+								 * decompressed size), zero otherwise */
+	uint32_t rf_rlepos;			/* File position of the decoder */
+	uint32_t rf_rlesrc;			/* Offset of the next byte to decode, relative
+								 * to rf_startoffset */
+	uint32_t rf_rlecount;		/* Bytes left in the current literal or run */
+#endif
 };
 
 /* This structure is used internally for describing the result of
@@ -199,6 +254,10 @@ struct romfs_dirinfo_s {
 
 	uint32_t rd_next;			/* Offset of the next file header+flags */
 	uint32_t rd_size;			/* Size (if file) */
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	uint32_t rd_index;			/* Offset to the directory index (if directory) */
+	uint32_t rd_usize;			/* Decompressed size (if compressed file) */
+#endif
 };
 
 /****************************************************************************
@@ -229,6 +288,9 @@ EXTERN int romfs_finddirentry(struct romfs_mountpt_s *rm, struct romfs_dirinfo_s
 EXTERN int romfs_parsedirentry(struct romfs_mountpt_s *rm, uint32_t offset, uint32_t *poffset, uint32_t *pnext, uint32_t *pinfo, uint32_t *psize);
 EXTERN int romfs_parsefilename(struct romfs_mountpt_s *rm, uint32_t offset, char *pname);
 EXTERN int romfs_datastart(struct romfs_mountpt_s *rm, uint32_t offset, uint32_t *start);
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+EXTERN int romfs_rleread(struct romfs_mountpt_s *rm, struct romfs_file_s *rf, uint32_t pos, uint8_t *buffer, size_t buflen);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
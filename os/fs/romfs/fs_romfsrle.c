@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/romfs/fs_romfsrle.c
+ *
+ * Streaming decoder for the run-length compressed files of extended ROMFS
+ * volumes.  The compressed data is read through the sector buffer of the
+ * file, so that the decoder needs no memory of its own and works the same
+ * way in XIP mode.  The decoder keeps its position, so sequential reads
+ * continue where the last one stopped; any other position is reached from
+ * the start of its block.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <sys/types.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "fs_romfs.h"
+
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: romfs_rlesource
+ *
+ * Desciption:
+ *   Make the sector holding the compressed data at 'offset' (relative to
+ *   the start of the file data) available in the file buffer.  Return the
+ *   index of that data in the buffer.
+ *
+ ****************************************************************************/
+
+static int romfs_rlesource(struct romfs_mountpt_s *rm, struct romfs_file_s *rf, uint32_t offset)
+{
+	int ret;
+
+	if (offset >= rf->rf_csize) {
+		fdbg("Compressed data overrun: %d\n", offset);
+		return -EIO;
+	}
+
+	offset += rf->rf_startoffset;
+	ret = romfs_filecacheread(rm, rf, SEC_NSECTORS(rm, offset));
+	if (ret < 0) {
+		return ret;
+	}
+
+	return offset & SEC_NDXMASK(rm);
+}
+
+/****************************************************************************
+ * Name: romfs_rleseek
+ *
+ * Desciption:
+ *   Set up the decoder to decode from the start of the block containing
+ *   the file position 'pos'.
+ *
+ ****************************************************************************/
+
+static int romfs_rleseek(struct romfs_mountpt_s *rm, struct romfs_file_s *rf, uint32_t pos)
+{
+	uint32_t block = pos / ROMFS_RLE_BLOCKSIZE;
+	uint8_t *src;
+	int ndx;
+
+	/* Table entries are aligned to their size, so none of them is split
+	 * between two sectors.
+	 */
+
+	ndx = romfs_rlesource(rm, rf, block * sizeof(uint32_t));
+	if (ndx < 0) {
+		return ndx;
+	}
+
+	src = &rf->rf_buffer[ndx];
+	rf->rf_rlesrc = (uint32_t)src[0] << 24 | (uint32_t)src[1] << 16 | (uint32_t)src[2] << 8 | src[3];
+	rf->rf_rlepos = block * ROMFS_RLE_BLOCKSIZE;
+	rf->rf_rlecount = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: romfs_rledecode
+ *
+ * Desciption:
+ *   Decode the next 'nbytes' bytes of the file into 'buffer' or, if
+ *   'buffer' is NULL, skip them.
+ *
+ ****************************************************************************/
+
+static int romfs_rledecode(struct romfs_mountpt_s *rm, struct romfs_file_s *rf, uint8_t *buffer, uint32_t nbytes)
+{
+	uint32_t chunk;
+	uint8_t control;
+	int ndx;
+
+	while (nbytes > 0) {
+		/* Start the next literal or run if the current one is exhausted */
+
+		if (rf->rf_rlecount == 0) {
+			ndx = romfs_rlesource(rm, rf, rf->rf_rlesrc);
+			if (ndx < 0) {
+				return ndx;
+			}
+
+			control = rf->rf_buffer[ndx];
+			rf->rf_rlesrc++;
+
+			if (control < ROMFS_RLE_RUN) {
+				rf->rf_rleliteral = true;
+				rf->rf_rlecount = control + 1;
+			} else {
+				ndx = romfs_rlesource(rm, rf, rf->rf_rlesrc);
+				if (ndx < 0) {
+					return ndx;
+				}
+
+				rf->rf_rleliteral = false;
+				rf->rf_rlebyte = rf->rf_buffer[ndx];
+				rf->rf_rlecount = control - ROMFS_RLE_RUN + ROMFS_RLE_MINRUN;
+				rf->rf_rlesrc++;
+			}
+		}
+
+		chunk = rf->rf_rlecount;
+		if (chunk > nbytes) {
+			chunk = nbytes;
+		}
+
+		if (rf->rf_rleliteral) {
+			/* Copy literal bytes up to the end of the sector at most */
+
+			ndx = romfs_rlesource(rm, rf, rf->rf_rlesrc);
+			if (ndx < 0) {
+				return ndx;
+			}
+
+			if (chunk > (uint32_t)(rm->rm_hwsectorsize - ndx)) {
+				chunk = rm->rm_hwsectorsize - ndx;
+			}
+
+			if (buffer) {
+				memcpy(buffer, &rf->rf_buffer[ndx], chunk);
+			}
+
+			rf->rf_rlesrc += chunk;
+		} else if (buffer) {
+			memset(buffer, rf->rf_rlebyte, chunk);
+		}
+
+		if (buffer) {
+			buffer += chunk;
+		}
+
+		rf->rf_rlecount -= chunk;
+		rf->rf_rlepos += chunk;
+		nbytes -= chunk;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: romfs_rleread
+ *
+ * Desciption:
+ *   Read 'buflen' bytes from the file position 'pos' of a compressed file.
+ *   The caller must have limited 'buflen' to the size of the file.  Return
+ *   the number of bytes read or a negated errno value.
+ *
+ ****************************************************************************/
+
+int romfs_rleread(struct romfs_mountpt_s *rm, struct romfs_file_s *rf, uint32_t pos, uint8_t *buffer, size_t buflen)
+{
+	int ret;
+
+	/* Continue from the current position of the decoder if it is in the
+	 * same block before 'pos'.  Otherwise start over from the block
+	 * containing 'pos'.
+	 */
+
+	if (rf->rf_rlepos > pos || rf->rf_rlepos / ROMFS_RLE_BLOCKSIZE != pos / ROMFS_RLE_BLOCKSIZE) {
+		ret = romfs_rleseek(rm, rf, pos);
+		if (ret < 0) {
+			goto errout;
+		}
+	}
+
+	ret = romfs_rledecode(rm, rf, NULL, pos - rf->rf_rlepos);
+	if (ret < 0) {
+		goto errout;
+	}
+
+	ret = romfs_rledecode(rm, rf, buffer, buflen);
+	if (ret < 0) {
+		goto errout;
+	}
+
+	return buflen;
+
+errout:
+	/* Do not trust the decoder state after a failure */
+
+	rf->rf_rlepos = (uint32_t)-1;
+	return ret;
+}
+
+#endif							/* CONFIG_FS_ROMFS_EXTENDED */
@@ -184,9 +184,17 @@ static inline int romfs_checkentry(struct romfs_mountpt_s *rm, uint32_t offset,
 				dirinfo->rd_dir.fr_firstoffset = info;
 				dirinfo->rd_dir.fr_curroffset = info;
 				dirinfo->rd_size = 0;
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+				dirinfo->rd_index = rm->rm_extended ? size : 0;
+				dirinfo->rd_usize = 0;
+#endif
 			} else {
 				dirinfo->rd_dir.fr_curroffset = offset;
 				dirinfo->rd_size = size;
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+				dirinfo->rd_index = 0;
+				dirinfo->rd_usize = rm->rm_extended ? info : 0;
+#endif
 			}
 
 			dirinfo->rd_next = next;
@@ -289,6 +297,100 @@ static int romfs_followhardlinks(struct romfs_mountpt_s *rm, uint32_t offset, ui
 	return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_hash
+ *
+ * Desciption:
+ *   Return the hash of a file name, as used to sort directory indices
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+static uint32_t romfs_hash(const char *name, int namelen)
+{
+	uint32_t hash = ROMFS_HASH_BASIS;
+
+	while (namelen-- > 0) {
+		hash ^= (uint8_t)*name++;
+		hash *= ROMFS_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/****************************************************************************
+ * Name: romfs_searchindex
+ *
+ * Desciption:
+ *   This is part of the romfs_finddirentry log.  Search the index of the
+ *   directory at dirinfo->rd_index for entryname.
+ *
+ ****************************************************************************/
+
+static int romfs_searchindex(struct romfs_mountpt_s *rm, const char *entryname, int entrylen, struct romfs_dirinfo_s *dirinfo)
+{
+	uint32_t offset;
+	uint32_t entry;
+	uint32_t count;
+	uint32_t hash;
+	uint32_t low;
+	uint32_t high;
+	uint32_t mid;
+	int16_t ndx;
+	int ret;
+
+	ndx = romfs_devcacheread(rm, dirinfo->rd_index);
+	if (ndx < 0) {
+		return ndx;
+	}
+
+	count = romfs_devread32(rm, ndx + ROMFS_INDEX_COUNT);
+	entry = dirinfo->rd_index + ROMFS_INDEX_ENTRY;
+	hash = romfs_hash(entryname, entrylen);
+
+	/* Find the first entry with this hash.  The entries are aligned to their
+	 * size, so none of them is split between two sectors.
+	 */
+
+	low = 0;
+	high = count;
+	while (low < high) {
+		mid = (low + high) >> 1;
+		ndx = romfs_devcacheread(rm, entry + mid * ROMFS_IENTRY_SIZE);
+		if (ndx < 0) {
+			return ndx;
+		}
+
+		if (romfs_devread32(rm, ndx + ROMFS_IENTRY_HASH) < hash) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	/* Then check the names of all of the entries with this hash */
+
+	for (; low < count; low++) {
+		ndx = romfs_devcacheread(rm, entry + low * ROMFS_IENTRY_SIZE);
+		if (ndx < 0) {
+			return ndx;
+		}
+
+		if (romfs_devread32(rm, ndx + ROMFS_IENTRY_HASH) != hash) {
+			break;
+		}
+
+		offset = romfs_devread32(rm, ndx + ROMFS_IENTRY_OFFSET);
+		ret = romfs_checkentry(rm, offset, entryname, entrylen, dirinfo);
+		if (ret == OK) {
+			return OK;
+		}
+	}
+
+	return -ENOENT;
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -305,6 +407,16 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm, const char *entryn
 	int16_t ndx;
 	int ret;
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	/* Use the index of the directory if it has one.  Names of NAME_MAX
+	 * characters may have been truncated, so they cannot be hashed.
+	 */
+
+	if (dirinfo->rd_index != 0 && entrylen < NAME_MAX) {
+		return romfs_searchindex(rm, entryname, entrylen, dirinfo);
+	}
+#endif
+
 	/* Then loop through the current directory until the directory
 	 * with the matching name is found.  Or until all of the entries
 	 * the directory have been examined.
@@ -559,9 +671,16 @@ int romfs_fsconfigure(struct romfs_mountpt_s *rm)
 
 	/* Verify the magic number at that identifies this as a ROMFS filesystem */
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	rm->rm_extended = (memcmp(rm->rm_buffer, ROMFS_VHDR_XMAGIC, 8) == 0);
+	if (!rm->rm_extended && memcmp(rm->rm_buffer, ROMFS_VHDR_MAGIC, 8) != 0) {
+		return -EINVAL;
+	}
+#else
 	if (memcmp(rm->rm_buffer, ROMFS_VHDR_MAGIC, 8) != 0) {
 		return -EINVAL;
 	}
+#endif
 
 	/* Then extract the values we need from the header and return success */
 
@@ -572,6 +691,24 @@ int romfs_fsconfigure(struct romfs_mountpt_s *rm)
 	name = (const char *)&rm->rm_buffer[ROMFS_VHDR_VOLNAME];
 	rm->rm_rootoffset = ROMFS_ALIGNUP(ROMFS_VHDR_VOLNAME + strlen(name) + 1);
 
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	/* The first root directory entry of an extended volume is the "."
+	 * directory header which holds the offset to the root directory index.
+	 */
+
+	rm->rm_rootindex = 0;
+	if (rm->rm_extended) {
+		ndx = romfs_devcacheread(rm, rm->rm_rootoffset);
+		if (ndx < 0) {
+			return ndx;
+		}
+
+		if (IS_DIRECTORY(romfs_devread32(rm, ndx + ROMFS_FHDR_NEXT))) {
+			rm->rm_rootindex = romfs_devread32(rm, ndx + ROMFS_FHDR_SIZE);
+		}
+	}
+#endif
+
 	/* and return success */
 
 	rm->rm_mounted = true;
@@ -678,6 +815,10 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm, struct romfs_dirinfo_s *dirin
 	dirinfo->rd_dir.fr_curroffset = rm->rm_rootoffset;
 	dirinfo->rd_next = RFNEXT_DIRECTORY;
 	dirinfo->rd_size = 0;
+#ifdef CONFIG_FS_ROMFS_EXTENDED
+	dirinfo->rd_index = rm->rm_rootindex;
+	dirinfo->rd_usize = 0;
+#endif
 
 	/* The root directory is a special case */
 
@@ -784,11 +925,17 @@ int romfs_parsedirentry(struct romfs_mountpt_s *rm, uint32_t offset, uint32_t *p
 		return ret;
 	}
 
-	/* Because everything is chunked and aligned to 16-bit boundaries,
-	 * we know that most the basic node info fits into the sector.  The
-	 * associated name may not, however.
+	/* Read the sector containing the real file header.  Because everything
+	 * is chunked and aligned to 16-bit boundaries, we know that most the
+	 * basic node info fits into the sector.  The associated name may not,
+	 * however.
 	 */
 
+	ndx = romfs_devcacheread(rm, *poffset);
+	if (ndx < 0) {
+		return ndx;
+	}
+
 	next = romfs_devread32(rm, ndx + ROMFS_FHDR_NEXT);
 	*pnext = (save & RFNEXT_OFFSETMASK) | (next & RFNEXT_ALLMODEMASK);
 	*pinfo = romfs_devread32(rm, ndx + ROMFS_FHDR_INFO);
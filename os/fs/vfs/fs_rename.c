@@ -206,6 +206,10 @@ int rename(FAR const char *oldpath, FAR const char *newpath)
 #endif
 		newinode->i_private = oldinode->i_private;	/* Per inode driver private data */
 
+		/* The children are now looked up below the new inode */
+
+		inode_rehash(newinode);
+
 		/* We now have two copies of the inode.  One with a reference count of
 		 * zero (the new one), and one that may have multiple references
 		 * including one by this logic (the old one)
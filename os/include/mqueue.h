@@ -95,6 +95,14 @@ struct mq_attr {
 
 typedef FAR struct mq_des *mqd_t;
 
+/** @brief structure of one message received by mq_receivev() */
+struct mq_msgvec {
+	FAR char *msg;				/* Buffer to receive the message */
+	size_t bufsize;				/* Size of the buffer in bytes */
+	size_t msglen;				/* Returned length of the received message */
+	int prio;					/* Returned priority of the received message */
+};
+
 /********************************************************************************
  * Public Data
  ********************************************************************************/
@@ -165,6 +173,16 @@ ssize_t mq_receive(mqd_t mqdes, FAR char *msg, size_t msglen, FAR int *prio);
  * @since TizenRT v1.0
  */
 ssize_t mq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen, FAR int *prio, FAR const struct timespec *abstime);
+/**
+ * @brief receive several messages from a message queue
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * Waits like mq_receive() for the first message, then also takes up to
+ * nvec - 1 further messages that are already queued.  Returns the number
+ * of messages received.
+ * @since TizenRT v2.1 PRE
+ */
+ssize_t mq_receivev(mqd_t mqdes, FAR struct mq_msgvec *msgvec, int nvec);
 /**
  * @brief notify process that a message is available
  * @details @b #include <mqueue.h> \n
@@ -189,6 +207,41 @@ int mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat, FAR struct mq_att
  */
 int mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/**
+ * @brief reserve a message buffer of a message queue
+ * @details @b #include <mqueue.h> \n
+ * The buffer holds mq_msgsize bytes.  It is given back by mq_msgcommit()
+ * or mq_msgrelease().
+ * @since TizenRT v2.1 PRE
+ */
+FAR void *mq_msgreserve(mqd_t mqdes);
+/**
+ * @brief send a message written in place in a reserved buffer
+ * @details @b #include <mqueue.h> \n
+ * Blocks like mq_send() while the queue is full.  On failure the buffer
+ * stays reserved.
+ * @since TizenRT v2.1 PRE
+ */
+int mq_msgcommit(mqd_t mqdes, FAR void *msg, size_t msglen, int prio);
+/**
+ * @brief receive a message without copying it
+ * @details @b #include <mqueue.h> \n
+ * Blocks like mq_receive().  The message buffer is lent to the caller
+ * until it is given back with mq_msgrelease().
+ * @since TizenRT v2.1 PRE
+ */
+ssize_t mq_msgreceive(mqd_t mqdes, FAR void **msg, FAR int *prio);
+/**
+ * @brief give back a message buffer
+ * @details @b #include <mqueue.h> \n
+ * Ends the loan of a buffer from mq_msgreceive() or cancels a reservation
+ * from mq_msgreserve().
+ * @since TizenRT v2.1 PRE
+ */
+int mq_msgrelease(mqd_t mqdes, FAR void *msg);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -79,6 +79,8 @@
 #define PRIOINHERIT_FLAGS_DISABLE (1 << 0) /* Bit 0: Priority inheritance
 					    * is disabled for this semaphore */
 #define FLAGS_INITIALIZED         (1 << 1) /* Bit 1: This semaphore initialized */
+#define FLAGS_HOLDER_DEFERRED     (1 << 2) /* Bit 2: The count was taken without
+					    * recording the holder */
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
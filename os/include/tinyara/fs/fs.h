@@ -160,6 +160,18 @@ struct block_operations {
 	int (*unlink)(FAR struct inode *inode);
 };
 
+/* This structure holds the sector cache statistics of a block-to-character
+ * (BCH) driver.  It is returned by the DIOC_GETSTATS ioctl command.
+ */
+
+struct bchstats_s {
+	uint32_t hits;				/* Sector accesses satisfied by the cache */
+	uint32_t misses;			/* Sector accesses that read the device */
+	uint32_t readahead;			/* Sectors read ahead of a sequential access */
+	uint32_t devreads;			/* Read requests to the block driver */
+	uint32_t devwrites;			/* Write requests to the block driver */
+};
+
 /* This structure is provided by a filesystem to describe a mount point.
  * Note that this structure differs from file_operations ONLY in the form of
  * the open method.  Once the file is opened, it can be accessed either as a
@@ -263,6 +275,10 @@ union inode_ops_u {
 struct inode {
 	FAR struct inode *i_peer;	/* Link to same level inode */
 	FAR struct inode *i_child;	/* Link to lower level inode */
+#if defined(CONFIG_FS_INODE_HASHSIZE) && CONFIG_FS_INODE_HASHSIZE > 0
+	FAR struct inode *i_parent;	/* Link to upper level inode (hash key) */
+	FAR struct inode *i_hnext;	/* Link to next inode in the hash bucket */
+#endif
 	int16_t i_crefs;			/* References to inode */
 	uint16_t i_flags;			/* Flags for inode */
 	union inode_ops_u u;		/* Inode operations */
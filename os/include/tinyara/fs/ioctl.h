@@ -170,6 +170,16 @@
 										 * OUT: None
 										 */
 
+#define DIOC_GETSTATS   _DIOC(0x0005)	/* IN:  Pointer to struct bchstats_s
+										 * OUT: Sector cache statistics of a
+										 *      BCH driver
+										 */
+
+#define DIOC_FLUSH      _DIOC(0x0006)	/* IN:  None
+										 * OUT: None, sectors cached by a BCH
+										 *      driver written to the media
+										 */
+
 /* TinyAra block driver ioctl definitions *************************************/
 
 #define _BIOCVALID(c)   (_IOC_TYPE(c) == _BIOCBASE)
@@ -83,6 +83,9 @@ struct mq_des;					/* forward reference */
 struct mqueue_inode_s {
 	FAR struct inode *inode;	/* Containing inode */
 	sq_queue_t msglist;			/* Prioritized message list */
+#ifdef CONFIG_MQ_SLAB
+	sq_queue_t msgslab;			/* Free messages sized for this queue */
+#endif
 	int16_t maxmsgs;			/* Maximum number of messages in the queue */
 	int16_t nmsgs;				/* Number of message in the queue */
 	int16_t nwaitnotfull;		/* Number tasks waiting for not full */
@@ -62,6 +62,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <queue.h>
 #include <signal.h>
 #include <semaphore.h>
@@ -183,6 +184,14 @@
 #define KEY_NOT_INUSE   (0)
 #define KEY_INUSE       (1)
 
+/* Wakeup latency histogram.  Bucket n holds the latencies below
+ * SCHED_TASKSTATS_LIMIT(n) microseconds (and not in a lower bucket); the
+ * last bucket holds all of the longer ones.
+ */
+
+#define SCHED_TASKSTATS_NBUCKETS  8
+#define SCHED_TASKSTATS_LIMIT(n)  (64ul << (2 * (n)))	/* 64us, 256us, ... */
+
 /********************************************************************************
  * Public Type Definitions
  ********************************************************************************/
@@ -472,6 +481,24 @@ struct task_group_s {
 };
 #endif
 
+#ifdef CONFIG_SCHED_TASKSTATS
+/* struct taskstats_s ************************************************************/
+/** @brief Scheduling statistics of a task or of the whole system.  Times are in
+ * microseconds.
+ */
+struct taskstats_s {
+	uint32_t nswitches;			/* Number of times switched in         */
+	uint32_t npreempted;		/* Switched out while ready to run     */
+	uint32_t nwakeups;			/* Number of latencies measured        */
+	uint32_t maxlatency;		/* Longest wakeup latency              */
+	uint64_t sumlatency;		/* Sum of the wakeup latencies         */
+	uint64_t runtime;			/* Total time running                  */
+	uint64_t waketime;			/* When last made ready to run         */
+	bool waking;				/* Made ready to run, not yet running  */
+	uint32_t latency[SCHED_TASKSTATS_NBUCKETS];	/* Latency histogram   */
+};
+#endif
+
 /* struct tcb_s ******************************************************************/
 
 FAR struct wdog_s;				/* Forward reference                   */
@@ -519,6 +546,10 @@ struct tcb_s {
 #endif
 	FAR struct wdog_s *waitdog;	/* All timed waits used this wdog      */
 
+#ifdef CONFIG_SCHED_TASKSTATS
+	struct taskstats_s stats;	/* Scheduling statistics               */
+#endif
+
 	/* Stack-Related Fields ****************************************************** */
 
 	size_t adj_stack_size;		/* Stack size after adjustment         */
@@ -723,6 +754,22 @@ void sched_foreach(sched_foreach_t handler, FAR void *arg);
  */
 FAR struct tcb_s *sched_gettcb(pid_t pid);
 
+#ifdef CONFIG_SCHED_TASKSTATS
+/**
+ * @ingroup SCHED_KERNEL
+ * @brief Take a snapshot of the scheduling statistics of a task
+ * @details @b #include <tinyara/sched.h> \n
+ *   The run time of the running task includes the time since it was
+ *   switched in.
+ * @param[in] tcb The TCB of the task, or NULL for the totals of the whole
+ *   system (with the run time of no task)
+ * @param[out] stats The location to return the statistics
+ * @return none
+ * @since TizenRT v2.1 PRE
+ */
+void sched_taskstats(FAR struct tcb_s *tcb, FAR struct taskstats_s *stats);
+#endif
+
 /* File system helpers **********************************************************/
 /* These functions all extract lists from the group structure assocated with the
  * currently executing task.
@@ -79,6 +79,7 @@ typedef int (*lib_getc_t)(FAR struct lib_instream_s *this);
 
 struct lib_outstream_s;
 typedef void (*lib_putc_t)(FAR struct lib_outstream_s *this, int ch);
+typedef void (*lib_write_t)(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len);
 typedef int (*lib_flush_t)(FAR struct lib_outstream_s *this);
 
 /**
@@ -97,6 +98,8 @@ struct lib_instream_s {
  */
 struct lib_outstream_s {
 	lib_putc_t put;				/* Put one character to the outstream */
+	lib_write_t write;			/* Put len characters to the outstream.  NULL if
+								 * the stream only supports put */
 #ifdef CONFIG_STDIO_LINEBUFFER
 	lib_flush_t flush;			/* Flush any buffered characters in the outstream */
 #endif
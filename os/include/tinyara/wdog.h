@@ -109,9 +109,9 @@
 	do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
 #ifdef CONFIG_PIC
-#define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
-#define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
+#define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #endif
 
 /****************************************************************************
@@ -144,12 +144,13 @@ typedef CODE void (*wdentry_t)(int argc, uint32_t arg1, ...);
  */
 
 struct wdog_s {
-	FAR struct wdog_s *next;	/* Support for singly linked lists. */
+	FAR struct wdog_s *next;	/* Support for singly and doubly linked lists. */
+	FAR struct wdog_s *prev;	/* Support for doubly linked lists. */
 	wdentry_t func;				/* Function to execute when delay expires */
 #ifdef CONFIG_PIC
 	FAR void *picbase;			/* PIC base address */
 #endif
-	int lag;					/* Timer associated with the delay */
+	uint32_t expire;			/* Timer wheel tick at which the delay expires */
 	uint8_t flags;				/* See WDOGF_* definitions above */
 	uint8_t argc;				/* The number of parameters to pass */
 	uint32_t parm[CONFIG_MAX_WDOGPARMS];
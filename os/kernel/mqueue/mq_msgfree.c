@@ -93,9 +93,11 @@
  * Description:
  *   The mq_msgfree function will return a message to the free pool of
  *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   allocated dynamically it will be deallocated.  A message from the
+ *   slab of a message queue goes back to that slab.
  *
  * Inputs:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Return Value:
@@ -103,7 +105,7 @@
  *
  ************************************************************************/
 
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
+void mq_msgfree(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
 {
 	irqstate_t saved_state;
 
@@ -142,7 +144,20 @@ void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
 
 	else if (mqmsg->type == MQ_ALLOC_DYN) {
 		sched_kfree(mqmsg);
-	} else {
+	}
+#ifdef CONFIG_MQ_SLAB
+
+	/* A message from the slab of the message queue goes back to the front
+	 * of the slab, where it is still likely to be in the cache.
+	 */
+
+	else if (mqmsg->type == MQ_ALLOC_SLAB) {
+		saved_state = irqsave();
+		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msgslab);
+		irqrestore(saved_state);
+	}
+#endif
+	else {
 		PANIC();
 	}
 }
@@ -70,6 +70,11 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The message slab follows the message queue structure, pointer aligned */
+
+#define MQ_INODE_SIZE \
+	((sizeof(struct mqueue_inode_s) + sizeof(FAR void *) - 1) & ~(sizeof(FAR void *) - 1))
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -112,6 +117,14 @@
 FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode, FAR struct mq_attr *attr)
 {
 	FAR struct mqueue_inode_s *msgq;
+	int16_t maxmsgs;
+	int16_t maxmsgsize;
+#ifdef CONFIG_MQ_SLAB
+	FAR struct mqueue_msg_s *mqmsg;
+	FAR char *slab;
+	size_t msgsize;
+	int i;
+#endif
 
 	/* Check if the caller is attempting to allocate a message for messages
 	 * larger than the configured maximum message size.
@@ -122,21 +135,57 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode, FAR struct mq_attr *attr)
 		return NULL;
 	}
 
-	/* Allocate memory for the new message queue. */
+	if (attr) {
+		maxmsgs    = (int16_t)attr->mq_maxmsg;
+		maxmsgsize = (int16_t)attr->mq_msgsize;
+	} else {
+		maxmsgs    = MQ_MAX_MSGS;
+		maxmsgsize = MQ_MAX_BYTES;
+	}
+
+#ifdef CONFIG_MQ_SLAB
+	/* Allocate memory for the new message queue together with a slab of
+	 * maxmsgs messages, each only large enough for maxmsgsize bytes.  If
+	 * that much memory is not available, the queue is created without a
+	 * slab and uses the system-wide message pool only.
+	 */
+
+	msgsize = MQ_MSG_SIZE(maxmsgsize);
+	slab = NULL;
+	msgq = NULL;
+
+	if (maxmsgs > 0) {
+		msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(MQ_INODE_SIZE + maxmsgs * msgsize);
+		if (msgq) {
+			slab = (FAR char *)msgq + MQ_INODE_SIZE;
+		}
+	}
+
+	if (!msgq)
+#endif
+	{
+		/* Allocate memory for the new message queue. */
 
-	msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(sizeof(struct mqueue_inode_s));
+		msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(sizeof(struct mqueue_inode_s));
+	}
 
 	if (msgq) {
 		/* Initialize the new named message queue */
 
 		sq_init(&msgq->msglist);
-		if (attr) {
-			msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
-			msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
-		} else {
-			msgq->maxmsgs    = MQ_MAX_MSGS;
-			msgq->maxmsgsize = MQ_MAX_BYTES;
+		msgq->maxmsgs    = maxmsgs;
+		msgq->maxmsgsize = maxmsgsize;
+
+#ifdef CONFIG_MQ_SLAB
+		sq_init(&msgq->msgslab);
+		if (slab) {
+			for (i = 0; i < maxmsgs; i++) {
+				mqmsg = (FAR struct mqueue_msg_s *)(slab + i * msgsize);
+				mqmsg->type = MQ_ALLOC_SLAB;
+				sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgslab);
+			}
 		}
+#endif
 
 #ifndef CONFIG_DISABLE_SIGNALS
 		msgq->ntpid = INVALID_PROCESS_ID;
@@ -114,11 +114,11 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
 		/* Deallocate the message structure. */
 
 		next = curr->next;
-		mq_msgfree(curr);
+		mq_msgfree(msgq, curr);
 		curr = next;
 	}
 
-	/* Then deallocate the message queue itself */
+	/* Then deallocate the message queue itself (and its message slab) */
 
 	sched_kfree(msgq);
 }
@@ -255,6 +255,8 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
  *   mqdes - Message queue descriptor
  *   mqmsg   - The message obtained by mq_waitmsg()
  *   ubuffer - The address of the user provided buffer to receive the message
+ *             or NULL to keep the message on loan to the caller
+ *             (see mq_msgreceive()).
  *   prio    - The user-provided location to return the message priority.
  *
  * Return Value:
@@ -282,19 +284,20 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 
 	rcvmsglen = mqmsg->msglen;
 
-	/* Copy the message into the caller's buffer */
-
-	memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
-
-	/* Copy the message priority as well (if a buffer is provided) */
+	/* Copy the message priority (if a buffer is provided) */
 
 	if (prio) {
 		*prio = mqmsg->priority;
 	}
 
-	/* We are done with the message.  Deallocate it now. */
+	/* Copy the message into the caller's buffer.  We are then done with the
+	 * message, so deallocate it now.
+	 */
 
-	mq_msgfree(mqmsg);
+	if (ubuffer) {
+		memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
+		mq_msgfree(mqdes->msgq, mqmsg);
+	}
 
 	/* Check if any tasks are waiting for the MQ not full event. */
 
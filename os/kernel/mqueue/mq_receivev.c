@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/mqueue/mq_receivev.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <errno.h>
+#include <mqueue.h>
+#include <queue.h>
+#include <debug.h>
+#include <tinyara/arch.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_receivev
+ *
+ * Description:
+ *   This function receives up to 'nvec' messages from the message queue
+ *   specified by "mqdes" in a single call.  It waits for the first message
+ *   just like mq_receive() and then also takes the messages that are
+ *   already queued behind it, in the same order in which mq_receive()
+ *   would have returned them, until either the queue is empty or all of
+ *   the buffers are filled.
+ *
+ *   Each buffer must be at least as large as the "mq_msgsize" attribute
+ *   of the message queue.  The length and the priority of each received
+ *   message are returned in its entry of 'msgvec'.
+ *
+ * Parameters:
+ *   mqdes  - Message Queue Descriptor
+ *   msgvec - The buffers to receive the messages
+ *   nvec   - The number of entries in 'msgvec'
+ *
+ * Return Value:
+ *   On success, the number of received messages (at least one) is
+ *   returned.  On failure, -1 (ERROR) is returned and the errno is set as
+ *   for mq_receive().  EINVAL is also returned if 'msgvec' is NULL or
+ *   'nvec' is not positive.
+ *
+ ****************************************************************************/
+
+ssize_t mq_receivev(mqd_t mqdes, FAR struct mq_msgvec *msgvec, int nvec)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	irqstate_t saved_state;
+	ssize_t nrecv = 0;
+	int i;
+
+	DEBUGASSERT(up_interrupt_context() == false);
+
+	/* mq_receivev() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	if (!msgvec || nvec <= 0) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	for (i = 0; i < nvec; i++) {
+		if (mq_verifyreceive(mqdes, msgvec[i].msg, msgvec[i].bufsize) != OK) {
+			leave_cancellation_point();
+			return ERROR;
+		}
+	}
+
+	/* Wait for the first message as mq_receive() does, with pre-emption
+	 * disabled until all of the messages have been received.
+	 */
+
+	sched_lock();
+
+	saved_state = irqsave();
+	mqmsg = mq_waitreceive(mqdes);
+	irqrestore(saved_state);
+
+	while (mqmsg) {
+		msgvec[nrecv].msglen = mq_doreceive(mqdes, mqmsg, msgvec[nrecv].msg, &msgvec[nrecv].prio);
+		if (++nrecv >= nvec) {
+			break;
+		}
+
+		/* Take the next message only if it is already there */
+
+		saved_state = irqsave();
+		mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&mqdes->msgq->msglist);
+		if (mqmsg) {
+			mqdes->msgq->nmsgs--;
+		}
+
+		irqrestore(saved_state);
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return nrecv > 0 ? nrecv : ERROR;
+}
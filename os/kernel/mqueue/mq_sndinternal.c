@@ -154,8 +154,8 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  * Description:
  *   The mq_msgalloc function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be taken from the slab of the
+ *   message queue if it has a free one, or else from the g_msgfree list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
  *   interrupt level, then the message will be allocated.  If a message
@@ -168,7 +168,7 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *   handler will be notified.
  *
  * Inputs:
- *   None
+ *   msgq - The message queue that the message will be sent to
  *
  * Return Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -176,11 +176,25 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *mq_msgalloc(void)
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq)
 {
 	FAR struct mqueue_msg_s *mqmsg;
 	irqstate_t saved_state;
 
+#ifdef CONFIG_MQ_SLAB
+	/* Messages of the queue's own slab are sized for it and need no search
+	 * of the system-wide pool.  These are used first, from any context.
+	 */
+
+	saved_state = irqsave();
+	mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msgslab);
+	irqrestore(saved_state);
+
+	if (mqmsg) {
+		return mqmsg;
+	}
+#endif
+
 	/* If we were called from an interrupt handler, then try to get the message
 	 * from generally available list of messages. If this fails, then try the
 	 * list of messages reserved for interrupt handlers
@@ -366,9 +380,13 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	mqmsg->priority = prio;
 	mqmsg->msglen = msglen;
 
-	/* Copy the message data into the message */
+	/* Copy the message data into the message, unless it was written there
+	 * in place (see mq_msgcommit())
+	 */
 
-	memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+	if (msg != mqmsg->mail) {
+		memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+	}
 
 	/* Insert the new message in the message queue */
 
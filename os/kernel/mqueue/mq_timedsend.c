@@ -253,7 +253,7 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio, FAR
 		/* Allocate the message */
 
 		irqrestore(saved_state);
-		mqmsg = mq_msgalloc();
+		mqmsg = mq_msgalloc(mqdes->msgq);
 	} else {
 		int ticks;
 
@@ -309,7 +309,7 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio, FAR
 		 */
 
 		if (ret == OK) {
-			mqmsg = mq_msgalloc();
+			mqmsg = mq_msgalloc(mqdes->msgq);
 		}
 	}
 
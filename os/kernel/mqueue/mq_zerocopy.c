@@ -0,0 +1,236 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/mqueue/mq_zerocopy.c
+ *
+ * Message queue interfaces that pass the message buffers themselves
+ * instead of copying the message data.  A sender reserves a buffer, writes
+ * the message into it and commits it to the queue; a receiver borrows the
+ * buffer of the received message and releases it when done.  The buffers
+ * are kernel memory, so these are available in the flat build only.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <mqueue.h>
+#include <sched.h>
+#include <debug.h>
+#include <tinyara/arch.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_msgreserve
+ *
+ * Description:
+ *   Reserve a message buffer of the message queue "mqdes".  The buffer can
+ *   hold "mq_msgsize" bytes.  It is taken from the message slab of the
+ *   queue when possible, so this does not wait for the queue to become
+ *   non-full; mq_msgcommit() does.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *
+ * Return Value:
+ *   The address of the message buffer on success.  On failure, NULL is
+ *   returned and the errno is set appropriately:
+ *
+ *   EINVAL   'mqdes' is NULL.
+ *   EPERM    Message queue opened not opened for writing.
+ *
+ ****************************************************************************/
+
+FAR void *mq_msgreserve(mqd_t mqdes)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+
+	if (!mqdes) {
+		set_errno(EINVAL);
+		return NULL;
+	}
+
+	if ((mqdes->oflags & O_WROK) == 0) {
+		set_errno(EPERM);
+		return NULL;
+	}
+
+	mqmsg = mq_msgalloc(mqdes->msgq);
+	if (!mqmsg) {
+		set_errno(ENOMEM);
+		return NULL;
+	}
+
+	return mqmsg->mail;
+}
+
+/****************************************************************************
+ * Name: mq_msgcommit
+ *
+ * Description:
+ *   Send the message that was written into a buffer from mq_msgreserve().
+ *   This behaves like mq_send(), except that the message is not copied.
+ *   On success the buffer belongs to the message queue again; on failure
+ *   it stays reserved and may be committed again or released.
+ *
+ * Parameters:
+ *   mqdes  - Message queue descriptor
+ *   msg    - The buffer returned by mq_msgreserve()
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Return Value:
+ *   As for mq_send().
+ *
+ ****************************************************************************/
+
+int mq_msgcommit(mqd_t mqdes, FAR void *msg, size_t msglen, int prio)
+{
+	FAR struct mqueue_inode_s *msgq;
+	irqstate_t saved_state;
+	int ret = ERROR;
+
+	/* mq_msgcommit() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	if (mq_verifysend(mqdes, msg, msglen, prio) != OK) {
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Wait until the message queue is not full, as mq_send() does */
+
+	sched_lock();
+	msgq = mqdes->msgq;
+
+	saved_state = irqsave();
+	if (up_interrupt_context() || msgq->nmsgs < msgq->maxmsgs || mq_waitsend(mqdes) == OK) {
+		irqrestore(saved_state);
+		ret = mq_dosend(mqdes, MQ_MSG_FROM_MAIL(msg), msg, msglen, prio);
+	} else {
+		irqrestore(saved_state);
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: mq_msgreceive
+ *
+ * Description:
+ *   Receive a message like mq_receive(), but instead of copying the
+ *   message, lend its buffer to the caller.  The buffer must be given back
+ *   with mq_msgrelease() before the message queue is closed.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *   msg   - The location to return the address of the message buffer
+ *   prio  - If not NULL, the location to store message priority
+ *
+ * Return Value:
+ *   As for mq_receive().
+ *
+ ****************************************************************************/
+
+ssize_t mq_msgreceive(mqd_t mqdes, FAR void **msg, FAR int *prio)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	irqstate_t saved_state;
+	ssize_t ret = ERROR;
+
+	DEBUGASSERT(up_interrupt_context() == false);
+
+	/* mq_msgreceive() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	if (!msg || !mqdes) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if ((mqdes->oflags & O_RDOK) == 0) {
+		set_errno(EPERM);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	sched_lock();
+
+	saved_state = irqsave();
+	mqmsg = mq_waitreceive(mqdes);
+	irqrestore(saved_state);
+
+	if (mqmsg) {
+		/* A NULL user buffer tells mq_doreceive() to keep the message */
+
+		ret = mq_doreceive(mqdes, mqmsg, NULL, prio);
+		*msg = mqmsg->mail;
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: mq_msgrelease
+ *
+ * Description:
+ *   Give back a message buffer that was lent by mq_msgreceive() or
+ *   reserved by mq_msgreserve() and not committed.
+ *
+ * Parameters:
+ *   mqdes - The message queue descriptor used to obtain the buffer
+ *   msg   - The message buffer
+ *
+ * Return Value:
+ *   0 (OK) on success.  On failure, -1 (ERROR) is returned and the errno
+ *   is set to EINVAL.
+ *
+ ****************************************************************************/
+
+int mq_msgrelease(mqd_t mqdes, FAR void *msg)
+{
+	if (!mqdes || !msg) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	mq_msgfree(mqdes->msgq, MQ_MSG_FROM_MAIL(msg));
+	return OK;
+}
+
+#endif							/* CONFIG_MQ_ZEROCOPY */
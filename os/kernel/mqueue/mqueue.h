@@ -63,6 +63,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <limits.h>
 #include <mqueue.h>
 #include <sched.h>
@@ -92,6 +93,18 @@
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* The size of a message structure that holds at most 'n' bytes of data,
+ * rounded up so that the messages of a slab stay pointer aligned.
+ */
+
+#define MQ_MSG_SIZE(n) \
+	((offsetof(struct mqueue_msg_s, mail) + (n) + sizeof(FAR void *) - 1) & ~(sizeof(FAR void *) - 1))
+
+/* The message structure that contains the data at 'p' */
+
+#define MQ_MSG_FROM_MAIL(p) \
+	((FAR struct mqueue_msg_s *)((FAR char *)(p) - offsetof(struct mqueue_msg_s, mail)))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -99,7 +112,8 @@
 enum mqalloc_e {
 	MQ_ALLOC_FIXED = 0,			/* pre-allocated; never freed */
 	MQ_ALLOC_DYN,				/* dynamically allocated; free when unused */
-	MQ_ALLOC_IRQ				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_IRQ,				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_SLAB				/* From the slab of its message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -108,12 +122,12 @@ struct mqueue_msg_s {
 	FAR struct mqueue_msg_s *next;	/* Forward link to next message */
 	uint8_t type;					/* (Used to manage allocations) */
 	uint8_t priority;				/* priority of message */
-#if MQ_MAX_BYTES < 256
+#if MQ_MAX_BYTES < 256 && !defined(CONFIG_MQ_ZEROCOPY)
 	uint8_t msglen;					/* Message data length */
 #else
-	uint16_t msglen;				/* Message data length */
+	uint16_t msglen;				/* Message data length (keeps mail 32-bit aligned) */
 #endif
-	char mail[MQ_MAX_BYTES];		/* Message data */
+	char mail[MQ_MAX_BYTES];		/* Message data (fewer bytes in a slab message) */
 };
 
 /****************************************************************************
@@ -156,7 +170,7 @@ void weak_function mq_initialize(void);
 void mq_desblockalloc(void);
 
 FAR struct mqueue_inode_s *mq_findnamed(FAR const char *mq_name);
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg);
+void mq_msgfree(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c ************************************************************/
 
@@ -171,7 +185,7 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 /* mq_sndinternal.c ********************************************************/
 
 int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio);
-FAR struct mqueue_msg_s *mq_msgalloc(void);
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg, size_t msglen, int prio);
 
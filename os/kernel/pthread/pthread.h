@@ -127,17 +127,28 @@ int pthread_sem_trytake(sem_t *sem);
 #endif
 int pthread_sem_give(sem_t *sem);
 
-#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+bool pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex);
+bool pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex);
+void pthread_mutex_addholder(FAR struct pthread_mutex_s *mutex);
+#else
+#define pthread_mutex_addholder(m)
+#endif
+
+#if !defined(CONFIG_PTHREAD_MUTEX_UNSAFE) || defined(CONFIG_PTHREAD_MUTEX_FASTPATH)
 int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
-void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
 #else
 #define pthread_mutex_take(m, i) pthread_sem_take(&(m)->sem, (i))
 #define pthread_mutex_trytake(m) pthread_sem_trytake(&(m)->sem)
 #define pthread_mutex_give(m)   pthread_sem_give(&(m)->sem)
 #endif
 
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
+#endif
+
 #if defined(CONFIG_CANCELLATION_POINTS) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 uint16_t pthread_disable_cancel(void);
 void pthread_enable_cancel(uint16_t oldstate);
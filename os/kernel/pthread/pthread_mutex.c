@@ -137,7 +137,22 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr)
 
 		if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0) {
 			ret = EOWNERDEAD;
-		} else {
+		}
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+		else if (pthread_mutex_fasttake(mutex)) {
+			/* The mutex was available and is ours now */
+
+			pthread_mutex_add(mutex);
+			ret = OK;
+		}
+#endif
+		else {
+			/* We will have to wait.  Make sure that the holder is known, so
+			 * that its priority can be boosted.
+			 */
+
+			pthread_mutex_addholder(mutex);
+
 			/* Take semaphore underlying the mutex.  pthread_sem_take
 			 * returns zero on success and a positive errno value on failure.
 			 */
@@ -200,7 +215,14 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
 
 		if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0) {
 			ret = EOWNERDEAD;
-		} else {
+		}
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+		else if (pthread_mutex_fasttake(mutex)) {
+			pthread_mutex_add(mutex);
+			ret = OK;
+		}
+#endif
+		else {
 			/* Try to take the semaphore underlying the mutex */
 
 			ret = sem_trywait(&mutex->sem);
@@ -270,7 +292,14 @@ int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
 
 		/* Now release the underlying semaphore */
 
-		ret = pthread_sem_give(&mutex->sem);
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+		if (pthread_mutex_fastgive(mutex)) {
+			ret = OK;
+		} else
+#endif
+		{
+			ret = pthread_sem_give(&mutex->sem);
+		}
 	}
 
 	return ret;
@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/pthread/pthread_mutexfast.c
+ *
+ * Fast path for uncontended mutexes.  An available mutex is taken, and a
+ * mutex that nobody waits for is given back, by updating the count of its
+ * semaphore with pre-emption disabled.  Interrupt handlers only change the
+ * count of a semaphore that has waiters, so no critical section is needed.
+ *
+ * The holder of a count taken this way is not recorded for priority
+ * inheritance; FLAGS_HOLDER_DEFERRED marks the semaphore instead.  The
+ * first thread that has to wait for the mutex records the holder (from
+ * mutex->pid) and clears the flag, so sem_wait() can boost the holder and
+ * sem_post() can restore its priority just as if the mutex had been taken
+ * with sem_wait().
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <unistd.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/sched.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fasttake
+ *
+ * Description:
+ *   Take the mutex if it is available, without recording the holder.
+ *
+ * Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Return Value:
+ *   true if the mutex was taken, false if the slow path must be used.
+ *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
+ ****************************************************************************/
+
+bool pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex)
+{
+	FAR sem_t *sem = &mutex->sem;
+
+	if (sem->semcount == 1 && (sem->flags & FLAGS_INITIALIZED) != 0) {
+		sem->semcount = 0;
+		sem->flags |= FLAGS_HOLDER_DEFERRED;
+
+		/* The holder is recorded here, in case a waiter comes before the
+		 * caller sets it.
+		 */
+
+		mutex->pid = getpid();
+		return true;
+	}
+
+	return false;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastgive
+ *
+ * Description:
+ *   Give back a mutex that was taken by pthread_mutex_fasttake() if nobody
+ *   has waited for it since.
+ *
+ * Parameters:
+ *  mutex - The mutex to be unlocked
+ *
+ * Return Value:
+ *   true if the mutex was given back, false if the slow path must be used.
+ *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
+ ****************************************************************************/
+
+bool pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex)
+{
+	FAR sem_t *sem = &mutex->sem;
+
+	if ((sem->flags & FLAGS_HOLDER_DEFERRED) != 0 && sem->semcount == 0) {
+		sem->flags &= ~FLAGS_HOLDER_DEFERRED;
+		sem->semcount = 1;
+		return true;
+	}
+
+	return false;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_addholder
+ *
+ * Description:
+ *   Record the holder of a mutex that was taken by pthread_mutex_fasttake().
+ *   This must be called before waiting for the mutex.  From then on, the
+ *   mutex is given back by sem_post().
+ *
+ * Parameters:
+ *  mutex - The mutex to be waited for
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
+ ****************************************************************************/
+
+void pthread_mutex_addholder(FAR struct pthread_mutex_s *mutex)
+{
+	FAR sem_t *sem = &mutex->sem;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	FAR struct tcb_s *htcb;
+	irqstate_t flags;
+#endif
+
+	if ((sem->flags & FLAGS_HOLDER_DEFERRED) != 0) {
+		sem->flags &= ~FLAGS_HOLDER_DEFERRED;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+		/* If the holder has exited, there is nobody to boost */
+
+		htcb = sched_gettcb(mutex->pid);
+		if (htcb != NULL) {
+			flags = irqsave();
+			sem_addholder_tcb(htcb, sem);
+			irqrestore(flags);
+		}
+#endif
+	}
+}
+
+#ifdef CONFIG_PTHREAD_MUTEX_UNSAFE
+/****************************************************************************
+ * Name: pthread_mutex_take, pthread_mutex_trytake and pthread_mutex_give
+ *
+ * Description:
+ *   Take, try to take and give the semaphore underlying the mutex, using
+ *   the fast path when possible.  These take the place of the robust
+ *   versions in pthread_mutex.c.
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr)
+{
+	int ret = OK;
+
+	sched_lock();
+	if (!pthread_mutex_fasttake(mutex)) {
+		pthread_mutex_addholder(mutex);
+		ret = pthread_sem_take(&mutex->sem, intr);
+	}
+
+	sched_unlock();
+	return ret;
+}
+
+int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
+{
+	int ret = OK;
+
+	sched_lock();
+	if (!pthread_mutex_fasttake(mutex)) {
+		ret = pthread_sem_trytake(&mutex->sem);
+	}
+
+	sched_unlock();
+	return ret;
+}
+
+int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
+{
+	int ret = OK;
+
+	sched_lock();
+	if (!pthread_mutex_fastgive(mutex)) {
+		ret = pthread_sem_give(&mutex->sem);
+	}
+
+	sched_unlock();
+	return ret;
+}
+#endif							/* CONFIG_PTHREAD_MUTEX_UNSAFE */
+
+#endif							/* CONFIG_PTHREAD_MUTEX_FASTPATH */
@@ -111,6 +111,9 @@ void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb)
 		/* Mark the mutex as INCONSISTENT and wake up any waiting thread */
 
 		mutex->flags |= _PTHREAD_MFLAGS_INCONSISTENT;
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+		mutex->sem.flags &= ~FLAGS_HOLDER_DEFERRED;
+#endif
 		(void)pthread_sem_give(&mutex->sem);
 	}
 
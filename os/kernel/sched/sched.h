@@ -278,6 +278,12 @@ void sched_timer_reassess(void);
 void weak_function sched_process_cpuload(void);
 #endif
 
+#ifdef CONFIG_SCHED_TASKSTATS
+void sched_taskstats_wakeup(FAR struct tcb_s *tcb);
+void sched_taskstats_switch(FAR struct tcb_s *tcb);
+void sched_taskstats_release(FAR struct tcb_s *tcb);
+#endif
+
 bool sched_verifytcb(FAR struct tcb_s *tcb);
 int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
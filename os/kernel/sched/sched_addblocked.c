@@ -129,4 +129,10 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state)
 	/* Make sure the TCB's state corresponds to the list */
 
 	btcb->task_state = task_state;
+
+#ifdef CONFIG_SCHED_TASKSTATS
+	/* A task that is blocked again before it ran has not woken up */
+
+	btcb->stats.waking = false;
+#endif
 }
@@ -185,6 +185,12 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
 		}
 #endif
 
+#ifdef CONFIG_SCHED_TASKSTATS
+		/* Stop charging run time to the task */
+
+		sched_taskstats_release(tcb);
+#endif
+
 		/* Release the task's process ID if one was assigned.  PID
 		 * zero is reserved for the IDLE task.  The TCB of the IDLE
 		 * task is never release so a value of zero simply means that
@@ -123,4 +123,10 @@ void sched_removeblocked(FAR struct tcb_s *btcb)
 	 */
 
 	btcb->task_state = TSTATE_TASK_INVALID;
+
+#ifdef CONFIG_SCHED_TASKSTATS
+	/* Start measuring the wakeup latency */
+
+	sched_taskstats_wakeup(btcb);
+#endif
 }
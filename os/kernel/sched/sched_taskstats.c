@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/sched/sched_taskstats.c
+ *
+ * Per-task scheduling statistics.  The architecture-specific context switch
+ * logic reports each switch with sched_taskstats_switch(); this charges the
+ * run time of the outgoing task and, if the incoming task was woken up,
+ * records the time it waited since sched_removeblocked() made it ready to
+ * run.  Totals for the whole system are kept as well, so that they survive
+ * the tasks that they were measured on.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_TASKSTATS
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* Totals for the whole system.  Only the counters and the histogram are
+ * used.
+ */
+
+static struct taskstats_s g_taskstats;
+
+/* The task that was last switched in and when.  This is NULL if that task
+ * has exited.
+ */
+
+static FAR struct tcb_s *g_taskstats_running;
+static uint64_t g_taskstats_switchtime;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_taskstats_now
+ *
+ * Description:
+ *   Return the current time in microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t sched_taskstats_now(void)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+	struct timespec ts;
+
+	(void)up_timer_gettime(&ts);
+	return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+#else
+	return (uint64_t)clock_systimer() * USEC_PER_TICK;
+#endif
+}
+
+/****************************************************************************
+ * Name: sched_taskstats_latency
+ *
+ * Description:
+ *   Add a wakeup latency to the statistics.
+ *
+ ****************************************************************************/
+
+static void sched_taskstats_latency(FAR struct taskstats_s *stats, uint32_t latency)
+{
+	int i;
+
+	for (i = 0; i < SCHED_TASKSTATS_NBUCKETS - 1; i++) {
+		if (latency < SCHED_TASKSTATS_LIMIT(i)) {
+			break;
+		}
+	}
+
+	stats->latency[i]++;
+	stats->nwakeups++;
+	stats->sumlatency += latency;
+	if (latency > stats->maxlatency) {
+		stats->maxlatency = latency;
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_taskstats_wakeup
+ *
+ * Description:
+ *   Note that a blocked task is being made ready to run.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sched_taskstats_wakeup(FAR struct tcb_s *tcb)
+{
+	tcb->stats.waketime = sched_taskstats_now();
+	tcb->stats.waking = true;
+}
+
+/****************************************************************************
+ * Name: sched_taskstats_switch
+ *
+ * Description:
+ *   Account for a context switch to 'tcb'.  This must be called by the
+ *   architecture-specific logic just before it restores the context of the
+ *   new task at the head of the ready-to-run list.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sched_taskstats_switch(FAR struct tcb_s *tcb)
+{
+	FAR struct tcb_s *otcb = g_taskstats_running;
+	uint64_t now = sched_taskstats_now();
+	uint64_t latency;
+
+	if (otcb == tcb) {
+		return;
+	}
+
+	if (otcb) {
+		otcb->stats.runtime += now - g_taskstats_switchtime;
+
+		/* A task that is switched out while it can still run was preempted */
+
+		if (otcb->task_state == TSTATE_TASK_READYTORUN) {
+			otcb->stats.npreempted++;
+			g_taskstats.npreempted++;
+		}
+	}
+
+	tcb->stats.nswitches++;
+	g_taskstats.nswitches++;
+
+	if (tcb->stats.waking) {
+		latency = now - tcb->stats.waketime;
+		if (latency > UINT32_MAX) {
+			latency = UINT32_MAX;
+		}
+
+		sched_taskstats_latency(&tcb->stats, (uint32_t)latency);
+		sched_taskstats_latency(&g_taskstats, (uint32_t)latency);
+		tcb->stats.waking = false;
+	}
+
+	g_taskstats_running = tcb;
+	g_taskstats_switchtime = now;
+}
+
+/****************************************************************************
+ * Name: sched_taskstats_release
+ *
+ * Description:
+ *   Forget a task whose TCB is being released.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sched_taskstats_release(FAR struct tcb_s *tcb)
+{
+	if (g_taskstats_running == tcb) {
+		g_taskstats_running = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: sched_taskstats
+ *
+ * Description:
+ *   Take a snapshot of the scheduling statistics of a task or, if 'tcb' is
+ *   NULL, of the whole system.
+ *
+ ****************************************************************************/
+
+void sched_taskstats(FAR struct tcb_s *tcb, FAR struct taskstats_s *stats)
+{
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (tcb) {
+		memcpy(stats, &tcb->stats, sizeof(struct taskstats_s));
+		if (tcb == g_taskstats_running) {
+			stats->runtime += sched_taskstats_now() - g_taskstats_switchtime;
+		}
+	} else {
+		memcpy(stats, &g_taskstats, sizeof(struct taskstats_s));
+	}
+
+	irqrestore(flags);
+}
+
+#endif							/* CONFIG_SCHED_TASKSTATS */
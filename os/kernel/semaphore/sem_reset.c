@@ -133,6 +133,10 @@ int sem_reset(FAR sem_t *sem, int16_t count)
 		sem->semcount = count;
 	}
 
+	/* Any count taken by a pthread mutex fast path is gone now */
+
+	sem->flags &= ~FLAGS_HOLDER_DEFERRED;
+
 	/* Allow any pending context switches to occur now */
 	irqrestore(flags);
 	sched_unlock();
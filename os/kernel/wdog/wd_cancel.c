@@ -108,8 +108,6 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
-	FAR struct wdog_s *curr;
-	FAR struct wdog_s *prev;
 	irqstate_t state;
 	int ret = ERROR;
 
@@ -124,54 +122,17 @@ int wd_cancel(WDOG_ID wdog)
 	 */
 
 	if (wdog && WDOG_ISACTIVE(wdog)) {
-		/* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-		 * to do this because there are additional operations that need to be
-		 * done.
+		/* Remove the watchdog from its slot of the timing wheel.  If it was
+		 * the next watchdog to expire, reassess the interval timer that will
+		 * generate the next interval event.
 		 */
 
-		prev = NULL;
-		curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-		while ((curr) && (curr != wdog)) {
-			prev = curr;
-			curr = curr->next;
-		}
-
-		/* Check if the watchdog was found in the list.  If not, then an OS
-		 * error has occurred because the watchdog is marked active!
-		 */
-
-		ASSERT(curr);
-
-		/* If there is a watchdog in the timer queue after the one that
-		 * is being cancelled, then it inherits the remaining ticks.
-		 */
-
-		if (curr->next) {
-			curr->next->lag += curr->lag;
-		}
-
-		/* Now, remove the watchdog from the timer queue */
-
-		if (prev) {
-			/* Remove the watchdog from mid- or end-of-queue */
-
-			(void)sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-		} else {
-			/* Remove the watchdog at the head of the queue */
-
-			(void)sq_remfirst(&g_wdactivelist);
-
-			/* Reassess the interval timer that will generate the next
-			 * interval event.
-			 */
-
+		if (wd_remove(wdog)) {
 			sched_timer_reassess();
 		}
 
 		/* Mark the watchdog inactive */
 
-		wdog->next = NULL;
 		WDOG_CLRACTIVE(wdog);
 
 		/* Return success */
@@ -110,20 +110,12 @@ int wd_gettime(WDOG_ID wdog)
 
 	flags = irqsave();
 	if (wdog && WDOG_ISACTIVE(wdog)) {
-		/* Traverse the watchdog list accumulating lag times until we find the wdog
-		 * that we are looking for
-		 */
-
-		FAR struct wdog_s *curr;
-		int delay = 0;
-
-		for (curr = (FAR struct wdog_s *)g_wdactivelist.head; curr; curr = curr->next) {
-			delay += curr->lag;
-			if (curr == wdog) {
-				irqrestore(flags);
-				return delay;
-			}
-		}
+		/* The watchdog expires at an absolute tick of the timing wheel */
+
+		int delay = (int)(int32_t)(wdog->expire - g_wdtick);
+
+		irqrestore(flags);
+		return delay;
 	}
 
 	irqrestore(flags);
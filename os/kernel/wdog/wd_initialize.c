@@ -78,12 +78,25 @@
 
 sq_queue_t g_wdfreelist;
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdwheel is the timing wheel holding the active watchdogs and g_wdmap
+ * is the bitmap of its non-empty slots.
  */
 
-sq_queue_t g_wdactivelist;
+dq_queue_t g_wdwheel[CONFIG_WDOG_WHEEL_SIZE];
+uint32_t g_wdmap[WDOG_WHEEL_NWORDS];
+
+/* The current time of the timing wheel */
+
+uint32_t g_wdtick;
+
+/* The cached expiration tick of the first watchdog to expire */
+
+uint32_t g_wdnext;
+bool g_wdnextvalid;
+
+/* This is the number of watchdogs in the timing wheel */
+
+uint16_t g_wdnactive;
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -137,7 +150,18 @@ void wd_initialize(void)
 	/* Initialize watchdog lists */
 
 	sq_init(&g_wdfreelist);
-	sq_init(&g_wdactivelist);
+
+	for (i = 0; i < CONFIG_WDOG_WHEEL_SIZE; i++) {
+		dq_init(&g_wdwheel[i]);
+	}
+
+	for (i = 0; i < WDOG_WHEEL_NWORDS; i++) {
+		g_wdmap[i] = 0;
+	}
+
+	g_wdtick = 0;
+	g_wdnextvalid = false;
+	g_wdnactive = 0;
 
 	/* The g_wdfreelist must be loaded at initialization time to hold the
 	 * configured number of watchdogs.
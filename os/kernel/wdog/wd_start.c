@@ -74,14 +74,6 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#ifndef MIN
-#define MIN(a, b) (((a) < (b)) ? (a) : (b))
-#endif
-
-#ifndef MAX
-#define MAX(a, b) (((a) > (b)) ? (a) : (b))
-#endif
-
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -115,8 +107,9 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
  * Name: wd_expiration
  *
  * Description:
- *   Check if the timer for the watchdog at the head of list is ready to
- *   run.  If so, remove the watchdog from the list and execute it.
+ *   Run the watchdogs in the timing wheel slot of the current tick that
+ *   are ready to run.  Watchdogs of later revolutions of the wheel are left
+ *   in the slot.
  *
  * Parameters:
  *   None
@@ -130,66 +123,65 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 
 static inline void wd_expiration(void)
 {
+	FAR dq_queue_t *slot = &g_wdwheel[WDOG_SLOT(g_wdtick)];
 	FAR struct wdog_s *wdog;
 
-	/* Check if the watchdog at the head of the list is ready to run */
-
-	if (((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0) {
-		/* Process the watchdog at the head of the list as well as any
-		 * other watchdogs that became ready to run at this time
-		 */
-
-		while (g_wdactivelist.head && ((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0) {
-			/* Remove the watchdog from the head of the list */
+	wdog = (FAR struct wdog_s *)slot->head;
+	while (wdog) {
+		/* Skip the watchdogs that expire on a later revolution */
 
-			wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdactivelist);
+		if ((int32_t)(wdog->expire - g_wdtick) > 0) {
+			wdog = wdog->next;
+			continue;
+		}
 
-			/* If there is another watchdog behind this one, update its
-			 * its lag (this shouldn't be necessary).
-			 */
+		/* Remove the watchdog from the timing wheel */
 
-			if (g_wdactivelist.head) {
-				((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
-			}
+		(void)wd_remove(wdog);
 
-			/* Indicate that the watchdog is no longer active. */
+		/* Indicate that the watchdog is no longer active. */
 
-			WDOG_CLRACTIVE(wdog);
+		WDOG_CLRACTIVE(wdog);
 
-			/* Execute the watchdog function */
+		/* Execute the watchdog function */
 
-			up_setpicbase(wdog->picbase);
-			switch (wdog->argc) {
-			default:
-				DEBUGPANIC();
-				break;
+		up_setpicbase(wdog->picbase);
+		switch (wdog->argc) {
+		default:
+			DEBUGPANIC();
+			break;
 
-			case 0:
-				(*((wdentry0_t)(wdog->func)))(0);
-				break;
+		case 0:
+			(*((wdentry0_t)(wdog->func)))(0);
+			break;
 
 #if CONFIG_MAX_WDOGPARMS > 0
-			case 1:
-				(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-				break;
+		case 1:
+			(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+			break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 1
-			case 2:
-				(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
-				break;
+		case 2:
+			(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+			break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 2
-			case 3:
-				(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-				break;
+		case 3:
+			(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+			break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 3
-			case 4:
-				(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
-				break;
+		case 4:
+			(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
+			break;
 #endif
-			}
 		}
+
+		/* The watchdog function may have started or cancelled other
+		 * watchdogs in this slot, so start over at the head of the slot.
+		 */
+
+		wdog = (FAR struct wdog_s *)slot->head;
 	}
 }
 
@@ -233,10 +225,6 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 {
 	va_list ap;
-	FAR struct wdog_s *curr;
-	FAR struct wdog_s *prev;
-	FAR struct wdog_s *next;
-	int32_t now;
 	irqstate_t state;
 	int i;
 
@@ -284,94 +272,23 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	}
 #ifdef CONFIG_SCHED_TICKLESS
 	/* Cancel the interval timer that drives the timing events.  This will cause
-	 * wd_timer to be called which update the delay value for the first time
-	 * at the head of the timer list (there is a possibility that it could even
-	 * remove it).
+	 * wd_timer to be called which advances the timing wheel by the time
+	 * elapsed in the current interval (there is a possibility that it could
+	 * even run some watchdogs).
 	 */
 
 	(void)sched_timer_cancel();
 #endif
 
-	/* Do the easy case first -- when the watchdog timer queue is empty. */
-
-	if (g_wdactivelist.head == NULL) {
-		/* Add the watchdog to the head == tail of the queue. */
-
-		sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-	}
-
-	/* There are other active watchdogs in the timer queue */
-
-	else {
-		now = 0;
-		prev = curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-		/* Advance to positive time */
-
-		while ((now += curr->lag) < 0 && curr->next) {
-			prev = curr;
-			curr = curr->next;
-		}
-
-		/* Advance past shorter delays */
-
-		while (now <= delay && curr->next) {
-			prev = curr;
-			curr = curr->next;
-			now += curr->lag;
-		}
-
-		/* Check if the new wdog must be inserted before the curr. */
-
-		if (delay < now) {
-			/* The relative delay time is smaller or equal to the current delay
-			 * time, so decrement the current delay time by the new relative
-			 * delay time.
-			 */
+	/* Hash the watchdog into the timing wheel and mark it as active. */
 
-			delay -= (now - curr->lag);
-			curr->lag -= delay;
-
-			/* Insert the new watchdog in the list */
-
-			if (curr == (FAR struct wdog_s *)g_wdactivelist.head) {
-				/* Insert the watchdog at the head of the list */
-
-				sq_addfirst((FAR sq_entry_t *)wdog, &g_wdactivelist);
-			} else {
-				/* Insert the watchdog in mid- or end-of-queue */
-
-				sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)wdog, &g_wdactivelist);
-
-			}
-		}
-
-		/* The new watchdog delay time is greater than the curr delay time,
-		 * so the new wdog must be inserted after the curr. This only occurs
-		 * if the wdog is to be added to the end of the list.
-		 */
-
-		else {
-			delay -= now;
-			if (!curr->next) {
-				sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-			} else {
-				next = curr->next;
-				next->lag -= delay;
-				sq_addafter((FAR sq_entry_t *)curr, (FAR sq_entry_t *)wdog, &g_wdactivelist);
-			}
-		}
-	}
-
-	/* Put the lag into the watchdog structure and mark it as active. */
-
-	wdog->lag = delay;
+	wd_insert(wdog, delay);
 	WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
 	/* Resume the interval timer that will generate the next interval event.
-	 * If the timer at the head of the list changed, then this will pick that
-	 * new delay.
+	 * If the new watchdog is now the first to expire, then this will pick its
+	 * delay.
 	 */
 
 	sched_timer_resume();
@@ -409,55 +326,57 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
 {
-	FAR struct wdog_s *wdog;
-	int decr;
-
-	/* Check if there are any active watchdogs to process */
+	int delay;
 
-	while (g_wdactivelist.head && ticks > 0) {
-		/* Get the watchdog at the head of the list */
-
-		wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+	/* Advance the timing wheel to the expiration tick of each watchdog that
+	 * expires in this interval and run the watchdogs of that tick.
+	 */
 
+	while (ticks > 0) {
+		delay = wd_nextdelay();
+		if (delay < 0) {
+			break;
+		}
 #ifndef CONFIG_SCHED_TICKLESS_ALARM
 		/* There is logic to handle the case where ticks is greater than
-		 * the watchdog lag, but if the scheduling is working properly
-		 * that should never happen.
+		 * the delay of the next watchdog, but if the scheduling is working
+		 * properly that should never happen.
 		 */
 
-		DEBUGASSERT(ticks <= wdog->lag);
+		DEBUGASSERT(ticks <= delay);
 #endif
-		/* Decrement the lag for this watchdog. */
-
-		decr = MIN(wdog->lag, ticks);
-
-		/* There are.  Decrement the lag counter */
-
-		wdog->lag -= decr;
-		ticks -= decr;
+		if (delay > ticks) {
+			break;
+		}
 
-		/* Check if the watchdog at the head of the list is ready to run */
+		g_wdtick += delay;
+		ticks -= delay;
 
 		wd_expiration();
 	}
 
+	/* Account for the rest of the interval */
+
+	g_wdtick += ticks;
+
 	/* Return the delay for the next watchdog to expire */
 
-	return g_wdactivelist.head ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+	delay = wd_nextdelay();
+	return delay > 0 ? (unsigned int)delay : 0;
 }
 
 #else
 void wd_timer(void)
 {
-	/* Check if there are any active watchdogs to process */
+	int slot;
 
-	if (g_wdactivelist.head) {
-		/* There are.  Decrement the lag counter */
+	/* Advance the timing wheel by one tick */
 
-		--(((FAR struct wdog_s *)g_wdactivelist.head)->lag);
+	slot = WDOG_SLOT(++g_wdtick);
 
-		/* Check if the watchdog at the head of the list is ready to run */
+	/* Check if there are any watchdogs to process in the new slot */
 
+	if ((g_wdmap[slot >> 5] & ((uint32_t)1 << (slot & 31))) != 0) {
 		wd_expiration();
 	}
 }
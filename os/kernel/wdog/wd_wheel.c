@@ -0,0 +1,210 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/wdog/wd_wheel.c
+ *
+ * Timing wheel operations on the active watchdogs.  A watchdog is hashed
+ * into the slot of its absolute expiration tick, so starting and cancelling
+ * a watchdog take constant time whatever the number of active watchdogs.
+ * Each slot may also hold watchdogs of later revolutions of the wheel; the
+ * expiration logic skips those until their own tick comes.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDOG_MAPBIT(s)     ((uint32_t)1 << ((s) & 31))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel so that it expires after 'delay'
+ *   ticks of the wheel.
+ *
+ * Parameters:
+ *   wdog  - The watchdog to add.  It must not be active.
+ *   delay - The delay in ticks.  Must be greater than zero.
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void wd_insert(FAR struct wdog_s *wdog, int delay)
+{
+	uint32_t expire = g_wdtick + (uint32_t)delay;
+	int slot = WDOG_SLOT(expire);
+
+	/* Watchdogs with the same expiration tick are added behind each other,
+	 * so they run in the order they were started.
+	 */
+
+	wdog->expire = expire;
+	dq_addlast((FAR dq_entry_t *)wdog, &g_wdwheel[slot]);
+	g_wdmap[slot >> 5] |= WDOG_MAPBIT(slot);
+
+	/* Keep the cached first expiration up to date */
+
+	if (g_wdnactive++ == 0) {
+		g_wdnext = expire;
+		g_wdnextvalid = true;
+	} else if (g_wdnextvalid && (int32_t)(expire - g_wdnext) < 0) {
+		g_wdnext = expire;
+	}
+}
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Parameters:
+ *   wdog - The watchdog to remove
+ *
+ * Return Value:
+ *   True if the watchdog was the next one to expire.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+bool wd_remove(FAR struct wdog_s *wdog)
+{
+	int slot = WDOG_SLOT(wdog->expire);
+	bool first;
+
+	dq_rem((FAR dq_entry_t *)wdog, &g_wdwheel[slot]);
+	if (dq_empty(&g_wdwheel[slot])) {
+		g_wdmap[slot >> 5] &= ~WDOG_MAPBIT(slot);
+	}
+
+	wdog->next = NULL;
+	wdog->prev = NULL;
+	g_wdnactive--;
+
+	/* If the cached first expiration is unknown, assume that this was the
+	 * first watchdog.  Otherwise, forget the cached value only if it was
+	 * this watchdog's; it will be looked up again when it is next needed.
+	 */
+
+	first = !g_wdnextvalid || wdog->expire == g_wdnext;
+	if (first) {
+		g_wdnextvalid = false;
+	}
+
+	return first;
+}
+
+/****************************************************************************
+ * Name: wd_nextdelay
+ *
+ * Description:
+ *   Return the number of ticks until the next watchdog expires.
+ *
+ * Parameters:
+ *   None
+ *
+ * Return Value:
+ *   The delay in ticks of the first watchdog to expire, or a negative
+ *   value if there are no active watchdogs.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+int wd_nextdelay(void)
+{
+	FAR struct wdog_s *wdog;
+	uint32_t bits;
+	int32_t remaining;
+	int32_t best;
+	int offset;
+	int slot;
+
+	if (g_wdnactive == 0) {
+		return -1;
+	}
+
+	if (!g_wdnextvalid) {
+		/* Visit the non-empty slots in order of their distance from the
+		 * current tick.  A watchdog expiring within one revolution is in
+		 * the slot at that distance, so the search ends as soon as the
+		 * distance reaches the shortest delay found so far.
+		 */
+
+		best = INT32_MAX;
+		offset = 0;
+
+		while (offset < CONFIG_WDOG_WHEEL_SIZE && offset < best) {
+			slot = WDOG_SLOT(g_wdtick + offset);
+			bits = g_wdmap[slot >> 5] >> (slot & 31);
+			if (bits == 0) {
+				/* Skip the rest of this word of the bitmap */
+
+				offset += 32 - (slot & 31);
+				continue;
+			}
+
+			while ((bits & 1) == 0) {
+				bits >>= 1;
+				offset++;
+			}
+
+			slot = WDOG_SLOT(g_wdtick + offset);
+			for (wdog = (FAR struct wdog_s *)g_wdwheel[slot].head; wdog; wdog = wdog->next) {
+				remaining = (int32_t)(wdog->expire - g_wdtick);
+				if (remaining < best) {
+					best = remaining;
+					g_wdnext = wdog->expire;
+				}
+			}
+
+			offset++;
+		}
+
+		g_wdnextvalid = true;
+	}
+
+	return (int)(int32_t)(g_wdnext - g_wdtick);
+}
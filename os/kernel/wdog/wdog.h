@@ -61,6 +61,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <queue.h>
 
 #include <tinyara/compiler.h>
 #include <tinyara/wdog.h>
@@ -69,6 +70,23 @@
  * Pre-processor Definitions
  ************************************************************************/
 
+/* Active watchdogs are hashed by their expiration tick into the slots of
+ * a timing wheel.  The occupancy of the slots is kept in a bitmap of
+ * 32-bit words, so the wheel size must be a power of two of at least 32.
+ */
+
+#ifndef CONFIG_WDOG_WHEEL_SIZE
+#define CONFIG_WDOG_WHEEL_SIZE 64
+#endif
+
+#if CONFIG_WDOG_WHEEL_SIZE < 32 || (CONFIG_WDOG_WHEEL_SIZE & (CONFIG_WDOG_WHEEL_SIZE - 1)) != 0
+#error CONFIG_WDOG_WHEEL_SIZE must be a power of two of at least 32
+#endif
+
+#define WDOG_WHEEL_MASK    (CONFIG_WDOG_WHEEL_SIZE - 1)
+#define WDOG_WHEEL_NWORDS  (CONFIG_WDOG_WHEEL_SIZE / 32)
+#define WDOG_SLOT(t)       ((t) & WDOG_WHEEL_MASK)
+
 /************************************************************************
  * Public Type Declarations
  ************************************************************************/
@@ -90,12 +108,33 @@ extern "C" {
 
 extern sq_queue_t g_wdfreelist;
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdwheel is the timing wheel holding the active watchdogs.  Each slot
+ * is a doubly linked list of the watchdogs whose expiration tick hashes to
+ * that slot, in the order they were started.  g_wdmap has one bit set for
+ * each slot that is not empty.
  */
 
-extern sq_queue_t g_wdactivelist;
+extern dq_queue_t g_wdwheel[CONFIG_WDOG_WHEEL_SIZE];
+extern uint32_t g_wdmap[WDOG_WHEEL_NWORDS];
+
+/* g_wdtick is the current time of the timing wheel.  It advances by one on
+ * each timer tick or, if CONFIG_SCHED_TICKLESS is defined, by the number of
+ * ticks in each interval that expires.
+ */
+
+extern uint32_t g_wdtick;
+
+/* g_wdnext caches the expiration tick of the first watchdog to expire.  It
+ * is only meaningful when g_wdnextvalid is true; it is recomputed lazily
+ * after the watchdog that it refers to is removed from the wheel.
+ */
+
+extern uint32_t g_wdnext;
+extern bool g_wdnextvalid;
+
+/* This is the number of watchdogs in the timing wheel */
+
+extern uint16_t g_wdnactive;
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -129,6 +168,66 @@ extern uint16_t g_wdnfree;
 
 void weak_function wd_initialize(void);
 
+/************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel so that it expires after 'delay'
+ *   ticks of the wheel.
+ *
+ * Parameters:
+ *   wdog  - The watchdog to add.  It must not be active.
+ *   delay - The delay in ticks.  Must be greater than zero.
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ************************************************************************/
+
+void wd_insert(FAR struct wdog_s *wdog, int delay);
+
+/************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Parameters:
+ *   wdog - The watchdog to remove
+ *
+ * Return Value:
+ *   True if the watchdog was the next one to expire.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ************************************************************************/
+
+bool wd_remove(FAR struct wdog_s *wdog);
+
+/************************************************************************
+ * Name: wd_nextdelay
+ *
+ * Description:
+ *   Return the number of ticks until the next watchdog expires.
+ *
+ * Parameters:
+ *   None
+ *
+ * Return Value:
+ *   The delay in ticks of the first watchdog to expire, or a negative
+ *   value if there are no active watchdogs.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ************************************************************************/
+
+int wd_nextdelay(void);
+
 /****************************************************************************
  * Name: wd_timer
  *
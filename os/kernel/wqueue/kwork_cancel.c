@@ -111,7 +111,7 @@
 
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
 {
-	struct work_s *cur_work;
+	FAR struct dq_queue_s *queue;
 	irqstate_t flags;
 	int ret = -ENOENT;
 
@@ -124,29 +124,22 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wo
 
 	flags = irqsave();
 	if (work->worker != NULL) {
-		/* A little test of the integrity of the work queue */
+		/* Work that is ready to be performed has no delay left; all other
+		 * queued work is still waiting on the delayed queue.
+		 */
 
-		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail);
-		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head);
+		queue = work->delay == 0 ? &wqueue->q : &wqueue->delayed;
 
-		/* check whether requested work is in queue list or not */
-		cur_work = (struct work_s *)wqueue->q.head;
-		do {
-			if (cur_work == NULL) {
-				irqrestore(flags);
-				return -ENOENT;
-			} else if (cur_work == work) {
-				break;
-			}
+		/* A little test of the integrity of the work queue */
 
-			cur_work = (struct work_s *)cur_work->dq.flink;
-		} while (1);
+		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == queue->tail);
+		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == queue->head);
 
 		/* Remove the entry from the work queue and make sure that it is
 		 * mark as available (i.e., the worker field is nullified).
 		 */
 
-		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+		dq_rem((FAR dq_entry_t *)work, queue);
 		work->worker = NULL;
 		ret = OK;
 	}
@@ -212,6 +212,7 @@ int work_lpstart(void)
 
 	g_lpwork.delay = CONFIG_SCHED_LPWORKPERIOD / USEC_PER_TICK;
 	dq_init(&g_lpwork.q);
+	dq_init(&g_lpwork.delayed);
 
 	/* Don't permit any of the threads to run until we have fully initialized
 	 * g_lpwork.
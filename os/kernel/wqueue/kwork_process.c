@@ -126,15 +126,16 @@
  ****************************************************************************/
 void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 {
-	volatile FAR struct work_s *work;
+	FAR struct work_s *work;
+	FAR struct work_s *next_work;
 	worker_t worker;
 	irqstate_t flags;
 	FAR void *arg;
 	clock_t elapsed;
-#ifndef CONFIG_SCHED_WORKQUEUE_SORTING
 	clock_t remaining;
-#endif
+#ifndef CONFIG_SCHED_WORKQUEUE_SORTING
 	clock_t stick;
+#endif
 	clock_t ctick;
 	clock_t next;
 
@@ -142,113 +143,98 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 	 * we process items in the work list.
 	 */
 
-	next = period;
 	flags = irqsave();
 
+#ifndef CONFIG_SCHED_WORKQUEUE_SORTING
 	/* Get the time that we started this polling cycle in clock ticks. */
 
 	stick = clock_systimer();
+#endif
 
-	/* And check each entry in the work queue.  Since we have disabled
-	 * interrupts we know:  (1) we will not be suspended unless we do
-	 * so ourselves, and (2) there will be no changes to the work queue
-	 */
-
-	work = (FAR struct work_s *)wqueue->q.head;
-	while (work) {
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
-		 * to the work queue.  It will always be greater than or equal to
-		 * zero.  Therefore a delay of zero will always execute immediately.
+	for (;;) {
+		/* Move the delayed work whose delay has elapsed to the ready queue
+		 * and find out when the next delayed work will be ready.  qtime is
+		 * the time that the work was added to the work queue.  Ready work
+		 * is marked by a zero delay.
 		 */
 
+		next = period;
 		ctick = clock_systimer();
-		elapsed = ctick - work->qtime;
-
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
-
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
-
-			worker = work->worker;
+		work = (FAR struct work_s *)wqueue->delayed.head;
+		while (work) {
+			next_work = (FAR struct work_s *)work->dq.flink;
+			elapsed = ctick - work->qtime;
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+			if (elapsed >= work->delay) {
+				dq_rem((FAR dq_entry_t *)work, &wqueue->delayed);
+				work->delay = 0;
+				dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+			} else {
+				remaining = work->delay - elapsed;
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
+				/* The delayed work is sorted, so none of the rest is
+				 * ready either.
+				 */
 
-				arg = work->arg;
+				next = remaining;
+				break;
+#else
+				if (remaining < next) {
+					/* Schedule to wake up when the work is ready */
 
-				/* Mark the work as no longer being queued */
+					next = remaining;
+				}
+#endif
+			}
 
-				work->worker = NULL;
+			work = next_work;
+		}
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
+		/* Take the oldest work that is ready to execute */
 
-				irqrestore(flags);
-				worker(arg);
+		work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+		if (work == NULL) {
+			break;
+		}
 
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
+		 */
 
-				flags = irqsave();
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
+		worker = work->worker;
 
-				work = (FAR struct work_s *)work->dq.flink;
-			}
-		} else {				/* elapsed < work->delay */
+		/* Check for a race condition where the work may be nullified
+		 * before it is removed from the queue.
+		 */
 
-			/* This one is not ready.
-			 *
-			 * NOTE that elapsed is relative to the the current time,
-			 * not the time of beginning of this queue processing pass.
-			 * So it may need an adjustment.
-			 */
+		if (worker != NULL) {
+			/* Extract the work argument (before re-enabling interrupts) */
 
-			elapsed += (ctick - stick);
-			if (elapsed > work->delay) {
-				/* The delay has expired while we are processing */
+			arg = work->arg;
 
-				elapsed = work->delay;
-			}
+			/* Mark the work as no longer being queued */
 
-			/* Will it be ready before the next scheduled wakeup interval? */
+			work->worker = NULL;
 
-#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
-			next = work->delay - elapsed;
+			/* Do the work.  Re-enable interrupts while the work is being
+			 * performed... we don't have any idea how long this will take!
+			 */
 
-			/* Then break at while loop due to sorted list */
-			break;
-#else
-			remaining = work->delay - elapsed;
-			if (remaining < next) {
-				/* Yes.. Then schedule to wake up when the work is ready */
-				next = remaining;
-			}
+			irqrestore(flags);
+			worker(arg);
 
-			/* Then try the next in the list. */
+			/* Time has passed and the queues may have changed while
+			 * interrupts were enabled, so check the delayed work again.
+			 */
 
-			work = (FAR struct work_s *)work->dq.flink;
-#endif
+			flags = irqsave();
 		}
 	}
 
 #ifdef CONFIG_SCHED_WORKQUEUE_SORTING
-	if ((FAR struct work_s *)wqueue->q.head == NULL) {
+	if ((FAR struct work_s *)wqueue->delayed.head == NULL) {
 		period = 0;
 	}
 #endif
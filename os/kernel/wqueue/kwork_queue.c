@@ -120,27 +120,23 @@
 
 static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay)
 {
-	struct work_s *cur_work;
-	struct work_s *next_work;
+#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
+	FAR struct work_s *prev;
+	clock_t elapsed;
+#endif
 	irqstate_t flags;
 	DEBUGASSERT(work != NULL);
 
-	next_work = NULL;
 	flags = irqsave();
 
-	/* check whether requested work is in queue list or not */
-	cur_work = (struct work_s *)wqueue->q.head;
-	while (cur_work != NULL) {
-		if (cur_work == work) {
-			irqrestore(flags);
-			return -EALREADY;
-		}
-
-		if ((cur_work->delay > delay) && (next_work == NULL)) {
-			next_work = cur_work;
-		}
+	/* Check whether the requested work is already queued.  The worker field
+	 * is nullified when queued work is performed or cancelled, so it is
+	 * non-NULL only for work that is still in one of the queues.
+	 */
 
-		cur_work = (struct work_s *)cur_work->dq.flink;
+	if (work->worker != NULL) {
+		irqrestore(flags);
+		return -EALREADY;
 	}
 
 	work->worker = worker;		/* Work callback */
@@ -148,15 +144,36 @@ static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wor
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = clock_systimer();	/* Time work queued */
 
-#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
-	if (next_work) {
-		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
-	} else {
+	if (delay == 0) {
+		/* The work is ready to be performed now */
+
 		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
-	}
+	} else {
+#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
+		/* Keep the delayed work sorted by expiration time.  Search from the
+		 * tail: work queued with the same delay as the work before it goes
+		 * right there.
+		 */
+
+		prev = (FAR struct work_s *)wqueue->delayed.tail;
+		while (prev != NULL) {
+			elapsed = work->qtime - prev->qtime;
+			if (elapsed >= prev->delay || prev->delay - elapsed <= delay) {
+				break;
+			}
+
+			prev = (FAR struct work_s *)prev->dq.blink;
+		}
+
+		if (prev) {
+			dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work, &wqueue->delayed);
+		} else {
+			dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayed);
+		}
 #else
-	dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+		dq_addlast((FAR dq_entry_t *)work, &wqueue->delayed);
 #endif
+	}
 
 	irqrestore(flags);
 
@@ -88,7 +88,8 @@ struct kworker_s {
 
 struct kwork_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct dq_queue_s delayed;	/* The queue of work waiting for its delay */
 	struct kworker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -99,7 +100,8 @@ struct kwork_wqueue_s {
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct dq_queue_s delayed;	/* The queue of work waiting for its delay */
 	struct kworker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -111,7 +113,8 @@ struct hp_wqueue_s {
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct dq_queue_s delayed;	/* The queue of work waiting for its delay */
 
 	/* Describes each thread in the low priority queue's thread pool */
 
@@ -19,6 +19,7 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <unistd.h>
 #ifdef CONFIG_ARCH_LOWPUTC
 #include <sched.h>
@@ -44,9 +45,35 @@ static void logm_putc(FAR struct lib_outstream_s *this, int ch)
 	}
 }
 
+static void logm_write(FAR struct lib_outstream_s *this, FAR const char *buf, size_t len)
+{
+	int pos = (g_logm_tail + this->nput) % logm_bufsize;
+	size_t room = (g_logm_head - pos - 1 + logm_bufsize) % logm_bufsize;
+	size_t chunk;
+
+	/* Same policy as logm_putc: what does not fit is dropped */
+
+	if (len > room) {
+		len = room;
+	}
+	this->nput += len;
+
+	while (len > 0) {
+		chunk = logm_bufsize - pos;
+		if (chunk > len) {
+			chunk = len;
+		}
+		memcpy(&g_logm_rsvbuf[pos], buf, chunk);
+		buf += chunk;
+		len -= chunk;
+		pos = 0;
+	}
+}
+
 static void logm_outstream(FAR struct lib_outstream_s *outstream)
 {
 	outstream->put = logm_putc;
+	outstream->write = logm_write;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	outstream->flush = lib_noflush;
 #endif
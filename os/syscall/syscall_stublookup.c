@@ -302,6 +302,8 @@ uintptr_t STUB_mq_open(int nbr, uintptr_t parm1, uintptr_t parm2,
 					   uintptr_t parm6);
 uintptr_t STUB_mq_receive(int nbr, uintptr_t parm1, uintptr_t parm2,
 						  uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_mq_receivev(int nbr, uintptr_t parm1, uintptr_t parm2,
+						   uintptr_t parm3);
 uintptr_t STUB_mq_send(int nbr, uintptr_t parm1, uintptr_t parm2,
 					   uintptr_t parm3, uintptr_t parm4);
 uintptr_t STUB_mq_setattr(int nbr, uintptr_t parm1, uintptr_t parm2,
@@ -0,0 +1,678 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/mkromfsx.c
+ *
+ * Make an extended ROMFS image (see os/fs/romfs/fs_romfs.h) from a
+ * directory tree.  The layout is the one of genromfs, with a sorted index
+ * after the entries of each directory and, with -c, run-length compressed
+ * file data for the files that it makes smaller.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+/* These must agree with os/fs/romfs/fs_romfs.h */
+
+#define ROMFS_XMAGIC        "-rom1fx-"
+#define ROMFS_ALIGNUP(a)    (((a) + 15) & ~15)
+
+#define RFNEXT_HARDLINK     0
+#define RFNEXT_DIRECTORY    1
+#define RFNEXT_FILE         2
+#define RFNEXT_EXEC         8
+
+#define ROMFS_HASH_BASIS    2166136261u
+#define ROMFS_HASH_PRIME    16777619u
+
+#define ROMFS_RLE_BLOCKSIZE 4096
+#define ROMFS_RLE_RUN       128
+#define ROMFS_RLE_MINRUN    3
+#define ROMFS_RLE_MAXRUN    130
+#define ROMFS_RLE_MAXLITERAL 128
+
+#define MAX_EXCLUDES        16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct node_s {
+	char *name;
+	char *path;
+	bool isdir;
+	bool isexec;
+	uint32_t size;				/* Size of a regular file */
+	int nchildren;				/* Children of a directory, sorted by name */
+	struct node_s **children;
+};
+
+struct image_s {
+	uint8_t *data;
+	uint32_t size;
+	uint32_t alloc;
+};
+
+struct index_s {
+	uint32_t hash;
+	uint32_t offset;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_exclude[MAX_EXCLUDES];
+static int g_nexclude;
+static bool g_compress;
+
+/* Statistics */
+
+static unsigned long g_nfiles;
+static unsigned long g_ndirs;
+static unsigned long g_ncompressed;
+static unsigned long g_filebytes;
+static unsigned long g_storedbytes;
+static unsigned long g_linearprobes;
+static unsigned long g_indexprobes;
+static unsigned long g_nlookups;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+	fprintf(stderr, "USAGE: %s [-c] [-V <volname>] [-x <name>] <directory> <image>\n", progname);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "Where:\n");
+	fprintf(stderr, "  -c            Run-length compress the files that become smaller\n");
+	fprintf(stderr, "  -V <volname>  Volume name (default: \"rom 1\")\n");
+	fprintf(stderr, "  -x <name>     Exclude files and directories with this name\n");
+	fprintf(stderr, "  <directory>   The directory tree to put in the image\n");
+	fprintf(stderr, "  <image>       The path to the output image file\n");
+	exit(exitcode);
+}
+
+static void *xmalloc(size_t size)
+{
+	void *ptr = malloc(size);
+
+	if (!ptr) {
+		fprintf(stderr, "ERROR: Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ptr;
+}
+
+static uint32_t romfs_hash(const char *name)
+{
+	uint32_t hash = ROMFS_HASH_BASIS;
+
+	while (*name) {
+		hash ^= (uint8_t)*name++;
+		hash *= ROMFS_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+static int compare_nodes(const void *a, const void *b)
+{
+	return strcmp((*(struct node_s *const *)a)->name, (*(struct node_s *const *)b)->name);
+}
+
+static int compare_index(const void *a, const void *b)
+{
+	const struct index_s *ia = a;
+	const struct index_s *ib = b;
+
+	if (ia->hash != ib->hash) {
+		return ia->hash < ib->hash ? -1 : 1;
+	}
+
+	return ia->offset < ib->offset ? -1 : 1;
+}
+
+static bool excluded(const char *name)
+{
+	int i;
+
+	for (i = 0; i < g_nexclude; i++) {
+		if (strcmp(name, g_exclude[i]) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Read a directory tree into memory */
+
+static struct node_s *scan_tree(const char *path, const char *name)
+{
+	struct node_s *node;
+	struct dirent *entry;
+	struct stat buf;
+	DIR *dirp;
+	char *child;
+	int alloc;
+
+	if (stat(path, &buf) < 0) {
+		fprintf(stderr, "ERROR: Cannot stat %s: %s\n", path, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	node = xmalloc(sizeof(struct node_s));
+	memset(node, 0, sizeof(struct node_s));
+	node->name = strdup(name);
+	node->path = strdup(path);
+
+	if (S_ISREG(buf.st_mode)) {
+		node->size = (uint32_t)buf.st_size;
+		node->isexec = (buf.st_mode & S_IXUSR) != 0;
+		g_nfiles++;
+		g_filebytes += node->size;
+		return node;
+	}
+
+	if (!S_ISDIR(buf.st_mode)) {
+		fprintf(stderr, "WARNING: Skipping %s (not a file or directory)\n", path);
+		free(node);
+		return NULL;
+	}
+
+	node->isdir = true;
+	g_ndirs++;
+
+	dirp = opendir(path);
+	if (!dirp) {
+		fprintf(stderr, "ERROR: Cannot open %s: %s\n", path, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	alloc = 0;
+	while ((entry = readdir(dirp)) != NULL) {
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0 || excluded(entry->d_name)) {
+			continue;
+		}
+
+		if (node->nchildren == alloc) {
+			alloc = alloc ? 2 * alloc : 16;
+			node->children = realloc(node->children, alloc * sizeof(struct node_s *));
+			if (!node->children) {
+				fprintf(stderr, "ERROR: Out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		child = xmalloc(strlen(path) + strlen(entry->d_name) + 2);
+		sprintf(child, "%s/%s", path, entry->d_name);
+		node->children[node->nchildren] = scan_tree(child, entry->d_name);
+		if (node->children[node->nchildren]) {
+			node->nchildren++;
+		}
+
+		free(child);
+	}
+
+	closedir(dirp);
+	qsort(node->children, node->nchildren, sizeof(struct node_s *), compare_nodes);
+	return node;
+}
+
+/* Image buffer */
+
+static uint32_t image_reserve(struct image_s *image, uint32_t size)
+{
+	uint32_t offset = image->size;
+
+	if (image->size + size > image->alloc) {
+		image->alloc = 2 * (image->size + size);
+		image->data = realloc(image->data, image->alloc);
+		if (!image->data) {
+			fprintf(stderr, "ERROR: Out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	memset(image->data + offset, 0, size);
+	image->size += size;
+	return offset;
+}
+
+static void image_put32(struct image_s *image, uint32_t offset, uint32_t value)
+{
+	uint8_t *ptr = image->data + offset;
+
+	ptr[0] = value >> 24;
+	ptr[1] = value >> 16;
+	ptr[2] = value >> 8;
+	ptr[3] = value;
+}
+
+static uint32_t image_get32(struct image_s *image, uint32_t offset)
+{
+	uint8_t *ptr = image->data + offset;
+
+	return (uint32_t)ptr[0] << 24 | (uint32_t)ptr[1] << 16 | (uint32_t)ptr[2] << 8 | ptr[3];
+}
+
+/* Make the 32-bit big-endian words in [offset, offset + size) sum up to zero
+ * by setting the checksum word at 'chksum'.
+ */
+
+static void image_checksum(struct image_s *image, uint32_t offset, uint32_t size, uint32_t chksum)
+{
+	uint32_t sum = 0;
+	uint32_t i;
+
+	image_put32(image, chksum, 0);
+	for (i = 0; i < size; i += 4) {
+		sum += image_get32(image, offset + i);
+	}
+
+	image_put32(image, chksum, -sum);
+}
+
+/* Add a file header and return its offset.  The next field is set later. */
+
+static uint32_t put_header(struct image_s *image, const char *name, uint32_t info, uint32_t size)
+{
+	uint32_t hdrsize = 16 + ROMFS_ALIGNUP(strlen(name) + 1);
+	uint32_t offset;
+
+	offset = image_reserve(image, hdrsize);
+	image_put32(image, offset + 4, info);
+	image_put32(image, offset + 8, size);
+	memcpy(image->data + offset + 16, name, strlen(name));
+	return offset;
+}
+
+static void finish_header(struct image_s *image, uint32_t offset, uint32_t next, uint32_t mode, const char *name)
+{
+	image_put32(image, offset, next | mode);
+	image_checksum(image, offset, 16 + ROMFS_ALIGNUP(strlen(name) + 1), offset + 12);
+}
+
+/* Encode one block of a file.  Return the encoded size. */
+
+static uint32_t rle_encode(const uint8_t *src, uint32_t size, uint8_t *dest)
+{
+	uint32_t literal = 0;
+	uint32_t nout = 0;
+	uint32_t run;
+	uint32_t i = 0;
+
+	while (i < size) {
+		for (run = 1; i + run < size && run < ROMFS_RLE_MAXRUN && src[i + run] == src[i]; run++) {
+		}
+
+		if (run >= ROMFS_RLE_MINRUN) {
+			if (literal > 0) {
+				dest[nout++] = literal - 1;
+				memcpy(&dest[nout], &src[i - literal], literal);
+				nout += literal;
+				literal = 0;
+			}
+
+			dest[nout++] = ROMFS_RLE_RUN + run - ROMFS_RLE_MINRUN;
+			dest[nout++] = src[i];
+			i += run;
+		} else {
+			literal++;
+			i++;
+			if (literal == ROMFS_RLE_MAXLITERAL) {
+				dest[nout++] = literal - 1;
+				memcpy(&dest[nout], &src[i - literal], literal);
+				nout += literal;
+				literal = 0;
+			}
+		}
+	}
+
+	if (literal > 0) {
+		dest[nout++] = literal - 1;
+		memcpy(&dest[nout], &src[i - literal], literal);
+		nout += literal;
+	}
+
+	return nout;
+}
+
+/* Compress a file.  Return the compressed size or zero if compression does
+ * not make the file smaller.
+ */
+
+static uint32_t rle_compress(const uint8_t *src, uint32_t size, uint8_t **pdest)
+{
+	uint32_t nblocks = (size + ROMFS_RLE_BLOCKSIZE - 1) / ROMFS_RLE_BLOCKSIZE;
+	uint32_t blocksize;
+	uint32_t nout;
+	uint32_t i;
+	uint8_t *dest;
+
+	/* Worst case: one control byte for each ROMFS_RLE_MAXLITERAL bytes */
+
+	dest = xmalloc(4 * nblocks + size + size / ROMFS_RLE_MAXLITERAL + nblocks + 1);
+	nout = 4 * nblocks;
+
+	for (i = 0; i < nblocks; i++) {
+		dest[4 * i] = nout >> 24;
+		dest[4 * i + 1] = nout >> 16;
+		dest[4 * i + 2] = nout >> 8;
+		dest[4 * i + 3] = nout;
+
+		blocksize = size - i * ROMFS_RLE_BLOCKSIZE;
+		if (blocksize > ROMFS_RLE_BLOCKSIZE) {
+			blocksize = ROMFS_RLE_BLOCKSIZE;
+		}
+
+		nout += rle_encode(src + i * ROMFS_RLE_BLOCKSIZE, blocksize, dest + nout);
+	}
+
+	if (nout >= size) {
+		free(dest);
+		return 0;
+	}
+
+	*pdest = dest;
+	return nout;
+}
+
+static uint8_t *read_file(struct node_s *node)
+{
+	uint8_t *data;
+	FILE *stream;
+
+	data = xmalloc(node->size + 1);
+	stream = fopen(node->path, "rb");
+	if (!stream || fread(data, 1, node->size, stream) != node->size) {
+		fprintf(stderr, "ERROR: Cannot read %s\n", node->path);
+		exit(EXIT_FAILURE);
+	}
+
+	fclose(stream);
+	return data;
+}
+
+/* Add a regular file: the header followed by the data */
+
+static uint32_t put_file(struct image_s *image, struct node_s *node)
+{
+	uint8_t *compressed = NULL;
+	uint32_t csize = 0;
+	uint32_t offset;
+	uint32_t data;
+	uint8_t *src;
+
+	src = read_file(node);
+	if (g_compress && node->size > 0) {
+		csize = rle_compress(src, node->size, &compressed);
+	}
+
+	if (csize > 0) {
+		offset = put_header(image, node->name, node->size, csize);
+		data = image_reserve(image, ROMFS_ALIGNUP(csize));
+		memcpy(image->data + data, compressed, csize);
+		g_storedbytes += csize;
+		g_ncompressed++;
+		free(compressed);
+	} else {
+		offset = put_header(image, node->name, 0, node->size);
+		data = image_reserve(image, ROMFS_ALIGNUP(node->size));
+		memcpy(image->data + data, src, node->size);
+		g_storedbytes += node->size;
+	}
+
+	free(src);
+	return offset;
+}
+
+/* Add the index of a directory.  Return its offset. */
+
+static uint32_t put_index(struct image_s *image, struct index_s *index, int count)
+{
+	uint32_t offset;
+	int i;
+
+	qsort(index, count, sizeof(struct index_s), compare_index);
+
+	offset = image_reserve(image, ROMFS_ALIGNUP(8 + 8 * count));
+	image_put32(image, offset, count);
+	for (i = 0; i < count; i++) {
+		image_put32(image, offset + 8 + 8 * i, index[i].hash);
+		image_put32(image, offset + 12 + 8 * i, index[i].offset);
+	}
+
+	return offset;
+}
+
+/* Account for the cost of looking up each entry of a directory: a linear
+ * search examines all of the entries up to the one found, a binary search
+ * examines about log2(count) index entries and the header found.
+ */
+
+static void count_probes(int count)
+{
+	int steps;
+	int i;
+
+	for (steps = 1; (1 << steps) <= count; steps++) {
+	}
+
+	for (i = 0; i < count; i++) {
+		g_linearprobes += i + 1;
+		g_indexprobes += steps + 1;
+	}
+
+	g_nlookups += count;
+}
+
+/* Add the entries of a directory.  'self' and 'parent' are the offsets of
+ * the headers of this directory and of its parent, or zero for the root
+ * directory.  Return the offset to the index.
+ */
+
+static uint32_t put_directory(struct image_s *image, struct node_s *node, uint32_t self, uint32_t parent)
+{
+	struct index_s *index;
+	struct node_s *child;
+	const char *name;
+	uint32_t *offsets;
+	uint32_t offset;
+	uint32_t mode;
+	bool isroot = (self == 0);
+	int count = node->nchildren + 2;
+	int i;
+
+	index = xmalloc(count * sizeof(struct index_s));
+	offsets = xmalloc(count * sizeof(uint32_t));
+
+	/* "." and "..".  The "." of the root directory is the header of the root
+	 * directory itself, the others are hard links.
+	 */
+
+	if (isroot) {
+		self = put_header(image, ".", 0, 0);
+		image_put32(image, self + 4, self);
+		parent = self;
+		offsets[0] = self;
+	} else {
+		offsets[0] = put_header(image, ".", self, 0);
+	}
+
+	offsets[1] = put_header(image, "..", parent, 0);
+
+	/* Then the children, each directory followed by its own entries */
+
+	for (i = 0; i < node->nchildren; i++) {
+		child = node->children[i];
+		if (child->isdir) {
+			offsets[i + 2] = put_header(image, child->name, 0, 0);
+			image_put32(image, offsets[i + 2] + 4, image->size);
+			image_put32(image, offsets[i + 2] + 8, put_directory(image, child, offsets[i + 2], self));
+		} else {
+			offsets[i + 2] = put_file(image, child);
+		}
+	}
+
+	/* Then the index */
+
+	for (i = 0; i < count; i++) {
+		name = i == 0 ? "." : i == 1 ? ".." : node->children[i - 2]->name;
+		index[i].hash = romfs_hash(name);
+		index[i].offset = offsets[i];
+	}
+
+	count_probes(count);
+	offset = put_index(image, index, count);
+
+	/* The root directory keeps its index in its "." header */
+
+	if (isroot) {
+		image_put32(image, self + 8, offset);
+	}
+
+	/* Now the offsets to the next entries are known */
+
+	for (i = 0; i < count; i++) {
+		if (i == 0) {
+			name = ".";
+			mode = isroot ? RFNEXT_DIRECTORY : RFNEXT_HARDLINK;
+		} else if (i == 1) {
+			name = "..";
+			mode = RFNEXT_HARDLINK;
+		} else {
+			child = node->children[i - 2];
+			name = child->name;
+			if (child->isdir) {
+				mode = RFNEXT_DIRECTORY;
+			} else {
+				mode = child->isexec ? RFNEXT_FILE | RFNEXT_EXEC : RFNEXT_FILE;
+			}
+		}
+
+		finish_header(image, offsets[i], i + 1 < count ? offsets[i + 1] : 0, mode, name);
+	}
+
+	free(offsets);
+	free(index);
+	return offset;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+	struct image_s image;
+	struct node_s *root;
+	const char *volname = "rom 1";
+	uint32_t offset;
+	FILE *stream;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "cV:x:h")) != -1) {
+		switch (opt) {
+		case 'c':
+			g_compress = true;
+			break;
+
+		case 'V':
+			volname = optarg;
+			break;
+
+		case 'x':
+			if (g_nexclude >= MAX_EXCLUDES) {
+				fprintf(stderr, "ERROR: Too many exclusions\n");
+				exit(EXIT_FAILURE);
+			}
+
+			g_exclude[g_nexclude++] = optarg;
+			break;
+
+		case 'h':
+			show_usage(argv[0], EXIT_SUCCESS);
+			break;
+
+		default:
+			show_usage(argv[0], EXIT_FAILURE);
+		}
+	}
+
+	if (optind + 2 != argc) {
+		show_usage(argv[0], EXIT_FAILURE);
+	}
+
+	root = scan_tree(argv[optind], "");
+	if (!root || !root->isdir) {
+		fprintf(stderr, "ERROR: %s is not a directory\n", argv[optind]);
+		exit(EXIT_FAILURE);
+	}
+
+	/* The volume header, then the root directory */
+
+	memset(&image, 0, sizeof(struct image_s));
+	offset = image_reserve(&image, 16 + ROMFS_ALIGNUP(strlen(volname) + 1));
+	memcpy(image.data, ROMFS_XMAGIC, 8);
+	memcpy(image.data + 16, volname, strlen(volname));
+
+	put_directory(&image, root, 0, 0);
+
+	/* Pad the image to a multiple of 1024 bytes like genromfs does.  The
+	 * checksum covers the first 512 bytes.
+	 */
+
+	image_reserve(&image, ((image.size + 1023) & ~1023) - image.size);
+	image_put32(&image, offset + 8, image.size);
+	image_checksum(&image, 0, image.size < 512 ? image.size : 512, offset + 12);
+
+	stream = fopen(argv[optind + 1], "wb");
+	if (!stream || fwrite(image.data, 1, image.size, stream) != image.size || fclose(stream) != 0) {
+		fprintf(stderr, "ERROR: Cannot write %s\n", argv[optind + 1]);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("%s: %lu files in %lu directories\n", argv[optind + 1], g_nfiles, g_ndirs);
+	printf("  file data : %lu bytes stored in %lu bytes (%lu files compressed)\n", g_filebytes, g_storedbytes, g_ncompressed);
+	printf("  image size: %lu bytes\n", (unsigned long)image.size);
+	printf("  headers examined per lookup: %.2f linear, %.2f indexed\n", (double)g_linearprobes / g_nlookups, (double)g_indexprobes / g_nlookups);
+
+	free(image.data);
+	return EXIT_SUCCESS;
+}